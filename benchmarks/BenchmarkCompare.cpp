@@ -0,0 +1,314 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "BenchmarkCompare.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace hipcomp {
+namespace benchmarks {
+
+namespace {
+
+struct Metric {
+  const char* name;
+  bool higher_is_better;
+  // Deterministic metrics are compared to the threshold only
+  bool deterministic;
+  double (*get)(const BenchmarkResult&);
+};
+
+const Metric RATIO_METRIC 
+    = {"ratio", true, true, [](const BenchmarkResult& res) { return res.ratio(); }};
+
+const Metric THROUGHPUT_METRICS[] = {
+    {"compress_gbps", true, false, [](const BenchmarkResult& res) { return res.compress_throughput; }},
+    {"decompress_gbps", true, false, [](const BenchmarkResult& res) { return res.decompress_throughput; }}};
+
+const Metric LATENCY_METRICS[] = {
+    {"compress_p50_us", false, false, [](const BenchmarkResult& res) { return res.compress_latency.p50; }},
+    {"compress_p99_us", false, false, [](const BenchmarkResult& res) { return res.compress_latency.p99; }},
+    {"decompress_p50_us", false, false, [](const BenchmarkResult& res) { return res.decompress_latency.p50; }},
+    {"decompress_p99_us", false, false, [](const BenchmarkResult& res) { return res.decompress_latency.p99; }}};
+
+double mean(const std::vector<double>& values)
+{
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += value;
+  }
+  return sum / values.size();
+}
+
+double sample_variance(const std::vector<double>& values, const double avg)
+{
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += (value - avg) * (value - avg);
+  }
+  return sum / (values.size() - 1);
+}
+
+/**
+ * @brief The continued fraction of the regularized incomplete beta function, 
+ * evaluated with the modified Lentz method
+ */
+double incomplete_beta_fraction(const double a, const double b, const double x)
+{
+  const double tiny = 1e-300;
+  double c = 1.0;
+  double d = 1.0 - (a + b) * x / (a + 1.0);
+  d = 1.0 / (std::fabs(d) < tiny ? tiny : d);
+  double res = d;
+  for (int m = 1; m <= 300; ++m) {
+    for (int step = 0; step < 2; ++step) {
+      const double numerator = step == 0 
+          ? m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)) 
+          : -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+      d = 1.0 + numerator * d;
+      d = 1.0 / (std::fabs(d) < tiny ? tiny : d);
+      c = 1.0 + numerator / c;
+      c = std::fabs(c) < tiny ? tiny : c;
+      res *= c * d;
+      if (step == 1 && std::fabs(c * d - 1.0) < 1e-12) {
+        return res;
+      }
+    }
+  }
+  return res;
+}
+
+// The regularized incomplete beta function I_x(a, b)
+double incomplete_beta(const double a, const double b, const double x)
+{
+  if (x <= 0.0) {
+    return 0.0;
+  }
+  if (x >= 1.0) {
+    return 1.0;
+  }
+  const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) 
+      + a * std::log(x) + b * std::log(1.0 - x));
+  if (x < (a + 1.0) / (a + b + 2.0)) {
+    return front * incomplete_beta_fraction(a, b, x) / a;
+  }
+  return 1.0 - front * incomplete_beta_fraction(b, a, 1.0 - x) / b;
+}
+
+std::string format_improvement(const double improvement)
+{
+  std::stringstream res;
+  res << (improvement < 0.0 ? "worse by " : "better by ") 
+      << std::fixed << std::setprecision(1) << 100.0 * std::fabs(improvement) << "%";
+  return res.str();
+}
+
+void write_json_list(std::ostream& out, const char* name, const std::vector<std::string>& values)
+{
+  out << "  " << json_string(name) << ": [";
+  for (size_t ix = 0; ix < values.size(); ++ix) {
+    out << (ix == 0 ? "" : ", ") << json_string(values[ix]);
+  }
+  out << "]";
+}
+
+} // namespace
+
+std::string configuration_key(const BenchmarkResult& result)
+{
+  std::stringstream key;
+  key << result.api << "/" << result.backend << "/" << result.format << "/" << result.data_type
+      << " dataset=" << result.dataset << " chunk_size=" << result.chunk_size 
+      << " num_chunks=" << result.num_chunks;
+  return key.str();
+}
+
+double welch_t_test(const std::vector<double>& a, const std::vector<double>& b)
+{
+  if (a.size() < 2 || b.size() < 2) {
+    return 1.0;
+  }
+  const double mean_a = mean(a);
+  const double mean_b = mean(b);
+  const double error_a = sample_variance(a, mean_a) / a.size();
+  const double error_b = sample_variance(b, mean_b) / b.size();
+  const double error = error_a + error_b;
+  if (error == 0.0) {
+    return mean_a == mean_b ? 1.0 : 0.0;
+  }
+
+  const double t = (mean_a - mean_b) / std::sqrt(error);
+  // Welch-Satterthwaite degrees of freedom
+  const double dof = error * error 
+      / (error_a * error_a / (a.size() - 1) + error_b * error_b / (b.size() - 1));
+  return incomplete_beta(dof / 2.0, 0.5, dof / (dof + t * t));
+}
+
+size_t CompareReport::num_regressions() const
+{
+  return std::count_if(comparisons.begin(), comparisons.end(), 
+      [](const MetricComparison& comparison) { return comparison.regression; });
+}
+
+CompareReport compare_results(
+    const std::vector<std::vector<BenchmarkResult>>& baseline_runs,
+    const std::vector<std::vector<BenchmarkResult>>& candidate_runs,
+    const CompareOptions& options)
+{
+  // The results of each configuration over all the runs of a side
+  using ResultsByConfiguration = std::map<std::string, std::vector<const BenchmarkResult*>>;
+  const auto group = [](const std::vector<std::vector<BenchmarkResult>>& runs) {
+    ResultsByConfiguration res;
+    for (const std::vector<BenchmarkResult>& run : runs) {
+      for (const BenchmarkResult& result : run) {
+        res[configuration_key(result)].push_back(&result);
+      }
+    }
+    return res;
+  };
+  const ResultsByConfiguration baseline = group(baseline_runs);
+  const ResultsByConfiguration candidate = group(candidate_runs);
+
+  std::vector<Metric> metrics;
+  if (options.compare_ratio) {
+    metrics.push_back(RATIO_METRIC);
+  }
+  if (options.compare_throughput) {
+    metrics.insert(metrics.end(), std::begin(THROUGHPUT_METRICS), std::end(THROUGHPUT_METRICS));
+  }
+  if (options.compare_latency) {
+    metrics.insert(metrics.end(), std::begin(LATENCY_METRICS), std::end(LATENCY_METRICS));
+  }
+
+  CompareReport report;
+  report.allow_missing = options.allow_missing;
+  for (const auto& entry : baseline) {
+    if (candidate.count(entry.first) == 0) {
+      report.missing.push_back(entry.first);
+    }
+  }
+  for (const auto& entry : candidate) {
+    const std::vector<const BenchmarkResult*>& candidate_results = entry.second;
+    if (std::any_of(candidate_results.begin(), candidate_results.end(), 
+        [](const BenchmarkResult* res) { return !res->verified; })) {
+      report.unverified.push_back(entry.first);
+    }
+
+    const auto baseline_entry = baseline.find(entry.first);
+    if (baseline_entry == baseline.end()) {
+      report.added.push_back(entry.first);
+      continue;
+    }
+    const std::vector<const BenchmarkResult*>& baseline_results = baseline_entry->second;
+
+    for (const Metric& metric : metrics) {
+      std::vector<double> baseline_values;
+      std::vector<double> candidate_values;
+      for (const BenchmarkResult* res : baseline_results) {
+        baseline_values.push_back(metric.get(*res));
+      }
+      for (const BenchmarkResult* res : candidate_results) {
+        candidate_values.push_back(metric.get(*res));
+      }
+
+      MetricComparison comparison;
+      comparison.configuration = entry.first;
+      comparison.metric = metric.name;
+      comparison.baseline = mean(baseline_values);
+      comparison.candidate = mean(candidate_values);
+      const double change = comparison.baseline != 0.0 
+          ? (comparison.candidate - comparison.baseline) / comparison.baseline : 0.0;
+      comparison.improvement = metric.higher_is_better ? change : -change;
+      comparison.p_value = metric.deterministic ? 1.0 : welch_t_test(baseline_values, candidate_values);
+
+      const bool tested = !metric.deterministic && baseline_values.size() > 1 && candidate_values.size() > 1;
+      comparison.regression = comparison.improvement < -options.threshold 
+          && (!tested || comparison.p_value < options.significance);
+      report.comparisons.push_back(comparison);
+    }
+  }
+  return report;
+}
+
+void write_report(std::ostream& out, const CompareReport& report)
+{
+  const auto write_comparison = [&out](const char* label, const MetricComparison& comparison) {
+    out << label << comparison.configuration << " " << comparison.metric << ": " 
+        << comparison.baseline << " -> " << comparison.candidate 
+        << " (" << format_improvement(comparison.improvement);
+    if (comparison.p_value < 1.0) {
+      out << ", p=" << comparison.p_value;
+    }
+    out << ")\n";
+  };
+
+  out << std::setprecision(4);
+  for (const MetricComparison& comparison : report.comparisons) {
+    if (comparison.regression) {
+      write_comparison("REGRESSION ", comparison);
+    }
+  }
+  for (const std::string& configuration : report.unverified) {
+    out << "UNVERIFIED " << configuration << ": decompressed data did not match the input\n";
+  }
+  for (const std::string& configuration : report.missing) {
+    out << "missing " << configuration << ": not measured by the candidate\n";
+  }
+  for (const std::string& configuration : report.added) {
+    out << "added " << configuration << ": not measured by the baseline\n";
+  }
+  out << report.comparisons.size() << " metrics compared, " << report.num_regressions() << " regressed, "
+      << report.unverified.size() << " unverified: " << (report.failed() ? "FAILED" : "PASSED") << "\n";
+}
+
+void write_report_json(std::ostream& out, const CompareReport& report)
+{
+  out << std::setprecision(6) << "{\n"
+      << "  \"failed\": " << (report.failed() ? "true" : "false") << ",\n"
+      << "  \"regressions\": " << report.num_regressions() << ",\n"
+      << "  \"comparisons\": [";
+  for (size_t ix = 0; ix < report.comparisons.size(); ++ix) {
+    const MetricComparison& comparison = report.comparisons[ix];
+    out << (ix == 0 ? "\n" : ",\n") 
+        << "    {\"configuration\": " << json_string(comparison.configuration) 
+        << ", \"metric\": " << json_string(comparison.metric) 
+        << ", \"baseline\": " << comparison.baseline 
+        << ", \"candidate\": " << comparison.candidate 
+        << ", \"improvement\": " << comparison.improvement 
+        << ", \"p_value\": " << comparison.p_value 
+        << ", \"regression\": " << (comparison.regression ? "true" : "false") << "}";
+  }
+  out << (report.comparisons.empty() ? "],\n" : "\n  ],\n");
+  write_json_list(out, "missing", report.missing);
+  out << ",\n";
+  write_json_list(out, "added", report.added);
+  out << ",\n";
+  write_json_list(out, "unverified", report.unverified);
+  out << "\n}\n";
+}
+
+} // namespace benchmarks
+} // namespace hipcomp
@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "BenchmarkResults.hpp"
+
+namespace hipcomp {
+namespace benchmarks {
+
+/**
+ * @brief Identifies the configuration a result was measured for, to match the same
+ * configuration across runs: API, backend, format, data type, dataset, chunk size
+ * and number of chunks.
+ */
+std::string configuration_key(const BenchmarkResult& result);
+
+/**
+ * @brief The two-sided p-value of Welch's t-test that two samples have the same
+ * mean. 1 if either sample has fewer than 2 values, or if both have no variance
+ * and the same mean.
+ */
+double welch_t_test(const std::vector<double>& a, const std::vector<double>& b);
+
+struct CompareOptions {
+  // Relative changes smaller than this are noise, never regressions
+  double threshold;
+  // With at least 2 runs on each side, changes must also have a p-value below this
+  double significance;
+  // Whether to compare the compression ratio, throughput and latency percentiles
+  bool compare_ratio;
+  bool compare_throughput;
+  bool compare_latency;
+  // Whether baseline configurations may be missing from the candidate
+  bool allow_missing;
+
+  CompareOptions()
+    : threshold(0.05),
+      significance(0.05),
+      compare_ratio(true),
+      compare_throughput(true),
+      compare_latency(true),
+      allow_missing(false)
+  {}
+};
+
+/**
+ * @brief The comparison of one metric of one configuration
+ */
+struct MetricComparison {
+  std::string configuration;
+  std::string metric;
+  // Means over the runs of each side
+  double baseline;
+  double candidate;
+  // Relative change of the candidate, positive when it is better
+  double improvement;
+  // Of Welch's t-test over the runs, 1 with a single run on either side
+  double p_value;
+  bool regression;
+};
+
+struct CompareReport {
+  std::vector<MetricComparison> comparisons;
+  // Configurations only measured by the baseline or the candidate
+  std::vector<std::string> missing;
+  std::vector<std::string> added;
+  // Configurations whose candidate round trip did not match the input
+  std::vector<std::string> unverified;
+  // From CompareOptions
+  bool allow_missing;
+
+  CompareReport() : allow_missing(false) {}
+
+  size_t num_regressions() const;
+
+  // Whether the candidate is a regression: slower, worse ratio or unverified. Also
+  // when nothing was compared, or baseline configurations are missing unless allowed.
+  bool failed() const
+  {
+    return num_regressions() > 0 || !unverified.empty() || comparisons.empty()
+        || (!allow_missing && !missing.empty());
+  }
+};
+
+/**
+ * @brief Compares the candidate runs to the baseline runs. Each run is the
+ * results of one benchmark invocation. Configurations are matched by
+ * configuration_key(), and their metrics averaged over the runs of each side.
+ *
+ * A metric regresses if it got worse by more than the threshold and, if both
+ * sides have at least 2 runs, the change is significant. The compression ratio
+ * is deterministic, so it is only compared to the threshold.
+ */
+CompareReport compare_results(
+    const std::vector<std::vector<BenchmarkResult>>& baseline_runs,
+    const std::vector<std::vector<BenchmarkResult>>& candidate_runs,
+    const CompareOptions& options);
+
+/**
+ * @brief Writes a human readable summary of the regressions, improvements and
+ * unmatched configurations
+ */
+void write_report(std::ostream& out, const CompareReport& report);
+
+/**
+ * @brief Writes every comparison of the report as JSON
+ */
+void write_report_json(std::ostream& out, const CompareReport& report);
+
+} // namespace benchmarks
+} // namespace hipcomp
@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "BenchmarkDatasets.hpp"
+#include "DatasetGenerator.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace hipcomp {
+namespace benchmarks {
+
+namespace {
+
+struct TypeInfo {
+  hipcompType_t type;
+  const char* name;
+  size_t size;
+};
+
+const TypeInfo TYPES[] = {
+    {HIPCOMP_TYPE_CHAR, "char", 1},
+    {HIPCOMP_TYPE_UCHAR, "uchar", 1},
+    {HIPCOMP_TYPE_SHORT, "short", 2},
+    {HIPCOMP_TYPE_USHORT, "ushort", 2},
+    {HIPCOMP_TYPE_INT, "int", 4},
+    {HIPCOMP_TYPE_UINT, "uint", 4},
+    {HIPCOMP_TYPE_LONGLONG, "longlong", 8},
+    {HIPCOMP_TYPE_ULONGLONG, "ulonglong", 8},
+    {HIPCOMP_TYPE_BITS, "bits", 1}};
+
+const TypeInfo& type_info(const hipcompType_t type)
+{
+  for (const TypeInfo& info : TYPES) {
+    if (info.type == type) {
+      return info;
+    }
+  }
+  throw std::invalid_argument("Unknown data type " + std::to_string(static_cast<int>(type)));
+}
+
+std::vector<uint8_t> read_file(const std::string& path, const size_t max_bytes)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Cannot open dataset file " + path);
+  }
+  std::vector<uint8_t> data(max_bytes);
+  file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(max_bytes));
+  data.resize(static_cast<size_t>(file.gcount()));
+  if (data.empty()) {
+    throw std::runtime_error("Dataset file " + path + " is empty");
+  }
+  return data;
+}
+
+} // namespace
+
+hipcompType_t parse_type(const std::string& name)
+{
+  for (const TypeInfo& info : TYPES) {
+    if (name == info.name) {
+      return info.type;
+    }
+  }
+  throw std::invalid_argument("Unknown data type " + name);
+}
+
+std::string type_name(const hipcompType_t type)
+{
+  return type_info(type).name;
+}
+
+size_t type_size(const hipcompType_t type)
+{
+  return type_info(type).size;
+}
+
+std::vector<uint8_t> load_dataset(
+    const std::string& name, const size_t max_bytes, const hipcompType_t data_type, const unsigned seed)
+{
+  const std::string file_prefix = "file:";
+  if (name.compare(0, file_prefix.size(), file_prefix) == 0) {
+    return read_file(name.substr(file_prefix.size()), max_bytes);
+  }
+
+  std::vector<uint8_t> data = datasets::generate(name, max_bytes, data_type, seed);
+  const size_t elem_size = type_size(data_type);
+  data.resize(data.size() / elem_size * elem_size);
+  return data;
+}
+
+} // namespace benchmarks
+} // namespace hipcomp
@@ -0,0 +1,67 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hipcomp.h"
+
+namespace hipcomp {
+namespace benchmarks {
+
+/**
+ * @brief Parses a data type name such as "char" or "ulonglong". Throws on unknown names.
+ */
+hipcompType_t parse_type(const std::string& name);
+
+/**
+ * @brief The name parse_type() accepts for type
+ */
+std::string type_name(hipcompType_t type);
+
+/**
+ * @brief The size of an element of type in bytes
+ */
+size_t type_size(hipcompType_t type);
+
+/**
+ * @brief Creates the input of a benchmark.
+ *
+ * Synthetic datasets come from datasets::generate() with elements of data_type, for
+ * example "runs", "sorted", "entropy:6", "text" or "noise".
+ *
+ * "file:<path>" reads a file instead, up to max_bytes of it.
+ *
+ * @param name The dataset.
+ * @param max_bytes The size of a synthetic dataset, and the most bytes read from a file.
+ * @param data_type The element type of a synthetic dataset.
+ * @param seed The seed of the random generators.
+ */
+std::vector<uint8_t> load_dataset(
+    const std::string& name, size_t max_bytes, hipcompType_t data_type, unsigned seed = 0);
+
+} // namespace benchmarks
+} // namespace hipcomp
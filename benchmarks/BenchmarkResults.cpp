@@ -0,0 +1,440 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "BenchmarkResults.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace hipcomp {
+namespace benchmarks {
+
+namespace {
+
+double nearest_rank(const std::vector<double>& sorted, const double percentile)
+{
+  const size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+  return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+std::string csv_field(const std::string& value)
+{
+  if (value.find_first_of(",\"\n") == std::string::npos) {
+    return value;
+  }
+  std::string res = "\"";
+  for (const char c : value) {
+    res += c;
+    if (c == '"') {
+      res += '"';
+    }
+  }
+  return res + "\"";
+}
+
+void write_json_latency(std::ostream& out, const char* name, const LatencyPercentiles& latency)
+{
+  out << "    " << json_string(name) << ": {\"p50\": " << latency.p50 << ", \"p90\": " << latency.p90
+      << ", \"p99\": " << latency.p99 << ", \"max\": " << latency.max << "}";
+}
+
+// Fields of one result by their CSV column names
+using ResultFields = std::map<std::string, std::string>;
+
+/**
+ * @brief Parses the JSON written by write_json(): an array of objects whose values
+ * are strings, numbers, booleans or objects of numbers
+ */
+class JsonResultParser
+{
+public:
+  explicit JsonResultParser(const std::string& text) : m_text(text), m_pos(0) {}
+
+  std::vector<ResultFields> parse()
+  {
+    std::vector<ResultFields> results;
+    expect('[');
+    if (!consume(']')) {
+      do {
+        results.push_back(parse_result());
+      } while (consume(','));
+      expect(']');
+    }
+    skip_whitespace();
+    if (m_pos != m_text.size()) {
+      fail("trailing characters");
+    }
+    return results;
+  }
+
+private:
+  ResultFields parse_result()
+  {
+    ResultFields fields;
+    expect('{');
+    do {
+      const std::string key = parse_string();
+      expect(':');
+      if (peek() == '{') {
+        // The latency objects, e.g. compress_latency_us.p50 is column compress_p50_us
+        const std::string direction = key.substr(0, key.find('_'));
+        expect('{');
+        do {
+          const std::string percentile = parse_string();
+          expect(':');
+          fields[direction + "_" + percentile + "_us"] = parse_scalar();
+        } while (consume(','));
+        expect('}');
+      } else {
+        fields[key] = parse_scalar();
+      }
+    } while (consume(','));
+    expect('}');
+    return fields;
+  }
+
+  std::string parse_scalar()
+  {
+    if (peek() == '"') {
+      return parse_string();
+    }
+    const size_t start = m_pos;
+    while (m_pos < m_text.size() && m_text[m_pos] != ',' && m_text[m_pos] != '}'
+        && !std::isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+      ++m_pos;
+    }
+    if (m_pos == start) {
+      fail("expected a value");
+    }
+    return m_text.substr(start, m_pos - start);
+  }
+
+  std::string parse_string()
+  {
+    expect('"');
+    std::string res;
+    while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+      char c = m_text[m_pos++];
+      if (c == '\\' && m_pos < m_text.size()) {
+        c = m_text[m_pos++];
+        if (c == 'n') {
+          c = '\n';
+        }
+      }
+      res += c;
+    }
+    expect('"');
+    return res;
+  }
+
+  void skip_whitespace()
+  {
+    while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+      ++m_pos;
+    }
+  }
+
+  char peek()
+  {
+    skip_whitespace();
+    return m_pos < m_text.size() ? m_text[m_pos] : '\0';
+  }
+
+  bool consume(const char c)
+  {
+    if (peek() != c) {
+      return false;
+    }
+    ++m_pos;
+    return true;
+  }
+
+  void expect(const char c)
+  {
+    if (!consume(c)) {
+      fail(std::string("expected '") + c + "'");
+    }
+  }
+
+  void fail(const std::string& what) const
+  {
+    throw std::runtime_error(
+        "Invalid benchmark results: " + what + " at offset " + std::to_string(m_pos));
+  }
+
+  const std::string& m_text;
+  size_t m_pos;
+};
+
+std::vector<std::string> split_csv_line(const std::string& line)
+{
+  std::vector<std::string> fields(1);
+  bool quoted = false;
+  for (size_t ix = 0; ix < line.size(); ++ix) {
+    const char c = line[ix];
+    if (quoted) {
+      if (c == '"' && ix + 1 < line.size() && line[ix + 1] == '"') {
+        fields.back() += '"';
+        ++ix;
+      } else if (c == '"') {
+        quoted = false;
+      } else {
+        fields.back() += c;
+      }
+    } else if (c == '"') {
+      quoted = true;
+    } else if (c == ',') {
+      fields.emplace_back();
+    } else if (c != '\r') {
+      fields.back() += c;
+    }
+  }
+  return fields;
+}
+
+std::vector<ResultFields> parse_csv(std::istream& in)
+{
+  std::string line;
+  std::getline(in, line);
+  const std::vector<std::string> header = split_csv_line(line);
+
+  std::vector<ResultFields> results;
+  while (std::getline(in, line)) {
+    if (line.empty() || line == "\r") {
+      continue;
+    }
+    const std::vector<std::string> values = split_csv_line(line);
+    if (values.size() != header.size()) {
+      throw std::runtime_error("Invalid benchmark results: row " + std::to_string(results.size() + 1)
+          + " has " + std::to_string(values.size()) + " fields instead of " + std::to_string(header.size()));
+    }
+    ResultFields fields;
+    for (size_t ix = 0; ix < header.size(); ++ix) {
+      fields[header[ix]] = values[ix];
+    }
+    results.push_back(fields);
+  }
+  return results;
+}
+
+const std::string& get_field(const ResultFields& fields, const std::string& name)
+{
+  const auto it = fields.find(name);
+  if (it == fields.end()) {
+    throw std::runtime_error("Invalid benchmark results: missing " + name);
+  }
+  return it->second;
+}
+
+double get_double(const ResultFields& fields, const std::string& name)
+{
+  const std::string& value = get_field(fields, name);
+  try {
+    return std::stod(value);
+  } catch (const std::exception&) {
+    throw std::runtime_error("Invalid benchmark results: " + name + " is " + value);
+  }
+}
+
+/**
+ * @brief A column added after the first results were written, 0 in older ones
+ */
+double get_optional_double(const ResultFields& fields, const std::string& name)
+{
+  return fields.count(name) ? get_double(fields, name) : 0.0;
+}
+
+size_t get_size(const ResultFields& fields, const std::string& name)
+{
+  const std::string& value = get_field(fields, name);
+  try {
+    return std::stoull(value);
+  } catch (const std::exception&) {
+    throw std::runtime_error("Invalid benchmark results: " + name + " is " + value);
+  }
+}
+
+LatencyPercentiles get_latency(const ResultFields& fields, const std::string& direction)
+{
+  return LatencyPercentiles{
+      get_double(fields, direction + "_p50_us"),
+      get_double(fields, direction + "_p90_us"),
+      get_double(fields, direction + "_p99_us"),
+      get_double(fields, direction + "_max_us")};
+}
+
+BenchmarkResult to_result(const ResultFields& fields)
+{
+  BenchmarkResult res;
+  res.api = get_field(fields, "api");
+  res.backend = get_field(fields, "backend");
+  res.format = get_field(fields, "format");
+  res.data_type = get_field(fields, "data_type");
+  res.dataset = get_field(fields, "dataset");
+  res.chunk_size = get_size(fields, "chunk_size");
+  res.num_chunks = get_size(fields, "num_chunks");
+  res.iterations = get_size(fields, "iterations");
+  res.uncompressed_bytes = get_size(fields, "uncompressed_bytes");
+  res.compressed_bytes = get_size(fields, "compressed_bytes");
+  res.compress_throughput = get_double(fields, "compress_gbps");
+  res.decompress_throughput = get_double(fields, "decompress_gbps");
+  res.compress_latency = get_latency(fields, "compress");
+  res.decompress_latency = get_latency(fields, "decompress");
+  res.verified = get_field(fields, "verified") == "true";
+  res.memory_bandwidth = get_optional_double(fields, "memory_gbps");
+  return res;
+}
+
+} // namespace
+
+std::string json_string(const std::string& value)
+{
+  std::string res = "\"";
+  for (const char c : value) {
+    switch (c) {
+    case '"':
+      res += "\\\"";
+      break;
+    case '\\':
+      res += "\\\\";
+      break;
+    case '\n':
+      res += "\\n";
+      break;
+    default:
+      res += c;
+    }
+  }
+  return res + "\"";
+}
+
+LatencyPercentiles compute_percentiles(std::vector<double> samples_us)
+{
+  if (samples_us.empty()) {
+    return LatencyPercentiles{0.0, 0.0, 0.0, 0.0};
+  }
+  std::sort(samples_us.begin(), samples_us.end());
+  return LatencyPercentiles{
+      nearest_rank(samples_us, 50.0),
+      nearest_rank(samples_us, 90.0),
+      nearest_rank(samples_us, 99.0),
+      samples_us.back()};
+}
+
+void write_json(std::ostream& out, const std::vector<BenchmarkResult>& results)
+{
+  out << std::setprecision(6) << "[";
+  for (size_t ix = 0; ix < results.size(); ++ix) {
+    const BenchmarkResult& res = results[ix];
+    out << (ix == 0 ? "\n" : ",\n") << "  {\n"
+        << "    \"api\": " << json_string(res.api) << ",\n"
+        << "    \"backend\": " << json_string(res.backend) << ",\n"
+        << "    \"format\": " << json_string(res.format) << ",\n"
+        << "    \"data_type\": " << json_string(res.data_type) << ",\n"
+        << "    \"dataset\": " << json_string(res.dataset) << ",\n"
+        << "    \"chunk_size\": " << res.chunk_size << ",\n"
+        << "    \"num_chunks\": " << res.num_chunks << ",\n"
+        << "    \"iterations\": " << res.iterations << ",\n"
+        << "    \"uncompressed_bytes\": " << res.uncompressed_bytes << ",\n"
+        << "    \"compressed_bytes\": " << res.compressed_bytes << ",\n"
+        << "    \"ratio\": " << res.ratio() << ",\n"
+        << "    \"compress_gbps\": " << res.compress_throughput << ",\n"
+        << "    \"decompress_gbps\": " << res.decompress_throughput << ",\n"
+        << "    \"memory_gbps\": " << res.memory_bandwidth << ",\n"
+        << "    \"bytes_per_input_byte\": " << res.bytes_per_input_byte() << ",\n"
+        << "    \"compress_bandwidth_fraction\": " << res.compress_bandwidth_fraction() << ",\n"
+        << "    \"decompress_bandwidth_fraction\": " << res.decompress_bandwidth_fraction() << ",\n";
+    write_json_latency(out, "compress_latency_us", res.compress_latency);
+    out << ",\n";
+    write_json_latency(out, "decompress_latency_us", res.decompress_latency);
+    out << ",\n"
+        << "    \"verified\": " << (res.verified ? "true" : "false") << "\n"
+        << "  }";
+  }
+  out << (results.empty() ? "]\n" : "\n]\n");
+}
+
+void write_csv(std::ostream& out, const std::vector<BenchmarkResult>& results)
+{
+  out << "api,backend,format,data_type,dataset,chunk_size,num_chunks,iterations,"
+         "uncompressed_bytes,compressed_bytes,ratio,compress_gbps,decompress_gbps,"
+         "memory_gbps,bytes_per_input_byte,compress_bandwidth_fraction,decompress_bandwidth_fraction,"
+         "compress_p50_us,compress_p90_us,compress_p99_us,compress_max_us,"
+         "decompress_p50_us,decompress_p90_us,decompress_p99_us,decompress_max_us,verified\n";
+  out << std::setprecision(6);
+  for (const BenchmarkResult& res : results) {
+    out << csv_field(res.api) << "," << csv_field(res.backend) << "," << csv_field(res.format) << ","
+        << csv_field(res.data_type) << "," << csv_field(res.dataset) << ","
+        << res.chunk_size << "," << res.num_chunks << "," << res.iterations << ","
+        << res.uncompressed_bytes << "," << res.compressed_bytes << "," << res.ratio() << ","
+        << res.compress_throughput << "," << res.decompress_throughput << ","
+        << res.memory_bandwidth << "," << res.bytes_per_input_byte() << ","
+        << res.compress_bandwidth_fraction() << "," << res.decompress_bandwidth_fraction() << ","
+        << res.compress_latency.p50 << "," << res.compress_latency.p90 << ","
+        << res.compress_latency.p99 << "," << res.compress_latency.max << ","
+        << res.decompress_latency.p50 << "," << res.decompress_latency.p90 << ","
+        << res.decompress_latency.p99 << "," << res.decompress_latency.max << ","
+        << (res.verified ? "true" : "false") << "\n";
+  }
+}
+
+std::vector<BenchmarkResult> read_results(std::istream& in)
+{
+  char first = '\0';
+  if (!(in >> std::ws).get(first)) {
+    return {};
+  }
+  in.unget();
+
+  std::vector<ResultFields> rows;
+  if (first == '[') {
+    std::stringstream text;
+    text << in.rdbuf();
+    rows = JsonResultParser(text.str()).parse();
+  } else {
+    rows = parse_csv(in);
+  }
+
+  std::vector<BenchmarkResult> results;
+  for (const ResultFields& fields : rows) {
+    results.push_back(to_result(fields));
+  }
+  return results;
+}
+
+std::vector<BenchmarkResult> read_results_file(const std::string& path)
+{
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("Cannot open benchmark results " + path);
+  }
+  return read_results(in);
+}
+
+} // namespace benchmarks
+} // namespace hipcomp
@@ -0,0 +1,136 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hipcomp {
+namespace benchmarks {
+
+/**
+ * @brief Percentiles of the time the iterations of a benchmark took, in microseconds
+ */
+struct LatencyPercentiles {
+  double p50;
+  double p90;
+  double p99;
+  double max;
+};
+
+/**
+ * @brief Computes the percentiles of samples, with nearest-rank rounding. All 0
+ * if there are no samples.
+ */
+LatencyPercentiles compute_percentiles(std::vector<double> samples_us);
+
+/**
+ * @brief The measurements of one benchmark configuration
+ */
+struct BenchmarkResult {
+  std::string api;
+  std::string backend;
+  std::string format;
+  std::string data_type;
+  std::string dataset;
+  size_t chunk_size;
+  size_t num_chunks;
+  size_t iterations;
+  size_t uncompressed_bytes;
+  size_t compressed_bytes;
+  // Uncompressed bytes per second over the mean iteration time, in GB/s
+  double compress_throughput;
+  double decompress_throughput;
+  LatencyPercentiles compress_latency;
+  LatencyPercentiles decompress_latency;
+  // Whether the decompressed data matched the input
+  bool verified;
+  // The measured bandwidth of the memory the backend works in, in GB/s, or 0 if
+  // not measured. See measure_memory_bandwidth().
+  double memory_bandwidth;
+
+  double ratio() const
+  {
+    return compressed_bytes > 0 ? static_cast<double>(uncompressed_bytes) / compressed_bytes : 0.0;
+  }
+
+  /**
+   * @brief The bytes compression or decompression must at least read and write per
+   * uncompressed byte: the uncompressed and the compressed data once each
+   */
+  double bytes_per_input_byte() const
+  {
+    return uncompressed_bytes > 0 ? 1.0 + static_cast<double>(compressed_bytes) / uncompressed_bytes : 0.0;
+  }
+
+  /**
+   * @brief The fraction of the memory bandwidth that the traffic of compression
+   * takes at its throughput. Close to 1 when compression is memory bound, and 0 if
+   * the bandwidth was not measured.
+   */
+  double compress_bandwidth_fraction() const
+  {
+    return memory_bandwidth > 0.0 ? compress_throughput * bytes_per_input_byte() / memory_bandwidth : 0.0;
+  }
+
+  /**
+   * @brief As compress_bandwidth_fraction(), for decompression
+   */
+  double decompress_bandwidth_fraction() const
+  {
+    return memory_bandwidth > 0.0 ? decompress_throughput * bytes_per_input_byte() / memory_bandwidth : 0.0;
+  }
+};
+
+/**
+ * @brief Writes results as a JSON array with one object per result
+ */
+void write_json(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+/**
+ * @brief Writes results as CSV with a header row
+ */
+void write_csv(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+/**
+ * @brief Reads results written by write_json() or write_csv(). The format is
+ * detected from the first character. Throws std::runtime_error on malformed input.
+ */
+std::vector<BenchmarkResult> read_results(std::istream& in);
+
+/**
+ * @brief Reads the results of a JSON or CSV file. Throws std::runtime_error if
+ * it cannot be opened or parsed.
+ */
+std::vector<BenchmarkResult> read_results_file(const std::string& path);
+
+/**
+ * @brief Quotes a string for JSON, escaping quotes, backslashes and newlines
+ */
+std::string json_string(const std::string& value);
+
+} // namespace benchmarks
+} // namespace hipcomp
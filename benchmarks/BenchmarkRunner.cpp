@@ -0,0 +1,430 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "BenchmarkRunner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+#include "hipcomp/ans.hpp"
+#include "hipcomp/bitcomp.hpp"
+#include "hipcomp/cascaded.hpp"
+#include "hipcomp/gdeflate.hpp"
+#include "hipcomp/hipcompHostThreadPool.hpp"
+#include "hipcomp/hipcompHybridBackend.hpp"
+#include "hipcomp/lz4.hpp"
+#include "hipcomp/snappy.hpp"
+
+#include "BenchmarkDatasets.hpp"
+
+namespace hipcomp {
+namespace benchmarks {
+
+namespace {
+
+void check_hip(const hipError_t err, const char* call)
+{
+  if (err != hipSuccess) {
+    throw HipCompException(hipcompErrorCudaError, std::string(call) + " failed: " + hipGetErrorString(err));
+  }
+}
+
+#define BENCHMARK_HIP_CHECK(call) check_hip((call), #call)
+
+/**
+ * @brief A buffer in host or device memory
+ */
+struct BenchmarkBuffer {
+  bool device;
+  uint8_t* ptr;
+  size_t size;
+
+  BenchmarkBuffer(const bool device, const size_t size)
+    : device(device),
+      ptr(nullptr),
+      size(size)
+  {
+    if (device) {
+      BENCHMARK_HIP_CHECK(hipMalloc(&ptr, std::max<size_t>(size, 1)));
+    } else {
+      ptr = new uint8_t[std::max<size_t>(size, 1)];
+    }
+  }
+
+  BenchmarkBuffer(const BenchmarkBuffer&) = delete;
+  BenchmarkBuffer& operator=(const BenchmarkBuffer&) = delete;
+
+  ~BenchmarkBuffer()
+  {
+    if (device) {
+      hipFree(ptr);
+    } else {
+      delete[] ptr;
+    }
+  }
+
+  void upload(const uint8_t* src, const size_t bytes)
+  {
+    if (device) {
+      BENCHMARK_HIP_CHECK(hipMemcpy(ptr, src, bytes, hipMemcpyHostToDevice));
+    } else {
+      std::memcpy(ptr, src, bytes);
+    }
+  }
+
+  std::vector<uint8_t> download(const size_t bytes) const
+  {
+    std::vector<uint8_t> res(bytes);
+    if (device) {
+      BENCHMARK_HIP_CHECK(hipMemcpy(res.data(), ptr, bytes, hipMemcpyDeviceToHost));
+    } else {
+      std::memcpy(res.data(), ptr, bytes);
+    }
+    return res;
+  }
+};
+
+/**
+ * @brief Runs fn for the warmup iterations and then the measured ones, and returns
+ * the durations fn reported for the measured ones, in microseconds
+ */
+template<typename Iteration>
+std::vector<double> run_iterations(const BenchmarkCase& bench, Iteration fn)
+{
+  std::vector<double> samples;
+  for (size_t i = 0; i < bench.warmup_iterations + bench.iterations; ++i) {
+    const double us = fn();
+    if (i >= bench.warmup_iterations) {
+      samples.push_back(us);
+    }
+  }
+  return samples;
+}
+
+double throughput_gbps(const size_t bytes, const std::vector<double>& samples_us)
+{
+  if (samples_us.empty()) {
+    return 0.0;
+  }
+  const double mean_us = std::accumulate(samples_us.begin(), samples_us.end(), 0.0) / samples_us.size();
+  return mean_us > 0.0 ? bytes / (mean_us * 1e3) : 0.0;
+}
+
+double measure_device_copy_us(hipStream_t stream, const size_t bytes, const size_t iterations)
+{
+  BenchmarkBuffer src(true, bytes);
+  BenchmarkBuffer dst(true, bytes);
+  BENCHMARK_HIP_CHECK(hipMemsetAsync(src.ptr, 1, bytes, stream));
+
+  hipEvent_t start;
+  hipEvent_t stop;
+  BENCHMARK_HIP_CHECK(hipEventCreate(&start));
+  BENCHMARK_HIP_CHECK(hipEventCreate(&stop));
+  double best_us = std::numeric_limits<double>::max();
+  try {
+    // The first copy is not measured
+    for (size_t i = 0; i <= iterations; ++i) {
+      BENCHMARK_HIP_CHECK(hipEventRecord(start, stream));
+      BENCHMARK_HIP_CHECK(hipMemcpyAsync(dst.ptr, src.ptr, bytes, hipMemcpyDeviceToDevice, stream));
+      BENCHMARK_HIP_CHECK(hipEventRecord(stop, stream));
+      BENCHMARK_HIP_CHECK(hipEventSynchronize(stop));
+      float ms = 0.0f;
+      BENCHMARK_HIP_CHECK(hipEventElapsedTime(&ms, start, stop));
+      if (i > 0) {
+        best_us = std::min(best_us, 1e3 * ms);
+      }
+    }
+  } catch (...) {
+    hipEventDestroy(start);
+    hipEventDestroy(stop);
+    throw;
+  }
+  BENCHMARK_HIP_CHECK(hipEventDestroy(start));
+  BENCHMARK_HIP_CHECK(hipEventDestroy(stop));
+  return best_us;
+}
+
+double measure_host_copy_us(const size_t bytes, const size_t iterations)
+{
+  BenchmarkBuffer src(false, bytes);
+  BenchmarkBuffer dst(false, bytes);
+  HostThreadPool& pool = get_host_thread_pool();
+  // The calling thread takes part
+  const size_t num_slices = pool.get_num_threads() + 1;
+  auto for_each_slice = [&](const std::function<void(size_t, size_t)>& fn) {
+    pool.parallel_for(num_slices, [&](const size_t ix) {
+      const size_t begin = bytes * ix / num_slices;
+      fn(begin, bytes * (ix + 1) / num_slices - begin);
+    });
+  };
+  // Touch the pages on the threads that copy them, which places them on their node
+  for_each_slice([&](const size_t offset, const size_t size) {
+    std::memset(src.ptr + offset, 1, size);
+    std::memset(dst.ptr + offset, 0, size);
+  });
+
+  typedef std::chrono::steady_clock Clock;
+  double best_us = std::numeric_limits<double>::max();
+  for (size_t i = 0; i <= iterations; ++i) {
+    const Clock::time_point start = Clock::now();
+    for_each_slice([&](const size_t offset, const size_t size) {
+      std::memcpy(dst.ptr + offset, src.ptr + offset, size);
+    });
+    const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    if (i > 0) {
+      best_us = std::min(best_us, us);
+    }
+  }
+  return best_us;
+}
+
+BenchmarkResult make_result(const BenchmarkCase& bench, const size_t num_chunks, const size_t uncompressed_bytes)
+{
+  BenchmarkResult res;
+  res.api = bench.api;
+  res.backend = bench.backend;
+  res.format = bench.format;
+  res.data_type = format_uses_type(bench.format) ? type_name(bench.data_type) : "-";
+  res.dataset = bench.dataset;
+  res.chunk_size = bench.chunk_size;
+  res.num_chunks = num_chunks;
+  res.iterations = bench.iterations;
+  res.uncompressed_bytes = uncompressed_bytes;
+  res.compressed_bytes = 0;
+  res.compress_throughput = 0.0;
+  res.decompress_throughput = 0.0;
+  res.compress_latency = compute_percentiles(std::vector<double>());
+  res.decompress_latency = res.compress_latency;
+  res.verified = false;
+  res.memory_bandwidth = 0.0;
+  return res;
+}
+
+} // namespace
+
+bool format_uses_type(const std::string& format)
+{
+  return format == "lz4" || format == "cascaded" || format == "bitcomp";
+}
+
+std::unique_ptr<BatchedCompressBackend> create_benchmark_backend(const BenchmarkCase& bench, hipStream_t stream)
+{
+  if (bench.backend == "host") {
+    if (bench.format != "lz4") {
+      throw HipCompException(hipcompErrorNotSupported, "There is no host codec for " + bench.format + ".");
+    }
+    return create_host_lz4_backend(bench.batch_size, bench.chunk_size);
+  }
+
+  if (bench.format == "lz4") {
+    return create_batched_compress_backend(
+        hipcompBatchedLZ4Opts_t{bench.data_type}, stream, bench.batch_size, bench.chunk_size);
+  } else if (bench.format == "snappy") {
+    return create_batched_compress_backend(
+        hipcompBatchedSnappyDefaultOpts, stream, bench.batch_size, bench.chunk_size);
+  } else if (bench.format == "cascaded") {
+    hipcompBatchedCascadedOpts_t opts = hipcompBatchedCascadedDefaultOpts;
+    opts.chunk_size = bench.chunk_size;
+    opts.type = bench.data_type;
+    return create_batched_compress_backend(opts, stream, bench.batch_size, bench.chunk_size);
+  } else if (bench.format == "gdeflate") {
+    return create_batched_compress_backend(
+        hipcompBatchedGdeflateDefaultOpts, stream, bench.batch_size, bench.chunk_size);
+  } else if (bench.format == "ans") {
+    return create_batched_compress_backend(
+        hipcompBatchedANSDefaultOpts, stream, bench.batch_size, bench.chunk_size);
+  } else if (bench.format == "bitcomp") {
+    hipcompBatchedBitcompFormatOpts opts = hipcompBatchedBitcompDefaultOpts;
+    opts.data_type = bench.data_type;
+    return create_batched_compress_backend(opts, stream, bench.batch_size, bench.chunk_size);
+  }
+  throw HipCompException(hipcompErrorInvalidValue, "Unknown format " + bench.format + ".");
+}
+
+std::unique_ptr<hipcompManagerBase> create_benchmark_manager(const BenchmarkCase& bench, hipStream_t stream)
+{
+  if (bench.backend == "host") {
+    throw HipCompException(hipcompErrorNotSupported, "Managers run on the device only.");
+  }
+
+  if (bench.format == "lz4") {
+    return std::unique_ptr<hipcompManagerBase>(new LZ4Manager(bench.chunk_size, bench.data_type, stream));
+  } else if (bench.format == "snappy") {
+    return std::unique_ptr<hipcompManagerBase>(new SnappyManager(bench.chunk_size, stream));
+  } else if (bench.format == "cascaded") {
+    hipcompBatchedCascadedOpts_t opts = hipcompBatchedCascadedDefaultOpts;
+    opts.chunk_size = bench.chunk_size;
+    opts.type = bench.data_type;
+    return std::unique_ptr<hipcompManagerBase>(new CascadedManager(opts, stream));
+  } else if (bench.format == "gdeflate") {
+    return std::unique_ptr<hipcompManagerBase>(
+        new GdeflateManager(bench.chunk_size, hipcompBatchedGdeflateDefaultOpts.algo, stream));
+  } else if (bench.format == "ans") {
+    return std::unique_ptr<hipcompManagerBase>(new ANSManager(bench.chunk_size, stream));
+  } else if (bench.format == "bitcomp") {
+    return std::unique_ptr<hipcompManagerBase>(new BitcompManager(bench.data_type, 0, stream));
+  }
+  throw HipCompException(hipcompErrorInvalidValue, "Unknown format " + bench.format + ".");
+}
+
+BenchmarkResult run_batched_benchmark(
+    const BenchmarkCase& bench, BatchedCompressBackend& backend, const std::vector<uint8_t>& data)
+{
+  const size_t num_chunks = std::min(bench.batch_size, (data.size() + bench.chunk_size - 1) / bench.chunk_size);
+  const size_t total_bytes = std::min(data.size(), num_chunks * bench.chunk_size);
+  const size_t max_comp_chunk_bytes = backend.get_max_compressed_chunk_size(bench.chunk_size);
+  const bool device = bench.backend != "host";
+
+  BenchmarkBuffer input(device, total_bytes);
+  BenchmarkBuffer comp(device, num_chunks * max_comp_chunk_bytes);
+  BenchmarkBuffer output(device, total_bytes);
+  input.upload(data.data(), total_bytes);
+
+  std::vector<const void*> input_ptrs(num_chunks);
+  std::vector<size_t> input_bytes(num_chunks);
+  std::vector<void*> comp_ptrs(num_chunks);
+  std::vector<size_t> comp_bytes(num_chunks);
+  std::vector<void*> output_ptrs(num_chunks);
+  std::vector<size_t> output_bytes(num_chunks);
+  for (size_t ix = 0; ix < num_chunks; ++ix) {
+    input_ptrs[ix] = input.ptr + ix * bench.chunk_size;
+    input_bytes[ix] = std::min(bench.chunk_size, total_bytes - ix * bench.chunk_size);
+    comp_ptrs[ix] = comp.ptr + ix * max_comp_chunk_bytes;
+    output_ptrs[ix] = output.ptr + ix * bench.chunk_size;
+  }
+  const size_t max_chunk_bytes = num_chunks > 0 ? input_bytes.front() : 0;
+
+  typedef std::chrono::steady_clock Clock;
+  const std::vector<double> compress_us = run_iterations(bench, [&]() {
+    const Clock::time_point start = Clock::now();
+    backend.compress_batch(input_ptrs.data(), input_bytes.data(), max_chunk_bytes, num_chunks,
+        comp_ptrs.data(), comp_bytes.data());
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+  });
+
+  const std::vector<const void*> comp_inputs(comp_ptrs.begin(), comp_ptrs.end());
+  const std::vector<double> decompress_us = run_iterations(bench, [&]() {
+    const Clock::time_point start = Clock::now();
+    backend.decompress_batch(comp_inputs.data(), comp_bytes.data(), input_bytes.data(), num_chunks,
+        output_ptrs.data(), output_bytes.data());
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+  });
+
+  BenchmarkResult res = make_result(bench, num_chunks, total_bytes);
+  res.compressed_bytes = std::accumulate(comp_bytes.begin(), comp_bytes.end(), size_t(0));
+  res.compress_throughput = throughput_gbps(total_bytes, compress_us);
+  res.decompress_throughput = throughput_gbps(total_bytes, decompress_us);
+  res.compress_latency = compute_percentiles(compress_us);
+  res.decompress_latency = compute_percentiles(decompress_us);
+  res.verified = output_bytes == input_bytes
+      && std::equal(data.begin(), data.begin() + total_bytes, output.download(total_bytes).begin());
+  return res;
+}
+
+BenchmarkResult run_manager_benchmark(
+    const BenchmarkCase& bench, hipcompManagerBase& manager, hipStream_t stream, const std::vector<uint8_t>& data)
+{
+  const size_t total_bytes = std::min(data.size(), bench.batch_size * bench.chunk_size);
+
+  CompressionConfig comp_config = manager.configure_compression(total_bytes);
+  BenchmarkBuffer input(true, total_bytes);
+  BenchmarkBuffer comp(true, comp_config.max_compressed_buffer_size);
+  BenchmarkBuffer output(true, total_bytes);
+  input.upload(data.data(), total_bytes);
+
+  hipEvent_t start;
+  hipEvent_t stop;
+  BENCHMARK_HIP_CHECK(hipEventCreate(&start));
+  BENCHMARK_HIP_CHECK(hipEventCreate(&stop));
+  auto time_on_stream = [&](const std::function<void()>& fn) {
+    BENCHMARK_HIP_CHECK(hipEventRecord(start, stream));
+    fn();
+    BENCHMARK_HIP_CHECK(hipEventRecord(stop, stream));
+    BENCHMARK_HIP_CHECK(hipEventSynchronize(stop));
+    float ms = 0.0f;
+    BENCHMARK_HIP_CHECK(hipEventElapsedTime(&ms, start, stop));
+    return 1e3 * ms;
+  };
+
+  BenchmarkResult res = make_result(bench, (total_bytes + bench.chunk_size - 1) / bench.chunk_size, total_bytes);
+  try {
+    const std::vector<double> compress_us = run_iterations(bench, [&]() {
+      return time_on_stream([&]() { manager.compress(input.ptr, comp.ptr, comp_config); });
+    });
+    if (*comp_config.get_status() != hipcompSuccess) {
+      throw HipCompException(*comp_config.get_status(), "Compression failed.");
+    }
+    res.compressed_bytes = manager.get_compressed_output_size(comp.ptr);
+
+    DecompressionConfig decomp_config = manager.configure_decompression(comp.ptr);
+    const std::vector<double> decompress_us = run_iterations(bench, [&]() {
+      return time_on_stream([&]() { manager.decompress(output.ptr, comp.ptr, decomp_config); });
+    });
+    if (*decomp_config.get_status() != hipcompSuccess) {
+      throw HipCompException(*decomp_config.get_status(), "Decompression failed.");
+    }
+
+    res.compress_throughput = throughput_gbps(total_bytes, compress_us);
+    res.decompress_throughput = throughput_gbps(total_bytes, decompress_us);
+    res.compress_latency = compute_percentiles(compress_us);
+    res.decompress_latency = compute_percentiles(decompress_us);
+    res.verified = std::equal(data.begin(), data.begin() + total_bytes, output.download(total_bytes).begin());
+  } catch (...) {
+    hipEventDestroy(start);
+    hipEventDestroy(stop);
+    throw;
+  }
+  BENCHMARK_HIP_CHECK(hipEventDestroy(start));
+  BENCHMARK_HIP_CHECK(hipEventDestroy(stop));
+  return res;
+}
+
+BenchmarkResult run_benchmark(const BenchmarkCase& bench, hipStream_t stream, const std::vector<uint8_t>& data)
+{
+  if (bench.api == "batched") {
+    std::unique_ptr<BatchedCompressBackend> backend = create_benchmark_backend(bench, stream);
+    return run_batched_benchmark(bench, *backend, data);
+  } else if (bench.api == "manager") {
+    std::unique_ptr<hipcompManagerBase> manager = create_benchmark_manager(bench, stream);
+    return run_manager_benchmark(bench, *manager, stream, data);
+  }
+  throw HipCompException(hipcompErrorInvalidValue, "Unknown API " + bench.api + ".");
+}
+
+double measure_memory_bandwidth(
+    const std::string& backend, hipStream_t stream, const size_t bytes, const size_t iterations)
+{
+  if (bytes == 0 || iterations == 0) {
+    throw HipCompException(hipcompErrorInvalidValue, "The bandwidth probe needs bytes and iterations.");
+  }
+  const double best_us = backend == "host" ? measure_host_copy_us(bytes, iterations)
+                                           : measure_device_copy_us(stream, bytes, iterations);
+  // Each byte is read once and written once
+  return best_us > 0.0 ? 2.0 * bytes / (best_us * 1e3) : 0.0;
+}
+
+} // namespace benchmarks
+} // namespace hipcomp
@@ -0,0 +1,116 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompCoalescingService.hpp"
+#include "hipcomp/hipcompManager.hpp"
+
+#include "BenchmarkResults.hpp"
+
+namespace hipcomp {
+namespace benchmarks {
+
+/**
+ * @brief One configuration to measure
+ */
+struct BenchmarkCase {
+  // "batched" for the batched C API, "manager" for the high level managers
+  std::string api;
+  // "device", or "host" for the host codecs, which need no GPU
+  std::string backend;
+  // lz4, snappy, cascaded, gdeflate, ans or bitcomp
+  std::string format;
+  hipcompType_t data_type;
+  size_t chunk_size;
+  // The most chunks in a batch, or in the buffer given to a manager
+  size_t batch_size;
+  std::string dataset;
+  size_t iterations;
+  size_t warmup_iterations;
+};
+
+/**
+ * @brief Whether the data type is an option of format. Other formats are measured
+ * once per chunk size and dataset.
+ */
+bool format_uses_type(const std::string& format);
+
+/**
+ * @brief Creates the backend a batched benchmark runs on.
+ *
+ * Throws hipcompErrorNotSupported for configurations without an implementation,
+ * e.g. formats without a host codec.
+ */
+std::unique_ptr<BatchedCompressBackend> create_benchmark_backend(const BenchmarkCase& bench, hipStream_t stream);
+
+/**
+ * @brief Creates the manager a manager benchmark runs on.
+ */
+std::unique_ptr<hipcompManagerBase> create_benchmark_manager(const BenchmarkCase& bench, hipStream_t stream);
+
+/**
+ * @brief Measures compression and decompression of data, split into chunks, on backend.
+ *
+ * Each iteration is timed on the host around a whole batch call, which includes
+ * the copies of the pointer and size arrays that a batched API user would also make.
+ * For the device backend, the chunks are staged in device memory beforehand.
+ */
+BenchmarkResult run_batched_benchmark(
+    const BenchmarkCase& bench, BatchedCompressBackend& backend, const std::vector<uint8_t>& data);
+
+/**
+ * @brief Measures compression and decompression of data in one buffer with manager.
+ *
+ * Each iteration is timed with events on stream.
+ */
+BenchmarkResult run_manager_benchmark(
+    const BenchmarkCase& bench, hipcompManagerBase& manager, hipStream_t stream, const std::vector<uint8_t>& data);
+
+/**
+ * @brief Creates the backend or manager of bench and measures it on data.
+ *
+ * @param stream The stream of the device backends and managers. Unused by the host backend.
+ */
+BenchmarkResult run_benchmark(const BenchmarkCase& bench, hipStream_t stream, const std::vector<uint8_t>& data);
+
+/**
+ * @brief Measures the memory bandwidth of a backend as the copy of STREAM does: the
+ * best rate over the iterations of copying one buffer to another, counting the bytes
+ * read and written. This is the ceiling of BenchmarkResult::memory_bandwidth.
+ *
+ * The device backend copies in device memory on stream. The host backend copies in
+ * host memory on the threads of get_host_thread_pool(), which run the host codecs.
+ *
+ * @param bytes The size of each buffer. Should be well above the size of the caches.
+ * @return The bandwidth in GB/s
+ */
+double measure_memory_bandwidth(
+    const std::string& backend, hipStream_t stream, size_t bytes, size_t iterations);
+
+} // namespace benchmarks
+} // namespace hipcomp
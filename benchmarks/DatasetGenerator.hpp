@@ -0,0 +1,446 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "hipcomp.h"
+
+namespace hipcomp {
+namespace datasets {
+
+/**
+ * @brief The random source of the generators.
+ *
+ * The standard engines' distributions are implementation defined, so the generators
+ * use SplitMix64 and their own mappings instead. A seed then gives the same dataset
+ * with every compiler and standard library.
+ */
+class Random
+{
+public:
+  explicit Random(const uint64_t seed) :
+      m_state(seed)
+  {
+  }
+
+  /**
+   * @brief A uniform integer in [0, bound). bound must be at least 1.
+   */
+  uint64_t below(const uint64_t bound)
+  {
+    // Rejects the top partial range, so every value is equally likely
+    const uint64_t limit = UINT64_MAX - UINT64_MAX % bound;
+    uint64_t value;
+    do {
+      value = next();
+    } while (value >= limit);
+    return value % bound;
+  }
+
+  /**
+   * @brief A uniform double in [0, 1)
+   */
+  double uniform()
+  {
+    return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  /**
+   * @brief A standard normal double, by the Box-Muller transform
+   */
+  double normal()
+  {
+    const double u1 = 1.0 - uniform();
+    const double u2 = uniform();
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+  }
+
+  uint64_t next()
+  {
+    // SplitMix64, which also turns small seeds into well mixed states
+    uint64_t z = (m_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+private:
+  uint64_t m_state;
+};
+
+/**
+ * @brief The shape of run lengths
+ */
+enum class RunLengthDistribution
+{
+  Fixed,     ///< Every run has the mean length
+  Uniform,   ///< Uniform in [1, 2 * mean - 1]
+  Geometric  ///< Geometric with the mean, so most runs are short and a few long
+};
+
+/**
+ * @brief Reinterprets elements as their bytes
+ */
+template <typename T>
+std::vector<uint8_t> as_bytes(const std::vector<T>& elements)
+{
+  std::vector<uint8_t> bytes(elements.size() * sizeof(T));
+  if (!bytes.empty()) {
+    std::memcpy(bytes.data(), elements.data(), bytes.size());
+  }
+  return bytes;
+}
+
+/**
+ * @brief Bytes with a given order-0 entropy.
+ *
+ * Symbol probabilities fall off geometrically, with the rate chosen so the entropy
+ * of the distribution is bits_per_byte, and the symbols are shuffled. 8 gives
+ * uniformly random bytes, 0 a single repeated byte.
+ */
+inline std::vector<uint8_t> entropy_bytes(const size_t bytes, const double bits_per_byte, const uint64_t seed)
+{
+  if (!(bits_per_byte >= 0.0 && bits_per_byte <= 8.0)) {
+    throw std::invalid_argument("Entropy must be in [0, 8] bits per byte");
+  }
+
+  auto probabilities = [](const double rate) {
+    std::vector<double> p(256);
+    double weight = 1.0;
+    double total = 0.0;
+    for (double& pi : p) {
+      pi = weight;
+      total += weight;
+      weight *= rate;
+    }
+    for (double& pi : p) {
+      pi /= total;
+    }
+    return p;
+  };
+  auto entropy = [](const std::vector<double>& p) {
+    double h = 0.0;
+    for (const double pi : p) {
+      if (pi > 0.0) {
+        h -= pi * std::log2(pi);
+      }
+    }
+    return h;
+  };
+
+  // The entropy grows with the rate, from 0 at rate 0 to 8 at rate 1
+  double low = 0.0;
+  double high = 1.0;
+  for (int i = 0; i < 64; ++i) {
+    const double mid = 0.5 * (low + high);
+    (entropy(probabilities(mid)) < bits_per_byte ? low : high) = mid;
+  }
+  const std::vector<double> p = probabilities(bits_per_byte >= 8.0 ? 1.0 : low);
+
+  std::vector<double> cdf(p.size());
+  double sum = 0.0;
+  for (size_t i = 0; i < p.size(); ++i) {
+    sum += p[i];
+    cdf[i] = sum;
+  }
+
+  Random random(seed);
+  uint8_t symbols[256];
+  for (int i = 0; i < 256; ++i) {
+    symbols[i] = static_cast<uint8_t>(i);
+  }
+  for (int i = 255; i > 0; --i) {
+    std::swap(symbols[i], symbols[random.below(i + 1)]);
+  }
+
+  std::vector<uint8_t> data(bytes);
+  for (uint8_t& byte : data) {
+    const double u = random.uniform() * sum;
+    const size_t ix = std::min<size_t>(std::upper_bound(cdf.begin(), cdf.end(), u) - cdf.begin(), 255);
+    byte = symbols[ix];
+  }
+  return data;
+}
+
+/**
+ * @brief Runs of repeated values, like random_runs() in the tests but with a choice of
+ * run length distribution and values drawn from num_values distinct random values.
+ */
+template <typename T>
+std::vector<T> runs(
+    const size_t count,
+    const RunLengthDistribution distribution,
+    const double mean_run,
+    const size_t num_values,
+    const uint64_t seed)
+{
+  static_assert(std::is_integral<T>::value, "Runs are generated for integer types");
+  if (mean_run < 1.0 || num_values == 0) {
+    throw std::invalid_argument("Runs need a mean length of at least 1 and at least one value");
+  }
+
+  Random random(seed);
+  std::vector<T> values(num_values);
+  for (T& value : values) {
+    value = static_cast<T>(random.next());
+  }
+
+  std::vector<T> data;
+  data.reserve(count);
+  while (data.size() < count) {
+    size_t run;
+    switch (distribution) {
+    case RunLengthDistribution::Fixed:
+      run = static_cast<size_t>(mean_run);
+      break;
+    case RunLengthDistribution::Uniform:
+      run = 1 + random.below(static_cast<uint64_t>(2 * mean_run - 1));
+      break;
+    default: {
+      const double p = 1.0 / mean_run;
+      run = p >= 1.0 ? 1 : 1 + static_cast<size_t>(std::log(1.0 - random.uniform()) / std::log(1.0 - p));
+      break;
+    }
+    }
+    data.insert(data.end(), std::min(run, count - data.size()), values[random.below(num_values)]);
+  }
+  return data;
+}
+
+/**
+ * @brief Increasing integers with random steps of up to max_step, of which a fraction
+ * disorder is swapped with random other positions.
+ */
+template <typename T>
+std::vector<T> sorted_integers(const size_t count, const uint64_t max_step, const double disorder, const uint64_t seed)
+{
+  static_assert(std::is_integral<T>::value, "Sorted data is generated for integer types");
+  Random random(seed);
+  std::vector<T> data(count);
+  uint64_t value = random.below(1000);
+  for (T& element : data) {
+    element = static_cast<T>(value);
+    value += random.below(max_step + 1);
+  }
+
+  const size_t num_swaps = static_cast<size_t>(disorder * count);
+  for (size_t i = 0; i < num_swaps && count > 1; ++i) {
+    std::swap(data[random.below(count)], data[random.below(count)]);
+  }
+  return data;
+}
+
+/**
+ * @brief Text from a vocabulary of random words with Zipf frequencies, where some
+ * phrases repeat earlier text verbatim, as in logs and markup.
+ */
+inline std::vector<uint8_t> repeated_text(const size_t bytes, const size_t vocabulary_size, const uint64_t seed)
+{
+  if (vocabulary_size == 0) {
+    throw std::invalid_argument("Text needs a vocabulary");
+  }
+
+  Random random(seed);
+  std::vector<std::string> vocabulary(vocabulary_size);
+  for (std::string& word : vocabulary) {
+    const size_t length = 2 + random.below(9);
+    for (size_t i = 0; i < length; ++i) {
+      word += static_cast<char>('a' + random.below(26));
+    }
+  }
+  std::vector<double> cdf(vocabulary_size);
+  double sum = 0.0;
+  for (size_t i = 0; i < vocabulary_size; ++i) {
+    sum += 1.0 / (i + 1);
+    cdf[i] = sum;
+  }
+
+  std::vector<uint8_t> text;
+  text.reserve(bytes + 256);
+  while (text.size() < bytes) {
+    if (text.size() > 256 && random.below(10) == 0) {
+      // Repeat a phrase from earlier in the text
+      const size_t length = 16 + random.below(128);
+      const size_t start = random.below(text.size() - length);
+      for (size_t i = 0; i < length; ++i) {
+        text.push_back(text[start + i]);
+      }
+    } else {
+      const size_t ix = std::min<size_t>(
+          std::upper_bound(cdf.begin(), cdf.end(), random.uniform() * sum) - cdf.begin(), vocabulary_size - 1);
+      text.insert(text.end(), vocabulary[ix].begin(), vocabulary[ix].end());
+      const uint64_t separator = random.below(16);
+      text.push_back(separator == 0 ? '\n' : separator == 1 ? '.' : ' ');
+    }
+  }
+  text.resize(bytes);
+  return text;
+}
+
+/**
+ * @brief A time series of sensor-like readings: a random walk with a daily cycle and
+ * measurement noise.
+ */
+template <typename T>
+std::vector<T> float_series(const size_t count, const uint64_t seed)
+{
+  static_assert(std::is_floating_point<T>::value, "Time series are generated for floating point types");
+  Random random(seed);
+  std::vector<T> data(count);
+  double level = 20.0 + 10.0 * random.uniform();
+  const double period = 1440.0;
+  for (size_t i = 0; i < count; ++i) {
+    level += 0.01 * random.normal();
+    const double cycle = 5.0 * std::sin(6.283185307179586 * static_cast<double>(i) / period);
+    data[i] = static_cast<T>(level + cycle + 0.05 * random.normal());
+  }
+  return data;
+}
+
+/**
+ * @brief Data that was already compressed: blocks of random payload behind small
+ * headers of a magic number and the payload size.
+ */
+inline std::vector<uint8_t> compressed_noise(const size_t bytes, const uint64_t seed)
+{
+  Random random(seed);
+  std::vector<uint8_t> data;
+  data.reserve(bytes + 8);
+  while (data.size() < bytes) {
+    const uint32_t payload = static_cast<uint32_t>(4096 + random.below(60 * 1024));
+    const uint32_t header[2] = {0x184D2204U, payload};
+    const uint8_t* header_bytes = reinterpret_cast<const uint8_t*>(header);
+    data.insert(data.end(), header_bytes, header_bytes + sizeof(header));
+    for (uint32_t i = 0; i < payload && data.size() < bytes; i += 8) {
+      const uint64_t word = random.next();
+      const uint8_t* word_bytes = reinterpret_cast<const uint8_t*>(&word);
+      data.insert(data.end(), word_bytes, word_bytes + std::min<size_t>(8, payload - i));
+    }
+  }
+  data.resize(bytes);
+  return data;
+}
+
+namespace detail {
+
+template <typename T>
+std::vector<uint8_t> typed_runs(const size_t bytes, const double mean_run, const uint64_t seed)
+{
+  return as_bytes(runs<T>(bytes / sizeof(T), RunLengthDistribution::Geometric, mean_run, 64, seed));
+}
+
+template <typename T>
+std::vector<uint8_t> typed_sorted(const size_t bytes, const double disorder, const uint64_t seed)
+{
+  return as_bytes(sorted_integers<T>(bytes / sizeof(T), 3, disorder, seed));
+}
+
+template <typename Generate>
+std::vector<uint8_t> for_type(const hipcompType_t type, Generate generate)
+{
+  switch (type) {
+  case HIPCOMP_TYPE_CHAR:
+    return generate(int8_t());
+  case HIPCOMP_TYPE_SHORT:
+    return generate(int16_t());
+  case HIPCOMP_TYPE_USHORT:
+    return generate(uint16_t());
+  case HIPCOMP_TYPE_INT:
+    return generate(int32_t());
+  case HIPCOMP_TYPE_UINT:
+    return generate(uint32_t());
+  case HIPCOMP_TYPE_LONGLONG:
+    return generate(int64_t());
+  case HIPCOMP_TYPE_ULONGLONG:
+    return generate(uint64_t());
+  default:
+    return generate(uint8_t());
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief The dataset names generate() accepts, without their optional parameter
+ */
+inline std::vector<std::string> dataset_names()
+{
+  return {"runs", "sorted", "nearsorted", "entropy", "random", "text", "floats", "noise"};
+}
+
+/**
+ * @brief Generates a dataset by name.
+ *
+ * Names take an optional parameter after a colon:
+ *   - "runs[:MEAN]": geometric runs of 64 distinct values of type, mean length 16
+ *   - "sorted": increasing integers of type
+ *   - "nearsorted[:DISORDER]": sorted, with a fraction of elements swapped, default 0.01
+ *   - "entropy[:BITS]": bytes with BITS of entropy each, default 4
+ *   - "random": uniformly random bytes
+ *   - "text[:VOCABULARY]": words from a vocabulary, default 1000 words, with repeats
+ *   - "floats": a time series of float, or of double if type is 8 bytes wide
+ *   - "noise": already compressed data
+ *
+ * The dataset holds whole elements of type, so it may be shorter than bytes.
+ */
+inline std::vector<uint8_t> generate(
+    const std::string& spec, const size_t bytes, const hipcompType_t type, const uint64_t seed)
+{
+  const size_t colon = spec.find(':');
+  const std::string name = spec.substr(0, colon);
+  const bool has_param = colon != std::string::npos;
+  const double param = has_param ? std::stod(spec.substr(colon + 1)) : 0.0;
+
+  if (name == "runs") {
+    const double mean_run = has_param ? param : 16.0;
+    return detail::for_type(type, [&](auto elem) { return detail::typed_runs<decltype(elem)>(bytes, mean_run, seed); });
+  } else if (name == "sorted" || name == "nearsorted") {
+    const double disorder = name == "sorted" ? 0.0 : has_param ? param : 0.01;
+    return detail::for_type(type, [&](auto elem) { return detail::typed_sorted<decltype(elem)>(bytes, disorder, seed); });
+  } else if (name == "entropy") {
+    return entropy_bytes(bytes, has_param ? param : 4.0, seed);
+  } else if (name == "random") {
+    return entropy_bytes(bytes, 8.0, seed);
+  } else if (name == "text") {
+    return repeated_text(bytes, has_param ? static_cast<size_t>(param) : 1000, seed);
+  } else if (name == "floats") {
+    if (type == HIPCOMP_TYPE_LONGLONG || type == HIPCOMP_TYPE_ULONGLONG) {
+      return as_bytes(float_series<double>(bytes / sizeof(double), seed));
+    }
+    return as_bytes(float_series<float>(bytes / sizeof(float), seed));
+  } else if (name == "noise") {
+    return compressed_noise(bytes, seed);
+  }
+  throw std::invalid_argument("Unknown dataset " + spec);
+}
+
+} // namespace datasets
+} // namespace hipcomp
@@ -0,0 +1,233 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "WorkloadReplay.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+#include "BenchmarkDatasets.hpp"
+
+namespace hipcomp {
+namespace benchmarks {
+
+namespace {
+
+bool is_known_format(const std::string& format)
+{
+  return format == "lz4" || format == "snappy" || format == "cascaded" || format == "gdeflate"
+      || format == "ans" || format == "bitcomp";
+}
+
+bool is_compression(const std::string& operation)
+{
+  return operation == "compress" || operation == "batched_compress";
+}
+
+/**
+ * @brief The backend or manager a benchmark runs on, without its batch size or dataset
+ */
+std::string runner_key(const BenchmarkCase& bench)
+{
+  std::ostringstream key;
+  key << bench.api << "/" << bench.format << "/" << type_name(bench.data_type) << "/" << bench.chunk_size;
+  if (bench.api == "batched") {
+    key << "/" << bench.batch_size;
+  }
+  return key.str();
+}
+
+std::string shape_key(const std::string& operation, const BenchmarkCase& bench, const size_t bytes)
+{
+  std::ostringstream key;
+  key << operation << " " << runner_key(bench) << " " << bench.batch_size << " " << bytes;
+  return key.str();
+}
+
+} // namespace
+
+WorkloadReplay plan_replay(const std::vector<WorkloadCall>& calls, const ReplayOptions& options)
+{
+  WorkloadReplay replay;
+  replay.replayed = false;
+  replay.verified = false;
+
+  std::map<std::string, size_t> shape_indices;
+  // The last batched compression of each format, for the shape of its decompressions
+  std::map<std::string, WorkloadCall> batched_compressions;
+
+  for (const WorkloadCall& call : calls) {
+    const bool manager = call.operation == "compress" || call.operation == "decompress"
+        || call.operation == "decompress_in_place";
+    const bool batched = call.operation == "batched_compress" || call.operation == "batched_decompress";
+    if (!manager && !batched) {
+      ++replay.skipped[call.operation + " is not replayed"];
+      continue;
+    }
+    if (!is_known_format(call.codec)) {
+      ++replay.skipped["unknown format " + call.codec];
+      continue;
+    }
+    if (options.backend == "host" && (manager || call.codec != "lz4")) {
+      ++replay.skipped["the host backend replays batched lz4 only"];
+      continue;
+    }
+
+    BenchmarkCase bench;
+    bench.api = manager ? "manager" : "batched";
+    bench.backend = options.backend;
+    bench.format = call.codec;
+    bench.data_type = call.data_type;
+    bench.chunk_size = call.chunk_size > 0 ? call.chunk_size : options.default_chunk_size;
+    bench.dataset = options.dataset;
+    bench.iterations = options.iterations;
+    bench.warmup_iterations = 0;
+
+    size_t bytes = call.bytes;
+    if (call.operation == "batched_compress") {
+      batched_compressions[call.codec] = call;
+    } else if (call.operation == "batched_decompress") {
+      const auto compression = batched_compressions.find(call.codec);
+      if (compression != batched_compressions.end()) {
+        bench.data_type = compression->second.data_type;
+        bench.chunk_size = compression->second.chunk_size > 0 ? compression->second.chunk_size 
+                                                              : options.default_chunk_size;
+      }
+    }
+    if (manager) {
+      if (bytes == 0) {
+        ++replay.skipped["the size of " + call.operation + " is unknown"];
+        continue;
+      }
+      bench.batch_size = (bytes + bench.chunk_size - 1) / bench.chunk_size;
+    } else {
+      if (call.batch_size == 0) {
+        ++replay.skipped["the batch size of " + call.operation + " is unknown"];
+        continue;
+      }
+      bench.batch_size = call.batch_size;
+      // The chunks are only known on the device, so replay the largest the call allowed
+      bytes = bench.batch_size * bench.chunk_size;
+    }
+
+    const std::string key = shape_key(call.operation, bench, bytes);
+    auto shape = shape_indices.find(key);
+    if (shape == shape_indices.end()) {
+      shape = shape_indices.emplace(key, replay.shapes.size()).first;
+      replay.shapes.push_back(ReplayShape{call.operation, bench, bytes, 0, 0.0, 0.0});
+    }
+    ReplayShape& replay_shape = replay.shapes[shape->second];
+    ++replay_shape.calls;
+    replay_shape.recorded_us += call.duration_ns * 1e-3;
+    replay.call_shapes.push_back(shape->second);
+  }
+  return replay;
+}
+
+void run_replay(WorkloadReplay& replay, const ReplayOptions& options, hipStream_t stream)
+{
+  std::map<std::string, std::unique_ptr<BatchedCompressBackend>> backends;
+  std::map<std::string, std::unique_ptr<hipcompManagerBase>> managers;
+  std::map<std::pair<size_t, hipcompType_t>, std::vector<uint8_t>> datasets;
+  std::vector<bool> warmed_up(replay.shapes.size(), false);
+
+  for (ReplayShape& shape : replay.shapes) {
+    shape.replayed_us = 0.0;
+  }
+  replay.verified = true;
+
+  for (const size_t ix_shape : replay.call_shapes) {
+    ReplayShape& shape = replay.shapes[ix_shape];
+    BenchmarkCase bench = shape.bench;
+    if (!warmed_up[ix_shape]) {
+      bench.warmup_iterations = options.warmup_iterations;
+      warmed_up[ix_shape] = true;
+    }
+
+    const std::pair<size_t, hipcompType_t> data_key(shape.bytes, bench.data_type);
+    auto data = datasets.find(data_key);
+    if (data == datasets.end()) {
+      data = datasets.emplace(data_key, load_dataset(options.dataset, shape.bytes, bench.data_type)).first;
+    }
+
+    BenchmarkResult result;
+    const std::string key = runner_key(bench);
+    if (bench.api == "batched") {
+      std::unique_ptr<BatchedCompressBackend>& backend = backends[key];
+      if (!backend) {
+        backend = create_benchmark_backend(bench, stream);
+      }
+      result = run_batched_benchmark(bench, *backend, data->second);
+    } else {
+      std::unique_ptr<hipcompManagerBase>& manager = managers[key];
+      if (!manager) {
+        manager = create_benchmark_manager(bench, stream);
+      }
+      result = run_manager_benchmark(bench, *manager, stream, data->second);
+    }
+
+    shape.replayed_us += is_compression(shape.operation) ? result.compress_latency.p50 
+                                                         : result.decompress_latency.p50;
+    replay.verified = replay.verified && result.verified;
+  }
+  replay.replayed = true;
+}
+
+void write_replay_report(std::ostream& out, const WorkloadReplay& replay)
+{
+  std::ostringstream table;
+  table << std::left << std::setw(20) << "operation" << std::setw(10) << "format" << std::setw(10) << "type"
+        << std::right << std::setw(10) << "chunk" << std::setw(8) << "batch" << std::setw(12) << "bytes"
+        << std::setw(8) << "calls" << std::setw(14) << "recorded_us";
+  if (replay.replayed) {
+    table << std::setw(14) << "replayed_us" << std::setw(12) << "GB/s";
+  }
+  table << "\n";
+
+  for (const ReplayShape& shape : replay.shapes) {
+    table << std::left << std::setw(20) << shape.operation << std::setw(10) << shape.bench.format 
+          << std::setw(10) << (format_uses_type(shape.bench.format) ? type_name(shape.bench.data_type) : "-")
+          << std::right << std::setw(10) << shape.bench.chunk_size << std::setw(8) << shape.bench.batch_size 
+          << std::setw(12) << shape.bytes << std::setw(8) << shape.calls << std::fixed << std::setprecision(1) 
+          << std::setw(14) << shape.recorded_us;
+    if (replay.replayed) {
+      const double gbps = shape.replayed_us > 0.0 ? shape.bytes * shape.calls / (shape.replayed_us * 1e3) : 0.0;
+      table << std::setw(14) << shape.replayed_us << std::setprecision(2) << std::setw(12) << gbps;
+    }
+    table << std::defaultfloat << "\n";
+  }
+  out << table.str();
+
+  for (const auto& skipped : replay.skipped) {
+    out << "Skipped " << skipped.second << " call" << (skipped.second == 1 ? "" : "s") << ": " << skipped.first 
+        << "\n";
+  }
+  if (replay.replayed && !replay.verified) {
+    out << "Some round trips did not match the input.\n";
+  }
+}
+
+} // namespace benchmarks
+} // namespace hipcomp
@@ -0,0 +1,123 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "hipcomp/hipcompWorkloadTrace.hpp"
+
+#include "BenchmarkRunner.hpp"
+
+namespace hipcomp {
+namespace benchmarks {
+
+/**
+ * @brief How to replay a recorded workload
+ */
+struct ReplayOptions {
+  // "device", or "host" to replay only the batched LZ4 calls, without a GPU
+  std::string backend;
+  // The synthetic data, see load_dataset()
+  std::string dataset;
+  // The chunk size of calls that recorded none
+  size_t default_chunk_size;
+  // Measured iterations of each call
+  size_t iterations;
+  // Unmeasured iterations before the first call of each shape
+  size_t warmup_iterations;
+
+  ReplayOptions()
+    : backend("device"),
+      dataset("runs"),
+      default_chunk_size(65536),
+      iterations(1),
+      warmup_iterations(1)
+  {}
+};
+
+/**
+ * @brief The calls of one operation with the same format, options and sizes
+ */
+struct ReplayShape {
+  // The recorded operation, e.g. "compress" or "batched_decompress"
+  std::string operation;
+  // The benchmark that replays a call
+  BenchmarkCase bench;
+  // The uncompressed bytes of a call
+  size_t bytes;
+  size_t calls;
+  // The host time of the calls when recorded, in microseconds
+  double recorded_us;
+  // The time of the calls when replayed, as measured by the benchmark, in microseconds
+  double replayed_us;
+};
+
+/**
+ * @brief A recorded workload mapped to benchmarks, and the result of running them
+ */
+struct WorkloadReplay {
+  // In the order of the first call of each shape
+  std::vector<ReplayShape> shapes;
+  // The index in shapes of each replayed call, in the recorded order
+  std::vector<size_t> call_shapes;
+  // The number of calls that are not replayed, by reason
+  std::map<std::string, size_t> skipped;
+  // Whether run_replay() ran, and whether all its round trips matched the input
+  bool replayed;
+  bool verified;
+};
+
+/**
+ * @brief Maps each recorded call to the benchmark of its shape.
+ *
+ * Managers are replayed with their recorded chunk size and data type, over the 
+ * recorded bytes. Batched compressions are replayed with their batch size and 
+ * maximum chunk size, which is all the host knows of them, and batched 
+ * decompressions with those of the previous batched compression of the format. 
+ * Size queries and unknown formats are skipped. Needs no GPU.
+ */
+WorkloadReplay plan_replay(const std::vector<WorkloadCall>& calls, const ReplayOptions& options);
+
+/**
+ * @brief Runs the calls of replay in order, each on synthetic data of its shape.
+ *
+ * A call is replayed as the compression or decompression of its benchmark, which 
+ * also compresses the data a decompression needs. Backends and managers are 
+ * created once per shape. Calls run back to back, without the recorded gaps 
+ * and threads.
+ *
+ * @param stream The stream of the device backend and managers. Unused by the host backend.
+ */
+void run_replay(WorkloadReplay& replay, const ReplayOptions& options, hipStream_t stream);
+
+/**
+ * @brief Writes a table of the shapes with their calls, bytes and times, then the skipped calls
+ */
+void write_replay_report(std::ostream& out, const WorkloadReplay& replay);
+
+} // namespace benchmarks
+} // namespace hipcomp
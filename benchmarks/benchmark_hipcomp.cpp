@@ -0,0 +1,287 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Measures the batched APIs and managers over formats, chunk sizes, batch sizes, 
+// data types and datasets, and reports throughput, ratio, latency percentiles and 
+// the fraction of the measured memory bandwidth as JSON or CSV. Run with --help 
+// for the options.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "hipcomp/hipcompHostThreadPool.hpp"
+
+#include "BenchmarkDatasets.hpp"
+#include "BenchmarkResults.hpp"
+#include "BenchmarkRunner.hpp"
+
+using namespace hipcomp;
+using namespace hipcomp::benchmarks;
+
+namespace {
+
+struct Options {
+  std::vector<std::string> apis;
+  std::string backend;
+  std::vector<std::string> formats;
+  std::vector<size_t> chunk_sizes;
+  std::vector<size_t> batch_sizes;
+  std::vector<hipcompType_t> types;
+  std::vector<std::string> datasets;
+  size_t iterations;
+  size_t warmup_iterations;
+  size_t bandwidth_bytes;
+  std::string json_path;
+  std::string csv_path;
+
+  Options()
+    : apis({"batched", "manager"}),
+      backend("device"),
+      formats({"lz4", "snappy", "cascaded"}),
+      chunk_sizes({65536}),
+      batch_sizes({1024}),
+      types({HIPCOMP_TYPE_CHAR}),
+      datasets({"runs", "random"}),
+      iterations(10),
+      warmup_iterations(2),
+      bandwidth_bytes(256 << 20)
+  {}
+};
+
+void print_usage(const char* name)
+{
+  std::cerr 
+      << "Usage: " << name << " [options]\n"
+      << "  --api LIST           batched,manager (default: both, batched only for the host backend)\n"
+      << "  --backend NAME       device or host (default: device). The host backend needs no GPU.\n"
+      << "  --formats LIST       lz4,snappy,cascaded,gdeflate,ans,bitcomp (default: lz4,snappy,cascaded)\n"
+      << "  --chunk-sizes LIST   chunk sizes in bytes, K and M suffixes allowed (default: 64K)\n"
+      << "  --batch-sizes LIST   chunks per batch or manager buffer (default: 1024)\n"
+      << "  --types LIST         char,uchar,short,ushort,int,uint,longlong,ulonglong (default: char)\n"
+      << "  --datasets LIST      runs,sorted,nearsorted,entropy:BITS,random,text,floats,noise\n"
+      << "                       or file:PATH (default: runs,random)\n"
+      << "  --iterations N       measured iterations (default: 10)\n"
+      << "  --warmup N           unmeasured iterations first (default: 2)\n"
+      << "  --bandwidth-bytes SIZE\n"
+      << "                       buffer size of the memory bandwidth probe, 0 to skip it (default: 256M)\n"
+      << "  --json PATH          write the results as JSON\n"
+      << "  --csv PATH           write the results as CSV (default: CSV to stdout)\n";
+}
+
+std::vector<std::string> split_list(const std::string& list)
+{
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+size_t parse_size(const std::string& value)
+{
+  size_t pos = 0;
+  size_t res = std::stoull(value, &pos);
+  const std::string suffix = value.substr(pos);
+  if (suffix == "K" || suffix == "k") {
+    res <<= 10;
+  } else if (suffix == "M" || suffix == "m") {
+    res <<= 20;
+  } else if (!suffix.empty()) {
+    throw std::invalid_argument("Invalid size " + value);
+  }
+  return res;
+}
+
+Options parse_options(int argc, char** argv)
+{
+  Options options;
+  bool apis_given = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      print_usage(argv[0]);
+      std::exit(0);
+    }
+    if (i + 1 >= argc) {
+      throw std::invalid_argument("Missing value for " + arg);
+    }
+    const std::string value = argv[++i];
+    if (arg == "--api") {
+      options.apis = split_list(value);
+      apis_given = true;
+    } else if (arg == "--backend") {
+      options.backend = value;
+    } else if (arg == "--formats") {
+      options.formats = split_list(value);
+    } else if (arg == "--chunk-sizes") {
+      options.chunk_sizes.clear();
+      for (const std::string& size : split_list(value)) {
+        options.chunk_sizes.push_back(parse_size(size));
+      }
+    } else if (arg == "--batch-sizes") {
+      options.batch_sizes.clear();
+      for (const std::string& size : split_list(value)) {
+        options.batch_sizes.push_back(parse_size(size));
+      }
+    } else if (arg == "--types") {
+      options.types.clear();
+      for (const std::string& type : split_list(value)) {
+        options.types.push_back(parse_type(type));
+      }
+    } else if (arg == "--datasets") {
+      options.datasets = split_list(value);
+    } else if (arg == "--iterations") {
+      options.iterations = parse_size(value);
+    } else if (arg == "--warmup") {
+      options.warmup_iterations = parse_size(value);
+    } else if (arg == "--bandwidth-bytes") {
+      options.bandwidth_bytes = parse_size(value);
+    } else if (arg == "--json") {
+      options.json_path = value;
+    } else if (arg == "--csv") {
+      options.csv_path = value;
+    } else {
+      throw std::invalid_argument("Unknown option " + arg);
+    }
+  }
+
+  if (options.backend != "device" && options.backend != "host") {
+    throw std::invalid_argument("Unknown backend " + options.backend);
+  }
+  if (options.backend == "host" && !apis_given) {
+    options.apis = {"batched"};
+  }
+  return options;
+}
+
+std::string describe(const BenchmarkCase& bench)
+{
+  std::stringstream desc;
+  desc << bench.api << "/" << bench.backend << "/" << bench.format;
+  if (format_uses_type(bench.format)) {
+    desc << "/" << type_name(bench.data_type);
+  }
+  desc << " chunk_size=" << bench.chunk_size << " batch_size=" << bench.batch_size 
+       << " dataset=" << bench.dataset;
+  return desc.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+    print_usage(argv[0]);
+    return 2;
+  }
+
+  // The host backend must not touch the HIP runtime, so that it runs without a GPU. Its
+  // threads are not pinned, as finding their NUMA node queries the current device.
+  hipStream_t stream = nullptr;
+  if (options.backend == "host") {
+    HostThreadPoolOptions pool_options;
+    pool_options.pin_threads = false;
+    configure_host_thread_pool(pool_options);
+  } else if (hipStreamCreate(&stream) != hipSuccess) {
+    std::cerr << "Cannot create a stream. Use --backend host to run without a GPU.\n";
+    return 1;
+  }
+
+  // The ceiling each result's throughput is compared to
+  double memory_bandwidth = 0.0;
+  if (options.bandwidth_bytes > 0) {
+    try {
+      memory_bandwidth = measure_memory_bandwidth(
+          options.backend, stream, options.bandwidth_bytes, std::max<size_t>(options.iterations, 1));
+      std::cerr << options.backend << " memory bandwidth: " << memory_bandwidth << " GB/s (copy of "
+                << options.bandwidth_bytes << " bytes)\n";
+    } catch (const std::exception& e) {
+      std::cerr << "Cannot measure the memory bandwidth: " << e.what() << "\n";
+    }
+  }
+
+  std::vector<BenchmarkResult> results;
+  bool failed = false;
+  for (const std::string& api : options.apis) {
+    for (const std::string& format : options.formats) {
+      // Formats without a data type option run once per configuration
+      const std::vector<hipcompType_t> types = format_uses_type(format) 
+          ? options.types : std::vector<hipcompType_t>{HIPCOMP_TYPE_CHAR};
+      for (const hipcompType_t type : types) {
+        for (const size_t chunk_size : options.chunk_sizes) {
+          for (const size_t batch_size : options.batch_sizes) {
+            for (const std::string& dataset : options.datasets) {
+              const BenchmarkCase bench{api, options.backend, format, type, chunk_size, batch_size, dataset,
+                  options.iterations, options.warmup_iterations};
+              try {
+                const std::vector<uint8_t> data = load_dataset(dataset, chunk_size * batch_size, type);
+                results.push_back(run_benchmark(bench, stream, data));
+                results.back().memory_bandwidth = memory_bandwidth;
+                if (!results.back().verified) {
+                  std::cerr << describe(bench) << ": decompressed data does not match the input\n";
+                  failed = true;
+                }
+              } catch (const HipCompException& e) {
+                std::cerr << describe(bench) << ": " 
+                    << (e.get_error() == hipcompErrorNotSupported ? "skipped, " : "failed, ") << e.what() << "\n";
+                failed = failed || e.get_error() != hipcompErrorNotSupported;
+              } catch (const std::exception& e) {
+                std::cerr << describe(bench) << ": failed, " << e.what() << "\n";
+                failed = true;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if (stream != nullptr) {
+    hipStreamDestroy(stream);
+  }
+
+  if (!options.json_path.empty()) {
+    std::ofstream json(options.json_path);
+    write_json(json, results);
+  }
+  if (!options.csv_path.empty()) {
+    std::ofstream csv(options.csv_path);
+    write_csv(csv, results);
+  } else if (options.json_path.empty()) {
+    write_csv(std::cout, results);
+  }
+
+  return failed ? 1 : 0;
+}
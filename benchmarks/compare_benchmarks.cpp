@@ -0,0 +1,180 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Compares the results of two benchmark_hipcomp runs and reports the configurations
+// that regressed. Exits with 0 if nothing regressed, 1 on regressions, unverified round
+// trips, missing configurations or nothing to compare, and 2 on invalid arguments or
+// results. Run with --help for the options.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BenchmarkCompare.hpp"
+#include "BenchmarkResults.hpp"
+
+using namespace hipcomp::benchmarks;
+
+namespace {
+
+struct Options {
+  std::vector<std::string> baseline_paths;
+  std::vector<std::string> candidate_paths;
+  CompareOptions compare;
+  std::string json_path;
+};
+
+void print_usage(const char* name)
+{
+  std::cerr 
+      << "Usage: " << name << " --baseline LIST --candidate LIST [options]\n"
+      << "  --baseline LIST      JSON or CSV results of benchmark_hipcomp. Several files are repeated\n"
+      << "                       runs, which enable a significance test.\n"
+      << "  --candidate LIST     the results to check, in the same way\n"
+      << "  --threshold PERCENT  relative changes up to this are noise (default: 5)\n"
+      << "  --significance P     p-value below which a change is significant, with at least 2 runs\n"
+      << "                       on each side (default: 0.05)\n"
+      << "  --metrics LIST       ratio,throughput,latency (default: all)\n"
+      << "  --json PATH          also write every comparison as JSON\n"
+      << "  --allow-missing      do not fail when the candidate lacks baseline configurations\n"
+      << "Exits with 0 if nothing regressed, 1 on regressions, unverified round trips, missing\n"
+      << "configurations or nothing to compare, and 2 on invalid arguments or results.\n";
+}
+
+std::vector<std::string> split_list(const std::string& list)
+{
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+double parse_double(const std::string& value)
+{
+  size_t pos = 0;
+  const double res = std::stod(value, &pos);
+  if (pos != value.size() || res < 0.0) {
+    throw std::invalid_argument("Invalid number " + value);
+  }
+  return res;
+}
+
+Options parse_options(int argc, char** argv)
+{
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      print_usage(argv[0]);
+      std::exit(0);
+    }
+    if (arg == "--allow-missing") {
+      options.compare.allow_missing = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      throw std::invalid_argument("Missing value for " + arg);
+    }
+    const std::string value = argv[++i];
+    if (arg == "--baseline") {
+      options.baseline_paths = split_list(value);
+    } else if (arg == "--candidate") {
+      options.candidate_paths = split_list(value);
+    } else if (arg == "--threshold") {
+      options.compare.threshold = parse_double(value) / 100.0;
+    } else if (arg == "--significance") {
+      options.compare.significance = parse_double(value);
+    } else if (arg == "--metrics") {
+      options.compare.compare_ratio = false;
+      options.compare.compare_throughput = false;
+      options.compare.compare_latency = false;
+      for (const std::string& metric : split_list(value)) {
+        if (metric == "ratio") {
+          options.compare.compare_ratio = true;
+        } else if (metric == "throughput") {
+          options.compare.compare_throughput = true;
+        } else if (metric == "latency") {
+          options.compare.compare_latency = true;
+        } else {
+          throw std::invalid_argument("Unknown metric " + metric);
+        }
+      }
+    } else if (arg == "--json") {
+      options.json_path = value;
+    } else {
+      throw std::invalid_argument("Unknown option " + arg);
+    }
+  }
+
+  if (options.baseline_paths.empty() || options.candidate_paths.empty()) {
+    throw std::invalid_argument("Both --baseline and --candidate are required");
+  }
+  return options;
+}
+
+std::vector<std::vector<BenchmarkResult>> read_runs(const std::vector<std::string>& paths)
+{
+  std::vector<std::vector<BenchmarkResult>> runs;
+  for (const std::string& path : paths) {
+    runs.push_back(read_results_file(path));
+  }
+  return runs;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+    print_usage(argv[0]);
+    return 2;
+  }
+
+  CompareReport report;
+  try {
+    report = compare_results(
+        read_runs(options.baseline_paths), read_runs(options.candidate_paths), options.compare);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+    return 2;
+  }
+
+  write_report(std::cout, report);
+  if (!options.json_path.empty()) {
+    std::ofstream json(options.json_path);
+    write_report_json(json, report);
+  }
+
+  return report.failed() ? 1 : 0;
+}
@@ -0,0 +1,184 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Replays a workload recorded with hipcomp::WorkloadRecorder: each call runs again 
+// with the same format, options and sizes on synthetic data, and the times are 
+// reported per shape next to the recorded ones. Exits with 0, with 1 if the replay 
+// failed or a round trip did not match the input, and with 2 on invalid arguments 
+// or workloads. Run with --help for the options.
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "hipcomp/hipcompHostThreadPool.hpp"
+
+#include "BenchmarkDatasets.hpp"
+#include "WorkloadReplay.hpp"
+
+using namespace hipcomp;
+using namespace hipcomp::benchmarks;
+
+namespace {
+
+struct Options {
+  std::string workload_path;
+  ReplayOptions replay;
+  bool plan_only;
+
+  Options()
+    : workload_path(),
+      replay(),
+      plan_only(false)
+  {}
+};
+
+void print_usage(const char* name)
+{
+  std::cerr 
+      << "Usage: " << name << " --workload PATH [options]\n"
+      << "  --workload PATH      the calls written by hipcomp::WorkloadRecorder\n"
+      << "  --backend NAME       device or host (default: device). The host backend needs no GPU\n"
+      << "                       and replays the batched lz4 calls only.\n"
+      << "  --dataset NAME       the synthetic data, as for benchmark_hipcomp --datasets (default: runs)\n"
+      << "  --chunk-size SIZE    the chunk size of calls that recorded none, K and M suffixes allowed\n"
+      << "                       (default: 64K)\n"
+      << "  --iterations N       measured iterations of each call (default: 1)\n"
+      << "  --warmup N           unmeasured iterations before the first call of each shape (default: 1)\n"
+      << "  --plan               list the shapes of the calls without running them\n"
+      << "Exits with 0, with 1 if the replay failed or a round trip did not match the input, and\n"
+      << "with 2 on invalid arguments or workloads.\n";
+}
+
+size_t parse_size(const std::string& value)
+{
+  size_t pos = 0;
+  size_t res = std::stoull(value, &pos);
+  const std::string suffix = value.substr(pos);
+  if (suffix == "K" || suffix == "k") {
+    res <<= 10;
+  } else if (suffix == "M" || suffix == "m") {
+    res <<= 20;
+  } else if (!suffix.empty()) {
+    throw std::invalid_argument("Invalid size " + value);
+  }
+  return res;
+}
+
+Options parse_options(int argc, char** argv)
+{
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      print_usage(argv[0]);
+      std::exit(0);
+    }
+    if (arg == "--plan") {
+      options.plan_only = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      throw std::invalid_argument("Missing value for " + arg);
+    }
+    const std::string value = argv[++i];
+    if (arg == "--workload") {
+      options.workload_path = value;
+    } else if (arg == "--backend") {
+      if (value != "device" && value != "host") {
+        throw std::invalid_argument("Unknown backend " + value);
+      }
+      options.replay.backend = value;
+    } else if (arg == "--dataset") {
+      options.replay.dataset = value;
+    } else if (arg == "--chunk-size") {
+      options.replay.default_chunk_size = parse_size(value);
+      if (options.replay.default_chunk_size == 0) {
+        throw std::invalid_argument("The chunk size must be positive");
+      }
+    } else if (arg == "--iterations") {
+      options.replay.iterations = parse_size(value);
+      if (options.replay.iterations == 0) {
+        throw std::invalid_argument("At least one iteration is needed");
+      }
+    } else if (arg == "--warmup") {
+      options.replay.warmup_iterations = parse_size(value);
+    } else {
+      throw std::invalid_argument("Unknown option " + arg);
+    }
+  }
+
+  if (options.workload_path.empty()) {
+    throw std::invalid_argument("--workload is required");
+  }
+  return options;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+    print_usage(argv[0]);
+    return 2;
+  }
+
+  WorkloadReplay replay;
+  try {
+    replay = plan_replay(read_workload(options.workload_path), options.replay);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+    return 2;
+  }
+
+  if (!options.plan_only) {
+    // The host pool is not pinned, as finding its NUMA node queries the current device
+    hipStream_t stream = nullptr;
+    if (options.replay.backend == "host") {
+      HostThreadPoolOptions pool_options;
+      pool_options.pin_threads = false;
+      configure_host_thread_pool(pool_options);
+    } else if (hipStreamCreate(&stream) != hipSuccess) {
+      std::cerr << "Cannot create a stream. Use --backend host to run without a GPU.\n";
+      return 1;
+    }
+    try {
+      run_replay(replay, options.replay, stream);
+    } catch (const std::exception& e) {
+      std::cerr << "Replay failed: " << e.what() << "\n";
+      if (stream) {
+        hipStreamDestroy(stream);
+      }
+      return 1;
+    }
+    if (stream) {
+      hipStreamDestroy(stream);
+    }
+  }
+
+  write_replay_report(std::cout, replay);
+  return replay.replayed && !replay.verified ? 1 : 0;
+}
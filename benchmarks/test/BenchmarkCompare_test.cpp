@@ -0,0 +1,244 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tests/catch.hpp"
+
+#include "BenchmarkCompare.hpp"
+#include "BenchmarkResults.hpp"
+
+using namespace hipcomp::benchmarks;
+
+namespace
+{
+
+BenchmarkResult make_result(
+    const std::string& dataset, const double compress_gbps, const double decompress_gbps)
+{
+  BenchmarkResult res;
+  res.api = "batched";
+  res.backend = "host";
+  res.format = "lz4";
+  res.data_type = "char";
+  res.dataset = dataset;
+  res.chunk_size = 4096;
+  res.num_chunks = 16;
+  res.iterations = 10;
+  res.uncompressed_bytes = 65536;
+  res.compressed_bytes = 16384;
+  res.compress_throughput = compress_gbps;
+  res.decompress_throughput = decompress_gbps;
+  res.compress_latency = LatencyPercentiles{10.0, 12.0, 15.0, 16.0};
+  res.decompress_latency = LatencyPercentiles{5.0, 6.0, 7.0, 8.0};
+  res.verified = true;
+  res.memory_bandwidth = 100.0;
+  return res;
+}
+
+const MetricComparison& find_comparison(
+    const CompareReport& report, const BenchmarkResult& configuration, const std::string& metric)
+{
+  for (const MetricComparison& comparison : report.comparisons) {
+    if (comparison.configuration == configuration_key(configuration) && comparison.metric == metric) {
+      return comparison;
+    }
+  }
+  throw std::runtime_error("No comparison of " + metric);
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("BenchmarkReadResultsTest", "[small]")
+{
+  std::vector<BenchmarkResult> results 
+      = {make_result("runs", 1.5, 3.25), make_result("file:/data/a,\"b\".bin", 0.5, 1.0)};
+  results[1].verified = false;
+
+  std::stringstream json;
+  write_json(json, results);
+  std::stringstream csv;
+  write_csv(csv, results);
+
+  for (std::stringstream* text : {&json, &csv}) {
+    const std::vector<BenchmarkResult> read = read_results(*text);
+    REQUIRE(read.size() == 2);
+    REQUIRE(read[1].dataset == results[1].dataset);
+    REQUIRE(configuration_key(read[0]) == configuration_key(results[0]));
+    REQUIRE(read[0].compressed_bytes == 16384);
+    REQUIRE(read[0].ratio() == 4.0);
+    REQUIRE(read[0].compress_throughput == 1.5);
+    REQUIRE(read[0].decompress_throughput == 3.25);
+    REQUIRE(read[0].compress_latency.p99 == 15.0);
+    REQUIRE(read[0].decompress_latency.max == 8.0);
+    REQUIRE(read[0].memory_bandwidth == 100.0);
+    REQUIRE(read[0].verified);
+    REQUIRE_FALSE(read[1].verified);
+  }
+
+  std::stringstream empty_json;
+  write_json(empty_json, {});
+  REQUIRE(read_results(empty_json).empty());
+  std::stringstream nothing;
+  REQUIRE(read_results(nothing).empty());
+
+  std::stringstream truncated(json.str().substr(0, 100));
+  REQUIRE_THROWS_AS(read_results(truncated), std::runtime_error);
+  std::stringstream short_row("api,backend\nbatched\n");
+  REQUIRE_THROWS_AS(read_results(short_row), std::runtime_error);
+  std::stringstream missing_column("api,backend\nbatched,host\n");
+  REQUIRE_THROWS_AS(read_results(missing_column), std::runtime_error);
+}
+
+TEST_CASE("BenchmarkWelchTest", "[small]")
+{
+  // t = -2 with 8 degrees of freedom
+  REQUIRE(welch_t_test({1, 2, 3, 4, 5}, {3, 4, 5, 6, 7}) == Approx(0.0805).epsilon(0.001));
+  REQUIRE(welch_t_test({1, 2, 3}, {1, 2, 3}) == Approx(1.0));
+  REQUIRE(welch_t_test({1, 1.01, 0.99}, {2, 2.01, 1.99}) < 1e-4);
+  REQUIRE(welch_t_test({1}, {2, 3}) == 1.0);
+  REQUIRE(welch_t_test({2, 2}, {2, 2}) == 1.0);
+  REQUIRE(welch_t_test({2, 2}, {3, 3}) == 0.0);
+}
+
+TEST_CASE("BenchmarkCompareSingleRunTest", "[small]")
+{
+  const std::vector<BenchmarkResult> baseline 
+      = {make_result("runs", 10.0, 20.0), make_result("random", 5.0, 5.0)};
+  std::vector<BenchmarkResult> candidate 
+      = {make_result("runs", 8.0, 21.0), make_result("sorted", 5.0, 5.0), make_result("random", 4.9, 5.0)};
+  candidate[0].decompress_latency.p50 = 6.0;
+  candidate[2].compressed_bytes = 18000;
+
+  const CompareReport report = compare_results({baseline}, {candidate}, CompareOptions());
+  REQUIRE(report.comparisons.size() == 14);
+  REQUIRE(report.num_regressions() == 3);
+  REQUIRE(report.failed());
+  REQUIRE(report.added == std::vector<std::string>{configuration_key(candidate[1])});
+  REQUIRE(report.missing.empty());
+  REQUIRE(report.unverified.empty());
+
+  for (const MetricComparison& comparison : report.comparisons) {
+    const bool runs = comparison.configuration == configuration_key(candidate[0]);
+    const bool regressed = runs 
+        ? comparison.metric == "compress_gbps" || comparison.metric == "decompress_p50_us"
+        : comparison.metric == "ratio";
+    INFO(comparison.configuration << " " << comparison.metric);
+    REQUIRE(comparison.regression == regressed);
+    REQUIRE(comparison.p_value == 1.0);
+  }
+  const MetricComparison& compress = find_comparison(report, candidate[0], "compress_gbps");
+  REQUIRE(compress.baseline == 10.0);
+  REQUIRE(compress.candidate == 8.0);
+  REQUIRE(compress.improvement == Approx(-0.2));
+  REQUIRE(find_comparison(report, candidate[0], "decompress_gbps").improvement == Approx(0.05));
+  REQUIRE(find_comparison(report, candidate[0], "decompress_p50_us").improvement == Approx(-0.2));
+
+  // A looser threshold and fewer metrics
+  CompareOptions options;
+  options.threshold = 0.25;
+  REQUIRE_FALSE(compare_results({baseline}, {candidate}, options).failed());
+  options.threshold = 0.05;
+  options.compare_ratio = false;
+  options.compare_latency = false;
+  const CompareReport throughput = compare_results({baseline}, {candidate}, options);
+  REQUIRE(throughput.comparisons.size() == 4);
+  REQUIRE(throughput.num_regressions() == 1);
+
+  // Missing configurations fail unless allowed
+  const CompareReport subset = compare_results({baseline}, {{baseline[0]}}, CompareOptions());
+  REQUIRE(subset.missing == std::vector<std::string>{configuration_key(baseline[1])});
+  REQUIRE(subset.num_regressions() == 0);
+  REQUIRE(subset.failed());
+  CompareOptions allow_missing;
+  allow_missing.allow_missing = true;
+  REQUIRE_FALSE(compare_results({baseline}, {{baseline[0]}}, allow_missing).failed());
+
+  // Nothing to compare is never a pass
+  std::vector<BenchmarkResult> renamed = {baseline[0]};
+  renamed[0].dataset = "other";
+  const CompareReport disjoint = compare_results({{baseline[0]}}, {renamed}, allow_missing);
+  REQUIRE(disjoint.comparisons.empty());
+  REQUIRE(disjoint.failed());
+
+  // A round trip that no longer matches the input always fails
+  std::vector<BenchmarkResult> unverified = baseline;
+  unverified[1].verified = false;
+  const CompareReport broken = compare_results({baseline}, {unverified}, CompareOptions());
+  REQUIRE(broken.num_regressions() == 0);
+  REQUIRE(broken.unverified == std::vector<std::string>{configuration_key(baseline[1])});
+  REQUIRE(broken.failed());
+}
+
+TEST_CASE("BenchmarkCompareRepeatedRunsTest", "[small]")
+{
+  CompareOptions options;
+  options.compare_ratio = false;
+  options.compare_latency = false;
+
+  // Slower by 10% with little noise: significant
+  const std::vector<std::vector<BenchmarkResult>> baseline 
+      = {{make_result("runs", 10.0, 20.0)}, {make_result("runs", 10.1, 20.0)}, {make_result("runs", 9.9, 20.0)}};
+  const std::vector<std::vector<BenchmarkResult>> slower 
+      = {{make_result("runs", 9.0, 20.0)}, {make_result("runs", 9.1, 20.0)}, {make_result("runs", 8.9, 20.0)}};
+  const CompareReport significant = compare_results(baseline, slower, options);
+  REQUIRE(significant.num_regressions() == 1);
+  REQUIRE(find_comparison(significant, slower[0][0], "compress_gbps").p_value < 0.01);
+  REQUIRE(find_comparison(significant, slower[0][0], "compress_gbps").candidate == Approx(9.0));
+
+  // Slower by 10% on average, but within the noise of the runs
+  const std::vector<std::vector<BenchmarkResult>> noisy 
+      = {{make_result("runs", 6.0, 20.0)}, {make_result("runs", 12.0, 20.0)}, {make_result("runs", 9.0, 20.0)}};
+  const CompareReport insignificant = compare_results(baseline, noisy, options);
+  REQUIRE(insignificant.num_regressions() == 0);
+  REQUIRE(find_comparison(insignificant, noisy[0][0], "compress_gbps").improvement == Approx(-0.1));
+  REQUIRE(find_comparison(insignificant, noisy[0][0], "compress_gbps").p_value > 0.05);
+}
+
+TEST_CASE("BenchmarkCompareReportTest", "[small]")
+{
+  std::vector<BenchmarkResult> candidate = {make_result("runs", 8.0, 20.0)};
+  candidate[0].verified = false;
+  const CompareReport report = compare_results({{make_result("runs", 10.0, 20.0)}}, {candidate}, CompareOptions());
+
+  std::stringstream text;
+  write_report(text, report);
+  REQUIRE(text.str().find("REGRESSION " + configuration_key(candidate[0]) + " compress_gbps: 10 -> 8 (worse by 20.0%)")
+      != std::string::npos);
+  REQUIRE(text.str().find("UNVERIFIED ") != std::string::npos);
+  REQUIRE(text.str().find("7 metrics compared, 1 regressed, 1 unverified: FAILED") != std::string::npos);
+
+  std::stringstream json;
+  write_report_json(json, report);
+  REQUIRE(json.str().find("\"failed\": true") != std::string::npos);
+  REQUIRE(json.str().find("\"metric\": \"compress_gbps\", \"baseline\": 10, \"candidate\": 8") != std::string::npos);
+  REQUIRE(json.str().find("\"unverified\": [\"" + configuration_key(candidate[0]) + "\"]") != std::string::npos);
+}
@@ -0,0 +1,285 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tests/catch.hpp"
+
+#include "BenchmarkDatasets.hpp"
+#include "BenchmarkResults.hpp"
+#include "BenchmarkRunner.hpp"
+#include "DatasetGenerator.hpp"
+
+using namespace hipcomp;
+using namespace hipcomp::benchmarks;
+
+namespace
+{
+
+BenchmarkCase host_case(const std::string& format, const std::string& dataset)
+{
+  return BenchmarkCase{"batched", "host", format, HIPCOMP_TYPE_CHAR, 4096, 16, dataset, 3, 1};
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("BenchmarkPercentilesTest", "[small]")
+{
+  std::vector<double> samples;
+  for (int i = 100; i >= 1; --i) {
+    samples.push_back(i);
+  }
+  const LatencyPercentiles latency = compute_percentiles(samples);
+  REQUIRE(latency.p50 == 50);
+  REQUIRE(latency.p90 == 90);
+  REQUIRE(latency.p99 == 99);
+  REQUIRE(latency.max == 100);
+
+  REQUIRE(compute_percentiles({7.0}).p50 == 7.0);
+  REQUIRE(compute_percentiles({}).max == 0.0);
+}
+
+TEST_CASE("BenchmarkDatasetTest", "[small]")
+{
+  for (const std::string& name : datasets::dataset_names()) {
+    const std::vector<uint8_t> data = load_dataset(name, 10000, HIPCOMP_TYPE_INT);
+    REQUIRE(data.size() == 10000);
+    REQUIRE(data == load_dataset(name, 10000, HIPCOMP_TYPE_INT));
+  }
+  // Whole elements only
+  REQUIRE(load_dataset("sorted", 1001, HIPCOMP_TYPE_LONGLONG).size() == 1000);
+
+  const std::string path = "BenchmarkDatasetTest.bin";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "0123456789";
+  }
+  REQUIRE(load_dataset("file:" + path, 4, HIPCOMP_TYPE_CHAR) == std::vector<uint8_t>({'0', '1', '2', '3'}));
+  REQUIRE(load_dataset("file:" + path, 100, HIPCOMP_TYPE_CHAR).size() == 10);
+  std::remove(path.c_str());
+
+  REQUIRE_THROWS(load_dataset("file:does/not/exist", 100, HIPCOMP_TYPE_CHAR));
+  REQUIRE_THROWS(load_dataset("unknown", 100, HIPCOMP_TYPE_CHAR));
+  REQUIRE(parse_type(type_name(HIPCOMP_TYPE_USHORT)) == HIPCOMP_TYPE_USHORT);
+  REQUIRE_THROWS(parse_type("float"));
+}
+
+namespace {
+
+double byte_entropy(const std::vector<uint8_t>& data)
+{
+  std::vector<double> counts(256, 0.0);
+  for (const uint8_t byte : data) {
+    counts[byte] += 1.0;
+  }
+  double entropy = 0.0;
+  for (const double count : counts) {
+    if (count > 0.0) {
+      const double p = count / data.size();
+      entropy -= p * std::log2(p);
+    }
+  }
+  return entropy;
+}
+
+} // namespace
+
+TEST_CASE("DatasetGeneratorEntropyTest", "[small]")
+{
+  for (const double bits : {0.0, 1.0, 3.5, 6.0, 8.0}) {
+    const std::vector<uint8_t> data = datasets::entropy_bytes(1 << 20, bits, 5);
+    REQUIRE(data.size() == 1 << 20);
+    REQUIRE(std::abs(byte_entropy(data) - bits) < 0.05);
+  }
+  REQUIRE(datasets::entropy_bytes(1000, 4.0, 1) == datasets::entropy_bytes(1000, 4.0, 1));
+  REQUIRE(datasets::entropy_bytes(1000, 4.0, 1) != datasets::entropy_bytes(1000, 4.0, 2));
+  REQUIRE_THROWS(datasets::entropy_bytes(10, 8.5, 0));
+  REQUIRE(byte_entropy(datasets::compressed_noise(1 << 20, 3)) > 7.99);
+}
+
+TEST_CASE("DatasetGeneratorRunsTest", "[small]")
+{
+  for (const datasets::RunLengthDistribution distribution :
+       {datasets::RunLengthDistribution::Fixed,
+        datasets::RunLengthDistribution::Uniform,
+        datasets::RunLengthDistribution::Geometric}) {
+    const std::vector<int> data = datasets::runs<int>(100000, distribution, 8.0, 16, 7);
+    REQUIRE(data.size() == 100000);
+
+    size_t num_runs = 1;
+    for (size_t i = 1; i < data.size(); ++i) {
+      num_runs += data[i] != data[i - 1];
+    }
+    // Adjacent runs can draw the same value and merge
+    const double mean_run = static_cast<double>(data.size()) / num_runs;
+    REQUIRE(mean_run > 7.5);
+    REQUIRE(mean_run < 10.0);
+  }
+
+  const std::vector<int> fixed = datasets::runs<int>(64, datasets::RunLengthDistribution::Fixed, 1.0, 1, 0);
+  REQUIRE(std::count(fixed.begin(), fixed.end(), fixed[0]) == 64);
+}
+
+TEST_CASE("DatasetGeneratorSortedTest", "[small]")
+{
+  const std::vector<uint32_t> sorted = datasets::sorted_integers<uint32_t>(10000, 3, 0.0, 1);
+  REQUIRE(std::is_sorted(sorted.begin(), sorted.end()));
+
+  std::vector<uint32_t> near_sorted = datasets::sorted_integers<uint32_t>(10000, 3, 0.01, 1);
+  REQUIRE(!std::is_sorted(near_sorted.begin(), near_sorted.end()));
+  size_t num_descents = 0;
+  for (size_t i = 1; i < near_sorted.size(); ++i) {
+    num_descents += near_sorted[i] < near_sorted[i - 1];
+  }
+  REQUIRE(num_descents <= 2 * 100);
+  // Swaps keep the values
+  std::sort(near_sorted.begin(), near_sorted.end());
+  REQUIRE(near_sorted == sorted);
+}
+
+TEST_CASE("DatasetGeneratorTextAndSeriesTest", "[small]")
+{
+  const std::vector<uint8_t> text = datasets::repeated_text(100000, 50, 2);
+  REQUIRE(text.size() == 100000);
+  for (const uint8_t c : text) {
+    REQUIRE(((c >= 'a' && c <= 'z') || c == ' ' || c == '.' || c == '\n'));
+  }
+  REQUIRE(byte_entropy(text) < 5.0);
+
+  const std::vector<float> series = datasets::float_series<float>(10000, 4);
+  for (size_t i = 1; i < series.size(); ++i) {
+    REQUIRE(std::isfinite(series[i]));
+    // Readings change smoothly
+    REQUIRE(std::abs(series[i] - series[i - 1]) < 1.0f);
+  }
+
+  for (const std::string& name : datasets::dataset_names()) {
+    REQUIRE(
+        datasets::generate(name, 4096, HIPCOMP_TYPE_SHORT, 9)
+        == datasets::generate(name, 4096, HIPCOMP_TYPE_SHORT, 9));
+  }
+  REQUIRE(datasets::generate("floats", 800, HIPCOMP_TYPE_LONGLONG, 0).size() == 800);
+  REQUIRE_THROWS(datasets::generate("zeros", 100, HIPCOMP_TYPE_CHAR, 0));
+}
+
+TEST_CASE("BenchmarkHostBackendTest", "[small]")
+{
+  const BenchmarkCase bench = host_case("lz4", "runs");
+  // A partial last chunk
+  const std::vector<uint8_t> data = load_dataset(bench.dataset, 10 * 4096 + 100, bench.data_type);
+
+  const BenchmarkResult res = run_benchmark(bench, nullptr, data);
+  REQUIRE(res.verified);
+  REQUIRE(res.num_chunks == 11);
+  REQUIRE(res.uncompressed_bytes == data.size());
+  REQUIRE(res.compressed_bytes > 0);
+  REQUIRE(res.ratio() > 1.0);
+  REQUIRE(res.compress_throughput > 0.0);
+  REQUIRE(res.decompress_latency.p50 > 0.0);
+  REQUIRE(res.data_type == "char");
+
+  // Batches are capped at the batch size
+  const std::vector<uint8_t> large = load_dataset("random", 100 * 4096, bench.data_type);
+  const BenchmarkResult capped = run_benchmark(bench, nullptr, large);
+  REQUIRE(capped.verified);
+  REQUIRE(capped.num_chunks == bench.batch_size);
+
+  try {
+    run_benchmark(host_case("snappy", "runs"), nullptr, data);
+    FAIL("The host backend has no Snappy codec.");
+  } catch (const HipCompException& e) {
+    REQUIRE(e.get_error() == hipcompErrorNotSupported);
+  }
+  BenchmarkCase manager_case = bench;
+  manager_case.api = "manager";
+  REQUIRE_THROWS_AS(run_benchmark(manager_case, nullptr, data), HipCompException);
+}
+
+TEST_CASE("BenchmarkMemoryBandwidthTest", "[small]")
+{
+  REQUIRE(measure_memory_bandwidth("host", nullptr, 1 << 20, 3) > 0.0);
+  REQUIRE_THROWS_AS(measure_memory_bandwidth("host", nullptr, 0, 3), HipCompException);
+
+  BenchmarkResult res = run_benchmark(host_case("lz4", "runs"), nullptr, load_dataset("runs", 8192, HIPCOMP_TYPE_CHAR));
+  REQUIRE(res.memory_bandwidth == 0.0);
+  REQUIRE(res.compress_bandwidth_fraction() == 0.0);
+
+  // 4:1 moves 1.25 bytes per input byte
+  res.uncompressed_bytes = 65536;
+  res.compressed_bytes = 16384;
+  res.compress_throughput = 8.0;
+  res.decompress_throughput = 32.0;
+  res.memory_bandwidth = 40.0;
+  REQUIRE(res.bytes_per_input_byte() == 1.25);
+  REQUIRE(res.compress_bandwidth_fraction() == Approx(0.25));
+  REQUIRE(res.decompress_bandwidth_fraction() == Approx(1.0));
+
+  std::stringstream csv;
+  write_csv(csv, {res});
+  REQUIRE(csv.str().find("memory_gbps,bytes_per_input_byte,compress_bandwidth_fraction,") != std::string::npos);
+  REQUIRE(csv.str().find(",40,1.25,0.25,1,") != std::string::npos);
+}
+
+TEST_CASE("BenchmarkReportTest", "[small]")
+{
+  std::vector<BenchmarkResult> results;
+  results.push_back(run_benchmark(host_case("lz4", "runs"), nullptr, load_dataset("runs", 8192, HIPCOMP_TYPE_CHAR)));
+  results.push_back(results.front());
+  results.back().dataset = "file:a,b.bin";
+
+  std::stringstream csv;
+  write_csv(csv, results);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(csv, line)) {
+    lines.push_back(line);
+  }
+  REQUIRE(lines.size() == 3);
+  REQUIRE(lines[0].compare(0, 12, "api,backend,") == 0);
+  REQUIRE(lines[1].compare(0, 20, "batched,host,lz4,cha") == 0);
+  // Fields with commas are quoted
+  REQUIRE(lines[2].find("\"file:a,b.bin\"") != std::string::npos);
+
+  std::stringstream json;
+  write_json(json, results);
+  const std::string text = json.str();
+  REQUIRE(text.front() == '[');
+  REQUIRE(text.find("\"format\": \"lz4\"") != std::string::npos);
+  REQUIRE(text.find("\"compress_latency_us\": {\"p50\": ") != std::string::npos);
+  REQUIRE(text.find("\"verified\": true") != std::string::npos);
+
+  std::stringstream empty;
+  write_json(empty, std::vector<BenchmarkResult>());
+  REQUIRE(empty.str() == "[]\n");
+}
@@ -0,0 +1,146 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tests/catch.hpp"
+
+#include "WorkloadReplay.hpp"
+
+using namespace hipcomp;
+using namespace hipcomp::benchmarks;
+
+namespace
+{
+
+WorkloadCall make_call(
+    const std::string& operation, const std::string& codec, const uint64_t bytes, const uint64_t batch_size,
+    const uint64_t chunk_size)
+{
+  return WorkloadCall{operation, codec, bytes, batch_size, chunk_size, HIPCOMP_TYPE_CHAR, 0, 2000, 0, 0};
+}
+
+/**
+ * An application that compresses two batches of 4 KB chunks and decompresses one, 
+ * next to calls the host backend cannot replay.
+ */
+std::vector<WorkloadCall> host_workload()
+{
+  return std::vector<WorkloadCall>{
+      make_call("batched_compress", "lz4", 0, 16, 4096),
+      make_call("batched_get_decompress_size", "lz4", 0, 16, 0),
+      make_call("batched_decompress", "lz4", 0, 16, 0),
+      make_call("batched_compress", "lz4", 0, 16, 4096),
+      make_call("compress", "lz4", 1 << 20, 16, 65536),
+      make_call("batched_compress", "snappy", 0, 16, 4096),
+      make_call("batched_compress", "segmented", 0, 16, 4096)};
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("WorkloadReplayPlanTest", "[small]")
+{
+  ReplayOptions options;
+  const WorkloadReplay replay = plan_replay(host_workload(), options);
+
+  REQUIRE(replay.shapes.size() == 4);
+  REQUIRE(replay.call_shapes == std::vector<size_t>({0, 1, 0, 2, 3}));
+  REQUIRE(replay.skipped.size() == 2);
+  REQUIRE(replay.skipped.at("batched_get_decompress_size is not replayed") == 1);
+  REQUIRE(replay.skipped.at("unknown format segmented") == 1);
+  REQUIRE_FALSE(replay.replayed);
+
+  const ReplayShape& compress = replay.shapes[0];
+  REQUIRE(compress.operation == "batched_compress");
+  REQUIRE(compress.bench.api == "batched");
+  REQUIRE(compress.bench.chunk_size == 4096);
+  REQUIRE(compress.bench.batch_size == 16);
+  REQUIRE(compress.bytes == 16 * 4096);
+  REQUIRE(compress.calls == 2);
+  REQUIRE(compress.recorded_us == Approx(4.0));
+
+  // the decompression takes the chunk size of the compression
+  const ReplayShape& decompress = replay.shapes[1];
+  REQUIRE(decompress.operation == "batched_decompress");
+  REQUIRE(decompress.bench.chunk_size == 4096);
+  REQUIRE(decompress.bytes == 16 * 4096);
+
+  const ReplayShape& manager = replay.shapes[2];
+  REQUIRE(manager.bench.api == "manager");
+  REQUIRE(manager.bench.chunk_size == 65536);
+  REQUIRE(manager.bench.batch_size == 16);
+  REQUIRE(manager.bytes == 1 << 20);
+
+  // without a recorded compression, the default chunk size
+  options.default_chunk_size = 8192;
+  const WorkloadReplay decompress_only 
+      = plan_replay(std::vector<WorkloadCall>{make_call("batched_decompress", "snappy", 0, 4, 0)}, options);
+  REQUIRE(decompress_only.shapes.size() == 1);
+  REQUIRE(decompress_only.shapes[0].bench.chunk_size == 8192);
+}
+
+TEST_CASE("WorkloadReplayHostTest", "[small]")
+{
+  ReplayOptions options;
+  options.backend = "host";
+  options.iterations = 2;
+  WorkloadReplay replay = plan_replay(host_workload(), options);
+
+  REQUIRE(replay.shapes.size() == 2);
+  REQUIRE(replay.call_shapes == std::vector<size_t>({0, 1, 0}));
+  REQUIRE(replay.skipped.at("the host backend replays batched lz4 only") == 2);
+
+  run_replay(replay, options, nullptr);
+  REQUIRE(replay.replayed);
+  REQUIRE(replay.verified);
+  for (const ReplayShape& shape : replay.shapes) {
+    REQUIRE(shape.replayed_us > 0.0);
+  }
+
+  std::ostringstream report;
+  write_replay_report(report, replay);
+  REQUIRE(report.str().find("replayed_us") != std::string::npos);
+  REQUIRE(report.str().find("batched_decompress") != std::string::npos);
+  REQUIRE(report.str().find("Skipped 2 calls: the host backend replays batched lz4 only") != std::string::npos);
+}
+
+TEST_CASE("WorkloadReplayFileTest", "[small]")
+{
+  // a recording replays the same as the calls it was written from
+  std::stringstream buffer;
+  write_workload(buffer, host_workload());
+  const WorkloadReplay replay = plan_replay(read_workload(buffer), ReplayOptions());
+  REQUIRE(replay.call_shapes == plan_replay(host_workload(), ReplayOptions()).call_shapes);
+
+  std::ostringstream report;
+  write_replay_report(report, replay);
+  REQUIRE(report.str().find("replayed_us") == std::string::npos);
+  REQUIRE(report.str().find("Skipped 1 call: unknown format segmented") != std::string::npos);
+}
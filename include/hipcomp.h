@@ -79,6 +79,46 @@ typedef enum hipcompType_t
   HIPCOMP_TYPE_BITS = 0xff    // 1b
 } hipcompType_t;
 
+/**
+ * @brief Statistics of compressing one chunk, written by the
+ * hipcompBatched*CompressWithStatsAsync() functions.
+ */
+typedef struct
+{
+  /**
+   * @brief The size of the chunk before compression.
+   */
+  size_t uncompressed_bytes;
+
+  /**
+   * @brief The size of the chunk after compression.
+   */
+  size_t compressed_bytes;
+
+  /**
+   * @brief LZ4 and Snappy: the number of matches (back-references).
+   */
+  size_t num_matches;
+
+  /**
+   * @brief LZ4 and Snappy: the bytes covered by matches.
+   */
+  size_t match_bytes;
+
+  /**
+   * @brief LZ4 and Snappy: the bytes stored as literals.
+   */
+  size_t literal_bytes;
+
+  /**
+   * @brief Cascaded: the layers applied to the chunk. All are 0 when the chunk
+   * did not compress and was stored as is.
+   */
+  int num_RLEs;
+  int num_deltas;
+  int use_bp;
+} hipcompChunkStats_t;
+
 /******************************************************************************
  * FUNCTION PROTOTYPES ********************************************************
  *****************************************************************************/
@@ -289,7 +289,8 @@ hipcompStatus_t hipcompBatchedBitcompCompressAsync(
  * NOTE: The function is not completely asynchronous, as it needs to look
  * at the compressed data in order to create the proper bitcomp handle.
  * The stream is synchronized, the data is examined, then the asynchronous
- * decompression is launched.
+ * decompression is launched. For the same reason it cannot be captured into
+ * a graph and returns `hipcompErrorNotSupported` while \p stream is capturing.
  *
  * @param[in] device_compressed_ptrs Array with size \p batch_size of pointers
  * in device-accessible memory to compressed buffers. Each compressed buffer
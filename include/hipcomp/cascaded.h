@@ -210,6 +210,31 @@ hipcompStatus_t hipcompBatchedCascadedCompressAsync(
     const hipcompBatchedCascadedOpts_t format_opts,
     hipStream_t stream);
 
+/**
+ * @brief Perform compression like hipcompBatchedCascadedCompressAsync(), and also record
+ * statistics of each chunk.
+ *
+ * The parameters are those of hipcompBatchedCascadedCompressAsync(), plus:
+ * @param device_stats The statistics of each chunk on the GPU (output), with the
+ * sizes and the layers used filled in.
+ * This pointer must be GPU accessible. Can be nullptr, in which case this is the
+ * same as hipcompBatchedCascadedCompressAsync().
+ *
+ * @return hipcompSuccess if successfully launched, and an error code otherwise.
+ */
+hipcompStatus_t hipcompBatchedCascadedCompressWithStatsAsync(
+    const void* const* device_uncompressed_ptrs,
+    const size_t* device_uncompressed_bytes,
+    size_t max_uncompressed_chunk_bytes, // not used
+    size_t batch_size,
+    void* device_temp_ptr, // not used
+    size_t temp_bytes,     // not used
+    void* const* device_compressed_ptrs,
+    size_t* device_compressed_bytes,
+    const hipcompBatchedCascadedOpts_t format_opts,
+    hipcompChunkStats_t* device_stats,
+    hipStream_t stream);
+
 /**
  * @brief Get the amount of temp space required on the GPU for decompression.
  *
@@ -27,23 +27,50 @@
   #include "cuda_runtime.h"
   
   #define hipDevAttrComputeCapabilityMajor cudaDevAttrComputeCapabilityMajor
+  #define hipDeviceAttributeMaxThreadsPerMultiProcessor cudaDevAttrMaxThreadsPerMultiProcessor
+  #define hipDeviceAttributeMultiprocessorCount cudaDevAttrMultiProcessorCount
+  #define hipDeviceAttribute_t cudaDeviceAttr
+  #define hipDeviceCanAccessPeer cudaDeviceCanAccessPeer
+  #define hipDeviceEnablePeerAccess cudaDeviceEnablePeerAccess
   #define hipDeviceGetAttribute cudaDeviceGetAttribute
+  #define hipDeviceGetPCIBusId cudaDeviceGetPCIBusId
+  #define hipDeviceGetStreamPriorityRange cudaDeviceGetStreamPriorityRange
   #define hipDeviceProp_t cudaDeviceProp
   #define hipDeviceSynchronize cudaDeviceSynchronize
   #define hipErrorInvalidValue cudaErrorInvalidValue
+  #define hipErrorNotReady cudaErrorNotReady
+  #define hipErrorPeerAccessAlreadyEnabled cudaErrorPeerAccessAlreadyEnabled
   #define hipError_t cudaError_t
   #define hipEventCreate cudaEventCreate
+  #define hipEventCreateWithFlags cudaEventCreateWithFlags
+  #define hipEventDestroy cudaEventDestroy
+  #define hipEventDisableTiming cudaEventDisableTiming
   #define hipEventElapsedTime cudaEventElapsedTime
+  #define hipEventQuery cudaEventQuery
   #define hipEventRecord cudaEventRecord
+  #define hipEventSynchronize cudaEventSynchronize
   #define hipEvent_t cudaEvent_t
   #define hipFree cudaFree
+  #define hipFuncAttributes cudaFuncAttributes
+  #define hipFuncGetAttributes cudaFuncGetAttributes
   #define hipFreeAsync cudaFreeAsync
+  #define hipGetDevice cudaGetDevice
+  #define hipGetDeviceCount cudaGetDeviceCount
   #define hipGetDeviceProperties cudaGetDeviceProperties
   #define hipGetErrorString cudaGetErrorString
   #define hipGetLastError cudaGetLastError
+  #define hipGraphDestroy cudaGraphDestroy
+  #define hipGraphExecDestroy cudaGraphExecDestroy
+  #define hipGraphExecUpdateResult cudaGraphExecUpdateResult
+  #define hipGraphExec_t cudaGraphExec_t
+  #define hipGraphLaunch cudaGraphLaunch
+  #define hipGraphNode_t cudaGraphNode_t
+  #define hipGraph_t cudaGraph_t
+  #define hipHostFn_t cudaHostFn_t
   #define hipHostFree cudaFreeHost
   #define hipHostMalloc cudaMallocHost
   #define hipHostMallocDefault cudaHostAllocDefault
+  #define hipLaunchHostFunc cudaLaunchHostFunc
   #define hipMalloc cudaMalloc
   #define hipMallocAsync cudaMallocAsync
   #define hipMallocManaged cudaMallocManaged
@@ -61,11 +88,47 @@
   #define hipPointerAttribute_t cudaPointerAttributes
   #define hipPointerGetAttributes cudaPointerGetAttributes
   #define hipRuntimeGetVersion cudaRuntimeGetVersion
+  #define hipSetDevice cudaSetDevice
+  #define hipStreamBeginCapture cudaStreamBeginCapture
+  #define hipStreamCaptureModeThreadLocal cudaStreamCaptureModeThreadLocal
+  #define hipStreamCaptureStatus cudaStreamCaptureStatus
+  #define hipStreamCaptureStatusActive cudaStreamCaptureStatusActive
   #define hipStreamCreate cudaStreamCreate
+  #define hipStreamCreateWithFlags cudaStreamCreateWithFlags
+  #define hipStreamCreateWithPriority cudaStreamCreateWithPriority
   #define hipStreamDestroy cudaStreamDestroy
+  #define hipStreamEndCapture cudaStreamEndCapture
+  #define hipStreamIsCapturing cudaStreamIsCapturing
+  #define hipStreamNonBlocking cudaStreamNonBlocking
   #define hipStreamSynchronize cudaStreamSynchronize
+  #define hipStreamWaitEvent cudaStreamWaitEvent
   #define hipStream_t cudaStream_t
   #define hipSuccess cudaSuccess
+
+  // CUDA 12 dropped the error node and log arguments that HIP kept from CUDA 11
+  #if CUDART_VERSION >= 12000
+  inline cudaError_t hipGraphInstantiate(
+      cudaGraphExec_t* exec, cudaGraph_t graph, cudaGraphNode_t* error_node, char* log, size_t log_size)
+  {
+    (void)error_node;
+    (void)log;
+    (void)log_size;
+    return cudaGraphInstantiate(exec, graph, 0);
+  }
+
+  inline cudaError_t hipGraphExecUpdate(
+      cudaGraphExec_t exec, cudaGraph_t graph, cudaGraphNode_t* error_node, cudaGraphExecUpdateResult* result)
+  {
+    cudaGraphExecUpdateResultInfo info;
+    const cudaError_t err = cudaGraphExecUpdate(exec, graph, &info);
+    *error_node = info.errorNode;
+    *result = info.result;
+    return err;
+  }
+  #else
+  #define hipGraphExecUpdate cudaGraphExecUpdate
+  #define hipGraphInstantiate cudaGraphInstantiate
+  #endif
 #else
   #error only use for HIP/NVIDIA compile path!
 #endif
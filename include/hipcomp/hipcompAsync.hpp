@@ -0,0 +1,147 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "hipcompManager.hpp"
+
+namespace hipcomp {
+
+/**
+ * @brief The outcome of an asynchronous compression
+ */
+struct CompressionResult {
+  hipcompStatus_t status;
+  size_t comp_size;     ///< Size of the compressed buffer, including its headers
+};
+
+/**
+ * @brief The outcome of an asynchronous decompression
+ */
+struct DecompressionResult {
+  hipcompStatus_t status;
+  size_t decomp_size;
+};
+
+using CompressionCallback = std::function<void(const CompressionResult&)>;
+using DecompressionCallback = std::function<void(const DecompressionResult&)>;
+
+/**
+ * @brief Issues the calls of a manager and notifies their completion without blocking.
+ *
+ * Each call is followed on its stream by a host function that reads the status, which 
+ * the config keeps in pinned memory, and the compressed size, which is copied to a 
+ * pinned slot from a pool. The result is then handed to a callback or a future, so 
+ * no thread has to synchronize the stream or poll the status.
+ *
+ * Callbacks run on the shared host thread pool (see get_host_thread_pool()), so they
+ * may call the HIP API, but callbacks of different calls can run concurrently and in
+ * any order. They must not throw and should return quickly, as they hold a thread of
+ * the pool. An exception a callback throws anyway is reported on stderr. Only if the 
+ * host is out of memory, so that neither the pool nor a new thread can take a callback, 
+ * does it run in the HIP host function itself, where it must not call the HIP API.
+ *
+ * Thread-safe. The manager must outlive this object, whose destruction waits for the
+ * callbacks of all calls issued through it. Calls cannot be captured into a graph.
+ */
+struct AsyncManager {
+
+private: // pimpl
+  struct AsyncManagerImpl;
+  std::unique_ptr<AsyncManagerImpl> impl;
+
+public: // API
+  /**
+   * @param manager The manager that does the compression and decompression.
+   */
+  explicit AsyncManager(hipcompManagerBase& manager);
+
+  AsyncManager(const AsyncManager&) = delete;
+  AsyncManager& operator=(const AsyncManager&) = delete;
+
+  ~AsyncManager();
+
+  /**
+   * @brief Compress on stream and call callback once the compression has finished
+   *
+   * @param decomp_buffer The uncompressed input data (GPU accessible).
+   * @param comp_buffer The location to output the compressed data to (GPU accessible).
+   * @param comp_config Resulted from configure_compression for this decomp_buffer.
+   * @param stream The stream to compress on. See hipcompManagerBase::compress.
+   * @param callback Receives the result.
+   */
+  void compress(
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config,
+      hipStream_t stream,
+      CompressionCallback callback);
+
+  /**
+   * @brief Compress on stream
+   *
+   * \return A future that becomes ready once the compression has finished.
+   */
+  std::future<CompressionResult> compress(
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config,
+      hipStream_t stream);
+
+  /**
+   * @brief Decompress on stream and call callback once the decompression has finished
+   *
+   * @param decomp_buffer The location to output the decompressed data to (GPU accessible).
+   * @param comp_buffer The compressed input data (GPU accessible).
+   * @param decomp_config Resulted from configure_decompression for this comp_buffer.
+   * @param stream The stream to decompress on. See hipcompManagerBase::decompress.
+   * @param callback Receives the result.
+   */
+  void decompress(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& decomp_config,
+      hipStream_t stream,
+      DecompressionCallback callback);
+
+  /**
+   * @brief Decompress on stream
+   *
+   * \return A future that becomes ready once the decompression has finished.
+   */
+  std::future<DecompressionResult> decompress(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& decomp_config,
+      hipStream_t stream);
+
+  /**
+   * @brief The number of calls whose callback has not returned yet
+   */
+  size_t get_num_in_flight() const;
+};
+
+} // namespace hipcomp
@@ -0,0 +1,203 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <memory>
+
+#include "ans.h"
+#include "bitcomp.h"
+#include "cascaded.h"
+#include "gdeflate.h"
+#include "lz4.h"
+#include "snappy.h"
+
+namespace hipcomp {
+
+/**
+ * @brief The batched compressor that a CoalescingCompressionService launches.
+ *
+ * Implementations compress a whole batch per call and return once the compressed 
+ * sizes are known. The buffers are whatever the backend can access. For the device 
+ * backends they are GPU-accessible buffers; the pointer and size arrays are always
+ * host arrays.
+ */
+struct BatchedCompressBackend {
+  virtual ~BatchedCompressBackend() = default;
+
+  /**
+   * \return The largest uncompressed chunk the backend accepts
+   */
+  virtual size_t get_max_chunk_size() const = 0;
+
+  /**
+   * \return The largest batch the backend accepts in one call
+   */
+  virtual size_t get_max_batch_size() const = 0;
+
+  /**
+   * \return The output size needed to compress a chunk of uncompressed_bytes
+   */
+  virtual size_t get_max_compressed_chunk_size(size_t uncompressed_bytes) const = 0;
+
+  /**
+   * @brief Compresses a batch and waits for the result.
+   *
+   * Throws if the batch could not be compressed.
+   *
+   * @param uncompressed_ptrs The input chunks (host array).
+   * @param uncompressed_bytes The input chunk sizes (host array).
+   * @param max_uncompressed_chunk_bytes The largest entry in uncompressed_bytes.
+   * @param batch_size The number of chunks.
+   * @param compressed_ptrs The output locations (host array).
+   * @param compressed_bytes The compressed sizes (host array, output).
+   */
+  virtual void compress_batch(
+      const void* const* uncompressed_ptrs,
+      const size_t* uncompressed_bytes,
+      size_t max_uncompressed_chunk_bytes,
+      size_t batch_size,
+      void* const* compressed_ptrs,
+      size_t* compressed_bytes) = 0;
+
+  /**
+   * @brief Decompresses a batch and waits for the result.
+   *
+   * Optional. Throws if any chunk fails to decompress. The default throws 
+   * hipcompErrorNotSupported.
+   *
+   * @param compressed_ptrs The input chunks (host array).
+   * @param compressed_bytes The input chunk sizes (host array).
+   * @param uncompressed_buffer_bytes The sizes of the output locations (host array).
+   * @param batch_size The number of chunks.
+   * @param uncompressed_ptrs The output locations (host array).
+   * @param uncompressed_bytes The decompressed sizes (host array, output).
+   */
+  virtual void decompress_batch(
+      const void* const* compressed_ptrs,
+      const size_t* compressed_bytes,
+      const size_t* uncompressed_buffer_bytes,
+      size_t batch_size,
+      void* const* uncompressed_ptrs,
+      size_t* uncompressed_bytes);
+};
+
+/**
+ * @brief Creates a backend over hipcompBatched*CompressAsync and hipcompBatched*DecompressAsync
+ * for the format of format_opts.
+ *
+ * The backend owns the device pointer arrays and temp space for up to max_batch_size 
+ * chunks of up to max_chunk_bytes and launches on stream.
+ */
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedLZ4Opts_t& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes);
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedSnappyOpts_t& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes);
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedCascadedOpts_t& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes);
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedGdeflateOpts_t& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes);
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedANSOpts_t& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes);
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedBitcompFormatOpts& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes);
+
+/**
+ * @brief Limits on how requests are coalesced into a launch.
+ */
+struct CoalescingOptions {
+  /**
+   * The most requests in one launch. Capped by the backend's maximum batch size.
+   */
+  size_t max_batch_size;
+  /**
+   * The most uncompressed bytes in one launch. A single larger request still launches alone.
+   */
+  size_t max_batch_bytes;
+  /**
+   * How long the oldest pending request may wait for others before a partial batch launches.
+   */
+  std::chrono::microseconds max_delay;
+
+  CoalescingOptions()
+    : max_batch_size(1024),
+      max_batch_bytes(64 << 20),
+      max_delay(200)
+  {}
+};
+
+/**
+ * @brief Coalesces compression requests from many threads into batched launches.
+ *
+ * Any thread can submit a single buffer and receive a future for its compressed size. 
+ * A dispatcher thread gathers pending requests until a batch is full or the oldest
+ * request has waited max_delay, then compresses them with one backend call. 
+ * Requests are launched in submission order.
+ *
+ * The destructor compresses everything still pending before returning.
+ */
+struct CoalescingCompressionService {
+
+private: // pimpl
+  struct CoalescingCompressionServiceImpl;
+  std::unique_ptr<CoalescingCompressionServiceImpl> impl;
+
+public: // API
+  CoalescingCompressionService(
+      std::unique_ptr<BatchedCompressBackend> backend,
+      const CoalescingOptions& options = CoalescingOptions());
+
+  CoalescingCompressionService(const CoalescingCompressionService&) = delete;
+  CoalescingCompressionService& operator=(const CoalescingCompressionService&) = delete;
+
+  ~CoalescingCompressionService();
+
+  /**
+   * \return The output size needed to compress a buffer of uncompressed_bytes
+   */
+  size_t get_max_compressed_size(size_t uncompressed_bytes) const;
+
+  /**
+   * @brief Queues a buffer for compression. Thread-safe.
+   *
+   * The buffers must stay valid until the future is ready. A request larger than
+   * the backend's maximum chunk size fails with hipcompErrorInvalidValue.
+   *
+   * @param uncompressed_ptr The input data.
+   * @param uncompressed_bytes The input size.
+   * @param compressed_ptr The output location, at least get_max_compressed_size() bytes.
+   * \return A future for the compressed size. Holds the backend's exception if the batch failed.
+   */
+  std::future<size_t> submit(
+      const void* uncompressed_ptr,
+      size_t uncompressed_bytes,
+      void* compressed_ptr);
+
+  /**
+   * \return The number of backend launches so far
+   */
+  size_t get_num_launches() const;
+};
+
+} // namespace hipcomp
@@ -0,0 +1,149 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+
+#include "hipcompManager.hpp"
+
+namespace hipcomp {
+
+/**
+ * @brief A compression captured into a graph, so that it is issued with a single launch.
+ *
+ * The graph holds every kernel, memset and copy that compress() issues, the reset of the
+ * config status and, optionally, the write of the compressed size. The buffers are 
+ * parameters: launching with buffers other than those of the last capture captures the 
+ * compression again and updates the executable graph in place. The uncompressed size is 
+ * fixed by the config.
+ *
+ * The manager's scratch buffer is allocated before capturing. SegmentedManager and 
+ * ShardedManager cannot be captured.
+ */
+struct CompressGraph {
+
+private: // pimpl
+  struct CompressGraphImpl;
+  std::unique_ptr<CompressGraphImpl> impl;
+
+public: // API
+  /**
+   * @brief Capture the compression of a buffer
+   *
+   * @param manager The manager to capture.
+   * @param manager_stream The stream the manager was constructed with. The graph is 
+   * captured from and launched on this stream.
+   * @param comp_config Resulted from configure_compression. Its status is written by 
+   * every launch.
+   * @param decomp_buffer The uncompressed input data (GPU accessible).
+   * @param comp_buffer The location to output the compressed data to (GPU accessible).
+   * @param comp_size If not null, where every launch writes the compressed size 
+   * (device or pinned host memory).
+   */
+  CompressGraph(
+      hipcompManagerBase& manager,
+      hipStream_t manager_stream,
+      const CompressionConfig& comp_config,
+      const uint8_t* decomp_buffer,
+      uint8_t* comp_buffer,
+      size_t* comp_size = nullptr);
+
+  CompressGraph(const CompressGraph&) = delete;
+  CompressGraph& operator=(const CompressGraph&) = delete;
+
+  ~CompressGraph();
+
+  /**
+   * @brief Launch the graph on the manager stream with the captured buffers
+   */
+  void launch();
+
+  /**
+   * @brief Launch the graph on the manager stream with other buffers 
+   *
+   * Captures again if any buffer differs from the last capture.
+   */
+  void launch(const uint8_t* decomp_buffer, uint8_t* comp_buffer, size_t* comp_size = nullptr);
+
+  /**
+   * @brief The config whose status the launches write
+   */
+  const CompressionConfig& get_config() const;
+};
+
+/**
+ * @brief A decompression captured into a graph, so that it is issued with a single launch.
+ *
+ * Works like CompressGraph. The config must come from 
+ * configure_decompression(const CompressionConfig&), as reading it from a compressed 
+ * buffer requires the host.
+ */
+struct DecompressGraph {
+
+private: // pimpl
+  struct DecompressGraphImpl;
+  std::unique_ptr<DecompressGraphImpl> impl;
+
+public: // API
+  /**
+   * @brief Capture the decompression of a buffer
+   *
+   * @param manager The manager to capture.
+   * @param manager_stream The stream the manager was constructed with. The graph is 
+   * captured from and launched on this stream.
+   * @param decomp_config Resulted from configure_decompression. Its status is written 
+   * by every launch.
+   * @param decomp_buffer The location to output the decompressed data to (GPU accessible).
+   * @param comp_buffer The compressed input data (GPU accessible).
+   */
+  DecompressGraph(
+      hipcompManagerBase& manager,
+      hipStream_t manager_stream,
+      const DecompressionConfig& decomp_config,
+      uint8_t* decomp_buffer,
+      const uint8_t* comp_buffer);
+
+  DecompressGraph(const DecompressGraph&) = delete;
+  DecompressGraph& operator=(const DecompressGraph&) = delete;
+
+  ~DecompressGraph();
+
+  /**
+   * @brief Launch the graph on the manager stream with the captured buffers
+   */
+  void launch();
+
+  /**
+   * @brief Launch the graph on the manager stream with other buffers 
+   *
+   * Captures again if any buffer differs from the last capture.
+   */
+  void launch(uint8_t* decomp_buffer, const uint8_t* comp_buffer);
+
+  /**
+   * @brief The config whose status the launches write
+   */
+  const DecompressionConfig& get_config() const;
+};
+
+} // namespace hipcomp
@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+
+#include "hipcompManager.hpp"
+
+namespace hipcomp {
+
+/**
+ * @brief Compresses and decompresses data that lives in pageable host memory.
+ *
+ * The input is processed in slices. Each slice is copied into a pinned staging buffer,
+ * transferred to the device, (de)compressed by the wrapped manager and copied back.
+ * Staging buffers, device buffers and events are kept in a number of slots so that the
+ * H2D copy of one slice, the kernels of the next and the D2H copy of another overlap.
+ *
+ * The compressed format is the concatenation of one manager container per slice, so
+ * any manager of the same format can decompress it slice by slice.
+ *
+ * The pipeline keeps its staging and device buffers between calls. It is not thread-safe.
+ */
+struct HostPipeline {
+
+private: // pimpl
+  struct HostPipelineImpl;
+  std::unique_ptr<HostPipelineImpl> impl;
+
+public: // API
+  /**
+   * @brief Construct the pipeline over an existing manager
+   *
+   * @param manager The manager that performs the (de)compression of each slice.
+   * @param manager_stream The stream the manager was constructed with.
+   * @param slice_size The number of uncompressed bytes per slice. Should be a multiple 
+   * of the manager's chunk size.
+   * @param num_slots The number of slices that can be in flight at once. 2 gives double 
+   * buffering, 3 (the default) triple buffering.
+   */
+  HostPipeline(
+      hipcompManagerBase& manager,
+      hipStream_t manager_stream,
+      const size_t slice_size = 1 << 24,
+      const size_t num_slots = 3);
+
+  HostPipeline(const HostPipeline&) = delete;
+  HostPipeline& operator=(const HostPipeline&) = delete;
+
+  ~HostPipeline();
+
+  /**
+   * @brief Computes the size of the output buffer needed to compress a host buffer
+   *
+   * @param decomp_buffer_size The uncompressed input data size.
+   * \return The maximum compressed size
+   */
+  size_t get_max_compressed_size(const size_t decomp_buffer_size);
+
+  /**
+   * @brief Compress a host buffer into a host buffer.
+   *
+   * Returns once the compressed data has been written to comp_buffer.
+   *
+   * @param decomp_buffer The uncompressed input data (host memory).
+   * @param decomp_buffer_size The size of the input data.
+   * @param comp_buffer The output location, at least get_max_compressed_size() bytes (host memory).
+   * \return The compressed size
+   */
+  size_t compress(
+      const uint8_t* decomp_buffer,
+      const size_t decomp_buffer_size,
+      uint8_t* comp_buffer);
+
+  /**
+   * @brief Computes the decompressed size of a buffer produced by compress()
+   *
+   * Only reads the slice headers on the host. Does not touch the device.
+   *
+   * @param comp_buffer The compressed data (host memory).
+   * @param comp_buffer_size The size of the compressed data.
+   * \return The decompressed size
+   */
+  size_t get_decompressed_size(const uint8_t* comp_buffer, const size_t comp_buffer_size);
+
+  /**
+   * @brief Decompress a host buffer produced by compress() into a host buffer.
+   *
+   * Returns once the decompressed data has been written to decomp_buffer.
+   *
+   * @param decomp_buffer The output location, at least get_decompressed_size() bytes (host memory).
+   * @param comp_buffer The compressed data (host memory).
+   * @param comp_buffer_size The size of the compressed data.
+   */
+  void decompress(
+      uint8_t* decomp_buffer,
+      const uint8_t* comp_buffer,
+      const size_t comp_buffer_size);
+};
+
+} // namespace hipcomp
@@ -0,0 +1,171 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hipcomp {
+
+/**
+ * @brief The NUMA nodes of the host and their CPUs, as reported by sysfs.
+ */
+struct HostTopology {
+  /**
+   * The CPUs of each node, indexed by node id. Empty for ids without a node.
+   */
+  std::vector<std::vector<int>> node_cpus;
+
+  /**
+   * @brief Reads the topology from sysfs_root/devices/system/node.
+   *
+   * \return The topology, or one without nodes if sysfs has no NUMA information,
+   * e.g. on other platforms.
+   */
+  static HostTopology detect(const std::string& sysfs_root = "/sys");
+};
+
+/**
+ * @brief The NUMA node a PCI device is attached to.
+ *
+ * @param pci_bus_id The bus id of the device, e.g. "0000:c1:00.0".
+ * @param sysfs_root Where sysfs is mounted.
+ * \return The node, or -1 if unknown.
+ */
+int get_pci_numa_node(const std::string& pci_bus_id, const std::string& sysfs_root = "/sys");
+
+/**
+ * @brief The NUMA node of the current HIP device, or -1 if unknown or there is no device.
+ */
+int get_current_device_numa_node(const std::string& sysfs_root = "/sys");
+
+/**
+ * @brief Which CPUs the threads of a HostThreadPool run on.
+ */
+struct HostThreadPoolOptions {
+  /**
+   * The number of threads. 0 for one per CPU of the node, or per hardware thread if 
+   * the threads are not pinned.
+   */
+  size_t num_threads;
+  /**
+   * The NUMA node to pin the threads to. -1 for the node closest to the current 
+   * device when the pool is created.
+   */
+  int numa_node;
+  /**
+   * Whether to pin the threads at all. If false, or the node is unknown, the threads 
+   * run on any CPU.
+   */
+  bool pin_threads;
+  /**
+   * Where sysfs is mounted, to read the topology from.
+   */
+  std::string sysfs_root;
+
+  HostThreadPoolOptions()
+    : num_threads(0),
+      numa_node(-1),
+      pin_threads(true),
+      sysfs_root("/sys")
+  {}
+};
+
+/**
+ * @brief Threads for the host side work of the library.
+ *
+ * Runs the host codecs, the staging copies of the host pipeline and the callbacks of
+ * the AsyncManager. On hosts with several NUMA nodes, the threads are pinned to the
+ * CPUs of the node the device is attached to, so that copies to and from pinned 
+ * staging buffers stay on the local memory controller.
+ *
+ * Thread-safe. The destructor runs the tasks still queued before returning.
+ */
+struct HostThreadPool {
+
+private: // pimpl
+  struct HostThreadPoolImpl;
+  std::unique_ptr<HostThreadPoolImpl> impl;
+
+public: // API
+  explicit HostThreadPool(const HostThreadPoolOptions& options = HostThreadPoolOptions());
+
+  HostThreadPool(const HostThreadPool&) = delete;
+  HostThreadPool& operator=(const HostThreadPool&) = delete;
+
+  ~HostThreadPool();
+
+  /**
+   * @brief Calls fn(ix) for every ix in [0, num_tasks) and waits for all calls.
+   *
+   * The calling thread takes part, so this may also be called from a task of the 
+   * pool itself. If a call throws, no further calls are started and the first 
+   * exception is rethrown once the running calls have returned.
+   *
+   * @param num_tasks The number of calls.
+   * @param fn The function to call.
+   * @param max_threads The most threads working on the calls, including the 
+   * calling one. 0 for no limit beyond the size of the pool.
+   */
+  void parallel_for(size_t num_tasks, const std::function<void(size_t)>& fn, size_t max_threads = 0);
+
+  /**
+   * @brief Queues a task to run on a thread of the pool.
+   *
+   * Tasks should not throw; an exception is reported on stderr and the pool
+   * carries on.
+   */
+  void submit(std::function<void()> task);
+
+  /**
+   * \return The number of threads
+   */
+  size_t get_num_threads() const;
+
+  /**
+   * \return The NUMA node the threads are pinned to, or -1 if they are not pinned
+   */
+  int get_numa_node() const;
+
+  /**
+   * \return The CPUs the threads are pinned to, empty if they are not pinned
+   */
+  const std::vector<int>& get_cpus() const;
+};
+
+/**
+ * @brief Sets the options of the pool returned by get_host_thread_pool().
+ *
+ * Must be called before the pool is first used, e.g. before creating managers with 
+ * host work. Afterwards it throws hipcompErrorNotSupported.
+ */
+void configure_host_thread_pool(const HostThreadPoolOptions& options);
+
+/**
+ * @brief The pool shared by the host side work of the library, created on first use.
+ */
+HostThreadPool& get_host_thread_pool();
+
+} // namespace hipcomp
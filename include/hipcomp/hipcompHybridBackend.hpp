@@ -0,0 +1,152 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+
+#include "hipcomp/hipcompCoalescingService.hpp"
+
+namespace hipcomp {
+
+/**
+ * @brief Creates a backend that compresses and decompresses LZ4 on the host.
+ *
+ * Chunks are spread over up to num_threads threads of the shared host thread pool,
+ * or all of them if 0. 
+ * The output is the same LZ4 block format as hipcompBatchedLZ4CompressAsync(), so 
+ * the host and the device can decompress each other's chunks, but the host 
+ * compressor searches for matches more greedily and compresses somewhat less. 
+ * Needs no device; the buffers must be host accessible.
+ */
+std::unique_ptr<BatchedCompressBackend> create_host_lz4_backend(
+    size_t max_batch_size, size_t max_chunk_bytes, size_t num_threads = 0);
+
+/**
+ * @brief How a HybridBatchedBackend divides batches.
+ */
+struct HybridOptions {
+  /**
+   * The device's share of the bytes of a batch until the throughput of both sides is measured.
+   */
+  double initial_device_share;
+  /**
+   * The weight of the newest batch in the moving average of each side's throughput, in (0, 1].
+   */
+  double smoothing;
+  /**
+   * The least share of the bytes each side gets while both exist, in [0, 0.5]. 
+   * Keeps measuring a side that is currently slow, so that work moves back to it 
+   * once it speeds up.
+   */
+  double min_share;
+
+  HybridOptions()
+    : initial_device_share(0.75),
+      smoothing(0.25),
+      min_share(0.05)
+  {}
+};
+
+/**
+ * @brief Splits each batch between a device backend and a host backend of the same format.
+ *
+ * A front part of the batch runs on the device while the rest runs on the host, 
+ * sized by the measured throughput of each side so both finish together. When the 
+ * device is busy with other work its throughput drops and the host takes a larger 
+ * share. Without a device backend every batch runs on the host.
+ *
+ * The limits are the tighter of the two backends'. With a device, the buffers must 
+ * be accessible from both the host and the device, e.g. managed or mapped host memory.
+ */
+struct HybridBatchedBackend : BatchedCompressBackend {
+
+private: // pimpl
+  struct HybridBatchedBackendImpl;
+  std::unique_ptr<HybridBatchedBackendImpl> impl;
+
+public: // API
+  /**
+   * @brief Creates the backend.
+   *
+   * @param device_backend The device side, or null if there is no device.
+   * @param host_backend The host side.
+   * @param options How to divide batches.
+   */
+  HybridBatchedBackend(
+      std::unique_ptr<BatchedCompressBackend> device_backend,
+      std::unique_ptr<BatchedCompressBackend> host_backend,
+      const HybridOptions& options = HybridOptions());
+
+  HybridBatchedBackend(const HybridBatchedBackend&) = delete;
+  HybridBatchedBackend& operator=(const HybridBatchedBackend&) = delete;
+
+  ~HybridBatchedBackend();
+
+  size_t get_max_chunk_size() const final override;
+
+  size_t get_max_batch_size() const final override;
+
+  size_t get_max_compressed_chunk_size(size_t uncompressed_bytes) const final override;
+
+  void compress_batch(
+      const void* const* uncompressed_ptrs,
+      const size_t* uncompressed_bytes,
+      size_t max_uncompressed_chunk_bytes,
+      size_t batch_size,
+      void* const* compressed_ptrs,
+      size_t* compressed_bytes) final override;
+
+  void decompress_batch(
+      const void* const* compressed_ptrs,
+      const size_t* compressed_bytes,
+      const size_t* uncompressed_buffer_bytes,
+      size_t batch_size,
+      void* const* uncompressed_ptrs,
+      size_t* uncompressed_bytes) final override;
+
+  /**
+   * \return The share of the bytes of the next compression batch that runs on the device
+   */
+  double get_compress_device_share() const;
+
+  /**
+   * \return The share of the bytes of the next decompression batch that runs on the device
+   */
+  double get_decompress_device_share() const;
+};
+
+/**
+ * @brief Creates a hybrid LZ4 backend over hipcompBatchedLZ4CompressAsync() on stream
+ * and create_host_lz4_backend().
+ *
+ * If no device is present, the backend runs every batch on the host and stream is unused.
+ */
+std::unique_ptr<HybridBatchedBackend> create_hybrid_lz4_backend(
+    const hipcompBatchedLZ4Opts_t& format_opts, 
+    hipStream_t stream, 
+    size_t max_batch_size, 
+    size_t max_chunk_bytes,
+    const HybridOptions& options = HybridOptions(),
+    size_t num_host_threads = 0);
+
+} // namespace hipcomp
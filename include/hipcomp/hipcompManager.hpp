@@ -49,7 +49,9 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "hipcomp.h"
@@ -82,6 +84,11 @@ public: // API
   size_t uncompressed_buffer_size;
   size_t max_compressed_buffer_size;
   size_t num_chunks;
+  /**
+   * Set before compressing to lay the compressed chunks out in order, which
+   * allows the result to be decompressed in place. Off by default.
+   */
+  bool in_place_decompressible;
 
   /**
    * @brief Construct the config given an hipcompStatus_t memory pool
@@ -135,6 +142,67 @@ public: // API
   ~DecompressionConfig();
 };
 
+/**
+ * @brief Breakdown of the memory, in bytes, that a manager or a batched API call uses.
+ */
+struct MemoryFootprint {
+  // Device memory
+  size_t scratch;       ///< Manager scratch buffer
+  size_t ix_chunk;      ///< Chunk counters used by the HLIF kernels
+  size_t temp;          ///< Temp space of a batched API call
+  size_t max_output;    ///< Worst-case output buffers
+  size_t contexts;      ///< Scratch and counters of calls on other streams, allocated so far
+
+  // Pinned host memory
+  size_t status_pool;   ///< Status pool backing the configs
+  size_t headers;       ///< Format header staging
+
+  // Pageable host memory
+  size_t configs;       ///< Config objects
+
+  size_t device_bytes() const 
+  {
+    return scratch + ix_chunk + temp + max_output + contexts;
+  }
+
+  size_t pinned_bytes() const 
+  {
+    return status_pool + headers;
+  }
+
+  size_t pageable_bytes() const 
+  {
+    return configs;
+  }
+};
+
+/**
+ * @brief Device resources of one kernel that a manager launches, for the manager's 
+ * device and configuration. Fields the runtime cannot report, e.g. for kernels of 
+ * external libraries, are 0.
+ */
+struct KernelResourceUsage {
+  std::string kernel;              ///< Format and direction, e.g. "lz4_compress"
+  int device_id;                   ///< Device the kernel runs on
+  uint32_t block_size;             ///< Threads per CTA
+  uint32_t registers_per_thread;   ///< As reported by hipFuncGetAttributes
+  size_t static_lds_bytes;         ///< LDS declared by the kernel, per CTA
+  size_t dynamic_lds_bytes;        ///< LDS requested at launch, per CTA
+  uint32_t num_cus;                ///< Compute units of the device
+  uint32_t ctas_per_cu;            ///< CTAs that can be resident on one CU at once
+  uint32_t grid_size;              ///< CTAs launched by each call
+  double occupancy;                ///< Resident threads per CU over the CU maximum
+
+  /**
+   * @brief The fraction of the device's CTA slots for this kernel that a call occupies
+   */
+  double device_fraction() const 
+  {
+    const size_t slots = static_cast<size_t>(num_cus) * ctas_per_cu;
+    return slots > 0 ? std::min(1.0, static_cast<double>(grid_size) / slots) : 0.0;
+  }
+};
+
 /**
  * @brief Abstract base class that defines the nvCOMP high level interface
  */
@@ -153,6 +221,9 @@ struct hipcompManagerBase {
   /**
    * @brief Perform compression asynchronously.
    *
+   * Only issues work on the user stream, so it can be captured into a graph once the
+   * scratch buffer is allocated. When captured, the status is reset by the graph.
+   *
    * @param decomp_buffer The uncompressed input data (GPU accessible).
    * @param comp_buffer The location to output the compressed data to (GPU accessible).
    * @param comp_config Resulted from configure_compression for this decomp_buffer.
@@ -162,6 +233,27 @@ struct hipcompManagerBase {
       uint8_t* comp_buffer,
       const CompressionConfig& comp_config) = 0;
 
+  /**
+   * @brief Perform compression asynchronously on the given stream.
+   *
+   * Thread-safe. A call on a stream other than the user stream leases its own scratch 
+   * space and chunk counters from a pool kept by the manager, so calls on different 
+   * streams can be issued from several threads and run concurrently. The pool grows on
+   * first use of a stream, which cannot happen during graph capture. Space used by a 
+   * captured call is only leased again on the same stream. A scratch buffer set with 
+   * set_scratch_buffer() is only used by calls on the user stream.
+   *
+   * @param decomp_buffer The uncompressed input data (GPU accessible).
+   * @param comp_buffer The location to output the compressed data to (GPU accessible).
+   * @param comp_config Resulted from configure_compression for this decomp_buffer.
+   * @param stream The stream to compress on.
+   */
+  virtual void compress(
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config,
+      hipStream_t stream) = 0;
+
   /**
    * @brief Configure the decompression using a compressed buffer. 
    *
@@ -189,6 +281,9 @@ struct hipcompManagerBase {
   /**
    * @brief Perform decompression asynchronously.
    *
+   * Can be captured into a graph like compress(), with a config from 
+   * configure_decompression(const CompressionConfig&).
+   *
    * @param decomp_buffer The location to output the decompressed data to (GPU accessible).
    * @param comp_buffer The compressed input data (GPU accessible).
    * @param decomp_config Resulted from configure_decompression given this decomp_buffer_size.
@@ -198,7 +293,52 @@ struct hipcompManagerBase {
       uint8_t* decomp_buffer, 
       const uint8_t* comp_buffer,
       const DecompressionConfig& decomp_config) = 0;
+
+  /**
+   * @brief Perform decompression asynchronously on the given stream.
+   *
+   * Thread-safe, with the same use of per-stream contexts as compress() on a stream.
+   *
+   * @param decomp_buffer The location to output the decompressed data to (GPU accessible).
+   * @param comp_buffer The compressed input data (GPU accessible).
+   * @param decomp_config Resulted from configure_decompression given this decomp_buffer_size.
+   * @param stream The stream to decompress on.
+   */
+  virtual void decompress(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& decomp_config,
+      hipStream_t stream) = 0;
   
+  /**
+   * @brief Computes the extra output space needed to decompress in place.
+   *
+   * A buffer compressed with CompressionConfig::in_place_decompressible set can be
+   * decompressed into an allocation of decomp_buffer_size plus this margin when the
+   * compressed data is copied to the end of that allocation.
+   *
+   * @param decomp_buffer_size The uncompressed data size.
+   * \return The margin in bytes
+   */
+  virtual size_t get_in_place_decompression_margin(const size_t decomp_buffer_size) = 0;
+
+  /**
+   * @brief Perform decompression into a buffer that also holds the compressed data.
+   *
+   * Synchronizes the user stream to read the chunk table, then decompresses the chunks 
+   * in an order that never overwrites compressed data that is still needed.
+   * The chunk table is staged in the scratch buffer.
+   *
+   * @param decomp_buffer The location to output the decompressed data to (GPU accessible).
+   * @param comp_buffer The compressed input data. Normally located at
+   * decomp_buffer + decomp_data_size + margin - compressed size.
+   * @param decomp_config Resulted from configure_decompression for this comp_buffer.
+   */
+  virtual void decompress_in_place(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& decomp_config) = 0;
+
   /**
    * @brief Allows the user to provide a user-allocated scratch buffer.
    * 
@@ -212,6 +352,14 @@ struct hipcompManagerBase {
    */
   virtual void set_scratch_buffer(uint8_t* new_scratch_buffer) = 0;
 
+  /**
+   * @brief Allocates the scratch buffer now rather than on the first compression / decompression.
+   * 
+   * Does nothing if the manager already has a scratch buffer. Call this (or set_scratch_buffer)
+   * before capturing the manager's work into a graph, as no allocation can happen during capture.
+   */
+  virtual void allocate_scratch_buffer() = 0;
+
   /** 
    * @brief Computes the size of the required scratch space
    * 
@@ -232,6 +380,57 @@ struct hipcompManagerBase {
    */ 
   virtual size_t get_compressed_output_size(uint8_t* comp_buffer) = 0;
 
+  /** 
+   * @brief Writes the compressed output size of a given buffer to a GPU accessible location
+   * 
+   * Does not synchronize. The size is written in stream order after any preceding compress call, 
+   * so a later kernel on the same stream, or on a stream that waits on event, can consume it 
+   * without the host blocking. The compression status already resides in pinned memory 
+   * (CompressionConfig::get_status()) that such a kernel can read directly.
+   * 
+   * @param comp_buffer The start pointer of the compressed buffer to assess (GPU accessible).
+   * @param comp_size The location to write the size to (device or pinned host memory).
+   * @param event If not null, recorded on the user stream once the size has been written.
+   */ 
+  virtual void get_compressed_output_size_async(
+      const uint8_t* comp_buffer, 
+      size_t* comp_size,
+      hipEvent_t event = nullptr) = 0;
+
+  /** 
+   * @brief Reports the memory used to compress batch_count buffers of a given size at once
+   * 
+   * Includes everything the manager allocates plus the worst-case compressed output buffers.
+   * Launches no device work and does not synchronize, so it can be called for admission 
+   * control. Sizing the output configures a compression, which borrows a status from the 
+   * manager's pinned pool, so it may allocate pinned host memory when the pool is empty.
+   * 
+   * @param decomp_buffer_size The uncompressed size of each buffer.
+   * @param batch_count The number of buffers with configs alive at the same time.
+   * \return The footprint
+   */ 
+  virtual MemoryFootprint get_memory_footprint(
+      const size_t decomp_buffer_size, 
+      const size_t batch_count = 1) = 0;
+
+  /**
+   * @brief Reports the registers, LDS, occupancy and grid size of the kernels the manager 
+   * launches, so that applications can tell how much of the device compression takes.
+   *
+   * Computed when the manager was constructed, for its device and configuration.
+   *
+   * \return One entry per kernel. Empty if the kernels are not launched by the manager itself.
+   */
+  virtual std::vector<KernelResourceUsage> get_kernel_resource_usage() = 0;
+
+  /**
+   * @brief The size of the format header that follows the common header of a compressed 
+   * buffer. For managers that assemble the containers of other managers.
+   *
+   * \return The size in bytes
+   */
+  virtual size_t get_format_header_size() = 0;
+
   virtual ~hipcompManagerBase() = default;
 };
 
@@ -266,6 +465,19 @@ public:
         comp_config);
   }
 
+  virtual void compress(
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config,
+      hipStream_t stream)
+  {
+    return impl->compress(
+        decomp_buffer,
+        comp_buffer,
+        comp_config,
+        stream);
+  }
+
   virtual DecompressionConfig configure_decompression(const uint8_t* comp_buffer) 
   {
     return impl->configure_decompression(comp_buffer);
@@ -283,12 +495,39 @@ public:
   {
     return impl->decompress(decomp_buffer, comp_buffer, decomp_config);
   }
+
+  virtual void decompress(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& decomp_config,
+      hipStream_t stream)
+  {
+    return impl->decompress(decomp_buffer, comp_buffer, decomp_config, stream);
+  }
+ 
+  virtual size_t get_in_place_decompression_margin(const size_t decomp_buffer_size)
+  {
+    return impl->get_in_place_decompression_margin(decomp_buffer_size);
+  }
+
+  virtual void decompress_in_place(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& decomp_config)
+  {
+    return impl->decompress_in_place(decomp_buffer, comp_buffer, decomp_config);
+  }
  
   virtual void set_scratch_buffer(uint8_t* new_scratch_buffer)
   {
     return impl->set_scratch_buffer(new_scratch_buffer);
   }
 
+  virtual void allocate_scratch_buffer()
+  {
+    return impl->allocate_scratch_buffer();
+  }
+
   virtual size_t get_required_scratch_buffer_size()
   {
     return impl->get_required_scratch_buffer_size();
@@ -298,6 +537,31 @@ public:
   {
     return impl->get_compressed_output_size(comp_buffer);
   }
+
+  virtual void get_compressed_output_size_async(
+      const uint8_t* comp_buffer, 
+      size_t* comp_size,
+      hipEvent_t event = nullptr)
+  {
+    return impl->get_compressed_output_size_async(comp_buffer, comp_size, event);
+  }
+
+  virtual MemoryFootprint get_memory_footprint(
+      const size_t decomp_buffer_size, 
+      const size_t batch_count = 1)
+  {
+    return impl->get_memory_footprint(decomp_buffer_size, batch_count);
+  }
+
+  virtual std::vector<KernelResourceUsage> get_kernel_resource_usage()
+  {
+    return impl->get_kernel_resource_usage();
+  }
+
+  virtual size_t get_format_header_size()
+  {
+    return impl->get_format_header_size();
+  }
 };
 
 } // namespace hipcomp
@@ -58,6 +58,7 @@
 #include "snappy.hpp"
 #include "bitcomp.hpp"
 #include "cascaded.hpp"
+#include "hipcompSegmentedManager.hpp"
 
 namespace hipcomp {
 
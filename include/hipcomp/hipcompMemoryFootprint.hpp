@@ -0,0 +1,83 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hipcompManager.hpp"
+#include "ans.h"
+#include "bitcomp.h"
+#include "cascaded.h"
+#include "gdeflate.h"
+#include "lz4.h"
+#include "snappy.h"
+
+namespace hipcomp {
+
+/**
+ * @brief Footprints of the low level batched APIs.
+ *
+ * Each overload reports the temp space and the worst-case output of one 
+ * hipcompBatched*CompressAsync / hipcompBatched*DecompressAsync call, using the 
+ * corresponding *GetTempSize and *GetMaxOutputChunkSize formulas. The per-chunk
+ * pointer, size and status arrays are owned by the caller and are not included.
+ *
+ * These are pure host computations and do not need a device. They throw 
+ * HipCompException if the format is not available in this build or the chunk
+ * size is not supported.
+ *
+ * @param batch_size The number of chunks in the batch.
+ * @param max_uncompressed_chunk_bytes The size of the largest uncompressed chunk.
+ * @param format_opts The options the batch is compressed with.
+ * \return The footprint
+ */
+MemoryFootprint get_batched_compress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedLZ4Opts_t& format_opts);
+MemoryFootprint get_batched_compress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedSnappyOpts_t& format_opts);
+MemoryFootprint get_batched_compress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedCascadedOpts_t& format_opts);
+MemoryFootprint get_batched_compress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedGdeflateOpts_t& format_opts);
+MemoryFootprint get_batched_compress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedANSOpts_t& format_opts);
+MemoryFootprint get_batched_compress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedBitcompFormatOpts& format_opts);
+
+/**
+ * @brief Decompression counterparts of get_batched_compress_memory_footprint().
+ *
+ * The options only select the format. max_output is the decompressed size of the batch.
+ */
+MemoryFootprint get_batched_decompress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedLZ4Opts_t& format_opts);
+MemoryFootprint get_batched_decompress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedSnappyOpts_t& format_opts);
+MemoryFootprint get_batched_decompress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedCascadedOpts_t& format_opts);
+MemoryFootprint get_batched_decompress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedGdeflateOpts_t& format_opts);
+MemoryFootprint get_batched_decompress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedANSOpts_t& format_opts);
+MemoryFootprint get_batched_decompress_memory_footprint(
+    size_t batch_size, size_t max_uncompressed_chunk_bytes, const hipcompBatchedBitcompFormatOpts& format_opts);
+
+} // namespace hipcomp
@@ -0,0 +1,171 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hipcomp.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hipcomp {
+
+/**
+ * @brief A snapshot of a latency histogram.
+ *
+ * Latencies are counted in buckets of at most 1/64 of their value, as in an HDR
+ * histogram, so quantiles are within about 1.6% of the recorded latencies from
+ * 1 ns up to about 36 minutes. Longer latencies are counted in the last bucket.
+ */
+struct LatencyHistogram {
+  /**
+   * The number of latencies in each bucket, see get_bucket_upper_bound_ns()
+   */
+  std::vector<uint64_t> counts;
+  uint64_t count = 0;
+  uint64_t sum_ns = 0;
+  uint64_t min_ns = 0;
+  uint64_t max_ns = 0;
+
+  /**
+   * \return The largest latency counted in bucket ix_bucket
+   */
+  static uint64_t get_bucket_upper_bound_ns(size_t ix_bucket);
+
+  /**
+   * @brief Computes a quantile, e.g. 0.99 for the 99th percentile.
+   *
+   * \return The upper bound of the bucket of the quantile, clamped to
+   * [min_ns, max_ns], or 0 if no latency was recorded
+   */
+  uint64_t get_quantile_ns(double quantile) const;
+
+  double get_mean_ns() const;
+};
+
+/**
+ * @brief The metrics of an operation of a format, e.g. "compress" of "lz4".
+ *
+ * The operations and the formats are those passed to a TraceListener, see
+ * hipcompTracing.hpp.
+ */
+struct OperationMetrics {
+  std::string codec;
+  std::string operation;
+
+  uint64_t calls = 0;
+
+  /**
+   * The uncompressed bytes passed to compression operations.
+   *
+   * Only sizes known on the host when an operation is called are counted. The sizes
+   * passed to the hipcompBatched* functions are on the device, so their compression
+   * counts the upper bound in TraceEvent::bytes.
+   */
+  uint64_t bytes_in = 0;
+
+  /**
+   * The uncompressed bytes produced by decompression operations.
+   *
+   * Compressed output sizes are not tracked: they are only written on the device,
+   * after the compress call has returned.
+   */
+  uint64_t bytes_out = 0;
+
+  /**
+   * The number of calls that failed, by status. Errors that kernels later write to
+   * the status of a config or of a chunk are not included.
+   */
+  std::map<hipcompStatus_t, uint64_t> errors;
+
+  /**
+   * The time from the start of a call to its return on the host. For
+   * asynchronous operations, this is the time to enqueue the work on the stream.
+   */
+  LatencyHistogram latency;
+};
+
+/**
+ * @brief The count and the bytes of an internal event of the library, e.g. the
+ * allocation of a scratch buffer.
+ */
+struct EventMetrics {
+  std::string name;
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+
+/**
+ * @brief The metrics of the process at one point in time.
+ */
+struct MetricsSnapshot {
+  /**
+   * Sorted by codec and operation
+   */
+  std::vector<OperationMetrics> operations;
+
+  /**
+   * Sorted by name. The events are:
+   * - scratch_allocation: a manager allocated its scratch buffer;
+   * - scratch_reallocation: set_scratch_buffer() replaced a scratch buffer,
+   *   with the size of the replaced buffer;
+   * - context_allocation: a manager allocated the scratch and counters of a call
+   *   on another stream than its own.
+   */
+  std::vector<EventMetrics> events;
+
+  /**
+   * @brief Writes the metrics in the Prometheus text exposition format. The
+   * latencies are summaries with the 0.5, 0.9, 0.99 and 0.999 quantiles.
+   */
+  void write_prometheus(std::ostream& out) const;
+
+  std::string to_prometheus() const;
+};
+
+/**
+ * @brief Starts or stops recording metrics in the process-wide registry.
+ *
+ * Metrics are disabled by default, and then cost an atomic load per operation.
+ * Stopping keeps the metrics recorded so far.
+ */
+void set_metrics_enabled(bool enabled);
+
+bool get_metrics_enabled();
+
+/**
+ * @brief Copies the metrics recorded so far. Thread-safe, and may be called while
+ * operations are recorded. Operations and events not seen since the last reset are
+ * omitted.
+ */
+MetricsSnapshot get_metrics_snapshot();
+
+/**
+ * @brief Sets all metrics recorded so far back to 0.
+ */
+void reset_metrics();
+
+} // namespace hipcomp
@@ -0,0 +1,172 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <memory>
+
+#include "hipcompCoalescingService.hpp"
+
+namespace hipcomp {
+
+/**
+ * @brief The queue a batch is scheduled on.
+ */
+enum class SchedulePriority {
+  Latency,    ///< Small interactive batches, launched as soon as possible
+  Throughput  ///< Bulk batches, launched in slices that yield to latency work
+};
+
+/**
+ * @brief Limits on how throughput batches share the device with latency batches.
+ */
+struct PrioritySchedulerOptions {
+  /**
+   * The most chunks of a throughput batch in one launch. Latency work can only 
+   * start ahead of a throughput batch between two of its launches, so this bounds 
+   * how long a latency batch waits behind bulk work.
+   */
+  size_t throughput_slice_chunks;
+  /**
+   * How long the next slice of a throughput batch waits for pending latency work 
+   * before it launches anyway, so that a steady stream of latency batches cannot 
+   * starve the bulk work.
+   */
+  std::chrono::microseconds max_throughput_delay;
+
+  PrioritySchedulerOptions()
+    : throughput_slice_chunks(256),
+      max_throughput_delay(10000)
+  {}
+};
+
+/**
+ * @brief Schedules batches on separate latency and throughput queues.
+ *
+ * Each queue has a dispatcher thread and its own backend. A latency batch launches 
+ * as soon as the previous latency batch is done. A throughput batch launches in 
+ * slices of throughput_slice_chunks, and a slice waits while latency batches are 
+ * pending or running, so bulk work is preempted at chunk boundaries. Batches of a 
+ * queue are launched in submission order.
+ *
+ * The backends are given, so the policy can be exercised with a simulated device.
+ * create_priority_batch_scheduler() builds one over the batched C API that launches 
+ * on streams of the highest and lowest priority.
+ *
+ * The destructor finishes everything still pending before returning.
+ */
+struct PriorityBatchScheduler {
+
+private: // pimpl
+  struct PriorityBatchSchedulerImpl;
+  std::unique_ptr<PriorityBatchSchedulerImpl> impl;
+
+public: // API
+  PriorityBatchScheduler(
+      std::unique_ptr<BatchedCompressBackend> latency_backend,
+      std::unique_ptr<BatchedCompressBackend> throughput_backend,
+      const PrioritySchedulerOptions& options = PrioritySchedulerOptions());
+
+  PriorityBatchScheduler(const PriorityBatchScheduler&) = delete;
+  PriorityBatchScheduler& operator=(const PriorityBatchScheduler&) = delete;
+
+  ~PriorityBatchScheduler();
+
+  /**
+   * @brief Queues a batch for compression. Thread-safe.
+   *
+   * The arrays and buffers must stay valid until the future is ready.
+   *
+   * @param priority The queue to schedule the batch on.
+   * @param uncompressed_ptrs The input chunks (host array).
+   * @param uncompressed_bytes The input chunk sizes (host array).
+   * @param batch_size The number of chunks.
+   * @param compressed_ptrs The output locations (host array).
+   * @param compressed_bytes The compressed sizes (host array, output).
+   * \return A future that is ready once the whole batch is compressed. Holds the 
+   * backend's exception if a launch failed, in which case the rest of the batch is skipped.
+   */
+  std::future<void> submit_compress(
+      SchedulePriority priority,
+      const void* const* uncompressed_ptrs,
+      const size_t* uncompressed_bytes,
+      size_t batch_size,
+      void* const* compressed_ptrs,
+      size_t* compressed_bytes);
+
+  /**
+   * @brief Queues a batch for decompression. Thread-safe.
+   *
+   * Like submit_compress(). The backends must support decompression.
+   *
+   * @param priority The queue to schedule the batch on.
+   * @param compressed_ptrs The input chunks (host array).
+   * @param compressed_bytes The input chunk sizes (host array).
+   * @param uncompressed_buffer_bytes The sizes of the output locations (host array).
+   * @param batch_size The number of chunks.
+   * @param uncompressed_ptrs The output locations (host array).
+   * @param uncompressed_bytes The decompressed sizes (host array, output).
+   */
+  std::future<void> submit_decompress(
+      SchedulePriority priority,
+      const void* const* compressed_ptrs,
+      const size_t* compressed_bytes,
+      const size_t* uncompressed_buffer_bytes,
+      size_t batch_size,
+      void* const* uncompressed_ptrs,
+      size_t* uncompressed_bytes);
+
+  /**
+   * \return The number of backend launches of a queue so far
+   */
+  size_t get_num_launches(SchedulePriority priority) const;
+};
+
+/**
+ * @brief Creates a scheduler over the batched C API for the format of format_opts.
+ *
+ * Each queue gets a backend from create_batched_compress_backend() on a stream the 
+ * scheduler owns: the latency queue launches on a stream of the greatest priority, 
+ * the throughput queue on a stream of the least priority.
+ */
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedLZ4Opts_t& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options = PrioritySchedulerOptions());
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedSnappyOpts_t& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options = PrioritySchedulerOptions());
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedCascadedOpts_t& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options = PrioritySchedulerOptions());
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedGdeflateOpts_t& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options = PrioritySchedulerOptions());
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedANSOpts_t& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options = PrioritySchedulerOptions());
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedBitcompFormatOpts& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options = PrioritySchedulerOptions());
+
+} // namespace hipcomp
@@ -0,0 +1,86 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "hipcompManager.hpp"
+
+namespace hipcomp {
+
+struct SegmentedFormatSpecHeader {
+  uint64_t segment_size;
+};
+
+/**
+ * @brief The number of internal streams of a SegmentedManager by default. The stream
+ * count is not part of the format, so create_manager() also uses it.
+ */
+constexpr size_t SEGMENTED_DEFAULT_NUM_STREAMS = 4;
+
+/**
+ * @brief Creates the manager that (de)compresses the segments issued on one stream
+ */
+using SegmentManagerFactory = std::function<std::shared_ptr<hipcompManagerBase>(hipStream_t stream)>;
+
+/**
+ * @brief Manager that pipelines very large buffers across several streams.
+ *
+ * The input is split into segments of segment_size bytes. Each segment is (de)compressed 
+ * by one of num_streams segment managers, each bound to its own internal stream, so 
+ * consecutive segments run concurrently. On compression, the segments are finalized in 
+ * order on the user stream: the segment table entry is written and the segment is copied 
+ * from its staging slot into comp_buffer while the following segments are still being 
+ * compressed. comp_buffer may be pinned host memory, in which case that copy streams the
+ * result to the host as segments complete.
+ *
+ * The container holds a table of segment offsets followed by one segment manager container
+ * per segment. All operations are ordered on the user stream like for any other manager. 
+ * decompress() synchronizes the user stream to read the segment table.
+ * The work of this manager cannot be captured into a graph.
+ */
+struct SegmentedManager : PimplManager {
+
+  /**
+   * @brief Construct a SegmentedManager
+   * 
+   * @param create_segment_manager Called once per internal stream to create the segment 
+   * managers. All of them must produce the same format.
+   * @param segment_size The number of uncompressed bytes per segment. Should be a multiple 
+   * of the segment managers' chunk size.
+   * @param num_streams The number of internal streams, and so of segments in flight.
+   * @param user_stream The stream all operations are ordered on.
+   * @param device_id The default device ID to use for all operations.
+   */
+  SegmentedManager(
+      const SegmentManagerFactory& create_segment_manager,
+      size_t segment_size = 1 << 26, 
+      size_t num_streams = SEGMENTED_DEFAULT_NUM_STREAMS,
+      hipStream_t user_stream = 0, 
+      const int device_id = 0);
+
+  ~SegmentedManager();
+};
+
+} // namespace hipcomp
@@ -0,0 +1,80 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "hipcompManager.hpp"
+
+namespace hipcomp {
+
+/**
+ * @brief Creates the manager that (de)compresses the shard handled by one device
+ */
+using ShardManagerFactory = std::function<std::shared_ptr<hipcompManagerBase>(hipStream_t stream, int device_id)>;
+
+/**
+ * @brief Manager that spreads the chunks of a buffer across several devices.
+ *
+ * Each shard device gets a contiguous range of chunks, its own stream and its own manager,
+ * which compresses the range into a container on that device. The shard containers are 
+ * then merged, in order on the user stream, into a single container with a unified chunk 
+ * table, so the result is a regular container of the shard managers' format that any 
+ * manager of that format can decompress. Decompression splits the chunk table the same way.
+ *
+ * The shard managers must be chunked (BatchManager based) managers of the same format and
+ * chunk size, such as LZ4Manager or SnappyManager. The input and output buffers must be 
+ * accessible from every shard device: pinned host memory, managed memory or memory on 
+ * a device with peer access. Peer access is enabled between the user device and the 
+ * shard devices when the manager is constructed. The same device may be listed more than 
+ * once to run several shards on it.
+ *
+ * The manager allocates its memory on each device, so it does not accept a user scratch 
+ * buffer. decompress() synchronizes the user stream to read the chunk table.
+ * The work of this manager cannot be captured into a graph.
+ */
+struct ShardedManager : PimplManager {
+
+  /**
+   * @brief Construct a ShardedManager
+   * 
+   * @param create_shard_manager Called once per shard device, with that device current, 
+   * to create the shard managers.
+   * @param uncomp_chunk_size The chunk size of the shard managers.
+   * @param shard_device_ids The devices to run shards on.
+   * @param user_stream The stream all operations are ordered on. 
+   * @param device_id The device of the user stream.
+   */
+  ShardedManager(
+      const ShardManagerFactory& create_shard_manager,
+      size_t uncomp_chunk_size,
+      const std::vector<int>& shard_device_ids,
+      hipStream_t user_stream = 0, 
+      const int device_id = 0);
+
+  ~ShardedManager();
+};
+
+} // namespace hipcomp
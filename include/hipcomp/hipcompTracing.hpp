@@ -0,0 +1,151 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hipcomp.h"
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace hipcomp {
+
+/**
+ * @brief An operation of the library, as passed to a TraceListener.
+ */
+struct TraceEvent {
+  /**
+   * What is done, e.g. "compress", "batch_decompress" or "batched_compress" for the
+   * hipcompBatched* functions.
+   */
+  const char* operation;
+  /**
+   * The format, e.g. "lz4" or "cascaded".
+   */
+  const char* codec;
+  /**
+   * The uncompressed bytes, or 0 when they are only known on the device, as for the
+   * decompression of the hipcompBatched* functions. Their compression only bounds the
+   * bytes, by the maximum chunk size times the number of chunks.
+   */
+  size_t bytes;
+  /**
+   * The number of chunks, or 0 if not known on the host.
+   */
+  size_t batch_size;
+  /**
+   * The stream the operation is enqueued on.
+   */
+  hipStream_t stream;
+  /**
+   * The uncompressed bytes of a chunk, or 0 if not known on the host or if the
+   * format has no chunks, as for the decompression of the hipcompBatched* functions.
+   */
+  size_t chunk_size;
+  /**
+   * The type of the compressed data, or HIPCOMP_TYPE_CHAR if the format has no such
+   * option or it is not known on the host.
+   */
+  hipcompType_t data_type;
+};
+
+/**
+ * @brief Receives the begin and end of each operation of the library.
+ *
+ * The calls are made on the thread of the operation, which enqueues work on the
+ * stream; the end does not wait for that work. Operations on several threads are
+ * traced concurrently, and operations nest, e.g. a manager's compress contains the
+ * batch compression. Listeners must not call the library.
+ */
+struct TraceListener {
+  virtual ~TraceListener() = default;
+
+  virtual void begin(const TraceEvent& event) = 0;
+
+  /**
+   * @brief Called with the event of the matching begin, also when the operation throws.
+   */
+  virtual void end(const TraceEvent& event) = 0;
+};
+
+/**
+ * @brief Sets the listener of all operations, or disables tracing with nullptr.
+ *
+ * Tracing is disabled by default, and then costs an atomic load per operation.
+ */
+void set_trace_listener(std::shared_ptr<TraceListener> listener);
+
+/**
+ * \return The listener, or nullptr if tracing is disabled
+ */
+std::shared_ptr<TraceListener> get_trace_listener();
+
+/**
+ * @brief Records operations in the Chrome trace event format, to view them in
+ * chrome://tracing or Perfetto next to other traces of the application.
+ */
+struct ChromeTraceWriter : TraceListener {
+private:
+  struct ChromeTraceWriterImpl;
+  std::unique_ptr<ChromeTraceWriterImpl> impl;
+
+public:
+  ChromeTraceWriter();
+
+  ~ChromeTraceWriter();
+
+  ChromeTraceWriter(const ChromeTraceWriter&) = delete;
+  ChromeTraceWriter& operator=(const ChromeTraceWriter&) = delete;
+
+  void begin(const TraceEvent& event) override;
+
+  void end(const TraceEvent& event) override;
+
+  /**
+   * @brief Writes the events recorded so far as a JSON object with a traceEvents array.
+   */
+  void write(std::ostream& out) const;
+
+  /**
+   * @brief Writes the events recorded so far to a file. Throws if it cannot be written.
+   */
+  void write(const std::string& path) const;
+
+  /**
+   * \return The number of begin and end events recorded
+   */
+  size_t get_num_events() const;
+
+  void clear();
+};
+
+/**
+ * @brief A listener that pushes a roctx range at the begin of each operation and
+ * pops it at the end, so operations show by name in rocprof traces.
+ *
+ * Throws hipcompErrorNotSupported if the library was built without USE_ROCTX.
+ */
+std::shared_ptr<TraceListener> create_roctx_trace_listener();
+
+} // namespace hipcomp
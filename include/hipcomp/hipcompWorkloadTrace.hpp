@@ -0,0 +1,128 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hipcomp.h"
+#include "hipcomp/hipcompTracing.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hipcomp {
+
+/**
+ * @brief A call of an application to the library, as recorded by a WorkloadRecorder.
+ *
+ * The fields are those of the TraceEvent of the call, see hipcompTracing.hpp.
+ */
+struct WorkloadCall {
+  std::string operation;
+  std::string codec;
+  uint64_t bytes;
+  uint64_t batch_size;
+  uint64_t chunk_size;
+  hipcompType_t data_type;
+  /**
+   * The begin of the call since the recorder was created, in nanoseconds
+   */
+  uint64_t start_ns;
+  /**
+   * The host time of the call, which for asynchronous calls excludes the kernels
+   */
+  uint64_t duration_ns;
+  /**
+   * The threads and the streams, numbered in the order they were first seen
+   */
+  uint32_t thread;
+  uint32_t stream;
+};
+
+/**
+ * @brief Records the calls of an application to the library, to replay the same
+ * sequence of formats, sizes and batch shapes on synthetic data, for example with
+ * benchmarks/replay_workload.
+ *
+ * Only the outermost operation of each thread is recorded, e.g. the compress of a
+ * manager but not the batch compression it contains. Calls are ordered by their begin.
+ */
+struct WorkloadRecorder : TraceListener {
+private:
+  struct WorkloadRecorderImpl;
+  std::unique_ptr<WorkloadRecorderImpl> impl;
+
+public:
+  WorkloadRecorder();
+
+  ~WorkloadRecorder();
+
+  WorkloadRecorder(const WorkloadRecorder&) = delete;
+  WorkloadRecorder& operator=(const WorkloadRecorder&) = delete;
+
+  void begin(const TraceEvent& event) override;
+
+  void end(const TraceEvent& event) override;
+
+  /**
+   * \return The calls that ended so far
+   */
+  std::vector<WorkloadCall> get_calls() const;
+
+  /**
+   * @brief Writes the calls that ended so far, see write_workload().
+   */
+  void write(std::ostream& out) const;
+
+  /**
+   * @brief Writes the calls that ended so far to a file. Throws if it cannot be written.
+   */
+  void write(const std::string& path) const;
+
+  void clear();
+};
+
+/**
+ * @brief Writes calls in a compact binary format: a header, the operation and codec
+ * names once, then a few variable length integers per call.
+ */
+void write_workload(std::ostream& out, const std::vector<WorkloadCall>& calls);
+
+/**
+ * @brief Reads calls written by write_workload().
+ *
+ * Throws hipcompErrorInvalidValue if the input is not a workload or is truncated.
+ */
+std::vector<WorkloadCall> read_workload(std::istream& in);
+
+/**
+ * @brief Reads the calls of a file written by write_workload().
+ *
+ * Throws hipcompErrorInvalidValue if it cannot be opened or read.
+ */
+std::vector<WorkloadCall> read_workload(const std::string& path);
+
+} // namespace hipcomp
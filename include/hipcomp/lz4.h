@@ -146,6 +146,8 @@ hipcompStatus_t hipcompBatchedLZ4CompressGetMaxOutputChunkSize(
  * @param batch_size The number of chunks to compress.
  * @param device_temp_ptr The temporary GPU workspace.
  * @param temp_bytes The size of the temporary GPU workspace.
+ * Large batches start from their largest chunks when temp_bytes is at least
+ * the size from hipcompBatchedLZ4CompressGetTempSize.
  * @param device_compressed_ptrs The pointers on the GPU, to the output location for
  * each compressed batch item (output). This pointer must be GPU accessible.
  * @param device_compressed_bytes The compressed size of each chunk on the GPU
@@ -167,6 +169,31 @@ hipcompStatus_t hipcompBatchedLZ4CompressAsync(
     hipcompBatchedLZ4Opts_t format_opts,
     hipStream_t stream);
 
+/**
+ * @brief Perform compression like hipcompBatchedLZ4CompressAsync(), and also record
+ * statistics of each chunk.
+ *
+ * The parameters are those of hipcompBatchedLZ4CompressAsync(), plus:
+ * @param device_stats The statistics of each chunk on the GPU (output), with the
+ * sizes, the number of matches and the match and literal bytes filled in.
+ * This pointer must be GPU accessible. Can be nullptr, in which case this is the
+ * same as hipcompBatchedLZ4CompressAsync().
+ *
+ * @return hipcompSuccess if successfully launched, and an error code otherwise.
+ */
+hipcompStatus_t hipcompBatchedLZ4CompressWithStatsAsync(
+    const void* const* device_uncompressed_ptrs,
+    const size_t* device_uncompressed_bytes,
+    size_t max_uncompressed_chunk_bytes,
+    size_t batch_size,
+    void* device_temp_ptr,
+    size_t temp_bytes,
+    void* const* device_compressed_ptrs,
+    size_t* device_compressed_bytes,
+    hipcompBatchedLZ4Opts_t format_opts,
+    hipcompChunkStats_t* device_stats,
+    hipStream_t stream);
+
 /**
  * @brief Get the amount of temp space required on the GPU for decompression.
  *
@@ -198,6 +225,8 @@ hipcompStatus_t hipcompBatchedLZ4DecompressGetTempSize(
  * @param batch_size The number of chunks to decompress.
  * @param device_temp_ptr The temporary GPU space.
  * @param temp_bytes The size of the temporary GPU space.
+ * Large batches start from their largest chunks when temp_bytes is at least
+ * the size from hipcompBatchedLZ4DecompressGetTempSize.
  * @param device_uncompressed_ptrs The pointers on the GPU, to where to
  * uncompress each chunk (output).
  * @param device_statuses The status for each chunk of whether it was
@@ -66,6 +66,70 @@ typedef struct
 
 static const hipcompBatchedSnappyOpts_t hipcompBatchedSnappyDefaultOpts = {0};
 
+/**
+ * @brief Where the decompression of one chunk spent its time, as filled in by
+ * hipcompBatchedSnappyDecompressWithProfileAsync().
+ *
+ * Each chunk is decompressed by three warps: the prefetch warp loads the
+ * compressed bytes into shared memory, the decode warp turns them into batches of
+ * LZ77 symbols, and the process warp writes the symbols to the output. All times
+ * are in device clock cycles. The wait counts are the iterations of the loops in
+ * which a warp polls for another one.
+ *
+ * A chunk with many decode waits for the prefetcher is prefetch-bound (see
+ * PREFETCH_SECTORS in src/snappy/config.h), a chunk with many decode waits for the
+ * processor is process-bound, and one with many process waits is decode-bound.
+ */
+typedef struct
+{
+  /**
+   * @brief From the start to the end of the chunk.
+   */
+  uint64_t total_cycles;
+
+  /**
+   * @brief The time of each warp from its start to its end.
+   */
+  uint64_t prefetch_cycles;
+  uint64_t decode_cycles;
+  uint64_t process_cycles;
+
+  /**
+   * @brief The time of the decode warp in each decoding strategy: the parallel
+   * decoding of 2 to 3 byte symbols, of 2 to 5 byte symbols, and the single
+   * thread decoding of the remaining symbols.
+   */
+  uint64_t decode_2_to_3_byte_cycles;
+  uint64_t decode_2_to_5_byte_cycles;
+  uint64_t decode_single_thread_cycles;
+
+  /**
+   * @brief The number of batches of symbols passed from the decode warp to the
+   * process warp.
+   */
+  uint64_t num_batches;
+
+  /**
+   * @brief Waits of the prefetch warp for free space in the prefetch buffer.
+   */
+  uint64_t prefetch_waits;
+
+  /**
+   * @brief Waits of the decode warp for prefetched bytes.
+   */
+  uint64_t decode_prefetch_waits;
+
+  /**
+   * @brief Waits of the decode warp for the process warp to free a batch.
+   */
+  uint64_t decode_process_waits;
+
+  /**
+   * @brief Waits of the process warp for a batch of symbols.
+   */
+  uint64_t process_waits;
+} hipcompSnappyDecompressProfile_t;
+
 /**
  * @brief Get the amount of temp space required on the GPU for decompression.
  *
@@ -108,6 +172,8 @@ hipcompStatus_t hipcompBatchedSnappyGetDecompressSizeAsync(
  * @param batch_size The number of chunks in the batch.
  * @param device_temp_ptr The temporary GPU space, could be NULL in case temprorary space is not needed.
  * @param temp_bytes The size of the temporary GPU space.
+ * Large batches start from their largest chunks when temp_bytes is at least
+ * the size from hipcompBatchedSnappyDecompressGetTempSize.
  * @param device_uncompressed_ptr The pointers on the GPU, to where to uncompress each chunk (output).
  * @param device_statuses The pointers on the GPU, to where to uncompress each chunk (output).
  * Can be nullptr if desired, in which case error status is not reported.
@@ -127,6 +193,33 @@ hipcompStatus_t hipcompBatchedSnappyDecompressAsync(
     hipcompStatus_t* device_statuses,
     hipStream_t stream);
 
+/**
+ * @brief Perform decompression like hipcompBatchedSnappyDecompressAsync(), and also
+ * profile the stages of the decompression of each chunk.
+ *
+ * The parameters are those of hipcompBatchedSnappyDecompressAsync(), plus:
+ * @param device_profiles The profile of each chunk on the GPU (output).
+ * This pointer must be GPU accessible. Can be nullptr, in which case this is the
+ * same as hipcompBatchedSnappyDecompressAsync(). Otherwise, a kernel with cycle
+ * counters is run, which is slower than the one without.
+ *
+ * @return hipcompSuccess if successfully launched, hipcompErrorNotSupported if
+ * the library was built with LOG_CYCLECOUNT=0 and device_profiles is not nullptr,
+ * and an error code otherwise.
+ */
+hipcompStatus_t hipcompBatchedSnappyDecompressWithProfileAsync(
+    const void* const* device_compresed_ptrs,
+    const size_t* device_compressed_bytes,
+    const size_t* device_uncompressed_bytes,
+    size_t* device_actual_uncompressed_bytes,
+    size_t batch_size,
+    void* const device_temp_ptr,
+    const size_t temp_bytes,
+    void* const* device_uncompressed_ptr,
+    hipcompStatus_t* device_statuses,
+    hipcompSnappyDecompressProfile_t* device_profiles,
+    hipStream_t stream);
+
 /**
  * @brief Get temporary space required for compression.
  *
@@ -173,6 +266,8 @@ hipcompStatus_t hipcompBatchedSnappyCompressGetMaxOutputChunkSize(
  * @param batch_size The number of chunks in the batch.
  * @param device_temp_ptr The temporary GPU workspace, could be NULL in case temprorary space is not needed.
  * @param temp_bytes The size of the temporary GPU workspace.
+ * Large batches start from their largest chunks when temp_bytes is at least
+ * the size from hipcompBatchedSnappyCompressGetTempSize.
  * @param device_compressed_ptr The pointers on the GPU, to the output location for each compressed batch item (output).
  * @param device_compressed_bytes The compressed size of each chunk on the GPU (output).
  * @param format_ops Snappy compression options.
@@ -192,6 +287,31 @@ hipcompStatus_t hipcompBatchedSnappyCompressAsync(
     hipcompBatchedSnappyOpts_t format_ops,
     hipStream_t stream);
 
+/**
+ * @brief Perform compression like hipcompBatchedSnappyCompressAsync(), and also record
+ * statistics of each chunk.
+ *
+ * The parameters are those of hipcompBatchedSnappyCompressAsync(), plus:
+ * @param device_stats The statistics of each chunk on the GPU (output), with the
+ * sizes, the number of matches and the match and literal bytes filled in.
+ * This pointer must be GPU accessible. Can be nullptr, in which case this is the
+ * same as hipcompBatchedSnappyCompressAsync().
+ *
+ * @return hipcompSuccess if successfully launched, and an error code otherwise.
+ */
+hipcompStatus_t hipcompBatchedSnappyCompressWithStatsAsync(
+    const void* const* device_uncompressed_ptr,
+    const size_t* device_uncompressed_bytes,
+    size_t max_uncompressed_chunk_bytes,
+    size_t batch_size,
+    void* device_temp_ptr,
+    size_t temp_bytes,
+    void* const* device_compressed_ptr,
+    size_t* device_compressed_bytes,
+    hipcompBatchedSnappyOpts_t format_ops,
+    hipcompChunkStats_t* device_stats,
+    hipStream_t stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -77,6 +77,15 @@ public:
 
   static void check_last_error(const std::string& msg = "");
 
+  /**
+   * @brief Check whether work issued on a stream is being captured into a graph.
+   *
+   * @param stream The stream.
+   *
+   * @return True if the stream is capturing.
+   */
+  static bool is_capturing(hipStream_t stream);
+
   /**
    * @brief Perform checked asynchronous memcpy.
    *
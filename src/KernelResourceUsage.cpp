@@ -0,0 +1,86 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "KernelResourceUsage.h"
+
+#include "HipUtils.h"
+#include "common.h"
+
+namespace hipcomp {
+
+namespace {
+
+int get_device_attribute(const hipDeviceAttribute_t attribute, const int device_id)
+{
+  int value = 0;
+  HipUtils::check(hipDeviceGetAttribute(&value, attribute, device_id), "hipDeviceGetAttribute");
+  return value;
+}
+
+} // namespace
+
+KernelResourceUsage get_kernel_resource_usage(
+    const char* kernel_name,
+    const void* kernel,
+    const int device_id,
+    const uint32_t block_size,
+    const size_t dynamic_lds_bytes)
+{
+  hipFuncAttributes attributes;
+  HipUtils::check(hipFuncGetAttributes(&attributes, kernel), "hipFuncGetAttributes");
+  int ctas_per_cu = 0;
+  HipUtils::check(
+      hipOccupancyMaxActiveBlocksPerMultiprocessor(&ctas_per_cu, kernel, block_size, dynamic_lds_bytes),
+      "hipOccupancyMaxActiveBlocksPerMultiprocessor");
+  const int max_threads_per_cu 
+      = get_device_attribute(hipDeviceAttributeMaxThreadsPerMultiProcessor, device_id);
+
+  KernelResourceUsage usage = get_kernel_resource_usage(kernel_name, device_id, 0);
+  usage.block_size = block_size;
+  usage.registers_per_thread = attributes.numRegs;
+  usage.static_lds_bytes = attributes.sharedSizeBytes;
+  usage.dynamic_lds_bytes = dynamic_lds_bytes;
+  usage.ctas_per_cu = ctas_per_cu;
+  usage.grid_size = usage.num_cus * usage.ctas_per_cu;
+  if (max_threads_per_cu > 0) {
+    usage.occupancy = static_cast<double>(ctas_per_cu) * block_size / max_threads_per_cu;
+  }
+  return usage;
+}
+
+KernelResourceUsage get_kernel_resource_usage(
+    const char* kernel_name,
+    const int device_id,
+    const uint32_t grid_size)
+{
+  KernelResourceUsage usage{};
+  usage.kernel = kernel_name;
+  usage.device_id = device_id;
+  usage.num_cus = get_device_attribute(hipDeviceAttributeMultiprocessorCount, device_id);
+  usage.grid_size = grid_size;
+  if (usage.num_cus > 0) {
+    usage.ctas_per_cu = roundUpDiv(grid_size, usage.num_cus);
+  }
+  return usage;
+}
+
+} // namespace hipcomp
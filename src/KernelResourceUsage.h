@@ -0,0 +1,70 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hipcomp/hipcompManager.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hipcomp {
+
+/**
+ * @brief Queries the attributes and occupancy of a kernel launched with a persistent 
+ * grid of as many CTAs as fit on the device, as the HLIF kernels are.
+ *
+ * @param kernel_name Format and direction, e.g. "lz4_compress".
+ * @param kernel The kernel function.
+ * @param device_id The device the kernel runs on, which must be current.
+ * @param block_size Threads per CTA.
+ * @param dynamic_lds_bytes LDS requested at launch, per CTA.
+ */
+KernelResourceUsage get_kernel_resource_usage(
+    const char* kernel_name,
+    const void* kernel,
+    int device_id,
+    uint32_t block_size,
+    size_t dynamic_lds_bytes);
+
+template <typename KERNEL>
+KernelResourceUsage get_kernel_resource_usage(
+    const char* kernel_name,
+    KERNEL* kernel,
+    const int device_id,
+    const uint32_t block_size,
+    const size_t dynamic_lds_bytes)
+{
+  return get_kernel_resource_usage(
+      kernel_name, reinterpret_cast<const void*>(kernel), device_id, block_size, dynamic_lds_bytes);
+}
+
+/**
+ * @brief The usage of a kernel of an external library, of which only the number of 
+ * CTAs it launches is known
+ */
+KernelResourceUsage get_kernel_resource_usage(
+    const char* kernel_name,
+    int device_id,
+    uint32_t grid_size);
+
+} // namespace hipcomp
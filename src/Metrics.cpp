@@ -0,0 +1,519 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Metrics.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+namespace hipcomp {
+
+namespace metrics {
+
+std::atomic<bool> enabled(false);
+
+} // namespace metrics
+
+namespace {
+
+// Values below 2^SUB_BUCKET_BITS have a bucket each; each larger power of two is
+// split into HALF_BUCKET_COUNT buckets
+constexpr int SUB_BUCKET_BITS = 7;
+constexpr uint64_t SUB_BUCKET_COUNT = uint64_t(1) << SUB_BUCKET_BITS;
+constexpr uint64_t HALF_BUCKET_COUNT = SUB_BUCKET_COUNT / 2;
+// The most significant bit of the largest latency with its own bucket, about 36 minutes
+constexpr int MAX_MAGNITUDE = 40;
+constexpr size_t NUM_BUCKETS
+    = SUB_BUCKET_COUNT + (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * HALF_BUCKET_COUNT;
+
+size_t get_bucket_index(const uint64_t value_ns)
+{
+  if (value_ns < SUB_BUCKET_COUNT) {
+    return static_cast<size_t>(value_ns);
+  }
+  int magnitude = SUB_BUCKET_BITS;
+  while (magnitude < 63 && (value_ns >> (magnitude + 1)) != 0) {
+    ++magnitude;
+  }
+  if (magnitude > MAX_MAGNITUDE) {
+    return NUM_BUCKETS - 1;
+  }
+  const int shift = magnitude - SUB_BUCKET_BITS + 1;
+  return SUB_BUCKET_COUNT + (magnitude - SUB_BUCKET_BITS) * HALF_BUCKET_COUNT
+         + ((value_ns >> shift) - HALF_BUCKET_COUNT);
+}
+
+using OperationKey = std::pair<const char*, const char*>;
+
+struct OperationKeyLess {
+  bool operator()(const OperationKey& lhs, const OperationKey& rhs) const
+  {
+    const std::less<const char*> less;
+    if (lhs.first != rhs.first) {
+      return less(lhs.first, rhs.first);
+    }
+    return less(lhs.second, rhs.second);
+  }
+};
+
+/**
+ * @brief The metrics of one operation, updated without locks except for errors
+ */
+struct OperationEntry {
+  const char* codec;
+  const char* operation;
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> bytes_in;
+  std::atomic<uint64_t> bytes_out;
+  std::atomic<uint64_t> sum_ns;
+  std::atomic<uint64_t> min_ns;
+  std::atomic<uint64_t> max_ns;
+  std::array<std::atomic<uint64_t>, NUM_BUCKETS> counts;
+  std::mutex errors_mutex;
+  std::map<hipcompStatus_t, uint64_t> errors;
+
+  OperationEntry(const char* codec, const char* operation) :
+      codec(codec),
+      operation(operation),
+      errors_mutex(),
+      errors()
+  {
+    reset();
+  }
+
+  void reset()
+  {
+    calls = 0;
+    bytes_in = 0;
+    bytes_out = 0;
+    sum_ns = 0;
+    min_ns = std::numeric_limits<uint64_t>::max();
+    max_ns = 0;
+    for (std::atomic<uint64_t>& count : counts) {
+      count = 0;
+    }
+    std::lock_guard<std::mutex> lock(errors_mutex);
+    errors.clear();
+  }
+
+  void record_latency(const uint64_t latency_ns)
+  {
+    counts[get_bucket_index(latency_ns)].fetch_add(1, std::memory_order_relaxed);
+    sum_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+
+    uint64_t min = min_ns.load(std::memory_order_relaxed);
+    while (latency_ns < min
+           && !min_ns.compare_exchange_weak(min, latency_ns, std::memory_order_relaxed)) {
+    }
+    uint64_t max = max_ns.load(std::memory_order_relaxed);
+    while (latency_ns > max
+           && !max_ns.compare_exchange_weak(max, latency_ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   * @brief Adds the metrics to those of the same operation in metrics
+   */
+  void add_to(OperationMetrics& metrics)
+  {
+    metrics.calls += calls.load(std::memory_order_relaxed);
+    metrics.bytes_in += bytes_in.load(std::memory_order_relaxed);
+    metrics.bytes_out += bytes_out.load(std::memory_order_relaxed);
+
+    LatencyHistogram& latency = metrics.latency;
+    latency.counts.resize(NUM_BUCKETS, 0);
+    uint64_t count = 0;
+    for (size_t ix = 0; ix < NUM_BUCKETS; ++ix) {
+      const uint64_t bucket_count = counts[ix].load(std::memory_order_relaxed);
+      latency.counts[ix] += bucket_count;
+      count += bucket_count;
+    }
+    if (count > 0) {
+      const uint64_t min = min_ns.load(std::memory_order_relaxed);
+      const uint64_t max = max_ns.load(std::memory_order_relaxed);
+      latency.min_ns = latency.count > 0 ? std::min(latency.min_ns, min) : min;
+      latency.max_ns = std::max(latency.max_ns, max);
+      latency.count += count;
+      latency.sum_ns += sum_ns.load(std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(errors_mutex);
+    for (const auto& error : errors) {
+      metrics.errors[error.first] += error.second;
+    }
+  }
+};
+
+struct EventEntry {
+  const char* name;
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> bytes;
+
+  explicit EventEntry(const char* name) :
+      name(name),
+      count(0),
+      bytes(0)
+  {
+  }
+};
+
+/**
+ * @brief The entries of the operations and events seen so far, keyed by the
+ * addresses of their names.
+ *
+ * Entries are never removed, so threads cache them without holding the lock. The
+ * same name at different addresses has several entries, which snapshots merge.
+ */
+struct Registry {
+  std::mutex mutex;
+  std::map<OperationKey, std::unique_ptr<OperationEntry>, OperationKeyLess> operations;
+  std::map<const char*, std::unique_ptr<EventEntry>, std::less<const char*>> events;
+
+  OperationEntry& get_operation(const char* codec, const char* operation)
+  {
+    thread_local std::map<OperationKey, OperationEntry*, OperationKeyLess> cache;
+
+    const OperationKey key(codec, operation);
+    auto cached = cache.find(key);
+    if (cached != cache.end()) {
+      return *cached->second;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<OperationEntry>& entry = operations[key];
+    if (!entry) {
+      entry.reset(new OperationEntry(codec, operation));
+    }
+    cache.emplace(key, entry.get());
+    return *entry;
+  }
+
+  EventEntry& get_event(const char* name)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<EventEntry>& entry = events[name];
+    if (!entry) {
+      entry.reset(new EventEntry(name));
+    }
+    return *entry;
+  }
+};
+
+Registry& get_registry()
+{
+  static Registry registry;
+  return registry;
+}
+
+bool is_decompression(const char* operation)
+{
+  return std::strstr(operation, "decompress") != nullptr;
+}
+
+const char* get_status_name(const hipcompStatus_t status)
+{
+  switch (status) {
+  case hipcompSuccess:
+    return "hipcompSuccess";
+  case hipcompErrorInvalidValue:
+    return "hipcompErrorInvalidValue";
+  case hipcompErrorNotSupported:
+    return "hipcompErrorNotSupported";
+  case hipcompErrorCannotDecompress:
+    return "hipcompErrorCannotDecompress";
+  case hipcompErrorCudaError:
+    return "hipcompErrorCudaError";
+  case hipcompErrorInternal:
+    return "hipcompErrorInternal";
+  }
+  return nullptr;
+}
+
+void write_label_value(std::ostream& out, const std::string& value)
+{
+  out << '"';
+  for (const char c : value) {
+    if (c == '\\' || c == '"') {
+      out << '\\' << c;
+    } else if (c == '\n') {
+      out << "\\n";
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+void write_operation_labels(std::ostream& out, const OperationMetrics& metrics)
+{
+  out << "codec=";
+  write_label_value(out, metrics.codec);
+  out << ",operation=";
+  write_label_value(out, metrics.operation);
+}
+
+/**
+ * @brief Writes a number independent of the formatting flags of out
+ */
+void write_double(std::ostream& out, const double value)
+{
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+  out << buffer;
+}
+
+void write_seconds(std::ostream& out, const double ns)
+{
+  write_double(out, ns * 1e-9);
+}
+
+void write_header(std::ostream& out, const char* name, const char* type, const char* help)
+{
+  out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+}
+
+void write_operation_counter(
+    std::ostream& out,
+    const std::vector<OperationMetrics>& operations,
+    const char* name,
+    const char* help,
+    uint64_t OperationMetrics::*counter)
+{
+  write_header(out, name, "counter", help);
+  for (const OperationMetrics& metrics : operations) {
+    out << name << '{';
+    write_operation_labels(out, metrics);
+    out << "} " << metrics.*counter << '\n';
+  }
+}
+
+} // namespace
+
+uint64_t LatencyHistogram::get_bucket_upper_bound_ns(const size_t ix_bucket)
+{
+  if (ix_bucket < SUB_BUCKET_COUNT) {
+    return ix_bucket;
+  }
+  const size_t magnitude = (ix_bucket - SUB_BUCKET_COUNT) / HALF_BUCKET_COUNT + SUB_BUCKET_BITS;
+  const uint64_t sub_bucket = (ix_bucket - SUB_BUCKET_COUNT) % HALF_BUCKET_COUNT + HALF_BUCKET_COUNT;
+  const size_t shift = magnitude - SUB_BUCKET_BITS + 1;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+uint64_t LatencyHistogram::get_quantile_ns(const double quantile) const
+{
+  if (count == 0) {
+    return 0;
+  }
+  const double clamped = std::min(std::max(quantile, 0.0), 1.0);
+  if (clamped == 0.0) {
+    return min_ns;
+  }
+  const uint64_t rank = std::max<uint64_t>(
+      static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(count))), 1);
+
+  uint64_t seen = 0;
+  for (size_t ix = 0; ix < counts.size(); ++ix) {
+    seen += counts[ix];
+    if (seen >= rank) {
+      return std::min(std::max(get_bucket_upper_bound_ns(ix), min_ns), max_ns);
+    }
+  }
+  return max_ns;
+}
+
+double LatencyHistogram::get_mean_ns() const
+{
+  return count > 0 ? static_cast<double>(sum_ns) / static_cast<double>(count) : 0.0;
+}
+
+void MetricsSnapshot::write_prometheus(std::ostream& out) const
+{
+  write_operation_counter(
+      out, operations, "hipcomp_operation_calls_total",
+      "Calls of an operation of the library.", &OperationMetrics::calls);
+  write_operation_counter(
+      out, operations, "hipcomp_operation_bytes_in_total",
+      "Bytes passed to an operation.", &OperationMetrics::bytes_in);
+  write_operation_counter(
+      out, operations, "hipcomp_operation_bytes_out_total",
+      "Bytes produced by an operation.", &OperationMetrics::bytes_out);
+
+  write_header(
+      out, "hipcomp_operation_errors_total", "counter", "Calls of an operation that failed.");
+  for (const OperationMetrics& metrics : operations) {
+    for (const auto& error : metrics.errors) {
+      out << "hipcomp_operation_errors_total{";
+      write_operation_labels(out, metrics);
+      out << ",status=";
+      const char* status_name = get_status_name(error.first);
+      write_label_value(
+          out, status_name ? std::string(status_name) : std::to_string(error.first));
+      out << "} " << error.second << '\n';
+    }
+  }
+
+  const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+  write_header(
+      out, "hipcomp_operation_latency_seconds", "summary",
+      "Host time of the calls of an operation.");
+  for (const OperationMetrics& metrics : operations) {
+    for (const double quantile : quantiles) {
+      out << "hipcomp_operation_latency_seconds{";
+      write_operation_labels(out, metrics);
+      out << ",quantile=\"";
+      write_double(out, quantile);
+      out << "\"} ";
+      write_seconds(out, static_cast<double>(metrics.latency.get_quantile_ns(quantile)));
+      out << '\n';
+    }
+    out << "hipcomp_operation_latency_seconds_sum{";
+    write_operation_labels(out, metrics);
+    out << "} ";
+    write_seconds(out, static_cast<double>(metrics.latency.sum_ns));
+    out << "\nhipcomp_operation_latency_seconds_count{";
+    write_operation_labels(out, metrics);
+    out << "} " << metrics.latency.count << '\n';
+  }
+
+  write_header(out, "hipcomp_events_total", "counter", "Internal events of the library.");
+  for (const EventMetrics& event : events) {
+    out << "hipcomp_events_total{event=";
+    write_label_value(out, event.name);
+    out << "} " << event.count << '\n';
+  }
+  write_header(
+      out, "hipcomp_event_bytes_total", "counter", "Bytes allocated or freed by internal events.");
+  for (const EventMetrics& event : events) {
+    out << "hipcomp_event_bytes_total{event=";
+    write_label_value(out, event.name);
+    out << "} " << event.bytes << '\n';
+  }
+}
+
+std::string MetricsSnapshot::to_prometheus() const
+{
+  std::ostringstream out;
+  write_prometheus(out);
+  return out.str();
+}
+
+void set_metrics_enabled(const bool enabled)
+{
+  metrics::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool get_metrics_enabled()
+{
+  return metrics::enabled.load(std::memory_order_relaxed);
+}
+
+MetricsSnapshot get_metrics_snapshot()
+{
+  Registry& registry = get_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  std::map<std::pair<std::string, std::string>, OperationMetrics> operations;
+  for (const auto& entry : registry.operations) {
+    // entries outlive resets since threads cache them, so skip the idle ones
+    if (entry.second->calls.load(std::memory_order_relaxed) == 0) {
+      continue;
+    }
+    OperationMetrics& metrics = operations[std::make_pair(
+        std::string(entry.second->codec), std::string(entry.second->operation))];
+    metrics.codec = entry.second->codec;
+    metrics.operation = entry.second->operation;
+    entry.second->add_to(metrics);
+  }
+
+  std::map<std::string, EventMetrics> events;
+  for (const auto& entry : registry.events) {
+    if (entry.second->count.load(std::memory_order_relaxed) == 0) {
+      continue;
+    }
+    EventMetrics& metrics = events[entry.second->name];
+    metrics.name = entry.second->name;
+    metrics.count += entry.second->count.load(std::memory_order_relaxed);
+    metrics.bytes += entry.second->bytes.load(std::memory_order_relaxed);
+  }
+
+  MetricsSnapshot snapshot;
+  for (auto& operation : operations) {
+    snapshot.operations.push_back(std::move(operation.second));
+  }
+  for (auto& event : events) {
+    snapshot.events.push_back(std::move(event.second));
+  }
+  return snapshot;
+}
+
+void reset_metrics()
+{
+  Registry& registry = get_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto& entry : registry.operations) {
+    entry.second->reset();
+  }
+  for (auto& entry : registry.events) {
+    entry.second->count = 0;
+    entry.second->bytes = 0;
+  }
+}
+
+namespace metrics {
+
+void record_operation(const TraceEvent& event, const uint64_t latency_ns, const hipcompStatus_t status)
+{
+  OperationEntry& entry = get_registry().get_operation(event.codec, event.operation);
+  entry.calls.fetch_add(1, std::memory_order_relaxed);
+  if (is_decompression(event.operation)) {
+    entry.bytes_out.fetch_add(event.bytes, std::memory_order_relaxed);
+  } else {
+    entry.bytes_in.fetch_add(event.bytes, std::memory_order_relaxed);
+  }
+  entry.record_latency(latency_ns);
+
+  if (status != hipcompSuccess) {
+    std::lock_guard<std::mutex> lock(entry.errors_mutex);
+    ++entry.errors[status];
+  }
+}
+
+void record_event(const char* name, const size_t bytes)
+{
+  EventEntry& entry = get_registry().get_event(name);
+  entry.count.fetch_add(1, std::memory_order_relaxed);
+  entry.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+} // namespace metrics
+
+} // namespace hipcomp
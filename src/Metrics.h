@@ -0,0 +1,58 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hipcomp/hipcompMetrics.hpp"
+#include "hipcomp/hipcompTracing.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hipcomp {
+
+namespace metrics {
+
+extern std::atomic<bool> enabled;
+
+/**
+ * @brief Records a call of an operation. The names of the event must be string
+ * literals, as they are kept by the registry.
+ */
+void record_operation(const TraceEvent& event, uint64_t latency_ns, hipcompStatus_t status);
+
+/**
+ * @brief Counts an internal event, named by a string literal.
+ */
+void record_event(const char* name, size_t bytes);
+
+inline void count_event(const char* name, const size_t bytes)
+{
+  if (enabled.load(std::memory_order_relaxed)) {
+    record_event(name, bytes);
+  }
+}
+
+} // namespace metrics
+
+} // namespace hipcomp
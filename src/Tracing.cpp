@@ -0,0 +1,250 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Tracing.h"
+
+#include "hipcomp.hpp"
+
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#ifdef HIPCOMP_USE_ROCTX
+#include <roctracer/roctx.h>
+#endif
+
+namespace hipcomp {
+
+namespace tracing {
+
+std::atomic<bool> enabled(false);
+
+} // namespace tracing
+
+namespace {
+
+std::mutex listener_mutex;
+std::shared_ptr<TraceListener> listener;
+
+/**
+ * @brief A small id of the calling thread, for trace viewers to show one row per thread
+ */
+uint64_t current_thread_index()
+{
+  static std::atomic<uint64_t> next_index(0);
+  thread_local const uint64_t index = next_index++;
+  return index;
+}
+
+void write_json_string(std::ostream& out, const std::string& str)
+{
+  out << '"';
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << ' ';
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+#ifdef HIPCOMP_USE_ROCTX
+struct RoctxTraceListener : TraceListener {
+  void begin(const TraceEvent& event) override
+  {
+    const std::string name = std::string("hipcomp ") + event.codec + " " + event.operation;
+    roctxRangePushA(name.c_str());
+  }
+
+  void end(const TraceEvent& /*event*/) override
+  {
+    roctxRangePop();
+  }
+};
+#endif
+
+} // namespace
+
+void set_trace_listener(std::shared_ptr<TraceListener> new_listener)
+{
+  std::lock_guard<std::mutex> lock(listener_mutex);
+  listener = std::move(new_listener);
+  tracing::enabled.store(listener != nullptr, std::memory_order_relaxed);
+}
+
+std::shared_ptr<TraceListener> get_trace_listener()
+{
+  std::lock_guard<std::mutex> lock(listener_mutex);
+  return listener;
+}
+
+void TraceScope::begin()
+{
+  m_listener = get_trace_listener();
+  if (m_listener) {
+    m_listener->begin(m_event);
+  }
+}
+
+void TraceScope::end() noexcept
+{
+  try {
+    m_listener->end(m_event);
+  } catch (...) {
+    // The operation may itself be unwinding, so a failing listener cannot throw
+  }
+}
+
+void TraceScope::record() noexcept
+{
+  const auto latency = std::chrono::steady_clock::now() - m_start;
+  hipcompStatus_t status = m_status;
+  if (status == hipcompSuccess && std::uncaught_exception()) {
+    status = hipcompErrorInternal;
+  }
+  try {
+    metrics::record_operation(
+        m_event,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count(),
+        status);
+  } catch (...) {
+    // As for end(), metrics must not fail the operation
+  }
+}
+
+struct ChromeTraceWriter::ChromeTraceWriterImpl {
+  struct Event {
+    char phase;
+    std::string name;
+    std::string codec;
+    double timestamp_us;
+    uint64_t thread;
+    size_t bytes;
+    size_t batch_size;
+    hipStream_t stream;
+  };
+
+  std::chrono::steady_clock::time_point start;
+  mutable std::mutex mutex;
+  std::vector<Event> events;
+
+  ChromeTraceWriterImpl() :
+      start(std::chrono::steady_clock::now()),
+      mutex(),
+      events()
+  {
+  }
+
+  void record(const char phase, const TraceEvent& event)
+  {
+    const double timestamp_us
+        = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    Event recorded{
+        phase,
+        std::string(event.codec) + " " + event.operation,
+        event.codec,
+        timestamp_us,
+        current_thread_index(),
+        event.bytes,
+        event.batch_size,
+        event.stream};
+
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back(std::move(recorded));
+  }
+};
+
+ChromeTraceWriter::ChromeTraceWriter() :
+    impl(new ChromeTraceWriterImpl())
+{
+}
+
+ChromeTraceWriter::~ChromeTraceWriter() = default;
+
+void ChromeTraceWriter::begin(const TraceEvent& event)
+{
+  impl->record('B', event);
+}
+
+void ChromeTraceWriter::end(const TraceEvent& event)
+{
+  impl->record('E', event);
+}
+
+void ChromeTraceWriter::write(std::ostream& out) const
+{
+  std::lock_guard<std::mutex> lock(impl->mutex);
+  out << "{\"traceEvents\":[";
+  for (size_t ix = 0; ix < impl->events.size(); ++ix) {
+    const ChromeTraceWriterImpl::Event& event = impl->events[ix];
+    out << (ix ? ",\n" : "\n") << "{\"name\":";
+    write_json_string(out, event.name);
+    out << ",\"cat\":";
+    write_json_string(out, event.codec);
+    out << ",\"ph\":\"" << event.phase << "\",\"ts\":" << std::fixed << event.timestamp_us
+        << std::defaultfloat << ",\"pid\":0,\"tid\":" << event.thread;
+    if (event.phase == 'B') {
+      out << ",\"args\":{\"bytes\":" << event.bytes << ",\"batch_size\":" << event.batch_size
+          << ",\"stream\":\"" << static_cast<const void*>(event.stream) << "\"}";
+    }
+    out << "}";
+  }
+  out << "\n]}\n";
+}
+
+void ChromeTraceWriter::write(const std::string& path) const
+{
+  std::ofstream out(path);
+  write(out);
+  out.flush();
+  if (!out) {
+    throw HipCompException(hipcompErrorInvalidValue, "Cannot write the trace to " + path);
+  }
+}
+
+size_t ChromeTraceWriter::get_num_events() const
+{
+  std::lock_guard<std::mutex> lock(impl->mutex);
+  return impl->events.size();
+}
+
+void ChromeTraceWriter::clear()
+{
+  std::lock_guard<std::mutex> lock(impl->mutex);
+  impl->events.clear();
+}
+
+std::shared_ptr<TraceListener> create_roctx_trace_listener()
+{
+#ifdef HIPCOMP_USE_ROCTX
+  return std::make_shared<RoctxTraceListener>();
+#else
+  throw HipCompException(hipcompErrorNotSupported, "hipCOMP was built without roctx, see the USE_ROCTX option.");
+#endif
+}
+
+} // namespace hipcomp
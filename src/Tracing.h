@@ -0,0 +1,126 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "Metrics.h"
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompTracing.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace hipcomp {
+
+namespace tracing {
+
+extern std::atomic<bool> enabled;
+
+} // namespace tracing
+
+/**
+ * @brief Traces an operation from construction to destruction if a listener is set,
+ * and records it in the metrics registry if metrics are enabled.
+ *
+ * When neither is enabled, construction is two atomic loads and the rest is skipped.
+ */
+class TraceScope
+{
+public:
+  TraceScope(
+      const char* operation,
+      const char* codec,
+      const size_t bytes,
+      const size_t batch_size,
+      hipStream_t stream,
+      const size_t chunk_size = 0,
+      const hipcompType_t data_type = HIPCOMP_TYPE_CHAR) :
+      m_listener(),
+      m_event{operation, codec, bytes, batch_size, stream, chunk_size, data_type},
+      m_measured(false),
+      m_status(hipcompSuccess)
+  {
+    if (tracing::enabled.load(std::memory_order_relaxed)) {
+      begin();
+    }
+    if (metrics::enabled.load(std::memory_order_relaxed)) {
+      m_measured = true;
+      m_start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~TraceScope()
+  {
+    if (m_listener) {
+      end();
+    }
+    if (m_measured) {
+      record();
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  /**
+   * @brief Sets the status of a failed operation, for its metrics.
+   *
+   * An operation left by an exception whose status was not set, by this or run(),
+   * is recorded as hipcompErrorInternal.
+   *
+   * \return status
+   */
+  hipcompStatus_t set_status(const hipcompStatus_t status)
+  {
+    m_status = status;
+    return status;
+  }
+
+  /**
+   * @brief Calls `op`, setting the status of a HipCompException it throws before
+   * rethrowing it.
+   */
+  template <typename OP>
+  void run(OP&& op)
+  {
+    try {
+      op();
+    } catch (const HipCompException& e) {
+      m_status = e.get_error();
+      throw;
+    }
+  }
+
+private:
+  void begin();
+  void end() noexcept;
+  void record() noexcept;
+
+  std::shared_ptr<TraceListener> m_listener;
+  TraceEvent m_event;
+  bool m_measured;
+  hipcompStatus_t m_status;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace hipcomp
@@ -0,0 +1,331 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "hipcomp/hipcompWorkloadTrace.hpp"
+
+#include "hipcomp.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace hipcomp {
+
+namespace {
+
+/*
+ * The binary format, all integers unsigned LEB128 unless noted:
+ *   "HCWT", version
+ *   the number of names, then each name as its length and its bytes
+ *   the number of calls, then for each call: the name indices of its operation and
+ *   codec, bytes, batch_size, chunk_size, data_type, the begin since the begin of the
+ *   previous call (zigzag signed), duration_ns, thread and stream.
+ * A call of a manager with microseconds between calls takes about 17 bytes.
+ */
+const char workload_magic[4] = {'H', 'C', 'W', 'T'};
+const uint64_t workload_version = 1;
+const uint64_t max_name_length = 1 << 10;
+
+void write_varint(std::ostream& out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out.put(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.put(static_cast<char>(value));
+}
+
+uint64_t read_varint(std::istream& in)
+{
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    const int c = in.get();
+    if (c == std::char_traits<char>::eof()) {
+      throw HipCompException(hipcompErrorInvalidValue, "The workload is truncated.");
+    }
+    value |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      return value;
+    }
+  }
+  throw HipCompException(hipcompErrorInvalidValue, "The workload has an invalid integer.");
+}
+
+uint32_t read_index(std::istream& in)
+{
+  const uint64_t value = read_varint(in);
+  if (value > UINT32_MAX) {
+    throw HipCompException(hipcompErrorInvalidValue, "The workload has an invalid thread or stream.");
+  }
+  return static_cast<uint32_t>(value);
+}
+
+hipcompType_t read_type(std::istream& in)
+{
+  const uint64_t value = read_varint(in);
+  if (value > HIPCOMP_TYPE_ULONGLONG && value != HIPCOMP_TYPE_BITS) {
+    throw HipCompException(hipcompErrorInvalidValue, "The workload has an invalid data type.");
+  }
+  return static_cast<hipcompType_t>(value);
+}
+
+uint64_t zigzag(const int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(const uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void sort_by_start(std::vector<WorkloadCall>& calls)
+{
+  std::stable_sort(calls.begin(), calls.end(), [](const WorkloadCall& a, const WorkloadCall& b) {
+    return a.start_ns < b.start_ns;
+  });
+}
+
+} // namespace
+
+struct WorkloadRecorder::WorkloadRecorderImpl {
+  /**
+   * @brief The outermost operation a thread is in
+   */
+  struct OpenCall {
+    size_t depth;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  std::chrono::steady_clock::time_point origin;
+  mutable std::mutex mutex;
+  std::map<std::thread::id, OpenCall> open_calls;
+  std::map<std::thread::id, uint32_t> threads;
+  std::map<hipStream_t, uint32_t> streams;
+  std::vector<WorkloadCall> calls;
+
+  WorkloadRecorderImpl() :
+      origin(std::chrono::steady_clock::now()),
+      mutex(),
+      open_calls(),
+      threads(),
+      streams(),
+      calls()
+  {
+  }
+
+  template<typename Key>
+  static uint32_t get_index(std::map<Key, uint32_t>& indices, const Key& key)
+  {
+    return indices.emplace(key, static_cast<uint32_t>(indices.size())).first->second;
+  }
+};
+
+WorkloadRecorder::WorkloadRecorder() :
+    impl(new WorkloadRecorderImpl())
+{
+}
+
+WorkloadRecorder::~WorkloadRecorder() = default;
+
+void WorkloadRecorder::begin(const TraceEvent& /*event*/)
+{
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(impl->mutex);
+  WorkloadRecorderImpl::OpenCall& open = impl->open_calls[std::this_thread::get_id()];
+  if (open.depth++ == 0) {
+    open.start = now;
+  }
+}
+
+void WorkloadRecorder::end(const TraceEvent& event)
+{
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  const std::thread::id thread = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(impl->mutex);
+  const auto open = impl->open_calls.find(thread);
+  if (open == impl->open_calls.end()) {
+    // The recorder was set during the operation
+    return;
+  }
+  if (--open->second.depth > 0) {
+    return;
+  }
+
+  typedef std::chrono::nanoseconds ns;
+  WorkloadCall call;
+  call.operation = event.operation;
+  call.codec = event.codec;
+  call.bytes = event.bytes;
+  call.batch_size = event.batch_size;
+  call.chunk_size = event.chunk_size;
+  call.data_type = event.data_type;
+  call.start_ns = std::chrono::duration_cast<ns>(open->second.start - impl->origin).count();
+  call.duration_ns = std::chrono::duration_cast<ns>(now - open->second.start).count();
+  call.thread = WorkloadRecorderImpl::get_index(impl->threads, thread);
+  call.stream = WorkloadRecorderImpl::get_index(impl->streams, event.stream);
+  impl->open_calls.erase(open);
+  impl->calls.push_back(std::move(call));
+}
+
+std::vector<WorkloadCall> WorkloadRecorder::get_calls() const
+{
+  std::vector<WorkloadCall> calls;
+  {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    calls = impl->calls;
+  }
+  sort_by_start(calls);
+  return calls;
+}
+
+void WorkloadRecorder::write(std::ostream& out) const
+{
+  write_workload(out, get_calls());
+}
+
+void WorkloadRecorder::write(const std::string& path) const
+{
+  std::ofstream out(path, std::ios::binary);
+  write(out);
+  out.flush();
+  if (!out) {
+    throw HipCompException(hipcompErrorInvalidValue, "Cannot write the workload to " + path);
+  }
+}
+
+void WorkloadRecorder::clear()
+{
+  std::lock_guard<std::mutex> lock(impl->mutex);
+  impl->calls.clear();
+}
+
+void write_workload(std::ostream& out, const std::vector<WorkloadCall>& calls)
+{
+  std::vector<std::string> names;
+  std::map<std::string, uint64_t> name_indices;
+  auto get_name_index = [&](const std::string& name) {
+    const auto inserted = name_indices.emplace(name, names.size());
+    if (inserted.second) {
+      names.push_back(name);
+    }
+    return inserted.first->second;
+  };
+  std::vector<uint64_t> call_names;
+  for (const WorkloadCall& call : calls) {
+    call_names.push_back(get_name_index(call.operation));
+    call_names.push_back(get_name_index(call.codec));
+  }
+
+  out.write(workload_magic, sizeof(workload_magic));
+  write_varint(out, workload_version);
+  write_varint(out, names.size());
+  for (const std::string& name : names) {
+    write_varint(out, name.size());
+    out.write(name.data(), name.size());
+  }
+
+  write_varint(out, calls.size());
+  uint64_t previous_start_ns = 0;
+  for (size_t ix = 0; ix < calls.size(); ++ix) {
+    const WorkloadCall& call = calls[ix];
+    write_varint(out, call_names[2 * ix]);
+    write_varint(out, call_names[2 * ix + 1]);
+    write_varint(out, call.bytes);
+    write_varint(out, call.batch_size);
+    write_varint(out, call.chunk_size);
+    write_varint(out, static_cast<uint64_t>(call.data_type));
+    write_varint(out, zigzag(static_cast<int64_t>(call.start_ns - previous_start_ns)));
+    write_varint(out, call.duration_ns);
+    write_varint(out, call.thread);
+    write_varint(out, call.stream);
+    previous_start_ns = call.start_ns;
+  }
+}
+
+std::vector<WorkloadCall> read_workload(std::istream& in)
+{
+  char magic[sizeof(workload_magic)];
+  if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), workload_magic)) {
+    throw HipCompException(hipcompErrorInvalidValue, "The input is not a hipCOMP workload.");
+  }
+  const uint64_t version = read_varint(in);
+  if (version != workload_version) {
+    throw HipCompException(
+        hipcompErrorInvalidValue, "Unsupported workload version " + std::to_string(version) + ".");
+  }
+
+  std::vector<std::string> names;
+  const uint64_t num_names = read_varint(in);
+  for (uint64_t ix = 0; ix < num_names; ++ix) {
+    const uint64_t length = read_varint(in);
+    if (length > max_name_length) {
+      throw HipCompException(hipcompErrorInvalidValue, "The workload has an invalid name.");
+    }
+    std::string name(length, '\0');
+    if (!in.read(&name[0], length)) {
+      throw HipCompException(hipcompErrorInvalidValue, "The workload is truncated.");
+    }
+    names.push_back(std::move(name));
+  }
+  auto read_name = [&]() -> const std::string& {
+    const uint64_t ix = read_varint(in);
+    if (ix >= names.size()) {
+      throw HipCompException(hipcompErrorInvalidValue, "The workload has an invalid name.");
+    }
+    return names[ix];
+  };
+
+  std::vector<WorkloadCall> calls;
+  const uint64_t num_calls = read_varint(in);
+  uint64_t start_ns = 0;
+  for (uint64_t ix = 0; ix < num_calls; ++ix) {
+    WorkloadCall call;
+    call.operation = read_name();
+    call.codec = read_name();
+    call.bytes = read_varint(in);
+    call.batch_size = read_varint(in);
+    call.chunk_size = read_varint(in);
+    call.data_type = read_type(in);
+    start_ns += static_cast<uint64_t>(unzigzag(read_varint(in)));
+    call.start_ns = start_ns;
+    call.duration_ns = read_varint(in);
+    call.thread = read_index(in);
+    call.stream = read_index(in);
+    calls.push_back(std::move(call));
+  }
+  return calls;
+}
+
+std::vector<WorkloadCall> read_workload(const std::string& path)
+{
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw HipCompException(hipcompErrorInvalidValue, "Cannot open the workload " + path);
+  }
+  return read_workload(in);
+}
+
+} // namespace hipcomp
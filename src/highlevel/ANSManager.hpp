@@ -95,14 +95,16 @@ public:
     return max_comp_chunk_size;
   }
 
-  uint32_t compute_compression_max_block_occupancy() final override
+  KernelResourceUsage compute_compression_kernel_usage() final override
   {
-    return ans::hlif::getBatchedCompMaxBlockOccupancy(device_id);
+    return get_kernel_resource_usage(
+        "ans_compress", device_id, ans::hlif::getBatchedCompMaxBlockOccupancy(device_id));
   }
 
-  uint32_t compute_decompression_max_block_occupancy() final override
+  KernelResourceUsage compute_decompression_kernel_usage() final override
   {
-    return ans::hlif::getBatchedDecompMaxBlockOccupancy(device_id);
+    return get_kernel_resource_usage(
+        "ans_decompress", device_id, ans::hlif::getBatchedDecompMaxBlockOccupancy(device_id));
   }
 
   ANSFormatSpecHeader* get_format_header() final override
@@ -110,9 +112,14 @@ public:
     return format_spec;
   }
 
-  void do_batch_compress(const CompressArgs& compress_args) final override
+  const char* get_codec_name() const final override
   {
-    ans::hlif::batchCompress(compress_args, get_max_comp_ctas(), user_stream);
+    return "ans";
+  }
+
+  void do_batch_compress(const CompressArgs& compress_args, hipStream_t stream) final override
+  {
+    ans::hlif::batchCompress(compress_args, get_max_comp_ctas(), stream);
   }
 
   void do_batch_decompress(
@@ -121,18 +128,19 @@ public:
       const uint32_t num_chunks,
       const size_t* comp_chunk_offsets,
       const size_t* comp_chunk_sizes,
-      hipcompStatus_t* output_status) final override
+      hipcompStatus_t* output_status,
+      const ExecutionContext& context) final override
   {
     ans::hlif::batchDecompress(
         comp_data_buffer,
         decomp_buffer,
         get_uncomp_chunk_size(),
-        ix_chunk,
+        context.ix_chunk,
         num_chunks,
         comp_chunk_offsets,
         comp_chunk_sizes,
         get_max_decomp_ctas(),
-        user_stream,
+        context.stream,
         output_status);
   }
 
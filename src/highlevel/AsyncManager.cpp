@@ -0,0 +1,286 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompAsync.hpp"
+#include "hipcomp/hipcompHostThreadPool.hpp"
+#include "Check.h"
+#include "CommonHeaderKernels.h"
+#include "HipUtils.h"
+#include "PinnedPtrs.hpp"
+#include "hipcomp_common_deps/hlif_shared_types.hpp"
+
+namespace hipcomp {
+
+namespace {
+
+void check_callback(const bool callable)
+{
+  if (!callable) {
+    throw HipCompException(hipcompErrorInvalidValue, "The completion callback must not be empty.");
+  }
+}
+
+} // namespace
+
+struct AsyncManager::AsyncManagerImpl {
+  hipcompManagerBase& manager;
+  // Looked up here rather than in a host function, as building the pool makes HIP calls
+  HostThreadPool& thread_pool;
+  PinnedPtrPool<size_t> size_pool;
+  std::mutex mutex;
+  std::condition_variable all_done;
+  size_t num_in_flight;
+
+  /**
+   * @brief A call whose completion has not been reported yet. Owned by its host function.
+   */
+  struct PendingCompression {
+    AsyncManagerImpl* owner;
+    // Keeps the status alive even if the caller drops its config
+    CompressionConfig config;
+    PinnedPtrPool<size_t>::PinnedPtrHandle comp_size;
+    CompressionCallback callback;
+  };
+
+  struct PendingDecompression {
+    AsyncManagerImpl* owner;
+    DecompressionConfig config;
+    DecompressionCallback callback;
+  };
+
+  explicit AsyncManagerImpl(hipcompManagerBase& manager)
+    : manager(manager),
+      thread_pool(get_host_thread_pool()),
+      size_pool(),
+      mutex(),
+      all_done(),
+      num_in_flight(0)
+  {}
+
+  ~AsyncManagerImpl()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    all_done.wait(lock, [this]() { return num_in_flight == 0; });
+  }
+
+  void compress(
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config,
+      hipStream_t stream,
+      CompressionCallback callback)
+  {
+    check_not_capturing(stream);
+
+    std::unique_ptr<PendingCompression> pending(new PendingCompression{
+        this, comp_config, size_pool.allocate_handle(), std::move(callback)});
+    manager.compress(decomp_buffer, comp_buffer, comp_config, stream);
+    copyCompressedOutputSize(
+        reinterpret_cast<const CommonHeader*>(comp_buffer), pending->comp_size.get_ptr(), stream);
+
+    launch_completion(stream, &complete_compression, pending.get());
+    pending.release();
+  }
+
+  void decompress(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& decomp_config,
+      hipStream_t stream,
+      DecompressionCallback callback)
+  {
+    check_not_capturing(stream);
+
+    std::unique_ptr<PendingDecompression> pending(new PendingDecompression{
+        this, decomp_config, std::move(callback)});
+    manager.decompress(decomp_buffer, comp_buffer, decomp_config, stream);
+
+    launch_completion(stream, &complete_decompression, pending.get());
+    pending.release();
+  }
+
+  size_t get_num_in_flight()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return num_in_flight;
+  }
+
+private:
+  void check_not_capturing(hipStream_t stream)
+  {
+    // A captured host function would run, and free its call, on every replay
+    if (HipUtils::is_capturing(stream)) {
+      throw HipCompException(hipcompErrorNotSupported, "AsyncManager calls cannot be captured into a graph.");
+    }
+  }
+
+  void launch_completion(hipStream_t stream, hipHostFn_t fn, void* pending)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++num_in_flight;
+    }
+    const hipError_t err = hipLaunchHostFunc(stream, fn, pending);
+    if (err != hipSuccess) {
+      finish_call();
+      HipUtils::check(err, "hipLaunchHostFunc()");
+    }
+  }
+
+  void finish_call()
+  {
+    // Notified under the lock, as the destructor may free this object right after
+    std::lock_guard<std::mutex> lock(mutex);
+    --num_in_flight;
+    all_done.notify_all();
+  }
+
+  // Host functions are called by the HIP runtime and cannot make HIP calls, so 
+  // they hand the callback to the host thread pool, where it may. The pending call
+  // is only owned by the task that runs it.
+  static void complete_compression(void* data) noexcept
+  {
+    PendingCompression* pending = static_cast<PendingCompression*>(data);
+    pending->owner->hand_off([pending]() {
+      std::unique_ptr<PendingCompression> owned(pending);
+      AsyncManagerImpl* owner = owned->owner;
+
+      run_callback([&]() {
+        owned->callback(CompressionResult{*owned->config.get_status(), *owned->comp_size});
+      });
+      owned.reset();
+      owner->finish_call();
+    });
+  }
+
+  static void complete_decompression(void* data) noexcept
+  {
+    PendingDecompression* pending = static_cast<PendingDecompression*>(data);
+    pending->owner->hand_off([pending]() {
+      std::unique_ptr<PendingDecompression> owned(pending);
+      AsyncManagerImpl* owner = owned->owner;
+
+      run_callback([&]() {
+        owned->callback(DecompressionResult{*owned->config.get_status(), owned->config.decomp_data_size});
+      });
+      owned.reset();
+      owner->finish_call();
+    });
+  }
+
+  template <typename Callback>
+  static void run_callback(Callback&& callback) noexcept
+  {
+    // Callbacks must not throw, but the call still has to finish if one does
+    try {
+      callback();
+    } catch (const std::exception& e) {
+      Check::exception_to_error(e, "AsyncManager callback");
+    } catch (...) {
+      std::cerr << "ERROR: In AsyncManager callback: unknown exception" << std::endl;
+    }
+  }
+
+  void hand_off(const std::function<void()>& task) noexcept
+  {
+    try {
+      thread_pool.submit(task);
+      return;
+    } catch (...) {
+    }
+    // Only out of memory: a thread of its own still keeps the callback out of the host function
+    try {
+      std::thread(task).detach();
+    } catch (...) {
+      // The last resort, documented in hipcompAsync.hpp
+      task();
+    }
+  }
+};
+
+AsyncManager::AsyncManager(hipcompManagerBase& manager)
+  : impl(std::make_unique<AsyncManagerImpl>(manager))
+{}
+
+AsyncManager::~AsyncManager()
+{}
+
+void AsyncManager::compress(
+    const uint8_t* decomp_buffer, 
+    uint8_t* comp_buffer,
+    const CompressionConfig& comp_config,
+    hipStream_t stream,
+    CompressionCallback callback)
+{
+  check_callback(static_cast<bool>(callback));
+  impl->compress(decomp_buffer, comp_buffer, comp_config, stream, std::move(callback));
+}
+
+std::future<CompressionResult> AsyncManager::compress(
+    const uint8_t* decomp_buffer, 
+    uint8_t* comp_buffer,
+    const CompressionConfig& comp_config,
+    hipStream_t stream)
+{
+  auto promise = std::make_shared<std::promise<CompressionResult>>();
+  std::future<CompressionResult> result = promise->get_future();
+  impl->compress(decomp_buffer, comp_buffer, comp_config, stream, 
+      [promise](const CompressionResult& res) { promise->set_value(res); });
+  return result;
+}
+
+void AsyncManager::decompress(
+    uint8_t* decomp_buffer, 
+    const uint8_t* comp_buffer,
+    const DecompressionConfig& decomp_config,
+    hipStream_t stream,
+    DecompressionCallback callback)
+{
+  check_callback(static_cast<bool>(callback));
+  impl->decompress(decomp_buffer, comp_buffer, decomp_config, stream, std::move(callback));
+}
+
+std::future<DecompressionResult> AsyncManager::decompress(
+    uint8_t* decomp_buffer, 
+    const uint8_t* comp_buffer,
+    const DecompressionConfig& decomp_config,
+    hipStream_t stream)
+{
+  auto promise = std::make_shared<std::promise<DecompressionResult>>();
+  std::future<DecompressionResult> result = promise->get_future();
+  impl->decompress(decomp_buffer, comp_buffer, decomp_config, stream, 
+      [promise](const DecompressionResult& res) { promise->set_value(res); });
+  return result;
+}
+
+size_t AsyncManager::get_num_in_flight() const
+{
+  return impl->get_num_in_flight();
+}
+
+} // namespace hipcomp
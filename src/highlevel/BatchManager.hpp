@@ -49,6 +49,8 @@
 
 #pragma once
 
+#include "InPlaceDecompression.hpp"
+#include "KernelResourceUsage.h"
 #include "ManagerBase.hpp"
 #include "common.h"
 
@@ -72,30 +74,28 @@ template<typename FormatSpecHeader>
 struct BatchManager : ManagerBase<FormatSpecHeader> {
 
 protected: // members
-  uint32_t* ix_chunk;
   using ManagerBase<FormatSpecHeader>::user_stream;
 
 private: // members
   uint32_t max_comp_ctas;
   uint32_t max_decomp_ctas;
+  KernelResourceUsage comp_kernel_usage;
+  KernelResourceUsage decomp_kernel_usage;
   size_t max_comp_chunk_size;
   size_t uncomp_chunk_size;
 
 public: // API
   BatchManager(size_t uncomp_chunk_size, hipStream_t user_stream = 0, int device_id = 0)
     : ManagerBase<FormatSpecHeader>(user_stream, device_id),
-      ix_chunk(0),
       max_comp_ctas(0),
       max_decomp_ctas(0),
+      comp_kernel_usage(),
+      decomp_kernel_usage(),
       max_comp_chunk_size(0),
       uncomp_chunk_size(uncomp_chunk_size)
-  {
-    HipUtils::check(hipMalloc(&ix_chunk, sizeof(uint32_t)));
-  }
+  {}
 
-  virtual ~BatchManager() {
-    HipUtils::check(hipFree(ix_chunk));
-  }
+  virtual ~BatchManager() {}
 
   BatchManager& operator=(const BatchManager&) = delete;     
   BatchManager(const BatchManager&) = delete;
@@ -103,7 +103,8 @@ public: // API
   void do_decompress(
       uint8_t* decomp_buffer, 
       const uint8_t* comp_buffer,
-      const DecompressionConfig& config) final override
+      const DecompressionConfig& config,
+      const ExecutionContext& context) final override
   {
     const size_t* comp_chunk_offsets = roundUpToAlignment<const size_t>(comp_buffer);
     const size_t* comp_chunk_sizes = comp_chunk_offsets + config.num_chunks;
@@ -111,14 +112,25 @@ public: // API
     const uint32_t* decomp_chunk_checksums = comp_chunk_checksums + config.num_chunks;
     const uint8_t* comp_data_buffer = reinterpret_cast<const uint8_t*>(decomp_chunk_checksums + config.num_chunks);
 
-    HipUtils::check(hipMemsetAsync(ix_chunk, 0, sizeof(uint32_t), user_stream));
-    do_batch_decompress(
-        comp_data_buffer,
-        decomp_buffer,
+    HipUtils::check(hipMemsetAsync(context.ix_chunk, 0, sizeof(uint32_t), context.stream));
+    TraceScope trace(
+        "batch_decompress",
+        this->get_codec_name(),
+        config.decomp_data_size,
         config.num_chunks,
-        comp_chunk_offsets,
-        comp_chunk_sizes,
-        config.get_status());
+        context.stream,
+        uncomp_chunk_size,
+        this->get_data_type());
+    trace.run([&]() {
+      do_batch_decompress(
+          comp_data_buffer,
+          decomp_buffer,
+          config.num_chunks,
+          comp_chunk_offsets,
+          comp_chunk_sizes,
+          config.get_status(),
+          context);
+    });
   }
   
   /**
@@ -137,6 +149,26 @@ public: // API
         user_stream));
   }
 
+  /**
+   * @brief Computes the margin needed to decompress in place
+   *
+   * Chunks written in order to the end of the output buffer stay ahead of the chunk
+   * being decompressed as long as the margin covers the worst-case expansion of every
+   * chunk plus one compressed chunk. The container headers are included so that
+   * the compressed buffer always fits.
+   */
+  size_t get_in_place_decompression_margin(const size_t decomp_buffer_size) final override
+  {
+    const size_t num_chunks = roundUpDiv(decomp_buffer_size, uncomp_chunk_size);
+    // The max size of some formats is padded to an alignment, which can add a few 
+    // more bytes of expansion to a short final chunk than to a full one.
+    const size_t max_chunk_expansion = max_comp_chunk_size - uncomp_chunk_size + sizeof(size_t);
+    const size_t header_size = sizeof(CommonHeader) + sizeof(FormatSpecHeader) + sizeof(size_t)
+        + num_chunks * (2 * sizeof(size_t) + 2 * sizeof(Checksum_t));
+
+    return header_size + num_chunks * max_chunk_expansion + max_comp_chunk_size;
+  }
+
   /**
    * @brief Optionally does additional decompression configuration without syncing the stream
    */
@@ -155,22 +187,23 @@ private: // pure virtual functions
   virtual size_t compute_max_compressed_chunk_size() = 0;
 
   /**
-   * @brief Computes the maximum CTA occupancy for compression
+   * @brief Computes the resources and maximum CTA occupancy of the compression kernel, 
+   * whose grid_size is the number of CTAs compression launches
    */ 
-  virtual uint32_t compute_compression_max_block_occupancy() = 0;
+  virtual KernelResourceUsage compute_compression_kernel_usage() = 0;
 
   /**
-   * @brief Computes the maximum CTA occupancy for decompression
+   * @brief Computes the resources and maximum CTA occupancy of the decompression kernel
    */ 
-  virtual uint32_t compute_decompression_max_block_occupancy() = 0;
+  virtual KernelResourceUsage compute_decompression_kernel_usage() = 0;
 
   /**
-   * @brief Does the batch level compression
+   * @brief Does the batch level compression on the given stream
    */ 
-  virtual void do_batch_compress(const CompressArgs& compress_args) = 0;
+  virtual void do_batch_compress(const CompressArgs& compress_args, hipStream_t stream) = 0;
 
   /**
-   * @brief Does the batch level decompression
+   * @brief Does the batch level decompression with the chunk counter and stream of context
    */ 
   virtual void do_batch_decompress(
       const uint8_t* comp_data_buffer,
@@ -178,15 +211,18 @@ private: // pure virtual functions
       const uint32_t num_chunks,
       const size_t* comp_chunk_offsets,
       const size_t* comp_chunk_sizes,
-      hipcompStatus_t* output_status) = 0;
+      hipcompStatus_t* output_status,
+      const ExecutionContext& context) = 0;
 
 protected: // derived helpers
   void finish_init() {
     max_comp_chunk_size = compute_max_compressed_chunk_size();    
     
     format_specific_init();
-    max_comp_ctas = compute_compression_max_block_occupancy();
-    max_decomp_ctas = compute_decompression_max_block_occupancy();
+    comp_kernel_usage = compute_compression_kernel_usage();
+    decomp_kernel_usage = compute_decompression_kernel_usage();
+    max_comp_ctas = comp_kernel_usage.grid_size;
+    max_decomp_ctas = decomp_kernel_usage.grid_size;
     
     ManagerBase<FormatSpecHeader>::finish_init();    
   }
@@ -208,6 +244,11 @@ protected: // accessors
     return uncomp_chunk_size;
   }
 
+  size_t get_chunk_size() const final override
+  {
+    return uncomp_chunk_size;
+  }
+
 
 private: // helper API overrides
   size_t calculate_max_compressed_output_size(CompressionConfig& comp_config) final override
@@ -227,16 +268,17 @@ private: // helper API overrides
       CommonHeader* common_header,
       const uint8_t* decomp_buffer, 
       uint8_t* comp_buffer,
-      const CompressionConfig& comp_config) final override
+      const CompressionConfig& comp_config,
+      const ExecutionContext& context) final override
   {    
     CompressArgs compress_args;
     compress_args.common_header = common_header;
     compress_args.decomp_buffer = decomp_buffer;
     compress_args.decomp_buffer_size = comp_config.uncompressed_buffer_size;
-    compress_args.scratch_buffer = ManagerBase<FormatSpecHeader>::scratch_buffer;
+    compress_args.scratch_buffer = context.scratch_buffer;
     compress_args.uncomp_chunk_size = uncomp_chunk_size;
     compress_args.ix_output = &common_header->comp_data_size;
-    compress_args.ix_chunk = ix_chunk;
+    compress_args.ix_chunk = context.ix_chunk;
     
     compress_args.num_chunks = comp_config.num_chunks;
     compress_args.max_comp_chunk_size = max_comp_chunk_size;
@@ -250,10 +292,89 @@ private: // helper API overrides
     
     compress_args.comp_buffer = reinterpret_cast<uint8_t*>(decomp_chunk_checksums + comp_config.num_chunks);
     compress_args.output_status = comp_config.get_status();
+    compress_args.ix_ordered_chunk = comp_config.in_place_decompressible ? context.ix_chunk + 1 : nullptr;
 
-    HipUtils::check(hipMemsetAsync(ix_chunk, 0, sizeof(uint32_t), user_stream));    
+    HipUtils::check(hipMemsetAsync(context.ix_chunk, 0, 2 * sizeof(uint32_t), context.stream));    
     
-    do_batch_compress(compress_args);
+    TraceScope trace(
+        "batch_compress",
+        this->get_codec_name(),
+        comp_config.uncompressed_buffer_size,
+        comp_config.num_chunks,
+        context.stream,
+        uncomp_chunk_size,
+        this->get_data_type());
+    trace.run([&]() { do_batch_compress(compress_args, context.stream); });
+  }
+
+  /**
+   * @brief Decompresses the chunks in launches scheduled by schedule_in_place_decompression
+   *
+   * The chunk table is overwritten by the first chunks, so it is copied into the 
+   * scratch buffer before any chunk is decompressed.
+   */
+  void do_decompress_in_place(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& config,
+      const ExecutionContext& context) final override
+  {
+    // The config may still be filled in asynchronously by configure_decompression
+    HipUtils::check(hipStreamSynchronize(context.stream));
+
+    const size_t num_chunks = config.num_chunks;
+    const size_t* comp_chunk_offsets = roundUpToAlignment<const size_t>(comp_buffer);
+    const size_t* comp_chunk_sizes = comp_chunk_offsets + num_chunks;
+    const uint32_t* comp_chunk_checksums = reinterpret_cast<const uint32_t*>(comp_chunk_sizes + num_chunks);
+    const uint32_t* decomp_chunk_checksums = comp_chunk_checksums + num_chunks;
+    const uint8_t* comp_data_buffer = reinterpret_cast<const uint8_t*>(decomp_chunk_checksums + num_chunks);
+
+    const size_t chunk_table_size = 2 * num_chunks * sizeof(size_t);
+    if (chunk_table_size > ManagerBase<FormatSpecHeader>::scratch_buffer_size) {
+      throw HipCompException(hipcompErrorInvalidValue, 
+          "In-place decompression requires the chunk table (" + std::to_string(chunk_table_size) 
+          + " bytes) to fit in the scratch buffer.");
+    }
+
+    size_t* device_chunk_offsets = reinterpret_cast<size_t*>(context.scratch_buffer);
+    size_t* device_chunk_sizes = device_chunk_offsets + num_chunks;
+    std::vector<size_t> host_chunk_offsets(num_chunks);
+    std::vector<size_t> host_chunk_sizes(num_chunks);
+
+    HipUtils::check(hipMemcpyAsync(device_chunk_offsets, comp_chunk_offsets, chunk_table_size, hipMemcpyDefault, context.stream));
+    HipUtils::check(hipMemcpyAsync(host_chunk_offsets.data(), comp_chunk_offsets, num_chunks * sizeof(size_t), hipMemcpyDefault, context.stream));
+    HipUtils::check(hipMemcpyAsync(host_chunk_sizes.data(), comp_chunk_sizes, num_chunks * sizeof(size_t), hipMemcpyDefault, context.stream));
+    HipUtils::check(hipStreamSynchronize(context.stream));
+
+    const std::vector<ChunkRange> launches = schedule_in_place_decompression(
+        reinterpret_cast<uintptr_t>(decomp_buffer),
+        config.decomp_data_size,
+        uncomp_chunk_size,
+        reinterpret_cast<uintptr_t>(comp_data_buffer),
+        host_chunk_offsets,
+        host_chunk_sizes);
+
+    for (const ChunkRange& launch : launches) {
+      HipUtils::check(hipMemsetAsync(context.ix_chunk, 0, sizeof(uint32_t), context.stream));
+      TraceScope trace(
+          "batch_decompress",
+          this->get_codec_name(),
+          launch.num_chunks * uncomp_chunk_size,
+          launch.num_chunks,
+          context.stream,
+          uncomp_chunk_size,
+          this->get_data_type());
+      trace.run([&]() {
+        do_batch_decompress(
+            comp_data_buffer,
+            decomp_buffer + launch.first_chunk * uncomp_chunk_size,
+            launch.num_chunks,
+            device_chunk_offsets + launch.first_chunk,
+            device_chunk_sizes + launch.first_chunk,
+            config.get_status(),
+            context);
+      });
+    }
   }
 
   virtual void do_configure_compression(CompressionConfig& config) final override
@@ -261,6 +382,12 @@ private: // helper API overrides
     config.num_chunks = roundUpDiv(config.uncompressed_buffer_size, uncomp_chunk_size);
   }
 
+  void do_get_kernel_resource_usage(std::vector<KernelResourceUsage>& usage) final override
+  {
+    usage.push_back(comp_kernel_usage);
+    usage.push_back(decomp_kernel_usage);
+  }
+
   /**
    * @brief Computes the required scratch space size
    * 
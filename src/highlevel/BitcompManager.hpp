@@ -97,13 +97,15 @@ public:
    * @param decomp_buffer_size The length of the uncompressed input data
    * @param comp_buffer The location to output the compressed data to (GPU accessible).
    * @param comp_config Resulted from configure_compression given this decomp_buffer_size.
+   * @param context The stream to compress on
    * 
    */
   void do_compress(
       CommonHeader* common_header,
       const uint8_t* decomp_buffer, 
       uint8_t* comp_buffer,
-      const CompressionConfig& comp_config) final override;
+      const CompressionConfig& comp_config,
+      const ExecutionContext& context) final override;
 
 
   /**
@@ -112,11 +114,13 @@ public:
    * @param decomp_buffer The location to output the decompressed data to (GPU accessible).
    * @param comp_buffer The compressed input data (GPU accessible).
    * @param decomp_config Resulted from configure_decompression given this decomp_buffer_size.
+   * @param context The stream to decompress on
    */
   void do_decompress(
       uint8_t* decomp_buffer, 
       const uint8_t* comp_buffer,
-      const DecompressionConfig& config) final override;
+      const DecompressionConfig& config,
+      const ExecutionContext& context) final override;
 
   /**
    * @brief Optionally does additional decompression configuration 
@@ -153,6 +157,16 @@ public:
   {
     return format_spec;
   }
+
+  const char* get_codec_name() const final override
+  {
+    return "bitcomp";
+  }
+
+  hipcompType_t get_data_type() const final override
+  {
+    return format_spec->data_type;
+  }
 };
 
 // BitcompManager implementation
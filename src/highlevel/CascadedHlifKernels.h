@@ -50,6 +50,7 @@
 #include "hipcomp.h"
 #include "common.h"
 #include "hipcomp/cascaded.h"
+#include "hipcomp/hipcompManager.hpp"
 #include "hipcomp_common_deps/hlif_shared_types.hpp"
 
 namespace hipcomp
@@ -74,9 +75,9 @@ void cascadedHlifBatchDecompress(
     hipcompStatus_t* output_status,
     const hipcompBatchedCascadedOpts_t* options);
 
-size_t
-cascadedHlifDecompMaxBlockOccupancy(const int device_id, hipcompType_t type);
-size_t
-cascadedHlifCompMaxBlockOccupancy(const int device_id, hipcompType_t type);
+KernelResourceUsage
+cascadedHlifDecompKernelUsage(const int device_id, hipcompType_t type);
+KernelResourceUsage
+cascadedHlifCompKernelUsage(const int device_id, hipcompType_t type);
 
 } // namespace hipcomp
@@ -99,15 +99,15 @@ public:
     return max_comp_chunk_size;
   }
 
-  uint32_t compute_compression_max_block_occupancy() final override
+  KernelResourceUsage compute_compression_kernel_usage() final override
   {
-    return cascadedHlifCompMaxBlockOccupancy(
+    return cascadedHlifCompKernelUsage(
         device_id, format_spec->options.type);
   }
 
-  uint32_t compute_decompression_max_block_occupancy() final override
+  KernelResourceUsage compute_decompression_kernel_usage() final override
   {
-    return cascadedHlifDecompMaxBlockOccupancy(
+    return cascadedHlifDecompKernelUsage(
         device_id, format_spec->options.type);
   }
 
@@ -116,12 +116,22 @@ public:
     return format_spec;
   }
 
-  void do_batch_compress(const CompressArgs& compress_args) final override
+  const char* get_codec_name() const final override
+  {
+    return "cascaded";
+  }
+
+  hipcompType_t get_data_type() const final override
+  {
+    return format_spec->options.type;
+  }
+
+  void do_batch_compress(const CompressArgs& compress_args, hipStream_t stream) final override
   {
     cascadedHlifBatchCompress(
         compress_args,
         get_max_comp_ctas(),
-        user_stream,
+        stream,
         &(format_spec->options));
   }
 
@@ -131,18 +141,19 @@ public:
       const uint32_t num_chunks,
       const size_t* comp_chunk_offsets,
       const size_t* comp_chunk_sizes,
-      hipcompStatus_t* output_status) final override
+      hipcompStatus_t* output_status,
+      const ExecutionContext& context) final override
   {
     cascadedHlifBatchDecompress(
         comp_data_buffer,
         decomp_buffer,
         get_uncomp_chunk_size(),
-        ix_chunk,
+        context.ix_chunk,
         num_chunks,
         comp_chunk_offsets,
         comp_chunk_sizes,
         get_max_decomp_ctas(),
-        user_stream,
+        context.stream,
         output_status,
         &(format_spec->options));
   }
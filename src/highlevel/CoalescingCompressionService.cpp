@@ -0,0 +1,266 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompCoalescingService.hpp"
+
+namespace hipcomp {
+
+namespace {
+
+/**
+ * @brief A submitted buffer waiting to be launched
+ */
+struct CompressRequest {
+  const void* uncompressed_ptr;
+  size_t uncompressed_bytes;
+  void* compressed_ptr;
+  std::chrono::steady_clock::time_point submit_time;
+  std::promise<size_t> result;
+};
+
+} // namespace
+
+struct CoalescingCompressionService::CoalescingCompressionServiceImpl {
+  std::unique_ptr<BatchedCompressBackend> backend;
+  size_t max_batch_size;
+  size_t max_batch_bytes;
+  std::chrono::microseconds max_delay;
+
+  mutable std::mutex mutex;
+  std::condition_variable pending_changed;
+  std::deque<CompressRequest> pending;
+  size_t pending_bytes;
+  size_t num_launches;
+  bool stopping;
+
+  // Only touched by the dispatcher thread
+  std::vector<CompressRequest> batch;
+  std::vector<const void*> uncompressed_ptrs;
+  std::vector<size_t> uncompressed_bytes;
+  std::vector<void*> compressed_ptrs;
+  std::vector<size_t> compressed_bytes;
+
+  std::thread dispatcher;
+
+  CoalescingCompressionServiceImpl(
+      std::unique_ptr<BatchedCompressBackend> backend_in,
+      const CoalescingOptions& options)
+    : backend(std::move(backend_in)),
+      max_batch_size(options.max_batch_size),
+      max_batch_bytes(options.max_batch_bytes),
+      max_delay(options.max_delay),
+      mutex(),
+      pending_changed(),
+      pending(),
+      pending_bytes(0),
+      num_launches(0),
+      stopping(false),
+      batch(),
+      uncompressed_ptrs(),
+      uncompressed_bytes(),
+      compressed_ptrs(),
+      compressed_bytes(),
+      dispatcher()
+  {
+    if (!backend) {
+      throw HipCompException(hipcompErrorInvalidValue, "CoalescingCompressionService needs a backend.");
+    }
+    max_batch_size = std::min(max_batch_size, backend->get_max_batch_size());
+    if (max_batch_size == 0) {
+      throw HipCompException(hipcompErrorInvalidValue, "CoalescingCompressionService needs a non-zero batch size.");
+    }
+
+    batch.reserve(max_batch_size);
+    uncompressed_ptrs.reserve(max_batch_size);
+    uncompressed_bytes.reserve(max_batch_size);
+    compressed_ptrs.reserve(max_batch_size);
+    compressed_bytes.reserve(max_batch_size);
+
+    dispatcher = std::thread([this]() { dispatch(); });
+  }
+
+  ~CoalescingCompressionServiceImpl()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    pending_changed.notify_all();
+    dispatcher.join();
+  }
+
+  std::future<size_t> submit(
+      const void* uncompressed_ptr,
+      const size_t uncompressed_bytes,
+      void* compressed_ptr)
+  {
+    CompressRequest request{
+        uncompressed_ptr, uncompressed_bytes, compressed_ptr, std::chrono::steady_clock::now(), {}};
+    std::future<size_t> res = request.result.get_future();
+
+    if (uncompressed_bytes > backend->get_max_chunk_size()) {
+      request.result.set_exception(std::make_exception_ptr(HipCompException(
+          hipcompErrorInvalidValue, "Request exceeds the maximum chunk size of the backend.")));
+      return res;
+    }
+
+    bool needs_wake;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending.push_back(std::move(request));
+      pending_bytes += uncompressed_bytes;
+      // The dispatcher only needs waking to start a wait or to launch a full batch
+      needs_wake = pending.size() == 1 || is_batch_full();
+    }
+    if (needs_wake) {
+      pending_changed.notify_one();
+    }
+
+    return res;
+  }
+
+  size_t get_num_launches() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return num_launches;
+  }
+
+private:
+  /**
+   * @brief Whether the pending requests fill a launch. Called with the mutex held.
+   */
+  bool is_batch_full() const
+  {
+    return pending.size() >= max_batch_size || pending_bytes >= max_batch_bytes;
+  }
+
+  /**
+   * @brief Moves the next launch worth of requests from pending to batch. 
+   * Called with the mutex held.
+   */
+  void take_batch()
+  {
+    size_t batch_bytes = 0;
+    while (!pending.empty() && batch.size() < max_batch_size) {
+      const size_t next_bytes = pending.front().uncompressed_bytes;
+      if (!batch.empty() && batch_bytes + next_bytes > max_batch_bytes) {
+        break;
+      }
+      batch_bytes += next_bytes;
+      batch.push_back(std::move(pending.front()));
+      pending.pop_front();
+    }
+    pending_bytes -= batch_bytes;
+    ++num_launches;
+  }
+
+  void launch_batch()
+  {
+    uncompressed_ptrs.clear();
+    uncompressed_bytes.clear();
+    compressed_ptrs.clear();
+    size_t max_uncompressed_chunk_bytes = 0;
+    for (const auto& request : batch) {
+      uncompressed_ptrs.push_back(request.uncompressed_ptr);
+      uncompressed_bytes.push_back(request.uncompressed_bytes);
+      compressed_ptrs.push_back(request.compressed_ptr);
+      max_uncompressed_chunk_bytes = std::max(max_uncompressed_chunk_bytes, request.uncompressed_bytes);
+    }
+    compressed_bytes.resize(batch.size());
+
+    try {
+      backend->compress_batch(
+          uncompressed_ptrs.data(),
+          uncompressed_bytes.data(),
+          max_uncompressed_chunk_bytes,
+          batch.size(),
+          compressed_ptrs.data(),
+          compressed_bytes.data());
+      for (size_t ix = 0; ix < batch.size(); ++ix) {
+        batch[ix].result.set_value(compressed_bytes[ix]);
+      }
+    } catch (...) {
+      for (auto& request : batch) {
+        request.result.set_exception(std::current_exception());
+      }
+    }
+    batch.clear();
+  }
+
+  void dispatch()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      pending_changed.wait(lock, [this]() { return stopping || !pending.empty(); });
+      if (pending.empty()) {
+        // stopping with nothing left to do
+        return;
+      }
+
+      // Wait for the batch to fill up, but not past the oldest request's deadline
+      const auto deadline = pending.front().submit_time + max_delay;
+      pending_changed.wait_until(lock, deadline, [this]() { return stopping || is_batch_full(); });
+
+      take_batch();
+
+      lock.unlock();
+      launch_batch();
+      lock.lock();
+    }
+  }
+};
+
+CoalescingCompressionService::CoalescingCompressionService(
+    std::unique_ptr<BatchedCompressBackend> backend,
+    const CoalescingOptions& options)
+  : impl(std::make_unique<CoalescingCompressionServiceImpl>(std::move(backend), options))
+{}
+
+CoalescingCompressionService::~CoalescingCompressionService() {}
+
+size_t CoalescingCompressionService::get_max_compressed_size(const size_t uncompressed_bytes) const
+{
+  return impl->backend->get_max_compressed_chunk_size(uncompressed_bytes);
+}
+
+std::future<size_t> CoalescingCompressionService::submit(
+    const void* uncompressed_ptr,
+    const size_t uncompressed_bytes,
+    void* compressed_ptr)
+{
+  return impl->submit(uncompressed_ptr, uncompressed_bytes, compressed_ptr);
+}
+
+size_t CoalescingCompressionService::get_num_launches() const
+{
+  return impl->get_num_launches();
+}
+
+} // namespace hipcomp
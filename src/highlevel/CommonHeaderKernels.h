@@ -0,0 +1,69 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hipcomp_common_deps/hlif_shared_types.hpp"
+
+#include "hip/hip_runtime.h"
+
+namespace hipcomp {
+
+/**
+ * @brief Writes the total size of the container that starts with common_header 
+ * to comp_size, ordered on stream.
+ *
+ * @param common_header The header of a compressed buffer (GPU accessible).
+ * @param comp_size The output location (GPU accessible, device or pinned host memory).
+ */
+void copyCompressedOutputSize(
+    const CommonHeader* common_header,
+    size_t* comp_size,
+    hipStream_t stream);
+
+/**
+ * @brief Sets output_status to status if status is an error, ordered on stream.
+ *
+ * Used by managers that issue work through other managers to report the first 
+ * failure of any piece in the config of the whole operation.
+ *
+ * @param status The status of one piece of work (GPU accessible).
+ * @param output_status The status of the whole operation (GPU accessible).
+ */
+void mergeOutputStatus(
+    const hipcompStatus_t* status,
+    hipcompStatus_t* output_status,
+    hipStream_t stream);
+
+/**
+ * @brief Sets output_status to hipcompSuccess, ordered on stream.
+ *
+ * Kernels only write the status on failure, so a graph that is replayed resets 
+ * the status as one of its nodes.
+ *
+ * @param output_status The status to reset (GPU accessible).
+ */
+void resetOutputStatus(
+    hipcompStatus_t* output_status,
+    hipStream_t stream);
+
+} // namespace hipcomp
@@ -52,20 +52,22 @@
 namespace hipcomp {
 
 CompressionConfig::CompressionConfigImpl::CompressionConfigImpl(PinnedPtrPool<hipcompStatus_t>& pool)
-  : status(pool.allocate())
+  : status(pool.allocate_handle())
 {
   *get_status() = hipcompSuccess;
 }
 
 hipcompStatus_t* CompressionConfig::CompressionConfigImpl::get_status() const {
-  return status->get_ptr();
+  return status.get_ptr();
 }
 
 CompressionConfig::CompressionConfig(PinnedPtrPool<hipcompStatus_t>& pool, size_t uncompressed_buffer_size)
-  : impl(std::make_shared<CompressionConfig::CompressionConfigImpl>(pool)),
+  : impl(std::allocate_shared<CompressionConfig::CompressionConfigImpl>(
+        HostBlockCacheAllocator<CompressionConfig::CompressionConfigImpl>(pool.get_host_block_cache()), pool)),
     uncompressed_buffer_size(uncompressed_buffer_size),
     max_compressed_buffer_size(0),
-    num_chunks(0)
+    num_chunks(0),
+    in_place_decompressible(false)
 {}
 
 hipcompStatus_t* CompressionConfig::get_status() const {
@@ -78,14 +80,16 @@ CompressionConfig::CompressionConfig(CompressionConfig&& other)
   : impl(std::move(other.impl)),
     uncompressed_buffer_size(other.uncompressed_buffer_size),
     max_compressed_buffer_size(other.max_compressed_buffer_size),
-    num_chunks(other.num_chunks)
+    num_chunks(other.num_chunks),
+    in_place_decompressible(other.in_place_decompressible)
 {}
 
 CompressionConfig::CompressionConfig(const CompressionConfig& other)
   : impl(other.impl),
     uncompressed_buffer_size(other.uncompressed_buffer_size),
     max_compressed_buffer_size(other.max_compressed_buffer_size),
-    num_chunks(other.num_chunks)
+    num_chunks(other.num_chunks),
+    in_place_decompressible(other.in_place_decompressible)
 {}
 
 CompressionConfig& CompressionConfig::operator=(const CompressionConfig& other) 
@@ -94,6 +98,7 @@ CompressionConfig& CompressionConfig::operator=(const CompressionConfig& other)
   uncompressed_buffer_size = other.uncompressed_buffer_size;
   max_compressed_buffer_size = other.max_compressed_buffer_size;
   num_chunks = other.num_chunks;
+  in_place_decompressible = other.in_place_decompressible;
   return *this;
 }
 
@@ -103,6 +108,7 @@ CompressionConfig& CompressionConfig::operator=(CompressionConfig&& other)
   uncompressed_buffer_size = other.uncompressed_buffer_size;
   max_compressed_buffer_size = other.max_compressed_buffer_size;
   num_chunks = other.num_chunks;
+  in_place_decompressible = other.in_place_decompressible;
   return *this;
 }
 
@@ -110,7 +116,7 @@ CompressionConfig& CompressionConfig::operator=(CompressionConfig&& other)
  * @brief Construct the config given an hipcompStatus_t memory pool
  */
 DecompressionConfig::DecompressionConfigImpl::DecompressionConfigImpl(PinnedPtrPool<hipcompStatus_t>& pool)
-  : status(pool.allocate()),
+  : status(pool.allocate_handle()),
     decomp_data_size(),
     num_chunks()
 {
@@ -121,11 +127,12 @@ DecompressionConfig::DecompressionConfigImpl::DecompressionConfigImpl(PinnedPtrP
  * @brief Get the raw hipcompStatus_t*
  */
 hipcompStatus_t* DecompressionConfig::DecompressionConfigImpl::get_status() const {
-  return status->get_ptr();
+  return status.get_ptr();
 }
 
 DecompressionConfig::DecompressionConfig(PinnedPtrPool<hipcompStatus_t>& pool)
-  : impl(std::make_shared<DecompressionConfig::DecompressionConfigImpl>(pool)),
+  : impl(std::allocate_shared<DecompressionConfig::DecompressionConfigImpl>(
+        HostBlockCacheAllocator<DecompressionConfig::DecompressionConfigImpl>(pool.get_host_block_cache()), pool)),
     decomp_data_size(0),
     num_chunks(0)
 {}
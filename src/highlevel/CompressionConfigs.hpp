@@ -71,7 +71,7 @@ namespace hipcomp {
  */
 struct CompressionConfig::CompressionConfigImpl {
 private: 
-  std::unique_ptr<PinnedPtrPool<hipcompStatus_t>::PinnedPtrHandle> status;
+  PinnedPtrPool<hipcompStatus_t>::PinnedPtrHandle status;
 
 public:
   /**
@@ -93,7 +93,7 @@ public:
  */
 struct DecompressionConfig::DecompressionConfigImpl {
 private: 
-  std::unique_ptr<PinnedPtrPool<hipcompStatus_t>::PinnedPtrHandle> status;
+  PinnedPtrPool<hipcompStatus_t>::PinnedPtrHandle status;
 
 public:
   size_t decomp_data_size;
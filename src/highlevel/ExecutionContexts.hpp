@@ -0,0 +1,243 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "hipcomp.hpp"
+
+#include "HipUtils.h"
+#include "Metrics.h"
+#include "common.h"
+
+namespace hipcomp {
+
+/**
+ * @brief The stream of a call and the device state that only that call uses
+ */
+struct ExecutionContext {
+  hipStream_t stream;
+  uint8_t* scratch_buffer;
+  // ix_chunk[0] hands out chunks, ix_chunk[1] orders chunk output for in-place layouts
+  uint32_t* ix_chunk;
+};
+
+/**
+ * @brief Execution contexts for calls on streams other than a manager's user stream.
+ *
+ * Each call leases a context for the time it takes to issue its work. A context is 
+ * handed out again once the work of its last call has finished, or right away to a 
+ * call on the same stream, so the pool grows to the number of streams that are in use 
+ * at once. Thread-safe.
+ */
+struct ExecutionContextPool {
+
+private:
+  struct Entry {
+    ExecutionContext context;
+    hipEvent_t done;
+    bool leased;
+    // The last release was during capture, so done is a node of the graph and cannot be queried
+    bool captured;
+  };
+
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Entry>> entries;
+  size_t scratch_buffer_size;
+
+public:
+  /**
+   * @brief Returns its context to the pool with release(), or when destroyed if the
+   * call failed before it
+   */
+  class Lease {
+    ExecutionContextPool* pool;
+    Entry* entry;
+
+  public:
+    Lease(ExecutionContextPool* pool, Entry* entry)
+      : pool(pool),
+        entry(entry)
+    {}
+
+    Lease(Lease&& other)
+      : pool(other.pool),
+        entry(other.entry)
+    {
+      other.entry = nullptr;
+    }
+
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    Lease& operator=(Lease&&) = delete;
+
+    ~Lease()
+    {
+      // The error of the failed call is the one reported, not a failure to release
+      if (entry != nullptr) {
+        pool->release(entry);
+      }
+    }
+
+    /**
+     * @brief Returns the context to the pool. Throws if the work issued in it could not
+     * be marked, in which case the context is not reused.
+     */
+    void release()
+    {
+      Entry* const released = entry;
+      entry = nullptr;
+      HipUtils::check(pool->release(released), "Failed to release an execution context");
+    }
+
+    const ExecutionContext& get() const
+    {
+      return entry->context;
+    }
+  };
+
+  ExecutionContextPool()
+    : mutex(),
+      entries(),
+      scratch_buffer_size(0)
+  {}
+
+  ExecutionContextPool(const ExecutionContextPool&) = delete;
+  ExecutionContextPool& operator=(const ExecutionContextPool&) = delete;
+
+  ~ExecutionContextPool()
+  {
+    for (auto& entry : entries) {
+      hipEventDestroy(entry->done);
+      hipFree(entry->context.scratch_buffer);
+    }
+  }
+
+  /**
+   * @brief Sets the scratch size of the contexts. Must be called before the first lease.
+   */
+  void set_scratch_buffer_size(const size_t size)
+  {
+    scratch_buffer_size = size;
+  }
+
+  /**
+   * @brief Leases a context for work on stream
+   *
+   * Allocates a new context if none is free, which cannot happen while the stream 
+   * is being captured into a graph. A context released during capture is only handed 
+   * out again on its own stream.
+   */
+  Lease acquire(hipStream_t stream)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Entry* free_entry = nullptr;
+    for (auto& entry : entries) {
+      if (entry->leased) {
+        continue;
+      }
+      if (entry->context.stream == stream) {
+        free_entry = entry.get();
+        break;
+      }
+      if (free_entry == nullptr && !entry->captured) {
+        const hipError_t err = hipEventQuery(entry->done);
+        if (err != hipErrorNotReady) {
+          HipUtils::check(err);
+          free_entry = entry.get();
+        }
+      }
+    }
+
+    if (free_entry == nullptr) {
+      free_entry = allocate_entry(stream);
+    }
+    free_entry->context.stream = stream;
+    free_entry->leased = true;
+
+    return Lease{this, free_entry};
+  }
+
+  /**
+   * @brief The device memory held by the contexts
+   */
+  size_t get_device_bytes()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size() * (roundUpTo(scratch_buffer_size, sizeof(size_t)) + 2 * sizeof(uint32_t));
+  }
+
+private:
+  Entry* allocate_entry(hipStream_t stream)
+  {
+    if (HipUtils::is_capturing(stream)) {
+      throw HipCompException(hipcompErrorNotSupported, 
+          "A new execution context cannot be allocated during graph capture. Issue a call on the stream before capturing it.");
+    }
+
+    // The chunk counters follow the scratch space in the same allocation
+    const size_t counters_offset = roundUpTo(scratch_buffer_size, sizeof(size_t));
+    uint8_t* buffer;
+    HipUtils::check(hipMalloc(&buffer, counters_offset + 2 * sizeof(uint32_t)));
+
+    std::unique_ptr<Entry> entry(new Entry{
+        ExecutionContext{stream, buffer, reinterpret_cast<uint32_t*>(buffer + counters_offset)}, 
+        nullptr, 
+        false,
+        false});
+    const hipError_t err = hipEventCreateWithFlags(&entry->done, hipEventDisableTiming);
+    if (err != hipSuccess) {
+      hipFree(buffer);
+      HipUtils::check(err);
+    }
+
+    metrics::count_event("context_allocation", counters_offset + 2 * sizeof(uint32_t));
+    entries.push_back(std::move(entry));
+    return entries.back().get();
+  }
+
+  hipError_t release(Entry* entry) noexcept
+  {
+    // Marks the point after which the next lease on another stream may reuse the context.
+    // During capture the event would be a node of the graph, so it is not recorded.
+    hipStreamCaptureStatus capture_status;
+    hipError_t err = hipStreamIsCapturing(entry->context.stream, &capture_status);
+    const bool captured = err == hipSuccess && capture_status == hipStreamCaptureStatusActive;
+    if (err == hipSuccess && !captured) {
+      err = hipEventRecord(entry->done, entry->context.stream);
+    }
+
+    // Without the mark a later lease could not wait for this one, so the context stays leased
+    if (err == hipSuccess) {
+      std::lock_guard<std::mutex> lock(mutex);
+      entry->captured = captured;
+      entry->leased = false;
+    }
+    return err;
+  }
+};
+
+} // namespace hipcomp
@@ -111,23 +111,25 @@ public:
     return max_comp_chunk_size;
   }
 
-  uint32_t compute_compression_max_block_occupancy() final override 
+  KernelResourceUsage compute_compression_kernel_usage() final override 
   {
 #ifdef ENABLE_GDEFLATE
-    return gdeflate::hlif::batchedGdeflateCompMaxBlockOccupancy(device_id);
+    return get_kernel_resource_usage(
+        "gdeflate_compress", device_id, gdeflate::hlif::batchedGdeflateCompMaxBlockOccupancy(device_id));
 #else
     throw std::runtime_error("hipcomp configured without gdeflate support. Please check the README for configuration instructions");
-    return 0;
+    return KernelResourceUsage{};
 #endif
   }
 
-  uint32_t compute_decompression_max_block_occupancy() final override 
+  KernelResourceUsage compute_decompression_kernel_usage() final override 
   {
 #ifdef ENABLE_GDEFLATE
-    return gdeflate::hlif::batchedGdeflateDecompMaxBlockOccupancy(device_id); 
+    return get_kernel_resource_usage(
+        "gdeflate_decompress", device_id, gdeflate::hlif::batchedGdeflateDecompMaxBlockOccupancy(device_id)); 
 #else
     throw std::runtime_error("hipcomp configured without gdeflate support. Please check the README for configuration instructions");
-    return 0;
+    return KernelResourceUsage{};
 #endif
   }
 
@@ -136,15 +138,21 @@ public:
     return format_spec;
   }
 
-  void do_batch_compress(const CompressArgs& compress_args) final override
+  const char* get_codec_name() const final override
+  {
+    return "gdeflate";
+  }
+
+  void do_batch_compress(const CompressArgs& compress_args, hipStream_t stream) final override
   {
 #ifdef ENABLE_GDEFLATE
     gdeflate::hlif::gdeflateHlifBatchCompress(
         compress_args,
         get_max_comp_ctas(),
-        user_stream);
+        stream);
 #else
     (void)compress_args;
+    (void)stream;
     throw std::runtime_error("hipcomp configured without gdeflate support. Please check the README for configuration instructions");
 #endif
   }
@@ -155,19 +163,20 @@ public:
       const uint32_t num_chunks,
       const size_t* comp_chunk_offsets,
       const size_t* comp_chunk_sizes,
-      hipcompStatus_t* output_status) final override
+      hipcompStatus_t* output_status,
+      const ExecutionContext& context) final override
   {        
 #ifdef ENABLE_GDEFLATE
     gdeflate::hlif::gdeflateHlifBatchDecompress(
         comp_data_buffer,
         decomp_buffer,
         get_uncomp_chunk_size(),
-        ix_chunk,
+        context.ix_chunk,
         num_chunks,
         comp_chunk_offsets,
         comp_chunk_sizes,
         get_max_decomp_ctas(),
-        user_stream,
+        context.stream,
         output_status);
 #else
     (void)comp_data_buffer;
@@ -176,6 +185,7 @@ public:
     (void)comp_chunk_offsets;
     (void)comp_chunk_sizes;
     (void)output_status;
+    (void)context;
     throw std::runtime_error("hipcomp configured without gdeflate support. Please check the README for configuration instructions");
 #endif
   }
@@ -0,0 +1,414 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompHostPipeline.hpp"
+#include "hipcomp/hipcompHostThreadPool.hpp"
+#include "hipcomp_common_deps/hlif_shared_types.hpp"
+#include "HipUtils.h"
+#include "PinnedPtrs.hpp"
+#include "common.h"
+
+namespace hipcomp {
+
+namespace {
+
+// Staging copies are split into pieces of at least this size for the host thread pool
+constexpr size_t MIN_STAGING_COPY_PIECE = 1 << 20;
+
+/**
+ * @brief Copies between user and staging memory on the host thread pool
+ *
+ * A single thread cannot saturate the memory bandwidth, and the pool's threads run 
+ * on the NUMA node the staging buffers are closest to.
+ */
+void staging_copy(uint8_t* dst, const uint8_t* src, const size_t bytes)
+{
+  const size_t num_pieces = std::max<size_t>(1, bytes / MIN_STAGING_COPY_PIECE);
+  if (num_pieces == 1) {
+    std::memcpy(dst, src, bytes);
+    return;
+  }
+  const size_t piece_size = roundUpDiv(bytes, num_pieces);
+  get_host_thread_pool().parallel_for(num_pieces, [&](const size_t ix) {
+    const size_t offset = ix * piece_size;
+    std::memcpy(dst + offset, src + offset, std::min(piece_size, bytes - offset));
+  });
+}
+
+/**
+ * @brief The location and sizes of one slice container in a compressed host buffer
+ */
+struct SliceInfo {
+  size_t comp_offset;
+  size_t comp_size;
+  size_t decomp_size;
+  size_t num_chunks;
+};
+
+std::vector<SliceInfo> parse_slices(const uint8_t* comp_buffer, const size_t comp_buffer_size)
+{
+  std::vector<SliceInfo> slices;
+  size_t offset = 0;
+  while (offset < comp_buffer_size) {
+    if (comp_buffer_size - offset < sizeof(CommonHeader)) {
+      throw HipCompException(hipcompErrorInvalidValue, "Compressed buffer ends inside a slice header.");
+    }
+    CommonHeader header;
+    std::memcpy(&header, comp_buffer + offset, sizeof(CommonHeader));
+
+    const size_t comp_size = header.comp_data_offset + header.comp_data_size;
+    if (comp_size < sizeof(CommonHeader) || comp_size > comp_buffer_size - offset) {
+      throw HipCompException(hipcompErrorInvalidValue, "Invalid slice size in compressed buffer.");
+    }
+    slices.push_back(SliceInfo{offset, comp_size, header.decomp_data_size, header.num_chunks});
+    offset += comp_size;
+  }
+  return slices;
+}
+
+} // namespace
+
+/**
+ * @brief The buffers and events used by one slice in flight
+ */
+struct PipelineSlot {
+  std::unique_ptr<PinnedBufferPool::PinnedBufferHandle> staging_in;
+  std::unique_ptr<PinnedBufferPool::PinnedBufferHandle> staging_out;
+  uint8_t* device_in;
+  size_t device_in_size;
+  uint8_t* device_out;
+  size_t device_out_size;
+  hipEvent_t copied_in;
+  hipEvent_t processed;
+  hipEvent_t copied_out;
+};
+
+struct HostPipeline::HostPipelineImpl {
+  hipcompManagerBase& manager;
+  hipStream_t compute_stream;
+  hipStream_t copy_in_stream;
+  hipStream_t copy_out_stream;
+  size_t slice_size;
+  PinnedBufferPool staging_pool;
+  std::vector<PipelineSlot> slots;
+
+  HostPipelineImpl(
+      hipcompManagerBase& manager,
+      hipStream_t manager_stream,
+      const size_t slice_size,
+      const size_t num_slots)
+    : manager(manager),
+      compute_stream(manager_stream),
+      copy_in_stream(),
+      copy_out_stream(),
+      slice_size(slice_size),
+      staging_pool(),
+      slots(num_slots)
+  {
+    if (slice_size == 0 || num_slots == 0) {
+      throw HipCompException(hipcompErrorInvalidValue, "HostPipeline needs a non-zero slice size and slot count.");
+    }
+
+    HipUtils::check(hipStreamCreateWithFlags(&copy_in_stream, hipStreamNonBlocking));
+    HipUtils::check(hipStreamCreateWithFlags(&copy_out_stream, hipStreamNonBlocking));
+    for (auto& slot : slots) {
+      slot.device_in = nullptr;
+      slot.device_in_size = 0;
+      slot.device_out = nullptr;
+      slot.device_out_size = 0;
+      HipUtils::check(hipEventCreateWithFlags(&slot.copied_in, hipEventDisableTiming));
+      HipUtils::check(hipEventCreateWithFlags(&slot.processed, hipEventDisableTiming));
+      HipUtils::check(hipEventCreateWithFlags(&slot.copied_out, hipEventDisableTiming));
+    }
+  }
+
+  ~HostPipelineImpl()
+  {
+    synchronize();
+    for (auto& slot : slots) {
+      HipUtils::check(hipFree(slot.device_in));
+      HipUtils::check(hipFree(slot.device_out));
+      HipUtils::check(hipEventDestroy(slot.copied_in));
+      HipUtils::check(hipEventDestroy(slot.processed));
+      HipUtils::check(hipEventDestroy(slot.copied_out));
+    }
+    HipUtils::check(hipStreamDestroy(copy_in_stream));
+    HipUtils::check(hipStreamDestroy(copy_out_stream));
+  }
+
+  /**
+   * @brief Waits for all work issued by the pipeline
+   */
+  void synchronize()
+  {
+    HipUtils::check(hipStreamSynchronize(copy_in_stream));
+    HipUtils::check(hipStreamSynchronize(compute_stream));
+    HipUtils::check(hipStreamSynchronize(copy_out_stream));
+  }
+
+  /**
+   * @brief Grows the staging and device buffers of every slot. Only called when idle.
+   */
+  void reserve(const size_t in_size, const size_t out_size)
+  {
+    for (auto& slot : slots) {
+      if (!slot.staging_in || slot.staging_in->size() < in_size) {
+        slot.staging_in.reset();
+        slot.staging_in = staging_pool.allocate(in_size);
+      }
+      if (!slot.staging_out || slot.staging_out->size() < out_size) {
+        slot.staging_out.reset();
+        slot.staging_out = staging_pool.allocate(out_size);
+      }
+      if (slot.device_in_size < in_size) {
+        HipUtils::check(hipFree(slot.device_in));
+        HipUtils::check(hipMalloc(&slot.device_in, in_size));
+        slot.device_in_size = in_size;
+      }
+      if (slot.device_out_size < out_size) {
+        HipUtils::check(hipFree(slot.device_out));
+        HipUtils::check(hipMalloc(&slot.device_out, out_size));
+        slot.device_out_size = out_size;
+      }
+    }
+  }
+
+  /**
+   * @brief Stages bytes of host input into the slot and starts the H2D copy 
+   *
+   * The compute stream waits for the copy before any later work.
+   */
+  void copy_in(PipelineSlot& slot, const uint8_t* src, const size_t bytes)
+  {
+    staging_copy(slot.staging_in->get_ptr(), src, bytes);
+    HipUtils::check(hipMemcpyAsync(
+        slot.device_in, slot.staging_in->get_ptr(), bytes, hipMemcpyHostToDevice, copy_in_stream));
+    HipUtils::check(hipEventRecord(slot.copied_in, copy_in_stream));
+    HipUtils::check(hipStreamWaitEvent(compute_stream, slot.copied_in, 0));
+  }
+
+  void check_status(const hipcompStatus_t* status)
+  {
+    if (*status != hipcompSuccess) {
+      const hipcompStatus_t err = *status;
+      synchronize();
+      throw HipCompException(err, "HostPipeline slice failed.");
+    }
+  }
+
+  size_t get_max_compressed_size(const size_t decomp_buffer_size)
+  {
+    const size_t num_full_slices = decomp_buffer_size / slice_size;
+    const size_t last_slice_size = decomp_buffer_size % slice_size;
+
+    size_t res = 0;
+    if (num_full_slices > 0) {
+      res += num_full_slices * manager.configure_compression(slice_size).max_compressed_buffer_size;
+    }
+    if (last_slice_size > 0) {
+      res += manager.configure_compression(last_slice_size).max_compressed_buffer_size;
+    }
+    return res;
+  }
+
+  size_t compress(
+      const uint8_t* decomp_buffer,
+      const size_t decomp_buffer_size,
+      uint8_t* comp_buffer)
+  {
+    const size_t num_slices = roundUpDiv(decomp_buffer_size, slice_size);
+    if (num_slices == 0) {
+      return 0;
+    }
+    const size_t max_comp_slice_size = manager.configure_compression(
+        std::min(slice_size, decomp_buffer_size)).max_compressed_buffer_size;
+    reserve(slice_size, max_comp_slice_size);
+
+    std::vector<CompressionConfig> configs;
+    configs.reserve(num_slices);
+    size_t comp_offset = 0;
+
+    auto launch = [&](const size_t ix) {
+      PipelineSlot& slot = slots[ix % slots.size()];
+      const size_t offset = ix * slice_size;
+      const size_t bytes = std::min(slice_size, decomp_buffer_size - offset);
+
+      copy_in(slot, decomp_buffer + offset, bytes);
+
+      configs.push_back(manager.configure_compression(bytes));
+      manager.compress(slot.device_in, slot.device_out, configs.back());
+
+      // The header is tiny so it is read back on the compute stream. The rest
+      // of the container is copied once its size is known.
+      HipUtils::check(hipMemcpyAsync(
+          slot.staging_out->get_ptr(), slot.device_out, sizeof(CommonHeader), 
+          hipMemcpyDeviceToHost, compute_stream));
+      HipUtils::check(hipEventRecord(slot.processed, compute_stream));
+    };
+
+    auto finish = [&](const size_t ix) {
+      PipelineSlot& slot = slots[ix % slots.size()];
+      HipUtils::check(hipEventSynchronize(slot.processed));
+      check_status(configs[ix].get_status());
+
+      CommonHeader header;
+      std::memcpy(&header, slot.staging_out->get_ptr(), sizeof(CommonHeader));
+      const size_t comp_size = header.comp_data_offset + header.comp_data_size;
+
+      HipUtils::check(hipMemcpyAsync(
+          slot.staging_out->get_ptr() + sizeof(CommonHeader), 
+          slot.device_out + sizeof(CommonHeader), 
+          comp_size - sizeof(CommonHeader),
+          hipMemcpyDeviceToHost, 
+          copy_out_stream));
+      HipUtils::check(hipEventRecord(slot.copied_out, copy_out_stream));
+      HipUtils::check(hipEventSynchronize(slot.copied_out));
+
+      staging_copy(comp_buffer + comp_offset, slot.staging_out->get_ptr(), comp_size);
+      comp_offset += comp_size;
+    };
+
+    for (size_t ix = 0; ix < num_slices; ++ix) {
+      if (ix >= slots.size()) {
+        finish(ix - slots.size());
+      }
+      launch(ix);
+    }
+    for (size_t ix = num_slices > slots.size() ? num_slices - slots.size() : 0; ix < num_slices; ++ix) {
+      finish(ix);
+    }
+
+    return comp_offset;
+  }
+
+  void decompress(
+      uint8_t* decomp_buffer,
+      const uint8_t* comp_buffer,
+      const size_t comp_buffer_size)
+  {
+    const std::vector<SliceInfo> slices = parse_slices(comp_buffer, comp_buffer_size);
+    if (slices.empty()) {
+      return;
+    }
+
+    size_t max_comp_size = 0;
+    size_t max_decomp_size = 0;
+    for (const auto& slice : slices) {
+      max_comp_size = std::max(max_comp_size, slice.comp_size);
+      max_decomp_size = std::max(max_decomp_size, slice.decomp_size);
+    }
+    reserve(max_comp_size, max_decomp_size);
+
+    std::vector<DecompressionConfig> configs;
+    configs.reserve(slices.size());
+    std::vector<size_t> decomp_offsets(slices.size());
+    for (size_t ix = 1; ix < slices.size(); ++ix) {
+      decomp_offsets[ix] = decomp_offsets[ix - 1] + slices[ix - 1].decomp_size;
+    }
+
+    auto launch = [&](const size_t ix) {
+      PipelineSlot& slot = slots[ix % slots.size()];
+      const SliceInfo& slice = slices[ix];
+
+      copy_in(slot, comp_buffer + slice.comp_offset, slice.comp_size);
+
+      // The header was already read on the host, so the config is built from it 
+      // rather than with a device read that the host would have to wait for.
+      configs.push_back(manager.configure_decompression(manager.configure_compression(slice.decomp_size)));
+      configs.back().decomp_data_size = slice.decomp_size;
+      configs.back().num_chunks = static_cast<uint32_t>(slice.num_chunks);
+      manager.decompress(slot.device_out, slot.device_in, configs.back());
+      HipUtils::check(hipEventRecord(slot.processed, compute_stream));
+
+      HipUtils::check(hipStreamWaitEvent(copy_out_stream, slot.processed, 0));
+      HipUtils::check(hipMemcpyAsync(
+          slot.staging_out->get_ptr(), slot.device_out, slice.decomp_size,
+          hipMemcpyDeviceToHost, copy_out_stream));
+      HipUtils::check(hipEventRecord(slot.copied_out, copy_out_stream));
+    };
+
+    auto finish = [&](const size_t ix) {
+      PipelineSlot& slot = slots[ix % slots.size()];
+      HipUtils::check(hipEventSynchronize(slot.copied_out));
+      check_status(configs[ix].get_status());
+
+      staging_copy(decomp_buffer + decomp_offsets[ix], slot.staging_out->get_ptr(), slices[ix].decomp_size);
+    };
+
+    for (size_t ix = 0; ix < slices.size(); ++ix) {
+      if (ix >= slots.size()) {
+        finish(ix - slots.size());
+      }
+      launch(ix);
+    }
+    for (size_t ix = slices.size() > slots.size() ? slices.size() - slots.size() : 0; ix < slices.size(); ++ix) {
+      finish(ix);
+    }
+  }
+};
+
+HostPipeline::HostPipeline(
+    hipcompManagerBase& manager,
+    hipStream_t manager_stream,
+    const size_t slice_size,
+    const size_t num_slots)
+  : impl(std::make_unique<HostPipelineImpl>(manager, manager_stream, slice_size, num_slots))
+{}
+
+HostPipeline::~HostPipeline() {}
+
+size_t HostPipeline::get_max_compressed_size(const size_t decomp_buffer_size)
+{
+  return impl->get_max_compressed_size(decomp_buffer_size);
+}
+
+size_t HostPipeline::compress(
+    const uint8_t* decomp_buffer,
+    const size_t decomp_buffer_size,
+    uint8_t* comp_buffer)
+{
+  return impl->compress(decomp_buffer, decomp_buffer_size, comp_buffer);
+}
+
+size_t HostPipeline::get_decompressed_size(const uint8_t* comp_buffer, const size_t comp_buffer_size)
+{
+  size_t res = 0;
+  for (const auto& slice : parse_slices(comp_buffer, comp_buffer_size)) {
+    res += slice.decomp_size;
+  }
+  return res;
+}
+
+void HostPipeline::decompress(
+    uint8_t* decomp_buffer,
+    const uint8_t* comp_buffer,
+    const size_t comp_buffer_size)
+{
+  impl->decompress(decomp_buffer, comp_buffer, comp_buffer_size);
+}
+
+} // namespace hipcomp
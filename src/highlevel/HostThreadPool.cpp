@@ -0,0 +1,379 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "Check.h"
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompHostThreadPool.hpp"
+
+namespace hipcomp {
+
+namespace {
+
+/**
+ * @brief Parses a sysfs CPU list such as "0-3,8,10-11"
+ */
+std::vector<int> parse_cpu_list(const std::string& list)
+{
+  std::vector<int> cpus;
+  std::stringstream ranges(list);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    range.erase(std::remove_if(range.begin(), range.end(), [](char c) { return std::isspace(c); }), range.end());
+    if (range.empty()) {
+      continue;
+    }
+    const size_t dash = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception&) {
+      // Not a list we understand, leave the node without CPUs
+      return std::vector<int>();
+    }
+  }
+  return cpus;
+}
+
+/**
+ * @brief The first line of a file, empty if it cannot be read
+ */
+std::string read_line(const std::string& path)
+{
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+/**
+ * @brief Restricts the calling thread to cpus. Leaves it unpinned if that fails.
+ */
+void pin_current_thread(const std::vector<int>& cpus)
+{
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)cpus;
+#endif
+}
+
+/**
+ * @brief The state of one parallel_for() call, shared with the pool tasks that help with it
+ *
+ * A task that starts after all indices were taken returns without touching fn, 
+ * which is only valid until the call returns.
+ */
+struct ParallelLoop {
+  const std::function<void(size_t)>* fn;
+  size_t num_tasks;
+  std::atomic<size_t> next;
+  std::atomic<bool> failed;
+  std::mutex mutex;
+  std::condition_variable all_done;
+  size_t num_done;
+  std::exception_ptr error;
+
+  ParallelLoop(const std::function<void(size_t)>& fn, const size_t num_tasks)
+    : fn(&fn),
+      num_tasks(num_tasks),
+      next(0),
+      failed(false),
+      num_done(0)
+  {}
+
+  void work()
+  {
+    for (size_t ix = next++; ix < num_tasks; ix = next++) {
+      if (!failed) {
+        try {
+          (*fn)(ix);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+          failed = true;
+        }
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      if (++num_done == num_tasks) {
+        all_done.notify_all();
+      }
+    }
+  }
+};
+
+} // namespace
+
+HostTopology HostTopology::detect(const std::string& sysfs_root)
+{
+  HostTopology topology;
+#ifdef __linux__
+  const std::string node_dir = sysfs_root + "/devices/system/node";
+  DIR* dir = opendir(node_dir.c_str());
+  if (dir == nullptr) {
+    return topology;
+  }
+  while (const dirent* entry = readdir(dir)) {
+    const std::string name = entry->d_name;
+    if (name.compare(0, 4, "node") != 0 || name.size() == 4 
+        || !std::all_of(name.begin() + 4, name.end(), [](char c) { return std::isdigit(c); })) {
+      continue;
+    }
+    const size_t node = std::stoul(name.substr(4));
+    if (node >= topology.node_cpus.size()) {
+      topology.node_cpus.resize(node + 1);
+    }
+    topology.node_cpus[node] = parse_cpu_list(read_line(node_dir + "/" + name + "/cpulist"));
+  }
+  closedir(dir);
+#else
+  (void)sysfs_root;
+#endif
+  return topology;
+}
+
+int get_pci_numa_node(const std::string& pci_bus_id, const std::string& sysfs_root)
+{
+  std::string bus_id = pci_bus_id;
+  std::transform(bus_id.begin(), bus_id.end(), bus_id.begin(), [](char c) { return std::tolower(c); });
+  const std::string line = read_line(sysfs_root + "/bus/pci/devices/" + bus_id + "/numa_node");
+  try {
+    return line.empty() ? -1 : std::max(-1, std::stoi(line));
+  } catch (const std::exception&) {
+    return -1;
+  }
+}
+
+int get_current_device_numa_node(const std::string& sysfs_root)
+{
+  int device;
+  char bus_id[64];
+  if (hipGetDevice(&device) != hipSuccess 
+      || hipDeviceGetPCIBusId(bus_id, sizeof(bus_id), device) != hipSuccess) {
+    // Clear the error, there is just no device to be close to
+    (void)hipGetLastError();
+    return -1;
+  }
+  return get_pci_numa_node(bus_id, sysfs_root);
+}
+
+struct HostThreadPool::HostThreadPoolImpl {
+  std::mutex mutex;
+  std::condition_variable work_available;
+  std::deque<std::function<void()>> tasks;
+  bool stopping;
+  int numa_node;
+  std::vector<int> cpus;
+  std::vector<std::thread> threads;
+
+  explicit HostThreadPoolImpl(const HostThreadPoolOptions& options)
+    : stopping(false),
+      numa_node(-1)
+  {
+    if (options.pin_threads) {
+      const int node = options.numa_node >= 0 ? options.numa_node : get_current_device_numa_node(options.sysfs_root);
+      const HostTopology topology = HostTopology::detect(options.sysfs_root);
+      if (node >= 0 && static_cast<size_t>(node) < topology.node_cpus.size() && !topology.node_cpus[node].empty()) {
+        numa_node = node;
+        cpus = topology.node_cpus[node];
+      }
+    }
+
+    size_t num_threads = options.num_threads;
+    if (num_threads == 0) {
+      num_threads = numa_node >= 0 ? cpus.size() : std::max(1U, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads.emplace_back([this]() { run(); });
+    }
+  }
+
+  ~HostThreadPoolImpl()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    work_available.notify_all();
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  void submit(std::function<void()> task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      tasks.push_back(std::move(task));
+    }
+    work_available.notify_one();
+  }
+
+private:
+  void run()
+  {
+    if (numa_node >= 0) {
+      pin_current_thread(cpus);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      work_available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+      if (tasks.empty()) {
+        // Only once stopping, so queued tasks still run
+        return;
+      }
+      std::function<void()> task = std::move(tasks.front());
+      tasks.pop_front();
+
+      lock.unlock();
+      try {
+        task();
+      } catch (const std::exception& e) {
+        // Nobody waits on a submitted task, so report what it threw
+        Check::exception_to_error(e, "HostThreadPool task");
+      } catch (...) {
+        std::cerr << "ERROR: In HostThreadPool task: unknown exception" << std::endl;
+      }
+      lock.lock();
+    }
+  }
+};
+
+HostThreadPool::HostThreadPool(const HostThreadPoolOptions& options)
+  : impl(std::make_unique<HostThreadPoolImpl>(options))
+{}
+
+HostThreadPool::~HostThreadPool()
+{}
+
+void HostThreadPool::parallel_for(
+    const size_t num_tasks, const std::function<void(size_t)>& fn, const size_t max_threads)
+{
+  if (num_tasks == 0) {
+    return;
+  }
+
+  size_t num_workers = std::min(num_tasks, impl->threads.size() + 1);
+  if (max_threads > 0) {
+    num_workers = std::min(num_workers, max_threads);
+  }
+
+  auto loop = std::make_shared<ParallelLoop>(fn, num_tasks);
+  for (size_t i = 1; i < num_workers; ++i) {
+    impl->submit([loop]() { loop->work(); });
+  }
+  loop->work();
+
+  std::unique_lock<std::mutex> lock(loop->mutex);
+  loop->all_done.wait(lock, [&]() { return loop->num_done == num_tasks; });
+  if (loop->error) {
+    std::rethrow_exception(loop->error);
+  }
+}
+
+void HostThreadPool::submit(std::function<void()> task)
+{
+  impl->submit(std::move(task));
+}
+
+size_t HostThreadPool::get_num_threads() const
+{
+  return impl->threads.size();
+}
+
+int HostThreadPool::get_numa_node() const
+{
+  return impl->numa_node;
+}
+
+const std::vector<int>& HostThreadPool::get_cpus() const
+{
+  return impl->cpus;
+}
+
+namespace {
+
+struct SharedHostThreadPool {
+  std::mutex mutex;
+  HostThreadPoolOptions options;
+  std::unique_ptr<HostThreadPool> pool;
+};
+
+SharedHostThreadPool& shared_host_thread_pool()
+{
+  static SharedHostThreadPool shared;
+  return shared;
+}
+
+} // namespace
+
+void configure_host_thread_pool(const HostThreadPoolOptions& options)
+{
+  SharedHostThreadPool& shared = shared_host_thread_pool();
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  if (shared.pool) {
+    throw HipCompException(hipcompErrorNotSupported, "The host thread pool is already in use.");
+  }
+  shared.options = options;
+}
+
+HostThreadPool& get_host_thread_pool()
+{
+  SharedHostThreadPool& shared = shared_host_thread_pool();
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  if (!shared.pool) {
+    shared.pool.reset(new HostThreadPool(shared.options));
+  }
+  return *shared.pool;
+}
+
+} // namespace hipcomp
@@ -0,0 +1,239 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <future>
+
+#include "hipcomp/hipcompHybridBackend.hpp"
+
+#include "Check.h"
+#include "ThroughputSplit.hpp"
+
+namespace hipcomp {
+
+struct HybridBatchedBackend::HybridBatchedBackendImpl {
+  typedef std::chrono::steady_clock Clock;
+
+  std::unique_ptr<BatchedCompressBackend> device_backend;
+  std::unique_ptr<BatchedCompressBackend> host_backend;
+  // Compression and decompression run at different rates on each side
+  ThroughputSplit compress_split;
+  ThroughputSplit decompress_split;
+
+  HybridBatchedBackendImpl(
+      std::unique_ptr<BatchedCompressBackend> device_backend,
+      std::unique_ptr<BatchedCompressBackend> host_backend,
+      const HybridOptions& options)
+    : device_backend(std::move(device_backend)),
+      host_backend(std::move(host_backend)),
+      compress_split(this->device_backend != nullptr, options.initial_device_share, options.smoothing, options.min_share),
+      decompress_split(this->device_backend != nullptr, options.initial_device_share, options.smoothing, options.min_share)
+  {
+    if (this->host_backend == nullptr) {
+      throw HipCompException(hipcompErrorInvalidValue, "A hybrid backend needs a host backend.");
+    }
+    if (options.smoothing <= 0.0 || options.smoothing > 1.0 
+        || options.min_share < 0.0 || options.min_share > 0.5
+        || options.initial_device_share < 0.0 || options.initial_device_share > 1.0) {
+      throw HipCompException(hipcompErrorInvalidValue, "Hybrid options are out of range.");
+    }
+  }
+
+  /**
+   * @brief Runs the front of a batch on the device and the rest on the host, 
+   * concurrently, and updates split with the time each side took.
+   *
+   * run_part(backend, first_chunk, num_chunks) runs a part of the batch. The split
+   * is by work_bytes. If either part fails, both are waited for and the device's 
+   * exception is rethrown first.
+   */
+  template<typename RunPart>
+  void run_split(
+      ThroughputSplit& split, 
+      const size_t* const work_bytes, 
+      const size_t batch_size, 
+      RunPart run_part)
+  {
+    if (batch_size == 0) {
+      return;
+    }
+
+    const size_t num_device = split.split(work_bytes, batch_size);
+    const size_t num_host = batch_size - num_device;
+
+    auto timed_part = [&](BatchedCompressBackend& backend, const size_t first_chunk, const size_t num_chunks) {
+      const Clock::time_point start = Clock::now();
+      run_part(backend, first_chunk, num_chunks);
+      return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    double device_seconds = 0.0;
+    double host_seconds = 0.0;
+    if (num_host == 0) {
+      device_seconds = timed_part(*device_backend, 0, num_device);
+    } else if (num_device == 0) {
+      host_seconds = timed_part(*host_backend, 0, batch_size);
+    } else {
+      // The device part mostly waits on its stream, so it gets the extra thread
+      std::future<double> device_part = std::async(
+          std::launch::async, timed_part, std::ref(*device_backend), size_t(0), num_device);
+
+      std::exception_ptr host_error;
+      try {
+        host_seconds = timed_part(*host_backend, num_device, num_host);
+      } catch (...) {
+        host_error = std::current_exception();
+      }
+      device_seconds = device_part.get();
+      if (host_error) {
+        std::rethrow_exception(host_error);
+      }
+    }
+
+    size_t device_bytes = 0;
+    for (size_t ix = 0; ix < num_device; ++ix) {
+      device_bytes += work_bytes[ix];
+    }
+    size_t host_bytes = 0;
+    for (size_t ix = num_device; ix < batch_size; ++ix) {
+      host_bytes += work_bytes[ix];
+    }
+    split.record(device_bytes, device_seconds, host_bytes, host_seconds);
+  }
+};
+
+HybridBatchedBackend::HybridBatchedBackend(
+    std::unique_ptr<BatchedCompressBackend> device_backend,
+    std::unique_ptr<BatchedCompressBackend> host_backend,
+    const HybridOptions& options)
+  : impl(std::make_unique<HybridBatchedBackendImpl>(std::move(device_backend), std::move(host_backend), options))
+{}
+
+HybridBatchedBackend::~HybridBatchedBackend() {}
+
+size_t HybridBatchedBackend::get_max_chunk_size() const
+{
+  const size_t host_max = impl->host_backend->get_max_chunk_size();
+  return impl->device_backend ? std::min(host_max, impl->device_backend->get_max_chunk_size()) : host_max;
+}
+
+size_t HybridBatchedBackend::get_max_batch_size() const
+{
+  const size_t host_max = impl->host_backend->get_max_batch_size();
+  return impl->device_backend ? std::min(host_max, impl->device_backend->get_max_batch_size()) : host_max;
+}
+
+size_t HybridBatchedBackend::get_max_compressed_chunk_size(const size_t uncompressed_bytes) const
+{
+  const size_t host_max = impl->host_backend->get_max_compressed_chunk_size(uncompressed_bytes);
+  return impl->device_backend 
+      ? std::max(host_max, impl->device_backend->get_max_compressed_chunk_size(uncompressed_bytes)) 
+      : host_max;
+}
+
+void HybridBatchedBackend::compress_batch(
+    const void* const* uncompressed_ptrs,
+    const size_t* uncompressed_bytes,
+    const size_t max_uncompressed_chunk_bytes,
+    const size_t batch_size,
+    void* const* compressed_ptrs,
+    size_t* compressed_bytes)
+{
+  if (batch_size > get_max_batch_size() || max_uncompressed_chunk_bytes > get_max_chunk_size()) {
+    throw HipCompException(hipcompErrorInvalidValue, "Batch exceeds the limits the backend was created with.");
+  }
+
+  impl->run_split(impl->compress_split, uncompressed_bytes, batch_size, 
+      [&](BatchedCompressBackend& backend, const size_t first_chunk, const size_t num_chunks) {
+        const size_t part_max_chunk_bytes = *std::max_element(
+            uncompressed_bytes + first_chunk, uncompressed_bytes + first_chunk + num_chunks);
+        backend.compress_batch(
+            uncompressed_ptrs + first_chunk,
+            uncompressed_bytes + first_chunk,
+            part_max_chunk_bytes,
+            num_chunks,
+            compressed_ptrs + first_chunk,
+            compressed_bytes + first_chunk);
+      });
+}
+
+void HybridBatchedBackend::decompress_batch(
+    const void* const* compressed_ptrs,
+    const size_t* compressed_bytes,
+    const size_t* uncompressed_buffer_bytes,
+    const size_t batch_size,
+    void* const* uncompressed_ptrs,
+    size_t* uncompressed_bytes)
+{
+  if (batch_size > get_max_batch_size()) {
+    throw HipCompException(hipcompErrorInvalidValue, "Batch exceeds the limits the backend was created with.");
+  }
+
+  // Decompression work follows the output size more closely than the input size
+  impl->run_split(impl->decompress_split, uncompressed_buffer_bytes, batch_size, 
+      [&](BatchedCompressBackend& backend, const size_t first_chunk, const size_t num_chunks) {
+        backend.decompress_batch(
+            compressed_ptrs + first_chunk,
+            compressed_bytes + first_chunk,
+            uncompressed_buffer_bytes + first_chunk,
+            num_chunks,
+            uncompressed_ptrs + first_chunk,
+            uncompressed_bytes + first_chunk);
+      });
+}
+
+double HybridBatchedBackend::get_compress_device_share() const
+{
+  return impl->compress_split.get_device_share();
+}
+
+double HybridBatchedBackend::get_decompress_device_share() const
+{
+  return impl->decompress_split.get_device_share();
+}
+
+std::unique_ptr<HybridBatchedBackend> create_hybrid_lz4_backend(
+    const hipcompBatchedLZ4Opts_t& format_opts, 
+    hipStream_t stream, 
+    const size_t max_batch_size, 
+    const size_t max_chunk_bytes,
+    const HybridOptions& options,
+    const size_t num_host_threads)
+{
+  std::unique_ptr<BatchedCompressBackend> device_backend;
+  int num_devices = 0;
+  if (hipGetDeviceCount(&num_devices) == hipSuccess && num_devices > 0) {
+    device_backend = create_batched_compress_backend(format_opts, stream, max_batch_size, max_chunk_bytes);
+  } else {
+    // Clear the error of the failed query, there is just no device to use
+    (void)hipGetLastError();
+  }
+
+  return std::make_unique<HybridBatchedBackend>(
+      std::move(device_backend), 
+      create_host_lz4_backend(max_batch_size, max_chunk_bytes, num_host_threads),
+      options);
+}
+
+} // namespace hipcomp
@@ -0,0 +1,97 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "hipcomp/hipcompManager.hpp"
+
+#include "HipUtils.h"
+
+namespace hipcomp {
+
+/**
+ * @brief Keeps the configs of wrapped managers alive while work that writes their 
+ * statuses may still be running.
+ *
+ * Managers that issue work through other managers create a config per piece of work.
+ * Their statuses return to the wrapped manager's pool when the config is destroyed, so
+ * the configs are retired with an event on the stream that joins the work and released
+ * once that event has completed.
+ */
+struct InFlightConfigs {
+
+private:
+  struct Entry {
+    hipEvent_t done;
+    std::vector<CompressionConfig> comp_configs;
+    std::vector<DecompressionConfig> decomp_configs;
+  };
+
+  std::deque<Entry> entries;
+
+public:
+  InFlightConfigs() = default;
+  InFlightConfigs(const InFlightConfigs&) = delete;
+  InFlightConfigs& operator=(const InFlightConfigs&) = delete;
+
+  ~InFlightConfigs()
+  {
+    for (auto& entry : entries) {
+      hipEventDestroy(entry.done);
+    }
+  }
+
+  /**
+   * @brief Holds the configs until the work currently on stream has finished
+   */
+  void retire(
+      hipStream_t stream,
+      std::vector<CompressionConfig>&& comp_configs,
+      std::vector<DecompressionConfig>&& decomp_configs)
+  {
+    hipEvent_t done;
+    HipUtils::check(hipEventCreateWithFlags(&done, hipEventDisableTiming));
+    HipUtils::check(hipEventRecord(done, stream));
+    entries.push_back(Entry{done, std::move(comp_configs), std::move(decomp_configs)});
+  }
+
+  /**
+   * @brief Releases the configs whose work has finished. Does not block.
+   */
+  void release_finished()
+  {
+    while (!entries.empty()) {
+      const hipError_t err = hipEventQuery(entries.front().done);
+      if (err == hipErrorNotReady) {
+        break;
+      }
+      HipUtils::check(err);
+      HipUtils::check(hipEventDestroy(entries.front().done));
+      entries.pop_front();
+    }
+  }
+};
+
+} // namespace hipcomp
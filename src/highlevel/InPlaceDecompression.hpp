@@ -0,0 +1,147 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hipcomp.hpp"
+
+namespace hipcomp {
+
+/**
+ * @brief A contiguous range of chunk indices that are decompressed by one launch
+ */
+struct ChunkRange {
+  size_t first_chunk;
+  size_t num_chunks;
+};
+
+/**
+ * @brief Orders the chunks of an HLIF buffer for decompression into memory that
+ * overlaps the compressed data.
+ *
+ * Chunk k writes [k * uncomp_chunk_size, (k + 1) * uncomp_chunk_size) of the output.
+ * A chunk may only run once every other chunk whose compressed bytes lie in that range
+ * has been decompressed, so the chunks are grouped into rounds by a topological sort of
+ * that dependency. Chunks within a round are independent; each round is returned as one
+ * or more contiguous ranges that can be launched back to back on a single stream.
+ *
+ * Throws if a chunk would overwrite its own compressed data or if the dependencies are
+ * cyclic. Neither happens for buffers compressed with an in-place layout and placed at the
+ * end of an output buffer that includes the margin reported by the manager.
+ *
+ * @param decomp_buffer Address of the output buffer
+ * @param decomp_data_size The total decompressed size
+ * @param uncomp_chunk_size The uncompressed size of every chunk but the last
+ * @param comp_data_buffer Address of the compressed chunk data
+ * @param comp_chunk_offsets Offset of each compressed chunk relative to comp_data_buffer
+ * @param comp_chunk_sizes Size of each compressed chunk
+ * \return The launches in execution order
+ */
+inline std::vector<ChunkRange> schedule_in_place_decompression(
+    const uintptr_t decomp_buffer,
+    const size_t decomp_data_size,
+    const size_t uncomp_chunk_size,
+    const uintptr_t comp_data_buffer,
+    const std::vector<size_t>& comp_chunk_offsets,
+    const std::vector<size_t>& comp_chunk_sizes)
+{
+  const size_t num_chunks = comp_chunk_offsets.size();
+  if (comp_chunk_sizes.size() != num_chunks || uncomp_chunk_size == 0) {
+    throw HipCompException(hipcompErrorInvalidValue, "Invalid chunk table for in-place decompression");
+  }
+
+  const uintptr_t decomp_end = decomp_buffer + decomp_data_size;
+
+  // blockers[k] is the number of chunks whose compressed data chunk k overwrites
+  std::vector<size_t> blockers(num_chunks, 0);
+  std::vector<std::vector<size_t>> dependents(num_chunks);
+
+  for (size_t ix_chunk = 0; ix_chunk < num_chunks; ++ix_chunk) {
+    const uintptr_t comp_start = comp_data_buffer + comp_chunk_offsets[ix_chunk];
+    const uintptr_t comp_end = comp_start + comp_chunk_sizes[ix_chunk];
+    if (comp_end <= decomp_buffer || comp_start >= decomp_end || comp_start == comp_end) {
+      continue;
+    }
+
+    const size_t first_overlap = 
+        comp_start <= decomp_buffer ? 0 : (comp_start - decomp_buffer) / uncomp_chunk_size;
+    const size_t last_overlap = 
+        ((comp_end < decomp_end ? comp_end : decomp_end) - decomp_buffer - 1) / uncomp_chunk_size;
+
+    for (size_t ix_overlap = first_overlap; ix_overlap <= last_overlap && ix_overlap < num_chunks; ++ix_overlap) {
+      if (ix_overlap == ix_chunk) {
+        throw HipCompException(hipcompErrorInvalidValue, 
+            "In-place decompression of chunk " + std::to_string(ix_chunk) 
+            + " would overwrite its own input. The output buffer margin is too small.");
+      }
+      ++blockers[ix_overlap];
+      dependents[ix_chunk].push_back(ix_overlap);
+    }
+  }
+
+  std::vector<size_t> round;
+  for (size_t ix_chunk = 0; ix_chunk < num_chunks; ++ix_chunk) {
+    if (blockers[ix_chunk] == 0) {
+      round.push_back(ix_chunk);
+    }
+  }
+
+  std::vector<ChunkRange> launches;
+  std::vector<size_t> next_round;
+  size_t num_scheduled = 0;
+  while (!round.empty()) {
+    // round is sorted, so consecutive indices fold into a single launch
+    for (size_t ix = 0; ix < round.size(); ++ix) {
+      if (ix > 0 && round[ix] == round[ix - 1] + 1) {
+        ++launches.back().num_chunks;
+      } else {
+        launches.push_back(ChunkRange{round[ix], 1});
+      }
+
+      for (const size_t dependent : dependents[round[ix]]) {
+        if (--blockers[dependent] == 0) {
+          next_round.push_back(dependent);
+        }
+      }
+    }
+    num_scheduled += round.size();
+
+    std::sort(next_round.begin(), next_round.end());
+    round.swap(next_round);
+    next_round.clear();
+  }
+
+  if (num_scheduled != num_chunks) {
+    throw HipCompException(hipcompErrorNotSupported, 
+        "The compressed chunks cannot be decompressed in place. "
+        "Compress with CompressionConfig::in_place_decompressible set.");
+  }
+
+  return launches;
+}
+
+} // namespace hipcomp
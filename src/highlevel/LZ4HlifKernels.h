@@ -49,6 +49,7 @@
 
 #pragma once
 
+#include "hipcomp/hipcompManager.hpp"
 #include "hipcomp_common_deps/hlif_shared_types.hpp"
 
 #include "LZ4Types.h"
@@ -74,8 +75,8 @@ void lz4HlifBatchDecompress(
     hipStream_t stream,
     hipcompStatus_t* output_status);
 
-size_t batchedLZ4DecompMaxBlockOccupancy(hipcompType_t data_type, const int device_id);
+KernelResourceUsage batchedLZ4DecompKernelUsage(hipcompType_t data_type, const int device_id);
 
-size_t batchedLZ4CompMaxBlockOccupancy(hipcompType_t data_type, const int device_id);
+KernelResourceUsage batchedLZ4CompKernelUsage(hipcompType_t data_type, const int device_id);
 
 } // namespace hipcomp
@@ -97,14 +97,14 @@ public:
     return max_comp_chunk_size;
   }
 
-  uint32_t compute_compression_max_block_occupancy() final override 
+  KernelResourceUsage compute_compression_kernel_usage() final override 
   {
-    return batchedLZ4CompMaxBlockOccupancy(format_spec->data_type, device_id);
+    return batchedLZ4CompKernelUsage(format_spec->data_type, device_id);
   }
 
-  uint32_t compute_decompression_max_block_occupancy() final override 
+  KernelResourceUsage compute_decompression_kernel_usage() final override 
   {
-    return batchedLZ4DecompMaxBlockOccupancy(format_spec->data_type, device_id); 
+    return batchedLZ4DecompKernelUsage(format_spec->data_type, device_id); 
   }
 
   LZ4FormatSpecHeader* get_format_header() final override 
@@ -112,14 +112,24 @@ public:
     return format_spec;
   }
 
-  void do_batch_compress(const CompressArgs& compress_args) final override
+  const char* get_codec_name() const final override
+  {
+    return "lz4";
+  }
+
+  hipcompType_t get_data_type() const final override
+  {
+    return format_spec->data_type;
+  }
+
+  void do_batch_compress(const CompressArgs& compress_args, hipStream_t stream) final override
   {
     lz4HlifBatchCompress(
         compress_args,
         hash_table_size,
         get_max_comp_ctas(),
         format_spec->data_type,
-        user_stream);
+        stream);
   }
 
   void do_batch_decompress(
@@ -128,18 +138,19 @@ public:
       const uint32_t num_chunks,
       const size_t* comp_chunk_offsets,
       const size_t* comp_chunk_sizes,
-      hipcompStatus_t* output_status) final override
+      hipcompStatus_t* output_status,
+      const ExecutionContext& context) final override
   {        
     lz4HlifBatchDecompress(
         comp_data_buffer,
         decomp_buffer,
         get_uncomp_chunk_size(),
-        ix_chunk,
+        context.ix_chunk,
         num_chunks,
         comp_chunk_offsets,
         comp_chunk_sizes,
         get_max_decomp_ctas(),
-        user_stream,
+        context.stream,
         output_status);
   }
 
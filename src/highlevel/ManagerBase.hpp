@@ -50,13 +50,19 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "hipcomp/hipcompManager.hpp"
 
 #include "Check.h"
+#include "CommonHeaderKernels.h"
+#include "ExecutionContexts.hpp"
 #include "HipUtils.h"
+#include "Metrics.h"
 #include "PinnedPtrs.hpp"
+#include "Tracing.h"
+#include "common.h"
 #include "hipcomp_common_deps/hlif_shared_types.hpp"
 
 namespace hipcomp {
@@ -68,6 +74,10 @@ namespace hipcomp {
  *
  * - Contains a CPU/GPU-accessible memory pool for result statuses to avoid repeated 
  *   allocations when tasked with multiple compressions / decompressions.
+ *
+ * - Can be used from several host threads at once. Calls on the user stream share the 
+ *   scratch buffer and chunk counters and are issued one at a time. Calls on other streams
+ *   lease their own from a pool of execution contexts and are issued in parallel.
  * 
  * - Templated on the particular format's FormatSpecHeader so that some operations can be shared here. 
  *   This is likely to be inherited by template classes. In this case, 
@@ -81,16 +91,21 @@ template <typename FormatSpecHeader>
 struct ManagerBase : hipcompManagerBase {
 
 protected: // members
-  CommonHeader* common_header_cpu;
   hipStream_t user_stream;
   uint8_t* scratch_buffer;
   size_t scratch_buffer_size;
+  // ix_chunk[0] hands out chunks, ix_chunk[1] orders chunk output for in-place layouts
+  uint32_t* ix_chunk;
   int device_id;
   PinnedPtrPool<hipcompStatus_t> status_pool;
   bool manager_filled_scratch_buffer;
 
 private: // members
   bool scratch_buffer_filled;
+  std::mutex scratch_buffer_mutex;
+  // Held while a call issues its work with the user stream context
+  std::mutex user_context_mutex;
+  ExecutionContextPool context_pool;
 
 protected: // members
   bool finished_init;
@@ -103,17 +118,19 @@ public: // API
    * @param device_id The default device ID to use for all operations. Optional, defaults to the default device
    */
   ManagerBase(hipStream_t user_stream = 0, int device_id = 0) 
-    : common_header_cpu(),
-      user_stream(user_stream),
+    : user_stream(user_stream),
       scratch_buffer(nullptr),
       scratch_buffer_size(0),
+      ix_chunk(nullptr),
       device_id(device_id),
       status_pool(),
       manager_filled_scratch_buffer(false),
       scratch_buffer_filled(false),
+      scratch_buffer_mutex(),
+      context_pool(),
       finished_init(false)
   {
-    HipUtils::check(hipHostMalloc(&common_header_cpu, sizeof(CommonHeader), hipHostMallocDefault));
+    HipUtils::check(hipMalloc(&ix_chunk, 2 * sizeof(uint32_t)));
   }
 
   size_t get_required_scratch_buffer_size() final override {
@@ -126,18 +143,71 @@ public: // API
   ManagerBase() = delete;     
 
   size_t get_compressed_output_size(uint8_t* comp_buffer) final override {
-    CommonHeader* common_header = reinterpret_cast<CommonHeader*>(comp_buffer);
+    check_not_capturing("get_compressed_output_size() cannot be captured into a graph. Use get_compressed_output_size_async().");
+
+    CommonHeader common_header;
     
-    HipUtils::check(hipMemcpy(common_header_cpu, 
-        common_header, 
+    HipUtils::check(hipMemcpy(&common_header, 
+        comp_buffer, 
         sizeof(CommonHeader),
         hipMemcpyDefault));
 
-    return common_header_cpu->comp_data_size + common_header_cpu->comp_data_offset;
+    return common_header.comp_data_size + common_header.comp_data_offset;
   };
+
+  void get_compressed_output_size_async(
+      const uint8_t* comp_buffer, 
+      size_t* comp_size,
+      hipEvent_t event = nullptr) final override
+  {
+    CHECK_NOT_NULL(comp_size);
+
+    copyCompressedOutputSize(reinterpret_cast<const CommonHeader*>(comp_buffer), comp_size, user_stream);
+
+    if (event != nullptr) {
+      HipUtils::check(hipEventRecord(event, user_stream));
+    }
+  }
   
+  MemoryFootprint get_memory_footprint(
+      const size_t decomp_buffer_size, 
+      const size_t batch_count = 1) final override
+  {
+    assert(finished_init);
+
+    MemoryFootprint footprint{};
+    footprint.scratch = scratch_buffer_size;
+    // Borrows a status from the pool, which only allocates pinned memory when it is empty
+    footprint.max_output = batch_count * configure_compression(decomp_buffer_size).max_compressed_buffer_size;
+
+    footprint.status_pool = PinnedPtrPool<hipcompStatus_t>::capacity_for(batch_count) * sizeof(hipcompStatus_t);
+    footprint.headers = sizeof(FormatSpecHeader);
+    footprint.ix_chunk = 2 * sizeof(uint32_t);
+    footprint.contexts = context_pool.get_device_bytes();
+    footprint.configs = batch_count * (sizeof(CompressionConfig) 
+        + sizeof(typename PinnedPtrPool<hipcompStatus_t>::PinnedPtrHandle));
+
+    do_get_memory_footprint(footprint);
+
+    return footprint;
+  }
+
+  std::vector<KernelResourceUsage> get_kernel_resource_usage() final override
+  {
+    assert(finished_init);
+
+    std::vector<KernelResourceUsage> usage;
+    do_get_kernel_resource_usage(usage);
+    return usage;
+  }
+
+  size_t get_format_header_size() final override
+  {
+    return sizeof(FormatSpecHeader);
+  }
+
   virtual ~ManagerBase() {
-    HipUtils::check(hipHostFree(common_header_cpu));
+    HipUtils::check(hipFree(ix_chunk));
     if (scratch_buffer_filled) {
       if (manager_filled_scratch_buffer) {
         HipUtils::check(hipFree(scratch_buffer));
@@ -158,6 +228,8 @@ public: // API
 
   virtual DecompressionConfig configure_decompression(const uint8_t* comp_buffer) final override
   {
+    check_not_capturing("configure_decompression(comp_buffer) cannot be captured into a graph. Use configure_decompression(comp_config).");
+
     const CommonHeader* common_header = reinterpret_cast<const CommonHeader*>(comp_buffer);
     DecompressionConfig decomp_config{status_pool};
     
@@ -185,7 +257,9 @@ public: // API
 
   void set_scratch_buffer(uint8_t* new_scratch_buffer) final override
   {
+    std::lock_guard<std::mutex> lock(scratch_buffer_mutex);
     if (scratch_buffer_filled) {
+      metrics::count_event("scratch_reallocation", scratch_buffer_size);
       if (manager_filled_scratch_buffer) {
         #if CUDART_VERSION >= 11020
           HipUtils::check(hipFreeAsync(scratch_buffer, user_stream));
@@ -200,63 +274,268 @@ public: // API
     scratch_buffer = new_scratch_buffer;
   }
 
-  virtual void compress(
-      const uint8_t* decomp_buffer, 
-      uint8_t* comp_buffer,
-      const CompressionConfig& comp_config) 
+  void allocate_scratch_buffer() final override
   {
-    assert(finished_init);
-
+    std::lock_guard<std::mutex> lock(scratch_buffer_mutex);
     if (!scratch_buffer_filled) {
+      check_not_capturing("The scratch buffer cannot be allocated during graph capture. Call allocate_scratch_buffer() before capturing.");
+
       #if CUDART_VERSION >= 11020
+        //: TODO check ROCm version for which this is available
         HipUtils::check(hipMallocAsync(&scratch_buffer, scratch_buffer_size, user_stream));
       #else
         HipUtils::check(hipMalloc(&scratch_buffer, scratch_buffer_size));
       #endif
+      metrics::count_event("scratch_allocation", scratch_buffer_size);
       scratch_buffer_filled = true;
       manager_filled_scratch_buffer = true;
     }    
+  }
 
-    CommonHeader* common_header = reinterpret_cast<CommonHeader*>(comp_buffer);
-    FormatSpecHeader* comp_format_header = reinterpret_cast<FormatSpecHeader*>(common_header + 1);
-    HipUtils::check(hipMemcpyAsync(comp_format_header, get_format_header(), sizeof(FormatSpecHeader), hipMemcpyDefault, user_stream));
+  void compress(
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config) final override
+  {
+    assert(finished_init);
 
-    HipUtils::check(hipMemsetAsync(&common_header->comp_data_size, 0, sizeof(uint64_t), user_stream));
+    std::lock_guard<std::mutex> lock(user_context_mutex);
+    compress_in_context(decomp_buffer, comp_buffer, comp_config, get_user_context());
+  }
 
-    uint8_t* new_comp_buffer = comp_buffer + sizeof(CommonHeader) + sizeof(FormatSpecHeader);
-    do_compress(common_header, decomp_buffer, new_comp_buffer, comp_config);
+  void compress(
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config,
+      hipStream_t stream) final override
+  {
+    assert(finished_init);
+
+    if (stream == user_stream) {
+      std::lock_guard<std::mutex> lock(user_context_mutex);
+      compress_in_context(decomp_buffer, comp_buffer, comp_config, get_user_context());
+      return;
+    }
+    check_other_streams_supported();
+    ExecutionContextPool::Lease lease = context_pool.acquire(stream);
+    compress_in_context(decomp_buffer, comp_buffer, comp_config, lease.get());
+    lease.release();
   }
 
-  virtual void decompress(
+  void decompress(
       uint8_t* decomp_buffer, 
       const uint8_t* comp_buffer,
-      const DecompressionConfig& config)
+      const DecompressionConfig& config) final override
   {
     assert(finished_init);
 
-    if (!scratch_buffer_filled) {
-      #if CUDART_VERSION >= 11020
-        //: TODO check ROCm version for which this is available
-        HipUtils::check(hipMallocAsync(&scratch_buffer, scratch_buffer_size, user_stream));
-      #else
-        HipUtils::check(hipMalloc(&scratch_buffer, scratch_buffer_size));
-      #endif
-      scratch_buffer_filled = true;
-      manager_filled_scratch_buffer = true;
-    }    
+    std::lock_guard<std::mutex> lock(user_context_mutex);
+    decompress_in_context(decomp_buffer, comp_buffer, config, get_user_context());
+  }
+
+  void decompress(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& config,
+      hipStream_t stream) final override
+  {
+    assert(finished_init);
+
+    if (stream == user_stream) {
+      std::lock_guard<std::mutex> lock(user_context_mutex);
+      decompress_in_context(decomp_buffer, comp_buffer, config, get_user_context());
+      return;
+    }
+    check_other_streams_supported();
+    ExecutionContextPool::Lease lease = context_pool.acquire(stream);
+    decompress_in_context(decomp_buffer, comp_buffer, config, lease.get());
+    lease.release();
+  }
+
+  virtual size_t get_in_place_decompression_margin(const size_t /*decomp_buffer_size*/) override
+  {
+    throw HipCompException(hipcompErrorNotSupported, "In-place decompression is not supported by this format.");
+  }
+
+  void decompress_in_place(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& config) final override
+  {
+    assert(finished_init);
+
+    check_not_capturing("In-place decompression reads the chunk table on the host and cannot be captured into a graph.");
 
     const uint8_t* new_comp_buffer = comp_buffer + sizeof(CommonHeader) + sizeof(FormatSpecHeader);
 
-    do_decompress(decomp_buffer, new_comp_buffer, config);
+    std::lock_guard<std::mutex> lock(user_context_mutex);
+    TraceScope trace(
+        "decompress_in_place",
+        get_codec_name(),
+        config.decomp_data_size,
+        config.num_chunks,
+        user_stream,
+        get_chunk_size(),
+        get_data_type());
+    trace.run([&]() { do_decompress_in_place(decomp_buffer, new_comp_buffer, config, get_user_context()); });
   }
   
 protected: // helpers 
   virtual void finish_init() {
     scratch_buffer_size = compute_scratch_buffer_size();
+    context_pool.set_scratch_buffer_size(scratch_buffer_size);
     finished_init = true;
   }
 
+  /**
+   * @brief Throws if the user stream is being captured into a graph
+   *
+   * @param msg The message of the exception.
+   */
+  void check_not_capturing(const char* msg)
+  {
+    if (HipUtils::is_capturing(user_stream)) {
+      throw HipCompException(hipcompErrorNotSupported, msg);
+    }
+  }
+
+  /**
+   * @brief The name of the format in traces, e.g. "lz4"
+   */
+  virtual const char* get_codec_name() const = 0;
+
+  /**
+   * @brief The uncompressed bytes of a chunk in traces, or 0 if the format has no chunks
+   */
+  virtual size_t get_chunk_size() const
+  {
+    return 0;
+  }
+
+  /**
+   * @brief The type of the compressed data in traces, if the format has such an option
+   */
+  virtual hipcompType_t get_data_type() const
+  {
+    return HIPCOMP_TYPE_CHAR;
+  }
+
 private: // helpers
+  /**
+   * @brief Resets the status as part of a graph being captured
+   *
+   * A config's status is reset when the config is created and kernels only write 
+   * errors, so without this a replay would report the error of a previous replay.
+   */
+  void reset_status_if_capturing(hipcompStatus_t* status, hipStream_t stream)
+  {
+    if (HipUtils::is_capturing(stream)) {
+      resetOutputStatus(status, stream);
+    }
+  }
+
+  /**
+   * @brief The context of calls on the user stream, allocating the scratch buffer if needed
+   */
+  ExecutionContext get_user_context()
+  {
+    allocate_scratch_buffer();
+
+    std::lock_guard<std::mutex> lock(scratch_buffer_mutex);
+    return ExecutionContext{user_stream, scratch_buffer, ix_chunk};
+  }
+
+  void check_other_streams_supported()
+  {
+    if (!supports_other_streams()) {
+      throw HipCompException(hipcompErrorNotSupported, 
+          "This manager can only run on the stream it was constructed with.");
+    }
+  }
+
+  void compress_in_context(
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config,
+      const ExecutionContext& context)
+  {
+    TraceScope trace(
+        "compress",
+        get_codec_name(),
+        comp_config.uncompressed_buffer_size,
+        comp_config.num_chunks,
+        context.stream,
+        get_chunk_size(),
+        get_data_type());
+    reset_status_if_capturing(comp_config.get_status(), context.stream);
+
+    CommonHeader* common_header = reinterpret_cast<CommonHeader*>(comp_buffer);
+    FormatSpecHeader* comp_format_header = reinterpret_cast<FormatSpecHeader*>(common_header + 1);
+    HipUtils::check(hipMemcpyAsync(comp_format_header, get_format_header(), sizeof(FormatSpecHeader), hipMemcpyDefault, context.stream));
+
+    HipUtils::check(hipMemsetAsync(&common_header->comp_data_size, 0, sizeof(uint64_t), context.stream));
+
+    uint8_t* new_comp_buffer = comp_buffer + sizeof(CommonHeader) + sizeof(FormatSpecHeader);
+    trace.run([&]() { do_compress(common_header, decomp_buffer, new_comp_buffer, comp_config, context); });
+  }
+
+  void decompress_in_context(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& config,
+      const ExecutionContext& context)
+  {
+    TraceScope trace(
+        "decompress",
+        get_codec_name(),
+        config.decomp_data_size,
+        config.num_chunks,
+        context.stream,
+        get_chunk_size(),
+        get_data_type());
+    reset_status_if_capturing(config.get_status(), context.stream);
+
+    const uint8_t* new_comp_buffer = comp_buffer + sizeof(CommonHeader) + sizeof(FormatSpecHeader);
+
+    trace.run([&]() { do_decompress(decomp_buffer, new_comp_buffer, config, context); });
+  }
+
+  /**
+   * @brief Whether calls may run on streams other than the user stream
+   */
+  virtual bool supports_other_streams()
+  {
+    return true;
+  }
+
+  /**
+   * @brief Optional helper that decompresses into memory overlapping the compressed data
+   *
+   * @param decomp_buffer The location to output the decompressed data to (GPU accessible).
+   * @param comp_buffer The compressed input data following the headers (GPU accessible).
+   * @param decomp_config Resulted from configure_decompression for this comp_buffer.
+   * @param context The user stream context.
+   */
+  virtual void do_decompress_in_place(
+      uint8_t* /*decomp_buffer*/, 
+      const uint8_t* /*comp_buffer*/,
+      const DecompressionConfig& /*config*/,
+      const ExecutionContext& /*context*/)
+  {
+    throw HipCompException(hipcompErrorNotSupported, "In-place decompression is not supported by this format.");
+  }
+
+  /**
+   * @brief Optionally adds format-specific allocations to the footprint
+   */
+  virtual void do_get_memory_footprint(MemoryFootprint& /*footprint*/) 
+  {}
+
+  /**
+   * @brief Optionally adds the kernels the format launches
+   */
+  virtual void do_get_kernel_resource_usage(std::vector<KernelResourceUsage>& /*usage*/) 
+  {}
 
   /**
    * @brief Required helper that actually does the compression 
@@ -266,13 +545,15 @@ private: // helpers
    * @param decomp_buffer_size The length of the uncompressed input data
    * @param comp_buffer The location to output the compressed data to (GPU accessible).
    * @param comp_config Resulted from configure_compression given this decomp_buffer_size.
+   * @param context The stream to issue the work on and the device state this call may use.
    * 
    */
   virtual void do_compress(
       CommonHeader* common_header,
       const uint8_t* decomp_buffer, 
       uint8_t* comp_buffer,
-      const CompressionConfig& comp_config) = 0;
+      const CompressionConfig& comp_config,
+      const ExecutionContext& context) = 0;
 
   /**
    * @brief Required helper that actually does the decompression 
@@ -280,11 +561,13 @@ private: // helpers
    * @param decomp_buffer The location to output the decompressed data to (GPU accessible).
    * @param comp_buffer The compressed input data (GPU accessible).
    * @param decomp_config Resulted from configure_decompression given this decomp_buffer_size.
+   * @param context The stream to issue the work on and the device state this call may use.
    */
   virtual void do_decompress(
       uint8_t* decomp_buffer, 
       const uint8_t* comp_buffer,
-      const DecompressionConfig& config) = 0;
+      const DecompressionConfig& config,
+      const ExecutionContext& context) = 0;
 
   /**
    * @brief Optionally does additional decompression configuration 
@@ -0,0 +1,258 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <functional>
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompGraph.hpp"
+#include "HipUtils.h"
+
+namespace hipcomp {
+
+namespace {
+
+/**
+ * @brief A graph captured from a stream along with its executable form
+ */
+struct CapturedGraph {
+  hipStream_t stream;
+  hipGraph_t graph;
+  hipGraphExec_t exec;
+
+  explicit CapturedGraph(hipStream_t stream)
+    : stream(stream),
+      graph(nullptr),
+      exec(nullptr)
+  {}
+
+  CapturedGraph(const CapturedGraph&) = delete;
+  CapturedGraph& operator=(const CapturedGraph&) = delete;
+
+  ~CapturedGraph()
+  {
+    if (exec != nullptr) {
+      hipGraphExecDestroy(exec);
+    }
+    if (graph != nullptr) {
+      hipGraphDestroy(graph);
+    }
+  }
+
+  /**
+   * @brief Captures the work that issue() places on the stream
+   *
+   * A recapture with the same topology only updates the parameters of the 
+   * executable graph, which is much cheaper than instantiating it again.
+   */
+  void capture(const std::function<void()>& issue)
+  {
+    hipGraph_t new_graph = nullptr;
+    HipUtils::check(hipStreamBeginCapture(stream, hipStreamCaptureModeThreadLocal));
+    try {
+      issue();
+    } catch (...) {
+      // End the capture so that the stream is usable again
+      if (hipStreamEndCapture(stream, &new_graph) == hipSuccess && new_graph != nullptr) {
+        hipGraphDestroy(new_graph);
+      }
+      throw;
+    }
+    HipUtils::check(hipStreamEndCapture(stream, &new_graph));
+
+    if (exec != nullptr) {
+      hipGraphNode_t error_node;
+      hipGraphExecUpdateResult update_result;
+      if (hipGraphExecUpdate(exec, new_graph, &error_node, &update_result) != hipSuccess) {
+        // Clear the error, the graph is instantiated again below
+        hipGetLastError();
+        HipUtils::check(hipGraphExecDestroy(exec));
+        exec = nullptr;
+      }
+    }
+    if (exec == nullptr) {
+      const hipError_t err = hipGraphInstantiate(&exec, new_graph, nullptr, nullptr, 0);
+      if (err != hipSuccess) {
+        exec = nullptr;
+        hipGraphDestroy(new_graph);
+        HipUtils::check(err, "Failed to instantiate the captured graph");
+      }
+    }
+
+    if (graph != nullptr) {
+      HipUtils::check(hipGraphDestroy(graph));
+    }
+    graph = new_graph;
+  }
+
+  void launch()
+  {
+    HipUtils::check(hipGraphLaunch(exec, stream));
+  }
+};
+
+} // namespace
+
+struct CompressGraph::CompressGraphImpl {
+  hipcompManagerBase& manager;
+  CompressionConfig comp_config;
+  CapturedGraph graph;
+  const uint8_t* decomp_buffer;
+  uint8_t* comp_buffer;
+  size_t* comp_size;
+
+  CompressGraphImpl(
+      hipcompManagerBase& manager,
+      hipStream_t manager_stream,
+      const CompressionConfig& comp_config,
+      const uint8_t* decomp_buffer,
+      uint8_t* comp_buffer,
+      size_t* comp_size)
+    : manager(manager),
+      comp_config(comp_config),
+      graph(manager_stream),
+      decomp_buffer(decomp_buffer),
+      comp_buffer(comp_buffer),
+      comp_size(comp_size)
+  {
+    manager.allocate_scratch_buffer();
+    capture();
+  }
+
+  void capture()
+  {
+    graph.capture([this]() {
+      manager.compress(decomp_buffer, comp_buffer, comp_config);
+      if (comp_size != nullptr) {
+        manager.get_compressed_output_size_async(comp_buffer, comp_size);
+      }
+    });
+  }
+
+  void launch(const uint8_t* new_decomp_buffer, uint8_t* new_comp_buffer, size_t* new_comp_size)
+  {
+    if (new_decomp_buffer != decomp_buffer || new_comp_buffer != comp_buffer || new_comp_size != comp_size) {
+      decomp_buffer = new_decomp_buffer;
+      comp_buffer = new_comp_buffer;
+      comp_size = new_comp_size;
+      capture();
+    }
+    graph.launch();
+  }
+};
+
+CompressGraph::CompressGraph(
+    hipcompManagerBase& manager,
+    hipStream_t manager_stream,
+    const CompressionConfig& comp_config,
+    const uint8_t* decomp_buffer,
+    uint8_t* comp_buffer,
+    size_t* comp_size)
+  : impl(std::make_unique<CompressGraphImpl>(
+        manager, manager_stream, comp_config, decomp_buffer, comp_buffer, comp_size))
+{}
+
+CompressGraph::~CompressGraph() {}
+
+void CompressGraph::launch()
+{
+  impl->graph.launch();
+}
+
+void CompressGraph::launch(const uint8_t* decomp_buffer, uint8_t* comp_buffer, size_t* comp_size)
+{
+  impl->launch(decomp_buffer, comp_buffer, comp_size);
+}
+
+const CompressionConfig& CompressGraph::get_config() const
+{
+  return impl->comp_config;
+}
+
+struct DecompressGraph::DecompressGraphImpl {
+  hipcompManagerBase& manager;
+  DecompressionConfig decomp_config;
+  CapturedGraph graph;
+  uint8_t* decomp_buffer;
+  const uint8_t* comp_buffer;
+
+  DecompressGraphImpl(
+      hipcompManagerBase& manager,
+      hipStream_t manager_stream,
+      const DecompressionConfig& decomp_config,
+      uint8_t* decomp_buffer,
+      const uint8_t* comp_buffer)
+    : manager(manager),
+      decomp_config(decomp_config),
+      graph(manager_stream),
+      decomp_buffer(decomp_buffer),
+      comp_buffer(comp_buffer)
+  {
+    manager.allocate_scratch_buffer();
+    capture();
+  }
+
+  void capture()
+  {
+    graph.capture([this]() {
+      manager.decompress(decomp_buffer, comp_buffer, decomp_config);
+    });
+  }
+
+  void launch(uint8_t* new_decomp_buffer, const uint8_t* new_comp_buffer)
+  {
+    if (new_decomp_buffer != decomp_buffer || new_comp_buffer != comp_buffer) {
+      decomp_buffer = new_decomp_buffer;
+      comp_buffer = new_comp_buffer;
+      capture();
+    }
+    graph.launch();
+  }
+};
+
+DecompressGraph::DecompressGraph(
+    hipcompManagerBase& manager,
+    hipStream_t manager_stream,
+    const DecompressionConfig& decomp_config,
+    uint8_t* decomp_buffer,
+    const uint8_t* comp_buffer)
+  : impl(std::make_unique<DecompressGraphImpl>(
+        manager, manager_stream, decomp_config, decomp_buffer, comp_buffer))
+{}
+
+DecompressGraph::~DecompressGraph() {}
+
+void DecompressGraph::launch()
+{
+  impl->graph.launch();
+}
+
+void DecompressGraph::launch(uint8_t* decomp_buffer, const uint8_t* comp_buffer)
+{
+  impl->launch(decomp_buffer, comp_buffer);
+}
+
+const DecompressionConfig& DecompressGraph::get_config() const
+{
+  return impl->decomp_config;
+}
+
+} // namespace hipcomp
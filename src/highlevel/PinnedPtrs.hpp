@@ -50,6 +50,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "HipUtils.h"
 
@@ -61,12 +62,124 @@ namespace hipcomp {
 static constexpr size_t PINNED_POOL_PREALLOC_SIZE = 10; // Initial allocation
 static constexpr size_t PINNED_POOL_REALLOC_SIZE = 100; // Reallocations
 
+/**
+ * @brief A cache of pageable host blocks, recycled by size
+ *
+ * Small objects that are created and destroyed at a high rate, like the config impls,
+ * return their blocks here instead of to the heap so that the steady state does not 
+ * allocate. Thread-safe, as configs are created and destroyed by several threads 
+ * sharing a manager.
+ */
+struct HostBlockCache {
+
+private: // data
+  struct FreeList {
+    size_t block_size;
+    std::vector<void*> blocks;
+  };
+  std::vector<FreeList> free_lists;
+  std::mutex mutex;
+
+  FreeList& get_free_list(const size_t block_size)
+  {
+    for (auto& free_list : free_lists) {
+      if (free_list.block_size == block_size) {
+        return free_list;
+      }
+    }
+    free_lists.push_back(FreeList{block_size, {}});
+    return free_lists.back();
+  }
+
+public: // API
+  HostBlockCache() = default;
+  HostBlockCache(const HostBlockCache&) = delete;
+  HostBlockCache& operator=(const HostBlockCache&) = delete;
+
+  void* allocate(const size_t block_size)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    FreeList& free_list = get_free_list(block_size);
+    if (free_list.blocks.empty()) {
+      return ::operator new(block_size);
+    }
+    void* res = free_list.blocks.back();
+    free_list.blocks.pop_back();
+    return res;
+  }
+
+  void deallocate(void* block, const size_t block_size)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    get_free_list(block_size).blocks.push_back(block);
+  }
+
+  ~HostBlockCache()
+  {
+    for (auto& free_list : free_lists) {
+      for (void* block : free_list.blocks) {
+        ::operator delete(block);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Standard allocator that serves single objects from a HostBlockCache
+ *
+ * Intended for std::allocate_shared, which only ever allocates one control block.
+ */
+template<typename T>
+struct HostBlockCacheAllocator {
+  typedef T value_type;
+
+  HostBlockCache* cache;
+
+  explicit HostBlockCacheAllocator(HostBlockCache& cache)
+    : cache(&cache)
+  {}
+
+  template<typename U>
+  HostBlockCacheAllocator(const HostBlockCacheAllocator<U>& other)
+    : cache(other.cache)
+  {}
+
+  T* allocate(const size_t n)
+  {
+    if (n != 1) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(cache->allocate(sizeof(T)));
+  }
+
+  void deallocate(T* ptr, const size_t n)
+  {
+    if (n != 1) {
+      ::operator delete(ptr);
+      return;
+    }
+    cache->deallocate(ptr, sizeof(T));
+  }
+
+  template<typename U>
+  bool operator==(const HostBlockCacheAllocator<U>& other) const
+  {
+    return cache == other.cache;
+  }
+
+  template<typename U>
+  bool operator!=(const HostBlockCacheAllocator<U>& other) const
+  {
+    return cache != other.cache;
+  }
+};
+
 /** 
  * @brief A memory pool that can allocate pinned host memory in batches 
  * 
  * This class is able to allocate a number of members of type T at once. In standard
  * memory pool fashion, when the user is finished with a value, 
- * the pointer to the value is pushed back into the pool.
+ * the pointer to the value is pushed back into the pool. Thread-safe.
  * 
  */ 
 template<typename T>
@@ -78,12 +191,16 @@ struct PinnedPtrPool {
 private: // data
   std::vector<T*> alloced_buffers; 
   std::vector<T*> pool;
+  HostBlockCache host_block_cache;
+  std::mutex mutex;
 
 public: // API
 
   PinnedPtrPool() 
     : alloced_buffers(1),
-      pool()
+      pool(),
+      host_block_cache(),
+      mutex()
   {
     T*& first_alloc = alloced_buffers[0];
 
@@ -148,7 +265,7 @@ public: // API
       return *ptr;
     }
 
-    T* get_ptr() {
+    T* get_ptr() const {
       return ptr;
     }
 
@@ -161,6 +278,16 @@ public: // API
    */ 
   std::unique_ptr<PinnedPtrHandle> allocate() 
   {
+    return std::make_unique<PinnedPtrHandle>(allocate_handle());
+  }
+
+  /**
+   * @brief Like allocate(), but returns the handle by value so that it can be 
+   * embedded in another object without a separate heap allocation
+   */ 
+  PinnedPtrHandle allocate_handle() 
+  {
+    std::lock_guard<std::mutex> lock(mutex);
     if (pool.empty()) {
       // realloc
       alloced_buffers.push_back(nullptr);
@@ -174,7 +301,28 @@ public: // API
     T* res = pool.back();
     pool.pop_back();
 
-    return std::make_unique<PinnedPtrHandle>(PinnedPtrHandle{*this, res});
+    return PinnedPtrHandle{*this, res};
+  }
+
+  /**
+   * @brief Get the cache used to recycle the host objects that hold this pool's pointers
+   */ 
+  HostBlockCache& get_host_block_cache()
+  {
+    return host_block_cache;
+  }
+
+  /**
+   * @brief The number of pointers a pool holds once num_handles are out at the same time
+   */ 
+  static size_t capacity_for(const size_t num_handles)
+  {
+    if (num_handles <= PINNED_POOL_PREALLOC_SIZE) {
+      return PINNED_POOL_PREALLOC_SIZE;
+    }
+    const size_t num_reallocs = 
+        (num_handles - PINNED_POOL_PREALLOC_SIZE + PINNED_POOL_REALLOC_SIZE - 1) / PINNED_POOL_REALLOC_SIZE;
+    return PINNED_POOL_PREALLOC_SIZE + num_reallocs * PINNED_POOL_REALLOC_SIZE;
   }
 
   ~PinnedPtrPool() {
@@ -189,6 +337,7 @@ private: // Only used by PinnedPtrHandle
    */ 
   void deallocate(T* ptr) 
   {
+    std::lock_guard<std::mutex> lock(mutex);
     pool.push_back(ptr);
   }
 
@@ -211,4 +360,153 @@ private: // helpers that PoolTestWrapper will use
   friend struct PoolTestWrapper<T>;
 };
 
+struct BufferPoolTestWrapper;
+
+/**
+ * @brief A memory pool of variable-sized pinned host buffers used for staging transfers
+ *
+ * Buffers are kept after the user is finished with them and handed out again to any
+ * later request that fits, so a steady stream of same-sized requests only calls
+ * hipHostMalloc on the first pass.
+ */
+struct PinnedBufferPool {
+
+private: // data
+  struct PinnedBuffer {
+    uint8_t* ptr;
+    size_t size;
+  };
+
+  std::vector<PinnedBuffer> alloced_buffers;
+  std::vector<PinnedBuffer> pool;
+
+public: // API
+
+  PinnedBufferPool()
+    : alloced_buffers(),
+      pool()
+  {}
+
+  PinnedBufferPool(const PinnedBufferPool&) = delete;
+  PinnedBufferPool& operator=(const PinnedBufferPool&) = delete;
+
+  /**
+   * @brief A wrapper for a pinned buffer, interacts with PinnedBufferPool.
+   *
+   * Like PinnedPtrHandle, this is intended to be held in a std::unique_ptr so that
+   * the destructor returns the buffer to the pool.
+   */
+  class PinnedBufferHandle {
+    PinnedBufferPool& memory_pool;
+    PinnedBuffer buffer;
+
+    PinnedBufferHandle(PinnedBufferPool& memory_pool, PinnedBuffer buffer)
+      : memory_pool(memory_pool),
+        buffer(buffer)
+    {}
+
+    // Disallow copies
+    PinnedBufferHandle& operator=(const PinnedBufferHandle&) = delete;
+    PinnedBufferHandle(const PinnedBufferHandle&) = delete;
+
+  public: // Public API
+    /**
+     * @brief Move constructor that steals the buffer from the expiring `other`
+     */
+    PinnedBufferHandle(PinnedBufferHandle&& other)
+      : memory_pool(other.memory_pool),
+        buffer(other.buffer)
+    {
+      other.buffer.ptr = nullptr;
+    }
+
+    /**
+     * @brief The destructor will automatically return the buffer to the memory pool
+     */
+    ~PinnedBufferHandle() {
+      if (buffer.ptr != nullptr) {
+        memory_pool.deallocate(buffer);
+      }
+    }
+
+  public: // accessors
+    uint8_t* get_ptr() {
+      return buffer.ptr;
+    }
+
+    /**
+     * @brief The usable size of the buffer, which may exceed the requested size
+     */
+    size_t size() const {
+      return buffer.size;
+    }
+
+    friend struct PinnedBufferPool;
+
+  }; // End PinnedBufferHandle definition
+
+  /**
+   * @brief Get a pinned host buffer of at least size bytes from the pool
+   *
+   * Reuses the smallest free buffer that fits and only allocates when none does.
+   */
+  std::unique_ptr<PinnedBufferHandle> allocate(const size_t size)
+  {
+    auto best = pool.end();
+    for (auto it = pool.begin(); it != pool.end(); ++it) {
+      if (it->size >= size && (best == pool.end() || it->size < best->size)) {
+        best = it;
+      }
+    }
+
+    PinnedBuffer res;
+    if (best == pool.end()) {
+      res.size = size;
+      HipUtils::check(hipHostMalloc(&res.ptr, size, hipHostMallocDefault));
+      alloced_buffers.push_back(res);
+    } else {
+      res = *best;
+      pool.erase(best);
+    }
+
+    return std::make_unique<PinnedBufferHandle>(PinnedBufferHandle{*this, res});
+  }
+
+  ~PinnedBufferPool() {
+    for (auto& alloced_buffer : alloced_buffers) {
+      HipUtils::check(hipHostFree(alloced_buffer.ptr));
+    }
+  }
+
+private: // Only used by PinnedBufferHandle
+  /**
+   * @brief Push the buffer back into the pool
+   */
+  void deallocate(const PinnedBuffer& buffer)
+  {
+    pool.push_back(buffer);
+  }
+
+private: // helpers that BufferPoolTestWrapper will use
+  /**
+   * @brief Get the number of buffers available without additional allocations
+   */
+  size_t get_current_available_buffer_count() {
+    return pool.size();
+  }
+
+  /**
+   * @brief Get the total number of pinned bytes that have been allocated
+   */
+  size_t capacity() {
+    size_t res = 0;
+    for (auto& alloced_buffer : alloced_buffers) {
+      res += alloced_buffer.size;
+    }
+    return res;
+  }
+
+  friend struct BufferPoolTestWrapper;
+};
+
 } // namespace hipcomp
\ No newline at end of file
@@ -0,0 +1,448 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompPriorityScheduler.hpp"
+#include "HipUtils.h"
+#include "common.h"
+
+namespace hipcomp {
+
+namespace {
+
+/**
+ * @brief A submitted batch, of which the chunks before next_chunk have been launched
+ */
+struct ScheduledBatch {
+  bool decompress;
+  const void* const* input_ptrs;
+  const size_t* input_bytes;
+  // Only used for decompression
+  const size_t* output_buffer_bytes;
+  void* const* output_ptrs;
+  size_t* output_bytes;
+  size_t batch_size;
+  size_t next_chunk;
+  std::promise<void> result;
+};
+
+/**
+ * @brief Runs the chunks [first_chunk, first_chunk + num_chunks) of batch on backend
+ */
+void launch_slice(
+    BatchedCompressBackend& backend, 
+    const ScheduledBatch& batch, 
+    const size_t first_chunk, 
+    const size_t num_chunks)
+{
+  if (batch.decompress) {
+    backend.decompress_batch(
+        batch.input_ptrs + first_chunk,
+        batch.input_bytes + first_chunk,
+        batch.output_buffer_bytes + first_chunk,
+        num_chunks,
+        batch.output_ptrs + first_chunk,
+        batch.output_bytes + first_chunk);
+  } else {
+    const size_t max_uncompressed_chunk_bytes = *std::max_element(
+        batch.input_bytes + first_chunk, batch.input_bytes + first_chunk + num_chunks);
+    backend.compress_batch(
+        batch.input_ptrs + first_chunk,
+        batch.input_bytes + first_chunk,
+        max_uncompressed_chunk_bytes,
+        num_chunks,
+        batch.output_ptrs + first_chunk,
+        batch.output_bytes + first_chunk);
+  }
+}
+
+/**
+ * @brief Backend that destroys the stream it launches on along with itself
+ */
+struct StreamOwningBackend : BatchedCompressBackend {
+private:
+  hipStream_t stream;
+  std::unique_ptr<BatchedCompressBackend> backend;
+
+public:
+  StreamOwningBackend(hipStream_t stream, std::unique_ptr<BatchedCompressBackend> backend)
+    : stream(stream),
+      backend(std::move(backend))
+  {}
+
+  ~StreamOwningBackend()
+  {
+    backend.reset();
+    hipStreamDestroy(stream);
+  }
+
+  size_t get_max_chunk_size() const final override
+  {
+    return backend->get_max_chunk_size();
+  }
+
+  size_t get_max_batch_size() const final override
+  {
+    return backend->get_max_batch_size();
+  }
+
+  size_t get_max_compressed_chunk_size(const size_t uncompressed_bytes) const final override
+  {
+    return backend->get_max_compressed_chunk_size(uncompressed_bytes);
+  }
+
+  void compress_batch(
+      const void* const* uncompressed_ptrs,
+      const size_t* uncompressed_bytes,
+      const size_t max_uncompressed_chunk_bytes,
+      const size_t batch_size,
+      void* const* compressed_ptrs,
+      size_t* compressed_bytes) final override
+  {
+    backend->compress_batch(uncompressed_ptrs, uncompressed_bytes, max_uncompressed_chunk_bytes, 
+        batch_size, compressed_ptrs, compressed_bytes);
+  }
+
+  void decompress_batch(
+      const void* const* compressed_ptrs,
+      const size_t* compressed_bytes,
+      const size_t* uncompressed_buffer_bytes,
+      const size_t batch_size,
+      void* const* uncompressed_ptrs,
+      size_t* uncompressed_bytes) final override
+  {
+    backend->decompress_batch(compressed_ptrs, compressed_bytes, uncompressed_buffer_bytes, 
+        batch_size, uncompressed_ptrs, uncompressed_bytes);
+  }
+};
+
+} // namespace
+
+struct PriorityBatchScheduler::PriorityBatchSchedulerImpl {
+  /**
+   * @brief The batches and dispatcher of one priority
+   */
+  struct Queue {
+    std::unique_ptr<BatchedCompressBackend> backend;
+    std::deque<ScheduledBatch> pending;
+    std::condition_variable pending_changed;
+    size_t num_launches;
+    std::thread dispatcher;
+  };
+
+  size_t throughput_slice_chunks;
+  std::chrono::microseconds max_throughput_delay;
+
+  mutable std::mutex mutex;
+  Queue latency;
+  Queue throughput;
+  // Whether the latency dispatcher is running a batch
+  bool latency_running;
+  std::condition_variable latency_idle;
+  bool stopping;
+
+  PriorityBatchSchedulerImpl(
+      std::unique_ptr<BatchedCompressBackend> latency_backend,
+      std::unique_ptr<BatchedCompressBackend> throughput_backend,
+      const PrioritySchedulerOptions& options)
+    : throughput_slice_chunks(options.throughput_slice_chunks),
+      max_throughput_delay(options.max_throughput_delay),
+      mutex(),
+      latency(),
+      throughput(),
+      latency_running(false),
+      latency_idle(),
+      stopping(false)
+  {
+    if (!latency_backend || !throughput_backend) {
+      throw HipCompException(hipcompErrorInvalidValue, "PriorityBatchScheduler needs a backend for each queue.");
+    }
+    if (latency_backend->get_max_batch_size() == 0 || throughput_backend->get_max_batch_size() == 0
+        || throughput_slice_chunks == 0) {
+      throw HipCompException(hipcompErrorInvalidValue, "PriorityBatchScheduler needs non-zero batch sizes.");
+    }
+    throughput_slice_chunks = std::min(throughput_slice_chunks, throughput_backend->get_max_batch_size());
+
+    latency.backend = std::move(latency_backend);
+    latency.num_launches = 0;
+    throughput.backend = std::move(throughput_backend);
+    throughput.num_launches = 0;
+
+    latency.dispatcher = std::thread([this]() { dispatch_latency(); });
+    throughput.dispatcher = std::thread([this]() { dispatch_throughput(); });
+  }
+
+  ~PriorityBatchSchedulerImpl()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    latency.pending_changed.notify_all();
+    throughput.pending_changed.notify_all();
+    latency.dispatcher.join();
+    throughput.dispatcher.join();
+  }
+
+  std::future<void> submit(SchedulePriority priority, ScheduledBatch batch)
+  {
+    std::future<void> res = batch.result.get_future();
+    if (batch.batch_size == 0) {
+      batch.result.set_value();
+      return res;
+    }
+
+    Queue& queue = get_queue(priority);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.pending.push_back(std::move(batch));
+    }
+    queue.pending_changed.notify_one();
+
+    return res;
+  }
+
+  size_t get_num_launches(SchedulePriority priority) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return priority == SchedulePriority::Latency ? latency.num_launches : throughput.num_launches;
+  }
+
+private:
+  Queue& get_queue(SchedulePriority priority)
+  {
+    return priority == SchedulePriority::Latency ? latency : throughput;
+  }
+
+  /**
+   * @brief Whether latency batches are pending or running. Called with the mutex held.
+   */
+  bool has_latency_work() const
+  {
+    return latency_running || !latency.pending.empty();
+  }
+
+  /**
+   * @brief Waits for a batch of queue and takes it. Returns false once stopping with 
+   * nothing left to do.
+   */
+  bool take_batch(std::unique_lock<std::mutex>& lock, Queue& queue, ScheduledBatch& batch)
+  {
+    queue.pending_changed.wait(lock, [&]() { return stopping || !queue.pending.empty(); });
+    if (queue.pending.empty()) {
+      return false;
+    }
+    batch = std::move(queue.pending.front());
+    queue.pending.pop_front();
+    return true;
+  }
+
+  void dispatch_latency()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ScheduledBatch batch{};
+    while (take_batch(lock, latency, batch)) {
+      latency_running = true;
+      const size_t max_launch_chunks = latency.backend->get_max_batch_size();
+      latency.num_launches += roundUpDiv(batch.batch_size, max_launch_chunks);
+      lock.unlock();
+
+      try {
+        for (size_t first = 0; first < batch.batch_size; first += max_launch_chunks) {
+          launch_slice(*latency.backend, batch, first, std::min(max_launch_chunks, batch.batch_size - first));
+        }
+        batch.result.set_value();
+      } catch (...) {
+        batch.result.set_exception(std::current_exception());
+      }
+
+      lock.lock();
+      latency_running = false;
+      if (!has_latency_work()) {
+        latency_idle.notify_all();
+      }
+    }
+  }
+
+  void dispatch_throughput()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ScheduledBatch batch{};
+    while (take_batch(lock, throughput, batch)) {
+      try {
+        while (batch.next_chunk < batch.batch_size) {
+          // The preemption point: pending latency work goes first, up to the deadline
+          latency_idle.wait_for(lock, max_throughput_delay, [this]() { return !has_latency_work(); });
+
+          const size_t first = batch.next_chunk;
+          const size_t num_chunks = std::min(throughput_slice_chunks, batch.batch_size - first);
+          batch.next_chunk += num_chunks;
+          ++throughput.num_launches;
+
+          lock.unlock();
+          launch_slice(*throughput.backend, batch, first, num_chunks);
+          lock.lock();
+        }
+        batch.result.set_value();
+      } catch (...) {
+        // Thrown by the launch, with the lock released
+        batch.result.set_exception(std::current_exception());
+        lock.lock();
+      }
+    }
+  }
+};
+
+PriorityBatchScheduler::PriorityBatchScheduler(
+    std::unique_ptr<BatchedCompressBackend> latency_backend,
+    std::unique_ptr<BatchedCompressBackend> throughput_backend,
+    const PrioritySchedulerOptions& options)
+  : impl(std::make_unique<PriorityBatchSchedulerImpl>(
+        std::move(latency_backend), std::move(throughput_backend), options))
+{}
+
+PriorityBatchScheduler::~PriorityBatchScheduler() {}
+
+std::future<void> PriorityBatchScheduler::submit_compress(
+    const SchedulePriority priority,
+    const void* const* uncompressed_ptrs,
+    const size_t* uncompressed_bytes,
+    const size_t batch_size,
+    void* const* compressed_ptrs,
+    size_t* compressed_bytes)
+{
+  return impl->submit(priority, ScheduledBatch{
+      false, uncompressed_ptrs, uncompressed_bytes, nullptr, compressed_ptrs, compressed_bytes, batch_size, 0, {}});
+}
+
+std::future<void> PriorityBatchScheduler::submit_decompress(
+    const SchedulePriority priority,
+    const void* const* compressed_ptrs,
+    const size_t* compressed_bytes,
+    const size_t* uncompressed_buffer_bytes,
+    const size_t batch_size,
+    void* const* uncompressed_ptrs,
+    size_t* uncompressed_bytes)
+{
+  return impl->submit(priority, ScheduledBatch{
+      true, compressed_ptrs, compressed_bytes, uncompressed_buffer_bytes, uncompressed_ptrs, uncompressed_bytes, 
+      batch_size, 0, {}});
+}
+
+size_t PriorityBatchScheduler::get_num_launches(const SchedulePriority priority) const
+{
+  return impl->get_num_launches(priority);
+}
+
+namespace {
+
+/**
+ * @brief A device backend on a new stream of the greatest or least priority
+ */
+template<typename FormatOpts>
+std::unique_ptr<BatchedCompressBackend> create_prioritized_backend(
+    const FormatOpts& format_opts, 
+    const SchedulePriority priority,
+    const size_t max_batch_size, 
+    const size_t max_chunk_bytes)
+{
+  int least_priority;
+  int greatest_priority;
+  HipUtils::check(hipDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+
+  hipStream_t stream;
+  HipUtils::check(hipStreamCreateWithPriority(&stream, hipStreamNonBlocking,
+      priority == SchedulePriority::Latency ? greatest_priority : least_priority));
+  std::unique_ptr<BatchedCompressBackend> backend;
+  try {
+    backend = create_batched_compress_backend(format_opts, stream, max_batch_size, max_chunk_bytes);
+  } catch (...) {
+    hipStreamDestroy(stream);
+    throw;
+  }
+  return std::make_unique<StreamOwningBackend>(stream, std::move(backend));
+}
+
+template<typename FormatOpts>
+std::unique_ptr<PriorityBatchScheduler> create_device_scheduler(
+    const FormatOpts& format_opts, 
+    const size_t max_batch_size, 
+    const size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options)
+{
+  return std::make_unique<PriorityBatchScheduler>(
+      create_prioritized_backend(format_opts, SchedulePriority::Latency, max_batch_size, max_chunk_bytes),
+      create_prioritized_backend(format_opts, SchedulePriority::Throughput, max_batch_size, max_chunk_bytes),
+      options);
+}
+
+} // namespace
+
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedLZ4Opts_t& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options)
+{
+  return create_device_scheduler(format_opts, max_batch_size, max_chunk_bytes, options);
+}
+
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedSnappyOpts_t& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options)
+{
+  return create_device_scheduler(format_opts, max_batch_size, max_chunk_bytes, options);
+}
+
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedCascadedOpts_t& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options)
+{
+  return create_device_scheduler(format_opts, max_batch_size, max_chunk_bytes, options);
+}
+
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedGdeflateOpts_t& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options)
+{
+  return create_device_scheduler(format_opts, max_batch_size, max_chunk_bytes, options);
+}
+
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedANSOpts_t& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options)
+{
+  return create_device_scheduler(format_opts, max_batch_size, max_chunk_bytes, options);
+}
+
+std::unique_ptr<PriorityBatchScheduler> create_priority_batch_scheduler(
+    const hipcompBatchedBitcompFormatOpts& format_opts, size_t max_batch_size, size_t max_chunk_bytes,
+    const PrioritySchedulerOptions& options)
+{
+  return create_device_scheduler(format_opts, max_batch_size, max_chunk_bytes, options);
+}
+
+} // namespace hipcomp
@@ -0,0 +1,398 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "hipcomp/hipcompSegmentedManager.hpp"
+
+#include "Check.h"
+#include "CommonHeaderKernels.h"
+#include "HipUtils.h"
+#include "InFlightConfigs.hpp"
+#include "ManagerBase.hpp"
+#include "SegmentedManagerKernels.h"
+#include "common.h"
+#include "hipcomp_common_deps/hlif_shared_types.hpp"
+
+namespace hipcomp {
+
+struct SegmentedManagerImpl : ManagerBase<SegmentedFormatSpecHeader> {
+private:
+  SegmentedFormatSpecHeader* format_spec;
+  std::vector<hipStream_t> streams;
+  std::vector<std::shared_ptr<hipcompManagerBase>> segment_managers;
+  // Recorded on the internal streams once a segment is (de)compressed
+  std::vector<hipEvent_t> segment_done;
+  // Recorded on the user stream once a staging slot has been copied out
+  std::vector<hipEvent_t> slot_free;
+  hipEvent_t inputs_ready;
+  // Size of one staging slot in the scratch buffer
+  size_t max_comp_segment_size;
+  std::vector<size_t> segment_scratch_offsets;
+  size_t total_scratch_size;
+  uint8_t* distributed_scratch_buffer;
+  InFlightConfigs in_flight;
+  // Calls share the segment streams and staging slots, so they are issued one at a time
+  std::mutex call_mutex;
+
+public:
+  SegmentedManagerImpl(
+      const SegmentManagerFactory& create_segment_manager,
+      size_t segment_size,
+      size_t num_streams,
+      hipStream_t user_stream,
+      const int device_id)
+    : ManagerBase(user_stream, device_id),
+      format_spec(),
+      streams(num_streams),
+      segment_managers(),
+      segment_done(num_streams),
+      slot_free(num_streams),
+      inputs_ready(),
+      max_comp_segment_size(),
+      segment_scratch_offsets(),
+      total_scratch_size(),
+      distributed_scratch_buffer(nullptr),
+      in_flight()
+  {
+    if (segment_size == 0 || num_streams == 0) {
+      throw HipCompException(hipcompErrorInvalidValue, "SegmentedManager needs a non-zero segment size and stream count.");
+    }
+
+    HipUtils::check(hipHostMalloc(&format_spec, sizeof(SegmentedFormatSpecHeader), hipHostMallocDefault));
+    format_spec->segment_size = segment_size;
+
+    HipUtils::check(hipEventCreateWithFlags(&inputs_ready, hipEventDisableTiming));
+    for (size_t s = 0; s < num_streams; ++s) {
+      HipUtils::check(hipStreamCreateWithFlags(&streams[s], hipStreamNonBlocking));
+      HipUtils::check(hipEventCreateWithFlags(&segment_done[s], hipEventDisableTiming));
+      HipUtils::check(hipEventCreateWithFlags(&slot_free[s], hipEventDisableTiming));
+
+      segment_managers.push_back(create_segment_manager(streams[s]));
+      if (!segment_managers.back()) {
+        throw HipCompException(hipcompErrorInvalidValue, "The segment manager factory returned null.");
+      }
+    }
+
+    max_comp_segment_size = roundUpTo(
+        segment_managers[0]->configure_compression(segment_size).max_compressed_buffer_size, 
+        SEGMENT_ALIGNMENT);
+
+    // The staging slots come first, followed by the scratch of each segment manager
+    total_scratch_size = num_streams * max_comp_segment_size;
+    for (auto& segment_manager : segment_managers) {
+      segment_scratch_offsets.push_back(total_scratch_size);
+      total_scratch_size += roundUpTo(segment_manager->get_required_scratch_buffer_size(), SEGMENT_ALIGNMENT);
+    }
+
+    finish_init();
+  }
+
+  virtual ~SegmentedManagerImpl()
+  {
+    HipUtils::check(hipStreamSynchronize(user_stream));
+    for (auto& stream : streams) {
+      HipUtils::check(hipStreamSynchronize(stream));
+    }
+    in_flight.release_finished();
+
+    // The segment managers own the status pools and scratch used on the streams
+    segment_managers.clear();
+    for (size_t s = 0; s < streams.size(); ++s) {
+      HipUtils::check(hipEventDestroy(segment_done[s]));
+      HipUtils::check(hipEventDestroy(slot_free[s]));
+      HipUtils::check(hipStreamDestroy(streams[s]));
+    }
+    HipUtils::check(hipEventDestroy(inputs_ready));
+    HipUtils::check(hipHostFree(format_spec));
+  }
+
+  SegmentedManagerImpl(const SegmentedManagerImpl&) = delete;
+  SegmentedManagerImpl& operator=(const SegmentedManagerImpl&) = delete;
+
+private: // helpers
+  size_t get_segment_size() const
+  {
+    return format_spec->segment_size;
+  }
+
+  /**
+   * @brief Computes where segment 0 starts, relative to the container start
+   *
+   * The segment table holds num_segments + 1 entries and directly follows the headers.
+   */
+  static uint64_t get_first_segment_offset(const size_t num_segments)
+  {
+    const size_t table_end = sizeof(CommonHeader) + sizeof(SegmentedFormatSpecHeader) 
+        + (num_segments + 1) * sizeof(uint64_t);
+    return num_segments == 0 ? table_end : roundUpTo(table_end, SEGMENT_ALIGNMENT);
+  }
+
+  /**
+   * @brief Hands each segment manager its part of the scratch buffer 
+   *
+   * Only does work the first time and after set_scratch_buffer().
+   */
+  void distribute_scratch_buffer()
+  {
+    if (scratch_buffer != distributed_scratch_buffer) {
+      for (size_t s = 0; s < segment_managers.size(); ++s) {
+        segment_managers[s]->set_scratch_buffer(scratch_buffer + segment_scratch_offsets[s]);
+      }
+      distributed_scratch_buffer = scratch_buffer;
+    }
+  }
+
+private: // ManagerBase overrides
+  size_t compute_scratch_buffer_size() final override
+  {
+    return total_scratch_size;
+  }
+
+  bool supports_other_streams() final override
+  {
+    // The segments are ordered against the user stream
+    return false;
+  }
+
+  SegmentedFormatSpecHeader* get_format_header() final override
+  {
+    return format_spec;
+  }
+
+  const char* get_codec_name() const final override
+  {
+    return "segmented";
+  }
+
+  void do_configure_compression(CompressionConfig& config) final override
+  {
+    config.num_chunks = roundUpDiv(config.uncompressed_buffer_size, get_segment_size());
+  }
+
+  size_t calculate_max_compressed_output_size(CompressionConfig& comp_config) final override
+  {
+    const size_t num_segments = comp_config.num_chunks;
+    const uint64_t first_segment_offset = get_first_segment_offset(num_segments);
+    if (num_segments == 0) {
+      return first_segment_offset;
+    }
+
+    const size_t last_segment_size = comp_config.uncompressed_buffer_size - (num_segments - 1) * get_segment_size();
+    return first_segment_offset + (num_segments - 1) * max_comp_segment_size + roundUpTo(
+        segment_managers[0]->configure_compression(last_segment_size).max_compressed_buffer_size,
+        SEGMENT_ALIGNMENT);
+  }
+
+  void do_configure_decompression(
+      DecompressionConfig& decomp_config,
+      const CommonHeader* common_header) final override
+  {
+    HipUtils::check(hipMemcpyAsync(&decomp_config.num_chunks, 
+        &common_header->num_chunks, 
+        sizeof(size_t),
+        hipMemcpyDefault,
+        user_stream));
+  }
+
+  void do_configure_decompression(
+      DecompressionConfig& decomp_config,
+      const CompressionConfig& comp_config) final override
+  {
+    decomp_config.num_chunks = comp_config.num_chunks;
+  }
+
+  void do_get_memory_footprint(MemoryFootprint& footprint) final override
+  {
+    // The scratch of the segment managers is already part of ours
+    for (auto& segment_manager : segment_managers) {
+      const MemoryFootprint segment_footprint = segment_manager->get_memory_footprint(get_segment_size());
+      footprint.ix_chunk += segment_footprint.ix_chunk;
+      footprint.contexts += segment_footprint.contexts;
+      footprint.status_pool += segment_footprint.status_pool;
+      footprint.headers += segment_footprint.headers;
+      footprint.configs += segment_footprint.configs;
+    }
+  }
+
+  void do_get_kernel_resource_usage(std::vector<KernelResourceUsage>& usage) final override
+  {
+    // The segments run concurrently, one per stream
+    for (auto& segment_manager : segment_managers) {
+      const std::vector<KernelResourceUsage> segment_usage = segment_manager->get_kernel_resource_usage();
+      usage.insert(usage.end(), segment_usage.begin(), segment_usage.end());
+    }
+  }
+
+  void do_compress(
+      CommonHeader* common_header,
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config,
+      const ExecutionContext& /*context*/) final override
+  {
+    std::lock_guard<std::mutex> lock(call_mutex);
+    check_not_capturing("SegmentedManager cannot be captured into a graph.");
+    in_flight.release_finished();
+    distribute_scratch_buffer();
+
+    const size_t decomp_buffer_size = comp_config.uncompressed_buffer_size;
+    const size_t num_segments = comp_config.num_chunks;
+    uint8_t* container = reinterpret_cast<uint8_t*>(common_header);
+    uint64_t* segment_table = reinterpret_cast<uint64_t*>(comp_buffer);
+    const uint32_t comp_data_offset = static_cast<uint32_t>(comp_buffer - container);
+    const uint64_t first_segment_offset = get_first_segment_offset(num_segments);
+
+    // Work already on the user stream, including the previous call's use of 
+    // the staging slots, must finish before the segments start
+    HipUtils::check(hipEventRecord(inputs_ready, user_stream));
+    for (size_t s = 0; s < std::min(num_segments, streams.size()); ++s) {
+      HipUtils::check(hipStreamWaitEvent(streams[s], inputs_ready, 0));
+    }
+
+    std::vector<CompressionConfig> segment_configs;
+    segment_configs.reserve(num_segments);
+    for (size_t ix = 0; ix < num_segments; ++ix) {
+      const size_t s = ix % streams.size();
+      const size_t offset = ix * get_segment_size();
+      const size_t bytes = std::min(get_segment_size(), decomp_buffer_size - offset);
+      uint8_t* slot = scratch_buffer + s * max_comp_segment_size;
+
+      if (ix >= streams.size()) {
+        HipUtils::check(hipStreamWaitEvent(streams[s], slot_free[s], 0));
+      }
+      segment_configs.push_back(segment_managers[s]->configure_compression(bytes));
+      segment_managers[s]->compress(decomp_buffer + offset, slot, segment_configs.back());
+      HipUtils::check(hipEventRecord(segment_done[s], streams[s]));
+
+      // Segments are finalized in order on the user stream, overlapping the 
+      // compression of the segments issued after this one
+      HipUtils::check(hipStreamWaitEvent(user_stream, segment_done[s], 0));
+      segmentedAppendSegment(
+          reinterpret_cast<const CommonHeader*>(slot), 
+          segment_table, 
+          ix, 
+          num_segments,
+          first_segment_offset,
+          segment_configs.back().get_status(), 
+          comp_config.get_status(),
+          user_stream);
+      segmentedCopySegment(slot, container, segment_table, ix, max_comp_segment_size, user_stream);
+      HipUtils::check(hipEventRecord(slot_free[s], user_stream));
+    }
+
+    segmentedFinalize(
+        common_header, 
+        segment_table, 
+        num_segments, 
+        decomp_buffer_size, 
+        get_segment_size(), 
+        first_segment_offset, 
+        comp_data_offset, 
+        user_stream);
+
+    in_flight.retire(user_stream, std::move(segment_configs), {});
+  }
+
+  void do_decompress(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& config,
+      const ExecutionContext& /*context*/) final override
+  {
+    std::lock_guard<std::mutex> lock(call_mutex);
+    check_not_capturing("SegmentedManager cannot be captured into a graph.");
+    in_flight.release_finished();
+    distribute_scratch_buffer();
+
+    const size_t num_segments = config.num_chunks;
+    if (num_segments == 0) {
+      return;
+    }
+    const uint8_t* container = comp_buffer - sizeof(CommonHeader) - sizeof(SegmentedFormatSpecHeader);
+
+    // The segment offsets are needed on the host to issue the segments. This also 
+    // orders the segments after all work already on the user stream.
+    SegmentedFormatSpecHeader stored_spec;
+    std::vector<uint64_t> segment_table(num_segments + 1);
+    HipUtils::check(hipMemcpyAsync(&stored_spec, 
+        container + sizeof(CommonHeader), 
+        sizeof(SegmentedFormatSpecHeader), 
+        hipMemcpyDefault, 
+        user_stream));
+    HipUtils::check(hipMemcpyAsync(segment_table.data(), 
+        comp_buffer, 
+        segment_table.size() * sizeof(uint64_t), 
+        hipMemcpyDefault, 
+        user_stream));
+    HipUtils::check(hipStreamSynchronize(user_stream));
+
+    if (stored_spec.segment_size != get_segment_size()) {
+      throw HipCompException(hipcompErrorInvalidValue, "The buffer was compressed with a different segment size.");
+    }
+    if (segment_table[0] != get_first_segment_offset(num_segments)) {
+      throw HipCompException(hipcompErrorInvalidValue, "Invalid segment table in compressed buffer.");
+    }
+
+    std::vector<DecompressionConfig> segment_configs;
+    segment_configs.reserve(num_segments);
+    for (size_t ix = 0; ix < num_segments; ++ix) {
+      const size_t s = ix % streams.size();
+      const size_t offset = ix * get_segment_size();
+      const size_t bytes = std::min(get_segment_size(), config.decomp_data_size - offset);
+      hipcompManagerBase& segment_manager = *segment_managers[s];
+
+      // Built from the known segment size instead of reading each segment header
+      segment_configs.push_back(
+          segment_manager.configure_decompression(segment_manager.configure_compression(bytes)));
+      segment_manager.decompress(decomp_buffer + offset, container + segment_table[ix], segment_configs.back());
+    }
+
+    for (size_t s = 0; s < std::min(num_segments, streams.size()); ++s) {
+      HipUtils::check(hipEventRecord(segment_done[s], streams[s]));
+      HipUtils::check(hipStreamWaitEvent(user_stream, segment_done[s], 0));
+    }
+    for (const auto& segment_config : segment_configs) {
+      mergeOutputStatus(segment_config.get_status(), config.get_status(), user_stream);
+    }
+
+    in_flight.retire(user_stream, {}, std::move(segment_configs));
+  }
+};
+
+SegmentedManager::SegmentedManager(
+    const SegmentManagerFactory& create_segment_manager,
+    size_t segment_size, 
+    size_t num_streams,
+    hipStream_t user_stream, 
+    const int device_id)
+{
+  impl = std::make_unique<SegmentedManagerImpl>(
+      create_segment_manager, segment_size, num_streams, user_stream, device_id);
+}
+
+SegmentedManager::~SegmentedManager() 
+{}
+
+} // namespace hipcomp
@@ -0,0 +1,95 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hipcomp.h"
+#include "hipcomp_common_deps/hlif_shared_types.hpp"
+
+#include "hip/hip_runtime.h"
+
+namespace hipcomp {
+
+/**
+ * @brief Alignment of the segment containers inside a segmented container
+ */
+constexpr size_t SEGMENT_ALIGNMENT = 256;
+
+/**
+ * @brief Appends a compressed segment to the segment table, ordered on stream.
+ *
+ * The table holds the start of each segment relative to the container start, followed by 
+ * the end of the last one. Entry ix + 1 is written from entry ix and the size recorded in 
+ * the segment's own header. The segment status is merged into output_status.
+ *
+ * @param segment_header The header of the compressed segment (GPU accessible).
+ * @param segment_table The table in the container (GPU accessible).
+ * @param ix The segment index.
+ * @param num_segments The number of segments in the container.
+ * @param first_segment_offset The start of segment 0, written when ix is 0.
+ * @param segment_status The status of the segment compression (GPU accessible).
+ * @param output_status The status of the whole compression (GPU accessible).
+ */
+void segmentedAppendSegment(
+    const CommonHeader* segment_header,
+    uint64_t* segment_table,
+    size_t ix,
+    size_t num_segments,
+    uint64_t first_segment_offset,
+    const hipcompStatus_t* segment_status,
+    hipcompStatus_t* output_status,
+    hipStream_t stream);
+
+/**
+ * @brief Copies a compressed segment to the location recorded in the segment table.
+ *
+ * The size is only known on the device, so the launch covers max_segment_size and 
+ * the threads past the end of the segment exit. Both locations are 8-byte aligned.
+ *
+ * @param segment The compressed segment in its staging slot (GPU accessible).
+ * @param comp_buffer The start of the container (GPU accessible).
+ * @param segment_table The table in the container, already holding entry ix + 1.
+ * @param ix The segment index.
+ * @param max_segment_size The size of the staging slot, a multiple of 8.
+ */
+void segmentedCopySegment(
+    const uint8_t* segment,
+    uint8_t* comp_buffer,
+    const uint64_t* segment_table,
+    size_t ix,
+    size_t max_segment_size,
+    hipStream_t stream);
+
+/**
+ * @brief Fills the common header of a segmented container once all segments are appended.
+ */
+void segmentedFinalize(
+    CommonHeader* common_header,
+    uint64_t* segment_table,
+    size_t num_segments,
+    size_t decomp_data_size,
+    size_t segment_size,
+    uint64_t first_segment_offset,
+    uint32_t comp_data_offset,
+    hipStream_t stream);
+
+} // namespace hipcomp
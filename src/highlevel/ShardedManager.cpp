@@ -0,0 +1,642 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "hipcomp/hipcompShardedManager.hpp"
+
+#include "Check.h"
+#include "CommonHeaderKernels.h"
+#include "HipUtils.h"
+#include "InFlightConfigs.hpp"
+#include "PinnedPtrs.hpp"
+#include "ShardedManagerKernels.h"
+#include "common.h"
+#include "hipcomp_common_deps/hlif_shared_types.hpp"
+
+namespace hipcomp {
+
+namespace {
+
+/**
+ * @brief Makes a device current for the lifetime of the guard
+ */
+struct DeviceGuard {
+  int previous_device;
+
+  explicit DeviceGuard(const int device_id)
+    : previous_device()
+  {
+    HipUtils::check(hipGetDevice(&previous_device));
+    HipUtils::check(hipSetDevice(device_id));
+  }
+
+  ~DeviceGuard()
+  {
+    hipSetDevice(previous_device);
+  }
+
+  DeviceGuard(const DeviceGuard&) = delete;
+  DeviceGuard& operator=(const DeviceGuard&) = delete;
+};
+
+void enable_peer_access(const int device_id, const int peer_device_id)
+{
+  if (device_id == peer_device_id) {
+    return;
+  }
+
+  int can_access = 0;
+  HipUtils::check(hipDeviceCanAccessPeer(&can_access, device_id, peer_device_id));
+  if (!can_access) {
+    throw HipCompException(hipcompErrorNotSupported, "Device " + std::to_string(device_id) 
+        + " cannot access device " + std::to_string(peer_device_id) + ".");
+  }
+
+  DeviceGuard guard(device_id);
+  const hipError_t err = hipDeviceEnablePeerAccess(peer_device_id, 0);
+  if (err == hipErrorPeerAccessAlreadyEnabled) {
+    // Clear the sticky error
+    hipGetLastError();
+  } else {
+    HipUtils::check(err);
+  }
+}
+
+/**
+ * @brief The chunks handled by one shard
+ */
+struct ShardRange {
+  size_t first_chunk;
+  size_t num_chunks;
+};
+
+/**
+ * @brief The resources of one shard device
+ */
+struct Shard {
+  int device_id;
+  hipStream_t stream;
+  std::shared_ptr<hipcompManagerBase> manager;
+  // Recorded on the shard stream once the shard is (de)compressed
+  hipEvent_t done;
+  // The shard container, on the shard device
+  uint8_t* container;
+  size_t container_size;
+  // The headers and chunk table of a shard container built for decompression
+  std::unique_ptr<PinnedBufferPool::PinnedBufferHandle> staging;
+};
+
+} // namespace
+
+struct ShardedManagerImpl : hipcompManagerBase {
+private:
+  hipStream_t user_stream;
+  int device_id;
+  size_t uncomp_chunk_size;
+  size_t format_spec_size;
+  size_t max_comp_chunk_size;
+  PinnedPtrPool<hipcompStatus_t> status_pool;
+  CommonHeader* common_header_cpu;
+  PinnedBufferPool staging_pool;
+  std::vector<Shard> shards;
+  hipEvent_t inputs_ready;
+  InFlightConfigs in_flight;
+  // Calls share the shard streams and staging buffers, so they are issued one at a time
+  std::mutex call_mutex;
+
+public:
+  ShardedManagerImpl(
+      const ShardManagerFactory& create_shard_manager,
+      size_t uncomp_chunk_size,
+      const std::vector<int>& shard_device_ids,
+      hipStream_t user_stream,
+      const int device_id)
+    : user_stream(user_stream),
+      device_id(device_id),
+      uncomp_chunk_size(uncomp_chunk_size),
+      format_spec_size(),
+      max_comp_chunk_size(),
+      status_pool(),
+      common_header_cpu(),
+      staging_pool(),
+      shards(),
+      inputs_ready(),
+      in_flight()
+  {
+    if (uncomp_chunk_size == 0 || shard_device_ids.empty()) {
+      throw HipCompException(hipcompErrorInvalidValue, "ShardedManager needs a non-zero chunk size and at least one shard device.");
+    }
+
+    DeviceGuard guard(device_id);
+    HipUtils::check(hipHostMalloc(&common_header_cpu, sizeof(CommonHeader), hipHostMallocDefault));
+    HipUtils::check(hipEventCreateWithFlags(&inputs_ready, hipEventDisableTiming));
+
+    for (const int shard_device_id : shard_device_ids) {
+      enable_peer_access(device_id, shard_device_id);
+      enable_peer_access(shard_device_id, device_id);
+
+      DeviceGuard shard_guard(shard_device_id);
+      Shard shard{shard_device_id, nullptr, nullptr, nullptr, nullptr, 0, nullptr};
+      HipUtils::check(hipStreamCreateWithFlags(&shard.stream, hipStreamNonBlocking));
+      HipUtils::check(hipEventCreateWithFlags(&shard.done, hipEventDisableTiming));
+      shards.push_back(std::move(shard));
+
+      shards.back().manager = create_shard_manager(shards.back().stream, shard_device_id);
+      if (!shards.back().manager) {
+        throw HipCompException(hipcompErrorInvalidValue, "The shard manager factory returned null.");
+      }
+    }
+
+    // A chunked container holds the headers, the chunk table and then the chunks, so its 
+    // maximum size grows by the same amount with every chunk.
+    hipcompManagerBase& manager = *shards[0].manager;
+    if (manager.configure_compression(uncomp_chunk_size).num_chunks != 1 
+        || manager.configure_compression(uncomp_chunk_size + 1).num_chunks != 2) {
+      throw HipCompException(hipcompErrorInvalidValue, "The chunk size does not match the shard managers.");
+    }
+    const size_t max_one_chunk = manager.configure_compression(uncomp_chunk_size).max_compressed_buffer_size;
+    const size_t max_two_chunks = manager.configure_compression(2 * uncomp_chunk_size).max_compressed_buffer_size;
+    const size_t max_three_chunks = manager.configure_compression(3 * uncomp_chunk_size).max_compressed_buffer_size;
+    const size_t per_chunk = max_two_chunks - max_one_chunk;
+    const size_t per_chunk_table = sizeof(ChunkStartOffset_t) + sizeof(uint32_t) + 2 * sizeof(Checksum_t);
+    format_spec_size = manager.get_format_header_size();
+    if (max_three_chunks - max_two_chunks != per_chunk 
+        || per_chunk < per_chunk_table 
+        || max_one_chunk < per_chunk + sizeof(CommonHeader) + format_spec_size) {
+      throw HipCompException(hipcompErrorNotSupported, "ShardedManager requires chunked shard managers.");
+    }
+    max_comp_chunk_size = per_chunk - per_chunk_table;
+  }
+
+  virtual ~ShardedManagerImpl()
+  {
+    HipUtils::check(hipStreamSynchronize(user_stream));
+    for (auto& shard : shards) {
+      DeviceGuard guard(shard.device_id);
+      HipUtils::check(hipStreamSynchronize(shard.stream));
+    }
+    in_flight.release_finished();
+
+    for (auto& shard : shards) {
+      DeviceGuard guard(shard.device_id);
+      // The manager may free memory on the shard stream
+      shard.manager.reset();
+      HipUtils::check(hipFree(shard.container));
+      HipUtils::check(hipEventDestroy(shard.done));
+      HipUtils::check(hipStreamDestroy(shard.stream));
+    }
+    HipUtils::check(hipEventDestroy(inputs_ready));
+    HipUtils::check(hipHostFree(common_header_cpu));
+  }
+
+  ShardedManagerImpl(const ShardedManagerImpl&) = delete;
+  ShardedManagerImpl& operator=(const ShardedManagerImpl&) = delete;
+
+private: // helpers
+  ShardRange get_shard_range(const size_t ix, const size_t num_chunks) const
+  {
+    const size_t first_chunk = num_chunks * ix / shards.size();
+    const size_t end_chunk = num_chunks * (ix + 1) / shards.size();
+    return ShardRange{first_chunk, end_chunk - first_chunk};
+  }
+
+  size_t get_range_size(const ShardRange& range, const size_t decomp_data_size) const
+  {
+    const size_t offset = range.first_chunk * uncomp_chunk_size;
+    return std::min(range.num_chunks * uncomp_chunk_size, decomp_data_size - offset);
+  }
+
+  /**
+   * @brief Computes the offset of the chunk table in a container
+   *
+   * Matches BatchManager, which aligns the table in memory rather than within the container.
+   */
+  size_t get_chunk_table_offset(const uint8_t* container) const
+  {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(container);
+    return roundUpTo(start + sizeof(CommonHeader) + format_spec_size, sizeof(size_t)) - start;
+  }
+
+  /**
+   * @brief Computes the offset of the chunk data in a container 
+   */
+  size_t get_data_offset(const uint8_t* container, const size_t num_chunks) const
+  {
+    return get_chunk_table_offset(container) 
+        + num_chunks * (2 * sizeof(size_t) + 2 * sizeof(Checksum_t));
+  }
+
+  void check_not_capturing()
+  {
+    if (HipUtils::is_capturing(user_stream)) {
+      throw HipCompException(hipcompErrorNotSupported, "ShardedManager cannot be captured into a graph.");
+    }
+  }
+
+  void check_user_stream(hipStream_t stream)
+  {
+    if (stream != user_stream) {
+      throw HipCompException(hipcompErrorNotSupported, "ShardedManager can only run on the stream it was constructed with.");
+    }
+  }
+
+  void reserve_container(Shard& shard, const size_t size)
+  {
+    if (shard.container_size < size) {
+      HipUtils::check(hipFree(shard.container));
+      HipUtils::check(hipMalloc(&shard.container, size));
+      shard.container_size = size;
+    }
+  }
+
+public: // API
+  CompressionConfig configure_compression(const size_t decomp_buffer_size) final override
+  {
+    CompressionConfig comp_config{status_pool, decomp_buffer_size};
+    comp_config.num_chunks = roundUpDiv(decomp_buffer_size, uncomp_chunk_size);
+    // The unified container has the same layout as one produced by a single shard manager
+    comp_config.max_compressed_buffer_size = 
+        shards[0].manager->configure_compression(decomp_buffer_size).max_compressed_buffer_size;
+    return comp_config;
+  }
+
+  DecompressionConfig configure_decompression(const uint8_t* comp_buffer) final override
+  {
+    DeviceGuard guard(device_id);
+    HipUtils::check(hipMemcpyAsync(common_header_cpu, 
+        comp_buffer, 
+        sizeof(CommonHeader), 
+        hipMemcpyDefault, 
+        user_stream));
+    HipUtils::check(hipStreamSynchronize(user_stream));
+
+    DecompressionConfig decomp_config{status_pool};
+    decomp_config.decomp_data_size = common_header_cpu->decomp_data_size;
+    decomp_config.num_chunks = static_cast<uint32_t>(common_header_cpu->num_chunks);
+    return decomp_config;
+  }
+
+  DecompressionConfig configure_decompression(const CompressionConfig& comp_config) final override
+  {
+    DecompressionConfig decomp_config{status_pool};
+    decomp_config.decomp_data_size = comp_config.uncompressed_buffer_size;
+    decomp_config.num_chunks = static_cast<uint32_t>(comp_config.num_chunks);
+    return decomp_config;
+  }
+
+  void compress(
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config) final override
+  {
+    std::lock_guard<std::mutex> lock(call_mutex);
+    check_not_capturing();
+    in_flight.release_finished();
+    DeviceGuard guard(device_id);
+
+    const size_t num_chunks = comp_config.num_chunks;
+    CommonHeader* common_header = reinterpret_cast<CommonHeader*>(comp_buffer);
+    size_t* chunk_offsets = reinterpret_cast<size_t*>(comp_buffer + get_chunk_table_offset(comp_buffer));
+    size_t* chunk_sizes = chunk_offsets + num_chunks;
+    Checksum_t* chunk_checksums = reinterpret_cast<Checksum_t*>(chunk_sizes + num_chunks);
+    const size_t data_offset = get_data_offset(comp_buffer, num_chunks);
+
+    // comp_data_size counts the data appended so far
+    HipUtils::check(hipMemsetAsync(&common_header->comp_data_size, 0, sizeof(uint64_t), user_stream));
+    HipUtils::check(hipMemsetAsync(chunk_checksums, 0, 2 * num_chunks * sizeof(Checksum_t), user_stream));
+    // Also orders the shards after the previous use of their containers
+    HipUtils::check(hipEventRecord(inputs_ready, user_stream));
+
+    std::vector<CompressionConfig> shard_configs;
+    std::vector<size_t> shard_ixs;
+    shard_configs.reserve(shards.size());
+    for (size_t ix = 0; ix < shards.size(); ++ix) {
+      const ShardRange range = get_shard_range(ix, num_chunks);
+      // The first shard always runs, so that an empty buffer still gets its format header
+      if (range.num_chunks == 0 && ix != 0) {
+        continue;
+      }
+      Shard& shard = shards[ix];
+      DeviceGuard shard_guard(shard.device_id);
+
+      shard_configs.push_back(shard.manager->configure_compression(
+          get_range_size(range, comp_config.uncompressed_buffer_size)));
+      reserve_container(shard, shard_configs.back().max_compressed_buffer_size);
+
+      HipUtils::check(hipStreamWaitEvent(shard.stream, inputs_ready, 0));
+      shard.manager->compress(
+          decomp_buffer + range.first_chunk * uncomp_chunk_size, 
+          shard.container, 
+          shard_configs.back());
+      HipUtils::check(hipEventRecord(shard.done, shard.stream));
+      shard_ixs.push_back(ix);
+    }
+
+    // Merge the shards in chunk order as they finish
+    for (size_t i = 0; i < shard_ixs.size(); ++i) {
+      const ShardRange range = get_shard_range(shard_ixs[i], num_chunks);
+      Shard& shard = shards[shard_ixs[i]];
+      const CommonHeader* shard_header = reinterpret_cast<const CommonHeader*>(shard.container);
+      const size_t* shard_chunk_offsets = reinterpret_cast<const size_t*>(
+          shard.container + get_chunk_table_offset(shard.container));
+
+      HipUtils::check(hipStreamWaitEvent(user_stream, shard.done, 0));
+      if (i == 0) {
+        HipUtils::check(hipMemcpyAsync(comp_buffer + sizeof(CommonHeader), 
+            shard.container + sizeof(CommonHeader), 
+            format_spec_size, 
+            hipMemcpyDefault, 
+            user_stream));
+      }
+      shardedAppendChunkTable(
+          shard_chunk_offsets,
+          shard_chunk_offsets + range.num_chunks,
+          range.num_chunks,
+          chunk_offsets + range.first_chunk,
+          chunk_sizes + range.first_chunk,
+          common_header,
+          user_stream);
+      shardedAppendData(
+          shard_header,
+          shard.container + get_data_offset(shard.container, range.num_chunks),
+          common_header,
+          comp_buffer + data_offset,
+          range.num_chunks * max_comp_chunk_size,
+          user_stream);
+      shardedAdvance(shard_header, common_header, shard_configs[i].get_status(), comp_config.get_status(), user_stream);
+    }
+
+    shardedFinalize(
+        reinterpret_cast<const CommonHeader*>(shards[0].container),
+        common_header,
+        comp_config.uncompressed_buffer_size,
+        num_chunks,
+        static_cast<uint32_t>(data_offset),
+        user_stream);
+
+    in_flight.retire(user_stream, std::move(shard_configs), {});
+  }
+
+  void decompress(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& decomp_config) final override
+  {
+    std::lock_guard<std::mutex> lock(call_mutex);
+    check_not_capturing();
+    in_flight.release_finished();
+    DeviceGuard guard(device_id);
+
+    const size_t num_chunks = decomp_config.num_chunks;
+    if (num_chunks == 0) {
+      return;
+    }
+
+    // The chunk table is needed on the host to build a container per shard. This 
+    // also orders the shards after all work already on the user stream.
+    std::vector<uint8_t> format_spec(format_spec_size);
+    std::vector<size_t> chunk_table(2 * num_chunks);
+    HipUtils::check(hipMemcpyAsync(common_header_cpu, comp_buffer, sizeof(CommonHeader), hipMemcpyDefault, user_stream));
+    HipUtils::check(hipMemcpyAsync(format_spec.data(), 
+        comp_buffer + sizeof(CommonHeader), 
+        format_spec_size, 
+        hipMemcpyDefault, 
+        user_stream));
+    HipUtils::check(hipMemcpyAsync(chunk_table.data(), 
+        comp_buffer + get_chunk_table_offset(comp_buffer), 
+        chunk_table.size() * sizeof(size_t), 
+        hipMemcpyDefault, 
+        user_stream));
+    HipUtils::check(hipStreamSynchronize(user_stream));
+
+    if (common_header_cpu->num_chunks != num_chunks || common_header_cpu->uncomp_chunk_size != uncomp_chunk_size) {
+      throw HipCompException(hipcompErrorInvalidValue, "The compressed buffer does not match the config or chunk size.");
+    }
+    const size_t* chunk_offsets = chunk_table.data();
+    const size_t* chunk_sizes = chunk_offsets + num_chunks;
+    const uint8_t* data = comp_buffer + get_data_offset(comp_buffer, num_chunks);
+
+    std::vector<DecompressionConfig> shard_configs;
+    shard_configs.reserve(shards.size());
+    for (size_t ix = 0; ix < shards.size(); ++ix) {
+      const ShardRange range = get_shard_range(ix, num_chunks);
+      if (range.num_chunks == 0) {
+        continue;
+      }
+      Shard& shard = shards[ix];
+      DeviceGuard shard_guard(shard.device_id);
+
+      // The shard's chunks normally sit together, but any layout works: the span 
+      // covering them is copied and the offsets are rebased to its start
+      size_t span_begin = chunk_offsets[range.first_chunk];
+      size_t span_end = span_begin;
+      for (size_t c = range.first_chunk; c < range.first_chunk + range.num_chunks; ++c) {
+        span_begin = std::min(span_begin, chunk_offsets[c]);
+        span_end = std::max(span_end, chunk_offsets[c] + chunk_sizes[c]);
+      }
+
+      // Shard containers come from hipMalloc, so the layout of an aligned address applies
+      const size_t shard_data_offset = get_data_offset(nullptr, range.num_chunks);
+      reserve_container(shard, shard_data_offset + span_end - span_begin);
+      if (!shard.staging || shard.staging->size() < shard_data_offset) {
+        shard.staging.reset();
+        shard.staging = staging_pool.allocate(shard_data_offset);
+      }
+
+      uint8_t* prefix = shard.staging->get_ptr();
+      std::memset(prefix, 0, shard_data_offset);
+      CommonHeader shard_header = *common_header_cpu;
+      shard_header.comp_data_size = span_end - span_begin;
+      shard_header.decomp_data_size = get_range_size(range, decomp_config.decomp_data_size);
+      shard_header.num_chunks = range.num_chunks;
+      shard_header.comp_data_offset = static_cast<uint32_t>(shard_data_offset);
+      std::memcpy(prefix, &shard_header, sizeof(CommonHeader));
+      std::memcpy(prefix + sizeof(CommonHeader), format_spec.data(), format_spec_size);
+      size_t* shard_chunk_offsets = reinterpret_cast<size_t*>(prefix + get_chunk_table_offset(nullptr));
+      for (size_t c = 0; c < range.num_chunks; ++c) {
+        shard_chunk_offsets[c] = chunk_offsets[range.first_chunk + c] - span_begin;
+        shard_chunk_offsets[range.num_chunks + c] = chunk_sizes[range.first_chunk + c];
+      }
+
+      HipUtils::check(hipMemcpyAsync(shard.container, prefix, shard_data_offset, hipMemcpyHostToDevice, shard.stream));
+      HipUtils::check(hipMemcpyAsync(shard.container + shard_data_offset, 
+          data + span_begin, 
+          span_end - span_begin, 
+          hipMemcpyDefault, 
+          shard.stream));
+
+      // Built from the known shard size instead of reading the header back
+      shard_configs.push_back(shard.manager->configure_decompression(
+          shard.manager->configure_compression(shard_header.decomp_data_size)));
+      shard.manager->decompress(
+          decomp_buffer + range.first_chunk * uncomp_chunk_size, 
+          shard.container, 
+          shard_configs.back());
+      HipUtils::check(hipEventRecord(shard.done, shard.stream));
+      HipUtils::check(hipStreamWaitEvent(user_stream, shard.done, 0));
+    }
+
+    for (const auto& shard_config : shard_configs) {
+      mergeOutputStatus(shard_config.get_status(), decomp_config.get_status(), user_stream);
+    }
+
+    in_flight.retire(user_stream, {}, std::move(shard_configs));
+  }
+
+  void compress(
+      const uint8_t* decomp_buffer, 
+      uint8_t* comp_buffer,
+      const CompressionConfig& comp_config,
+      hipStream_t stream) final override
+  {
+    check_user_stream(stream);
+    compress(decomp_buffer, comp_buffer, comp_config);
+  }
+
+  void decompress(
+      uint8_t* decomp_buffer, 
+      const uint8_t* comp_buffer,
+      const DecompressionConfig& decomp_config,
+      hipStream_t stream) final override
+  {
+    check_user_stream(stream);
+    decompress(decomp_buffer, comp_buffer, decomp_config);
+  }
+
+  size_t get_in_place_decompression_margin(const size_t /*decomp_buffer_size*/) final override
+  {
+    throw HipCompException(hipcompErrorNotSupported, "In-place decompression is not supported by ShardedManager.");
+  }
+
+  void decompress_in_place(
+      uint8_t* /*decomp_buffer*/, 
+      const uint8_t* /*comp_buffer*/,
+      const DecompressionConfig& /*decomp_config*/) final override
+  {
+    throw HipCompException(hipcompErrorNotSupported, "In-place decompression is not supported by ShardedManager.");
+  }
+
+  void set_scratch_buffer(uint8_t* /*new_scratch_buffer*/) final override
+  {
+    throw HipCompException(hipcompErrorNotSupported, "ShardedManager allocates its scratch space on each shard device.");
+  }
+
+  void allocate_scratch_buffer() final override
+  {
+    for (auto& shard : shards) {
+      DeviceGuard guard(shard.device_id);
+      shard.manager->allocate_scratch_buffer();
+    }
+  }
+
+  size_t get_required_scratch_buffer_size() final override
+  {
+    return 0;
+  }
+
+  size_t get_compressed_output_size(uint8_t* comp_buffer) final override
+  {
+    std::lock_guard<std::mutex> lock(call_mutex);
+    DeviceGuard guard(device_id);
+    HipUtils::check(hipMemcpy(common_header_cpu, comp_buffer, sizeof(CommonHeader), hipMemcpyDefault));
+    return common_header_cpu->comp_data_size + common_header_cpu->comp_data_offset;
+  }
+
+  void get_compressed_output_size_async(
+      const uint8_t* comp_buffer, 
+      size_t* comp_size,
+      hipEvent_t event = nullptr) final override
+  {
+    CHECK_NOT_NULL(comp_size);
+    DeviceGuard guard(device_id);
+
+    copyCompressedOutputSize(reinterpret_cast<const CommonHeader*>(comp_buffer), comp_size, user_stream);
+
+    if (event != nullptr) {
+      HipUtils::check(hipEventRecord(event, user_stream));
+    }
+  }
+
+  MemoryFootprint get_memory_footprint(
+      const size_t decomp_buffer_size, 
+      const size_t batch_count = 1) final override
+  {
+    MemoryFootprint footprint{};
+    footprint.max_output = batch_count * configure_compression(decomp_buffer_size).max_compressed_buffer_size;
+    footprint.status_pool = PinnedPtrPool<hipcompStatus_t>::capacity_for(batch_count) * sizeof(hipcompStatus_t);
+    footprint.headers = sizeof(CommonHeader);
+    footprint.configs = batch_count * (sizeof(CompressionConfig) 
+        + sizeof(PinnedPtrPool<hipcompStatus_t>::PinnedPtrHandle));
+
+    const size_t num_chunks = roundUpDiv(decomp_buffer_size, uncomp_chunk_size);
+    for (size_t ix = 0; ix < shards.size(); ++ix) {
+      const size_t shard_size = get_range_size(get_shard_range(ix, num_chunks), decomp_buffer_size);
+      const MemoryFootprint shard_footprint = shards[ix].manager->get_memory_footprint(shard_size);
+      footprint.scratch += shard_footprint.scratch;
+      footprint.ix_chunk += shard_footprint.ix_chunk;
+      footprint.contexts += shard_footprint.contexts;
+      // The shard containers are intermediate buffers
+      footprint.temp += shard_footprint.max_output;
+      footprint.status_pool += shard_footprint.status_pool;
+      footprint.headers += shard_footprint.headers;
+      footprint.configs += shard_footprint.configs;
+    }
+    return footprint;
+  }
+
+  std::vector<KernelResourceUsage> get_kernel_resource_usage() final override
+  {
+    // Each entry names the device of its shard
+    std::vector<KernelResourceUsage> usage;
+    for (const Shard& shard : shards) {
+      const std::vector<KernelResourceUsage> shard_usage = shard.manager->get_kernel_resource_usage();
+      usage.insert(usage.end(), shard_usage.begin(), shard_usage.end());
+    }
+    return usage;
+  }
+
+  size_t get_format_header_size() final override
+  {
+    // The merged container has the format of the shard containers
+    return format_spec_size;
+  }
+};
+
+ShardedManager::ShardedManager(
+    const ShardManagerFactory& create_shard_manager,
+    size_t uncomp_chunk_size,
+    const std::vector<int>& shard_device_ids,
+    hipStream_t user_stream, 
+    const int device_id)
+{
+  impl = std::make_unique<ShardedManagerImpl>(
+      create_shard_manager, uncomp_chunk_size, shard_device_ids, user_stream, device_id);
+}
+
+ShardedManager::~ShardedManager() 
+{}
+
+} // namespace hipcomp
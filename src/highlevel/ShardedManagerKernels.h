@@ -0,0 +1,97 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hipcomp.h"
+#include "hipcomp_common_deps/hlif_shared_types.hpp"
+
+#include "hip/hip_runtime.h"
+
+namespace hipcomp {
+
+/**
+ * @brief Copies the chunk table of a shard container into the unified chunk table, 
+ * ordered on stream.
+ *
+ * The shard's chunk offsets are rebased by the number of data bytes already appended,
+ * which is read from comp_data_size in the header of the unified container.
+ *
+ * @param shard_chunk_offsets The chunk offsets of the shard container (GPU accessible).
+ * @param shard_chunk_sizes The chunk sizes of the shard container (GPU accessible).
+ * @param shard_num_chunks The number of chunks in the shard.
+ * @param chunk_offsets The unified chunk offsets, starting at the shard's first chunk.
+ * @param chunk_sizes The unified chunk sizes, starting at the shard's first chunk.
+ * @param common_header The header of the unified container.
+ */
+void shardedAppendChunkTable(
+    const size_t* shard_chunk_offsets,
+    const size_t* shard_chunk_sizes,
+    size_t shard_num_chunks,
+    size_t* chunk_offsets,
+    size_t* chunk_sizes,
+    const CommonHeader* common_header,
+    hipStream_t stream);
+
+/**
+ * @brief Copies the compressed data of a shard container behind the data already
+ * appended to the unified container.
+ *
+ * The size is only known on the device, so the launch covers max_data_size and 
+ * the threads past the end of the data exit.
+ *
+ * @param shard_header The header of the shard container (GPU accessible).
+ * @param shard_data The compressed data of the shard container (GPU accessible).
+ * @param common_header The header of the unified container.
+ * @param data The compressed data of the unified container.
+ * @param max_data_size The maximum compressed data size of the shard.
+ */
+void shardedAppendData(
+    const CommonHeader* shard_header,
+    const uint8_t* shard_data,
+    const CommonHeader* common_header,
+    uint8_t* data,
+    size_t max_data_size,
+    hipStream_t stream);
+
+/**
+ * @brief Accounts for the data of a shard in the unified header and merges the shard status.
+ */
+void shardedAdvance(
+    const CommonHeader* shard_header,
+    CommonHeader* common_header,
+    const hipcompStatus_t* shard_status,
+    hipcompStatus_t* output_status,
+    hipStream_t stream);
+
+/**
+ * @brief Fills the remaining fields of the unified header from the header of the first shard.
+ */
+void shardedFinalize(
+    const CommonHeader* shard_header,
+    CommonHeader* common_header,
+    size_t decomp_data_size,
+    size_t num_chunks,
+    uint32_t comp_data_offset,
+    hipStream_t stream);
+
+} // namespace hipcomp
@@ -50,6 +50,7 @@
 #pragma once
 
 #include "hipcomp.h"
+#include "hipcomp/hipcompManager.hpp"
 #include "hipcomp_common_deps/hlif_shared_types.hpp"
 
 namespace hipcomp {
@@ -71,7 +72,7 @@ void snappyHlifBatchDecompress(
     hipStream_t stream,
     hipcompStatus_t* output_status);
 
-size_t snappyHlifDecompMaxBlockOccupancy(const int device_id); 
-size_t snappyHlifCompMaxBlockOccupancy(const int device_id);
+KernelResourceUsage snappyHlifDecompKernelUsage(const int device_id); 
+KernelResourceUsage snappyHlifCompKernelUsage(const int device_id);
 
 } // namespace hipcomp
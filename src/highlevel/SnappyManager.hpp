@@ -93,14 +93,14 @@ public:
     return max_comp_chunk_size;
   }
 
-  uint32_t compute_compression_max_block_occupancy() final override 
+  KernelResourceUsage compute_compression_kernel_usage() final override 
   {
-    return snappyHlifCompMaxBlockOccupancy(device_id);
+    return snappyHlifCompKernelUsage(device_id);
   }
 
-  uint32_t compute_decompression_max_block_occupancy() final override 
+  KernelResourceUsage compute_decompression_kernel_usage() final override 
   {
-    return snappyHlifDecompMaxBlockOccupancy(device_id); 
+    return snappyHlifDecompKernelUsage(device_id); 
   }  
 
   SnappyFormatSpecHeader* get_format_header() final override 
@@ -108,12 +108,17 @@ public:
     return format_spec;
   }
 
-  void do_batch_compress(const CompressArgs& compress_args) final override
+  const char* get_codec_name() const final override
+  {
+    return "snappy";
+  }
+
+  void do_batch_compress(const CompressArgs& compress_args, hipStream_t stream) final override
   {
     snappyHlifBatchCompress(
         compress_args,
         get_max_comp_ctas(),
-        user_stream);
+        stream);
   }
 
   void do_batch_decompress(
@@ -122,18 +127,19 @@ public:
       const uint32_t num_chunks,
       const size_t* comp_chunk_offsets,
       const size_t* comp_chunk_sizes,
-      hipcompStatus_t* output_status) final override
+      hipcompStatus_t* output_status,
+      const ExecutionContext& context) final override
   {        
     snappyHlifBatchDecompress(
         comp_data_buffer,
         decomp_buffer,
         get_uncomp_chunk_size(),
-        ix_chunk,
+        context.ix_chunk,
         num_chunks,
         comp_chunk_offsets,
         comp_chunk_sizes,
         get_max_decomp_ctas(),
-        user_stream,
+        context.stream,
         output_status);
   }
 };
@@ -0,0 +1,150 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace hipcomp {
+
+/**
+ * @brief Decides which part of a batch runs on the device and which on the host.
+ *
+ * Keeps a moving average of the throughput of each side and gives the device the 
+ * share of the bytes it can finish in the time the host finishes the rest. While 
+ * both sides exist, each keeps at least min_share of the bytes so that a change
+ * in either throughput is still noticed, e.g. once other work leaves the device 
+ * idle again.
+ *
+ * Not thread-safe.
+ */
+struct ThroughputSplit {
+private:
+  bool has_device;
+  double smoothing;
+  double min_share;
+  double device_share;
+  // Bytes per second, 0 until measured
+  double device_rate;
+  double host_rate;
+
+public:
+  /**
+   * @brief Creates the split.
+   *
+   * @param has_device Whether there is a device side. Without one, all chunks run on the host.
+   * @param initial_device_share The device's share of the bytes until both throughputs are measured.
+   * @param smoothing The weight of a new measurement in the moving averages, in (0, 1].
+   * @param min_share The least share of the bytes each side gets, in [0, 0.5].
+   */
+  ThroughputSplit(
+      const bool has_device,
+      const double initial_device_share,
+      const double smoothing,
+      const double min_share)
+    : has_device(has_device),
+      smoothing(smoothing),
+      min_share(min_share),
+      device_share(has_device ? clamp_share(initial_device_share) : 0.0),
+      device_rate(0.0),
+      host_rate(0.0)
+  {}
+
+  /**
+   * @brief The number of chunks, from the front of the batch, that run on the device.
+   *
+   * The device gets the shortest prefix that holds its share of the bytes, except 
+   * for a share of 0 or 1, which leaves the whole batch to one side.
+   *
+   * @param chunk_bytes The chunk sizes.
+   * @param batch_size The number of chunks.
+   */
+  size_t split(const size_t* const chunk_bytes, const size_t batch_size) const
+  {
+    if (device_share <= 0.0) {
+      return 0;
+    } else if (device_share >= 1.0) {
+      return batch_size;
+    }
+
+    double total_bytes = 0;
+    for (size_t i = 0; i < batch_size; ++i) {
+      total_bytes += static_cast<double>(chunk_bytes[i]);
+    }
+
+    const double device_bytes = device_share * total_bytes;
+    double prefix_bytes = 0;
+    size_t num_device = 0;
+    while (num_device < batch_size && prefix_bytes < device_bytes) {
+      prefix_bytes += static_cast<double>(chunk_bytes[num_device]);
+      ++num_device;
+    }
+    return num_device;
+  }
+
+  /**
+   * @brief Updates the split with how long each side took for its part of a batch.
+   *
+   * A side that had no bytes or took no measurable time keeps its last throughput.
+   */
+  void record(
+      const size_t device_bytes, 
+      const double device_seconds, 
+      const size_t host_bytes, 
+      const double host_seconds)
+  {
+    if (!has_device) {
+      return;
+    }
+    if (device_bytes > 0 && device_seconds > 0.0) {
+      device_rate = average(device_rate, device_bytes / device_seconds);
+    }
+    if (host_bytes > 0 && host_seconds > 0.0) {
+      host_rate = average(host_rate, host_bytes / host_seconds);
+    }
+    if (device_rate > 0.0 && host_rate > 0.0) {
+      device_share = clamp_share(device_rate / (device_rate + host_rate));
+    }
+  }
+
+  /**
+   * @brief The share of the bytes of a batch that runs on the device.
+   */
+  double get_device_share() const
+  {
+    return device_share;
+  }
+
+private:
+  double clamp_share(const double share) const
+  {
+    return std::min(std::max(share, min_share), 1.0 - min_share);
+  }
+
+  double average(const double current, const double measured) const
+  {
+    return current > 0.0 ? (1.0 - smoothing) * current + smoothing * measured : measured;
+  }
+};
+
+} // namespace hipcomp
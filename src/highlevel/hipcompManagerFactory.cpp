@@ -57,6 +57,7 @@
 #include "hipcomp/gdeflate.hpp"
 #include "hipcomp/cascaded.hpp"
 #include "hipcomp/bitcomp.hpp"
+#include "hipcomp/hipcompSegmentedManager.hpp"
 #include "hipcomp_common_deps/hlif_shared_types.hpp"
 #include "HipUtils.h"
 
@@ -138,6 +139,31 @@ std::shared_ptr<hipcompManagerBase> create_manager(const uint8_t* comp_buffer, h
       res = std::make_shared<CascadedManager>(format_spec.options, stream, device_id);
       break;
     }
+    case FormatType::Segmented: 
+    {
+      SegmentedFormatSpecHeader format_spec;
+      const SegmentedFormatSpecHeader* gpu_format_header = reinterpret_cast<const SegmentedFormatSpecHeader*>(comp_buffer + sizeof(CommonHeader));
+      HipUtils::check(hipMemcpyAsync(&format_spec, gpu_format_header, sizeof(SegmentedFormatSpecHeader), hipMemcpyDefault, stream));
+      // The first entry of the segment table locates the first segment, whose header names the segment format
+      uint64_t first_segment_offset;
+      HipUtils::check(hipMemcpyAsync(&first_segment_offset, gpu_format_header + 1, sizeof(uint64_t), hipMemcpyDefault, stream));
+      HipUtils::check(hipStreamSynchronize(stream));
+
+      if (cpu_common_header.num_chunks == 0) {
+        throw HipCompException(hipcompErrorNotSupported, "Cannot determine the segment format of an empty segmented buffer.");
+      }
+
+      const uint8_t* first_segment = comp_buffer + first_segment_offset;
+      res = std::make_shared<SegmentedManager>(
+          [first_segment, device_id](hipStream_t segment_stream) {
+            return create_manager(first_segment, segment_stream, device_id);
+          },
+          format_spec.segment_size, 
+          SEGMENTED_DEFAULT_NUM_STREAMS,
+          stream, 
+          device_id);
+      break;
+    }
     case FormatType::NotSupportedError:
     {
       assert(false);
@@ -0,0 +1,293 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "tests/catch.hpp"
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompCoalescingService.hpp"
+
+using namespace hipcomp;
+using namespace std;
+
+namespace {
+
+/**
+ * Host codec that run-length encodes bytes as (count, value) pairs and records 
+ * the batches it is given.
+ */
+struct HostRLEBackend : BatchedCompressBackend {
+  size_t max_batch_size;
+  size_t max_chunk_size;
+  bool fail;
+  std::mutex mutex;
+  std::vector<size_t> batch_sizes;
+  // Catch assertions are not thread-safe, so violations are recorded instead
+  std::atomic<bool> bad_max_chunk_bytes;
+  std::atomic<int> concurrent_calls;
+  std::atomic<int> max_concurrent_calls;
+
+  HostRLEBackend(size_t max_batch_size, size_t max_chunk_size) 
+    : max_batch_size(max_batch_size),
+      max_chunk_size(max_chunk_size),
+      fail(false),
+      mutex(),
+      batch_sizes(),
+      bad_max_chunk_bytes(false),
+      concurrent_calls(0),
+      max_concurrent_calls(0)
+  {}
+
+  size_t get_max_chunk_size() const override
+  {
+    return max_chunk_size;
+  }
+
+  size_t get_max_batch_size() const override
+  {
+    return max_batch_size;
+  }
+
+  size_t get_max_compressed_chunk_size(size_t uncompressed_bytes) const override
+  {
+    return 2 * uncompressed_bytes;
+  }
+
+  void compress_batch(
+      const void* const* uncompressed_ptrs,
+      const size_t* uncompressed_bytes,
+      size_t max_uncompressed_chunk_bytes,
+      size_t batch_size,
+      void* const* compressed_ptrs,
+      size_t* compressed_bytes) override
+  {
+    const int calls = ++concurrent_calls;
+    max_concurrent_calls = std::max(max_concurrent_calls.load(), calls);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      batch_sizes.push_back(batch_size);
+    }
+
+    size_t max_bytes = 0;
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      max_bytes = std::max(max_bytes, uncompressed_bytes[ix]);
+    }
+    if (max_bytes != max_uncompressed_chunk_bytes) {
+      bad_max_chunk_bytes = true;
+    }
+
+    if (fail) {
+      --concurrent_calls;
+      throw HipCompException(hipcompErrorCannotDecompress, "backend failure");
+    }
+
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      const uint8_t* in = static_cast<const uint8_t*>(uncompressed_ptrs[ix]);
+      uint8_t* out = static_cast<uint8_t*>(compressed_ptrs[ix]);
+      size_t out_size = 0;
+      for (size_t i = 0; i < uncompressed_bytes[ix];) {
+        size_t run = 1;
+        while (i + run < uncompressed_bytes[ix] && in[i + run] == in[i] && run < 255) {
+          ++run;
+        }
+        out[out_size++] = static_cast<uint8_t>(run);
+        out[out_size++] = in[i];
+        i += run;
+      }
+      compressed_bytes[ix] = out_size;
+    }
+    --concurrent_calls;
+  }
+};
+
+std::vector<uint8_t> rle_decode(const uint8_t* data, size_t size)
+{
+  std::vector<uint8_t> res;
+  for (size_t i = 0; i < size; i += 2) {
+    res.insert(res.end(), data[i], data[i + 1]);
+  }
+  return res;
+}
+
+std::vector<uint8_t> make_input(size_t seed, size_t size)
+{
+  std::vector<uint8_t> res(size);
+  for (size_t i = 0; i < size; ++i) {
+    res[i] = static_cast<uint8_t>((seed + i / (1 + seed % 7)) % 251);
+  }
+  return res;
+}
+
+} // namespace
+
+TEST_CASE("CoalescingServiceMultiThreadTest", "[small]")
+{
+  constexpr size_t num_threads = 8;
+  constexpr size_t requests_per_thread = 200;
+
+  auto backend = std::make_unique<HostRLEBackend>(64, 1 << 16);
+  HostRLEBackend& backend_ref = *backend;
+
+  CoalescingOptions options;
+  options.max_batch_size = 32;
+  options.max_delay = std::chrono::microseconds(2000);
+  CoalescingCompressionService service{std::move(backend), options};
+
+  std::vector<std::thread> threads;
+  std::atomic<size_t> num_mismatches{0};
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<std::vector<uint8_t>> inputs;
+      std::vector<std::vector<uint8_t>> outputs;
+      std::vector<std::future<size_t>> futures;
+      for (size_t r = 0; r < requests_per_thread; ++r) {
+        inputs.push_back(make_input(t * requests_per_thread + r, 100 + (r * 37) % 4000));
+        outputs.emplace_back(service.get_max_compressed_size(inputs.back().size()));
+      }
+      for (size_t r = 0; r < requests_per_thread; ++r) {
+        futures.push_back(service.submit(inputs[r].data(), inputs[r].size(), outputs[r].data()));
+      }
+      for (size_t r = 0; r < requests_per_thread; ++r) {
+        const size_t comp_size = futures[r].get();
+        if (rle_decode(outputs[r].data(), comp_size) != inputs[r]) {
+          ++num_mismatches;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(num_mismatches == 0);
+
+  // requests were coalesced, and no launch broke the batch size limit
+  const size_t num_requests = num_threads * requests_per_thread;
+  REQUIRE(service.get_num_launches() < num_requests);
+  size_t total = 0;
+  for (size_t batch_size : backend_ref.batch_sizes) {
+    REQUIRE(batch_size <= 32);
+    total += batch_size;
+  }
+  REQUIRE(total == num_requests);
+  REQUIRE(!backend_ref.bad_max_chunk_bytes);
+  REQUIRE(backend_ref.max_concurrent_calls == 1);
+}
+
+TEST_CASE("CoalescingServiceBatchBytesTest", "[small]")
+{
+  auto backend = std::make_unique<HostRLEBackend>(1024, 1 << 20);
+  HostRLEBackend& backend_ref = *backend;
+
+  CoalescingOptions options;
+  options.max_batch_bytes = 10000;
+  options.max_delay = std::chrono::microseconds(100000);
+
+  std::vector<std::vector<uint8_t>> inputs;
+  std::vector<std::vector<uint8_t>> outputs;
+  for (size_t r = 0; r < 10; ++r) {
+    inputs.push_back(make_input(r, 4000));
+    outputs.emplace_back(2 * 4000);
+  }
+  CoalescingCompressionService service{std::move(backend), options};
+  {
+    std::vector<std::future<size_t>> futures;
+    for (size_t r = 0; r < inputs.size(); ++r) {
+      futures.push_back(service.submit(inputs[r].data(), inputs[r].size(), outputs[r].data()));
+    }
+    for (size_t r = 0; r < inputs.size(); ++r) {
+      REQUIRE(rle_decode(outputs[r].data(), futures[r].get()) == inputs[r]);
+    }
+
+    // at most two 4000 byte requests fit in 10000 bytes
+    for (size_t batch_size : backend_ref.batch_sizes) {
+      REQUIRE(batch_size <= 2);
+    }
+  }
+}
+
+TEST_CASE("CoalescingServiceLatencyTest", "[small]")
+{
+  CoalescingOptions options;
+  options.max_delay = std::chrono::microseconds(1000);
+  CoalescingCompressionService service{std::make_unique<HostRLEBackend>(1024, 1 << 16), options};
+
+  // a lone request launches once its delay runs out instead of waiting for a full batch
+  const std::vector<uint8_t> input = make_input(3, 1000);
+  std::vector<uint8_t> output(2 * input.size());
+  auto future = service.submit(input.data(), input.size(), output.data());
+  REQUIRE(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+  REQUIRE(rle_decode(output.data(), future.get()) == input);
+  REQUIRE(service.get_num_launches() == 1);
+}
+
+TEST_CASE("CoalescingServiceErrorTest", "[small]")
+{
+  auto backend = std::make_unique<HostRLEBackend>(16, 1000);
+  HostRLEBackend& backend_ref = *backend;
+  CoalescingCompressionService service{std::move(backend)};
+
+  const std::vector<uint8_t> input = make_input(0, 2000);
+  std::vector<uint8_t> output(2 * input.size());
+
+  // larger than the backend's maximum chunk size
+  auto too_large = service.submit(input.data(), input.size(), output.data());
+  REQUIRE_THROWS_AS(too_large.get(), HipCompException);
+
+  backend_ref.fail = true;
+  auto failed = service.submit(input.data(), 500, output.data());
+  try {
+    failed.get();
+    FAIL("expected the backend error");
+  } catch (const HipCompException& e) {
+    REQUIRE(e.get_error() == hipcompErrorCannotDecompress);
+  }
+}
+
+TEST_CASE("CoalescingServiceDrainTest", "[small]")
+{
+  CoalescingOptions options;
+  // long enough that only the destructor can flush the requests
+  options.max_delay = std::chrono::microseconds(60000000);
+
+  std::vector<uint8_t> input = make_input(5, 300);
+  std::vector<std::vector<uint8_t>> outputs(5, std::vector<uint8_t>(600));
+  std::vector<std::future<size_t>> futures;
+  {
+    CoalescingCompressionService service{std::make_unique<HostRLEBackend>(1024, 1 << 16), options};
+    for (auto& output : outputs) {
+      futures.push_back(service.submit(input.data(), input.size(), output.data()));
+    }
+  }
+  for (size_t r = 0; r < outputs.size(); ++r) {
+    REQUIRE(futures[r].wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    REQUIRE(rle_decode(outputs[r].data(), futures[r].get()) == input);
+  }
+}
@@ -0,0 +1,116 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "hip/hip_runtime.h"
+
+#include "tests/catch.hpp"
+
+#include "highlevel/CompressionConfigs.hpp"
+
+using namespace hipcomp;
+using namespace std;
+
+namespace {
+std::atomic<size_t> num_heap_allocations{0};
+}
+
+void* operator new(size_t size)
+{
+  ++num_heap_allocations;
+  void* res = malloc(size == 0 ? 1 : size);
+  if (res == nullptr) {
+    throw std::bad_alloc();
+  }
+  return res;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  free(ptr);
+}
+
+TEST_CASE("test_configs_steady_state_allocations")
+{
+  PinnedPtrPool<hipcompStatus_t> pool{};
+
+  auto make_configs = [&]() {
+    CompressionConfig comp_config{pool, 1 << 16};
+    DecompressionConfig decomp_config{pool};
+    *comp_config.get_status() = hipcompErrorInvalidValue;
+    *decomp_config.get_status() = hipcompErrorInvalidValue;
+
+    // copies share the impl and moves steal it
+    CompressionConfig comp_copy{comp_config};
+    CompressionConfig comp_moved{std::move(comp_copy)};
+    REQUIRE(comp_moved.get_status() == comp_config.get_status());
+    DecompressionConfig decomp_moved{std::move(decomp_config)};
+    REQUIRE(*decomp_moved.get_status() == hipcompErrorInvalidValue);
+  };
+
+  // warm up
+  make_configs();
+
+  const size_t allocations_before = num_heap_allocations;
+  for (size_t i = 0; i < 1000; ++i) {
+    make_configs();
+  }
+  REQUIRE(num_heap_allocations == allocations_before);
+}
+
+TEST_CASE("test_configs_recycle_statuses")
+{
+  PinnedPtrPool<hipcompStatus_t> pool{};
+
+  hipcompStatus_t* first_status;
+  {
+    CompressionConfig comp_config{pool, 100};
+    first_status = comp_config.get_status();
+    REQUIRE(*first_status == hipcompSuccess);
+    *first_status = hipcompErrorInvalidValue;
+  }
+
+  // the status is returned to the pool and reset by the next config
+  CompressionConfig comp_config{pool, 100};
+  REQUIRE(comp_config.get_status() == first_status);
+  REQUIRE(*comp_config.get_status() == hipcompSuccess);
+
+  // configs alive at the same time never share a status
+  vector<DecompressionConfig> decomp_configs;
+  for (size_t i = 0; i < 2 * PINNED_POOL_PREALLOC_SIZE; ++i) {
+    decomp_configs.emplace_back(pool);
+    for (size_t j = 0; j < i; ++j) {
+      REQUIRE(decomp_configs[j].get_status() != decomp_configs[i].get_status());
+    }
+    REQUIRE(decomp_configs[i].get_status() != comp_config.get_status());
+  }
+}
@@ -0,0 +1,276 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tests/catch.hpp"
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompHostThreadPool.hpp"
+
+using namespace hipcomp;
+using namespace std;
+
+namespace {
+
+/**
+ * A sysfs tree with two NUMA nodes and one PCI device on node 1, in a temporary directory
+ */
+struct FakeSysfs {
+  std::string root;
+
+  FakeSysfs(const std::string& node0_cpus, const std::string& node1_cpus)
+  {
+    char dir_template[] = "/tmp/hipcomp_sysfs_XXXXXX";
+    REQUIRE(mkdtemp(dir_template) != nullptr);
+    root = dir_template;
+
+    make_dirs("/devices/system/node/node0");
+    make_dirs("/devices/system/node/node1");
+    make_dirs("/devices/system/node/possible_not_a_node");
+    make_dirs("/bus/pci/devices/0000:c1:00.0");
+    write("/devices/system/node/node0/cpulist", node0_cpus + "\n");
+    write("/devices/system/node/node1/cpulist", node1_cpus + "\n");
+    write("/bus/pci/devices/0000:c1:00.0/numa_node", "1\n");
+  }
+
+  ~FakeSysfs()
+  {
+    const std::string command = "rm -rf " + root;
+    REQUIRE(std::system(command.c_str()) == 0);
+  }
+
+  void make_dirs(const std::string& path)
+  {
+    std::string dir = root;
+    size_t start = 1;
+    while (start <= path.size()) {
+      const size_t end = std::min(path.find('/', start), path.size());
+      dir += path.substr(start - 1, end - start + 1);
+      mkdir(dir.c_str(), 0755);
+      start = end + 1;
+    }
+  }
+
+  void write(const std::string& path, const std::string& contents)
+  {
+    std::ofstream file(root + path);
+    file << contents;
+  }
+};
+
+std::vector<int> allowed_cpus()
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  REQUIRE(sched_getaffinity(0, sizeof(set), &set) == 0);
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &set)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("HostTopologyTest", "[small]")
+{
+  FakeSysfs sysfs("0-3,8", "4-7, 9-10");
+
+  const HostTopology topology = HostTopology::detect(sysfs.root);
+  REQUIRE(topology.node_cpus.size() == 2);
+  REQUIRE(topology.node_cpus[0] == std::vector<int>({0, 1, 2, 3, 8}));
+  REQUIRE(topology.node_cpus[1] == std::vector<int>({4, 5, 6, 7, 9, 10}));
+
+  REQUIRE(get_pci_numa_node("0000:C1:00.0", sysfs.root) == 1);
+  REQUIRE(get_pci_numa_node("0000:c2:00.0", sysfs.root) == -1);
+
+  REQUIRE(HostTopology::detect(sysfs.root + "/missing").node_cpus.empty());
+}
+
+TEST_CASE("HostThreadPoolPinningTest", "[small]")
+{
+  // Node 0 holds a CPU this process may run on
+  const std::vector<int> cpus = allowed_cpus();
+  REQUIRE(!cpus.empty());
+  FakeSysfs sysfs(std::to_string(cpus.front()), "100000");
+
+  HostThreadPoolOptions options;
+  options.numa_node = 0;
+  options.sysfs_root = sysfs.root;
+  HostThreadPool pool(options);
+  REQUIRE(pool.get_numa_node() == 0);
+  REQUIRE(pool.get_cpus() == std::vector<int>({cpus.front()}));
+  // One thread per CPU of the node
+  REQUIRE(pool.get_num_threads() == 1);
+
+  std::mutex mutex;
+  std::set<int> seen_cpus;
+  std::thread::id caller = std::this_thread::get_id();
+  pool.parallel_for(64, [&](size_t) {
+    if (std::this_thread::get_id() != caller) {
+      std::lock_guard<std::mutex> lock(mutex);
+      seen_cpus.insert(sched_getcpu());
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  });
+  for (const int cpu : seen_cpus) {
+    REQUIRE(cpu == cpus.front());
+  }
+
+  SECTION("no pinning")
+  {
+    HostThreadPoolOptions unpinned = options;
+    unpinned.pin_threads = false;
+    unpinned.num_threads = 3;
+    HostThreadPool unpinned_pool(unpinned);
+    REQUIRE(unpinned_pool.get_numa_node() == -1);
+    REQUIRE(unpinned_pool.get_cpus().empty());
+    REQUIRE(unpinned_pool.get_num_threads() == 3);
+  }
+
+  SECTION("unknown node")
+  {
+    HostThreadPoolOptions unknown = options;
+    unknown.numa_node = 5;
+    HostThreadPool unknown_pool(unknown);
+    REQUIRE(unknown_pool.get_numa_node() == -1);
+    REQUIRE(unknown_pool.get_num_threads() > 0);
+  }
+}
+
+TEST_CASE("HostThreadPoolParallelForTest", "[small]")
+{
+  HostThreadPoolOptions options;
+  options.pin_threads = false;
+  options.num_threads = 4;
+  HostThreadPool pool(options);
+
+  SECTION("every index once")
+  {
+    std::vector<std::atomic<int>> counts(1000);
+    for (auto& count : counts) {
+      count = 0;
+    }
+    pool.parallel_for(counts.size(), [&](size_t ix) { ++counts[ix]; });
+    for (auto& count : counts) {
+      REQUIRE(count == 1);
+    }
+  }
+
+  SECTION("thread limit")
+  {
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    pool.parallel_for(200, [&](size_t) {
+      std::lock_guard<std::mutex> lock(mutex);
+      threads.insert(std::this_thread::get_id());
+    }, 2);
+    REQUIRE(threads.size() <= 2);
+  }
+
+  SECTION("exception")
+  {
+    std::atomic<int> num_calls(0);
+    REQUIRE_THROWS_AS(
+        pool.parallel_for(100, [&](size_t ix) {
+          ++num_calls;
+          if (ix == 10) {
+            throw std::runtime_error("task failed");
+          }
+        }),
+        std::runtime_error);
+    REQUIRE(num_calls <= 100);
+
+    // The pool is still usable
+    std::atomic<int> sum(0);
+    pool.parallel_for(10, [&](size_t ix) { sum += static_cast<int>(ix); });
+    REQUIRE(sum == 45);
+  }
+
+  SECTION("nested")
+  {
+    // Every pool thread is busy with an outer call, so the inner calls must get 
+    // by with their calling thread
+    std::atomic<int> sum(0);
+    pool.parallel_for(8, [&](size_t) {
+      pool.parallel_for(100, [&](size_t) { ++sum; });
+    });
+    REQUIRE(sum == 800);
+  }
+
+  SECTION("submit")
+  {
+    std::mutex mutex;
+    std::condition_variable done;
+    int num_done = 0;
+    for (int i = 0; i < 20; ++i) {
+      pool.submit([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++num_done;
+        done.notify_all();
+      });
+    }
+    // A throwing task does not take a thread down
+    pool.submit([]() { throw std::runtime_error("reported"); });
+
+    std::unique_lock<std::mutex> lock(mutex);
+    REQUIRE(done.wait_for(lock, std::chrono::seconds(10), [&]() { return num_done == 20; }));
+  }
+}
+
+TEST_CASE("SharedHostThreadPoolTest", "[small]")
+{
+  HostThreadPoolOptions options;
+  options.pin_threads = false;
+  options.num_threads = 2;
+  configure_host_thread_pool(options);
+
+  HostThreadPool& pool = get_host_thread_pool();
+  REQUIRE(&pool == &get_host_thread_pool());
+  REQUIRE(pool.get_num_threads() == 2);
+
+  REQUIRE_THROWS_AS(configure_host_thread_pool(options), HipCompException);
+}
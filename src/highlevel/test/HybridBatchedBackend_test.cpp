@@ -0,0 +1,269 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "tests/catch.hpp"
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompHybridBackend.hpp"
+#include "highlevel/ThroughputSplit.hpp"
+
+using namespace hipcomp;
+using namespace std;
+
+namespace {
+
+/**
+ * A stand-in for a device: the host codec, slowed down to a fixed throughput
+ */
+struct SimulatedDeviceBackend : BatchedCompressBackend {
+  std::unique_ptr<BatchedCompressBackend> backend;
+  double seconds_per_byte;
+  size_t num_chunks;
+  bool fail;
+
+  SimulatedDeviceBackend(const size_t max_batch_size, const size_t max_chunk_bytes, const double bytes_per_second)
+    : backend(create_host_lz4_backend(max_batch_size, max_chunk_bytes, 1)),
+      seconds_per_byte(1.0 / bytes_per_second),
+      num_chunks(0),
+      fail(false)
+  {}
+
+  size_t get_max_chunk_size() const override
+  {
+    return backend->get_max_chunk_size();
+  }
+
+  size_t get_max_batch_size() const override
+  {
+    return backend->get_max_batch_size();
+  }
+
+  size_t get_max_compressed_chunk_size(const size_t uncompressed_bytes) const override
+  {
+    return backend->get_max_compressed_chunk_size(uncompressed_bytes);
+  }
+
+  void compress_batch(
+      const void* const* uncompressed_ptrs,
+      const size_t* uncompressed_bytes,
+      const size_t max_uncompressed_chunk_bytes,
+      const size_t batch_size,
+      void* const* compressed_ptrs,
+      size_t* compressed_bytes) override
+  {
+    if (fail) {
+      throw HipCompException(hipcompErrorInternal, "Simulated device failure.");
+    }
+    num_chunks += batch_size;
+    size_t total_bytes = 0;
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      total_bytes += uncompressed_bytes[ix];
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(total_bytes * seconds_per_byte));
+    backend->compress_batch(uncompressed_ptrs, uncompressed_bytes, max_uncompressed_chunk_bytes, 
+        batch_size, compressed_ptrs, compressed_bytes);
+  }
+
+  void decompress_batch(
+      const void* const* compressed_ptrs,
+      const size_t* compressed_bytes,
+      const size_t* uncompressed_buffer_bytes,
+      const size_t batch_size,
+      void* const* uncompressed_ptrs,
+      size_t* uncompressed_bytes) override
+  {
+    num_chunks += batch_size;
+    backend->decompress_batch(compressed_ptrs, compressed_bytes, uncompressed_buffer_bytes, 
+        batch_size, uncompressed_ptrs, uncompressed_bytes);
+  }
+};
+
+/**
+ * A batch with its inputs, outputs and round trip buffers
+ */
+struct TestBatch {
+  std::vector<std::vector<uint8_t>> inputs;
+  std::vector<std::vector<uint8_t>> compressed;
+  std::vector<std::vector<uint8_t>> outputs;
+  std::vector<const void*> input_ptrs;
+  std::vector<size_t> input_bytes;
+  std::vector<void*> compressed_ptrs;
+  std::vector<size_t> compressed_bytes;
+  std::vector<void*> output_ptrs;
+  std::vector<size_t> output_bytes;
+
+  TestBatch(const size_t batch_size, const size_t chunk_bytes, const size_t max_compressed_bytes)
+  {
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      std::vector<uint8_t> input(chunk_bytes);
+      for (size_t i = 0; i < chunk_bytes; ++i) {
+        input[i] = static_cast<uint8_t>((i / 7 + ix) % 13);
+      }
+      inputs.push_back(std::move(input));
+      compressed.emplace_back(max_compressed_bytes);
+      outputs.emplace_back(chunk_bytes);
+    }
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      input_ptrs.push_back(inputs[ix].data());
+      input_bytes.push_back(inputs[ix].size());
+      compressed_ptrs.push_back(compressed[ix].data());
+      output_ptrs.push_back(outputs[ix].data());
+    }
+    compressed_bytes.resize(batch_size);
+    output_bytes.resize(batch_size);
+  }
+
+  void round_trip(BatchedCompressBackend& backend)
+  {
+    const size_t batch_size = inputs.size();
+    backend.compress_batch(input_ptrs.data(), input_bytes.data(), 
+        *std::max_element(input_bytes.begin(), input_bytes.end()), batch_size, 
+        compressed_ptrs.data(), compressed_bytes.data());
+    backend.decompress_batch(compressed_ptrs.data(), compressed_bytes.data(), input_bytes.data(), 
+        batch_size, output_ptrs.data(), output_bytes.data());
+    REQUIRE(output_bytes == input_bytes);
+    REQUIRE(outputs == inputs);
+  }
+};
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("ThroughputSplitTest", "[small]")
+{
+  const std::vector<size_t> sizes(100, 1000);
+
+  SECTION("initial share")
+  {
+    ThroughputSplit split(true, 0.75, 0.5, 0.05);
+    REQUIRE(split.split(sizes.data(), sizes.size()) == 75);
+  }
+
+  SECTION("no device")
+  {
+    ThroughputSplit split(false, 0.75, 0.5, 0.05);
+    split.record(1000, 1.0, 1000, 1.0);
+    REQUIRE(split.get_device_share() == 0.0);
+    REQUIRE(split.split(sizes.data(), sizes.size()) == 0);
+  }
+
+  SECTION("follows throughput")
+  {
+    ThroughputSplit split(true, 0.5, 1.0, 0.05);
+    // The device is three times faster than the host
+    split.record(3000, 1.0, 1000, 1.0);
+    REQUIRE(split.get_device_share() == Approx(0.75));
+    // The device becomes much slower, e.g. busy with other kernels
+    split.record(1000, 100.0, 1000, 1.0);
+    REQUIRE(split.get_device_share() == Approx(0.05));
+    REQUIRE(split.split(sizes.data(), sizes.size()) == 5);
+  }
+
+  SECTION("smoothing")
+  {
+    ThroughputSplit split(true, 0.5, 0.5, 0.0);
+    split.record(1000, 1.0, 1000, 1.0);
+    REQUIRE(split.get_device_share() == Approx(0.5));
+    // The device rate averages to 2000 bytes/s
+    split.record(3000, 1.0, 1000, 1.0);
+    REQUIRE(split.get_device_share() == Approx(2.0 / 3.0));
+  }
+
+  SECTION("uneven chunks")
+  {
+    const std::vector<size_t> uneven = {10, 10, 1000, 10, 10};
+    ThroughputSplit split(true, 0.5, 0.5, 0.05);
+    REQUIRE(split.split(uneven.data(), uneven.size()) == 3);
+  }
+}
+
+TEST_CASE("HybridBackendNoDeviceTest", "[small]")
+{
+  HybridBatchedBackend backend(nullptr, create_host_lz4_backend(64, 1 << 16, 4));
+  REQUIRE(backend.get_compress_device_share() == 0.0);
+
+  TestBatch batch(64, 10000, backend.get_max_compressed_chunk_size(10000));
+  batch.round_trip(backend);
+  REQUIRE(backend.get_compress_device_share() == 0.0);
+}
+
+TEST_CASE("HybridBackendSplitTest", "[small]")
+{
+  const size_t batch_size = 64;
+  const size_t chunk_bytes = 1 << 14;
+  std::unique_ptr<SimulatedDeviceBackend> device(
+      new SimulatedDeviceBackend(batch_size, chunk_bytes, 5e6));
+  SimulatedDeviceBackend& device_ref = *device;
+
+  HybridOptions options;
+  options.initial_device_share = 0.9;
+  options.smoothing = 0.5;
+  HybridBatchedBackend backend(std::move(device), create_host_lz4_backend(batch_size, chunk_bytes, 2), options);
+
+  TestBatch batch(batch_size, chunk_bytes, backend.get_max_compressed_chunk_size(chunk_bytes));
+  batch.round_trip(backend);
+  REQUIRE(device_ref.num_chunks > 0);
+
+  // The simulated device is much slower than the host codec, so work moves to the 
+  // host but the device keeps its minimum share
+  for (int i = 0; i < 5; ++i) {
+    batch.round_trip(backend);
+  }
+  REQUIRE(backend.get_compress_device_share() < 0.5);
+  REQUIRE(backend.get_compress_device_share() >= options.min_share);
+}
+
+TEST_CASE("HybridBackendErrorTest", "[small]")
+{
+  std::unique_ptr<SimulatedDeviceBackend> device(new SimulatedDeviceBackend(16, 1 << 12, 1e9));
+  device->fail = true;
+  HybridBatchedBackend backend(std::move(device), create_host_lz4_backend(16, 1 << 12, 2));
+
+  TestBatch batch(16, 1 << 12, backend.get_max_compressed_chunk_size(1 << 12));
+  REQUIRE_THROWS_AS(
+      backend.compress_batch(batch.input_ptrs.data(), batch.input_bytes.data(), 1 << 12, 16, 
+          batch.compressed_ptrs.data(), batch.compressed_bytes.data()),
+      HipCompException);
+
+  // Beyond the limits
+  REQUIRE_THROWS_AS(
+      backend.compress_batch(batch.input_ptrs.data(), batch.input_bytes.data(), 1 << 13, 16, 
+          batch.compressed_ptrs.data(), batch.compressed_bytes.data()),
+      HipCompException);
+
+  HybridOptions bad_options;
+  bad_options.min_share = 0.75;
+  REQUIRE_THROWS_AS(
+      HybridBatchedBackend(nullptr, create_host_lz4_backend(16, 1 << 12), bad_options),
+      HipCompException);
+}
@@ -0,0 +1,144 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <vector>
+
+#include "tests/catch.hpp"
+
+#include "highlevel/InPlaceDecompression.hpp"
+
+using namespace hipcomp;
+using namespace std;
+
+namespace {
+
+constexpr size_t chunk_size = 100;
+
+/**
+ * Applies the schedule to a simulated buffer and checks that no chunk's compressed 
+ * data is overwritten before it is decompressed.
+ */
+void check_schedule(
+    const vector<ChunkRange>& launches,
+    const size_t decomp_data_size,
+    const uintptr_t comp_data_buffer,
+    const vector<size_t>& offsets,
+    const vector<size_t>& sizes)
+{
+  const size_t num_chunks = offsets.size();
+  vector<bool> done(num_chunks, false);
+  for (const ChunkRange& launch : launches) {
+    for (size_t ix = launch.first_chunk; ix < launch.first_chunk + launch.num_chunks; ++ix) {
+      REQUIRE(!done[ix]);
+      const size_t out_start = ix * chunk_size;
+      const size_t out_end = min(out_start + chunk_size, decomp_data_size);
+      for (size_t other = 0; other < num_chunks; ++other) {
+        if (done[other]) {
+          continue;
+        }
+        const size_t in_start = comp_data_buffer + offsets[other];
+        const size_t in_end = in_start + sizes[other];
+        REQUIRE((in_end <= out_start || in_start >= out_end));
+      }
+    }
+    for (size_t ix = launch.first_chunk; ix < launch.first_chunk + launch.num_chunks; ++ix) {
+      done[ix] = true;
+    }
+  }
+  for (size_t ix = 0; ix < num_chunks; ++ix) {
+    REQUIRE(done[ix]);
+  }
+}
+
+} // namespace
+
+TEST_CASE("in_place_disjoint_buffers")
+{
+  const vector<size_t> offsets{0, 50, 80};
+  const vector<size_t> sizes{50, 30, 10};
+  const auto launches = schedule_in_place_decompression(0, 300, chunk_size, 1000, offsets, sizes);
+
+  REQUIRE(launches.size() == 1);
+  REQUIRE(launches[0].first_chunk == 0);
+  REQUIRE(launches[0].num_chunks == 3);
+}
+
+TEST_CASE("in_place_ordered_tail")
+{
+  // 10 chunks compressed to 40 bytes each, ordered and placed at the end of the buffer
+  const size_t decomp_data_size = 1000;
+  const size_t margin = 150;
+  vector<size_t> offsets;
+  vector<size_t> sizes;
+  for (size_t ix = 0; ix < 10; ++ix) {
+    offsets.push_back(ix * 40);
+    sizes.push_back(40);
+  }
+  const uintptr_t comp_data_buffer = decomp_data_size + margin - 400;
+  const auto launches = schedule_in_place_decompression(
+      0, decomp_data_size, chunk_size, comp_data_buffer, offsets, sizes);
+
+  // The chunks whose output is below the compressed data all go in the first launch
+  REQUIRE(launches.front().first_chunk == 0);
+  REQUIRE(launches.front().num_chunks == 7);
+  check_schedule(launches, decomp_data_size, comp_data_buffer, offsets, sizes);
+}
+
+TEST_CASE("in_place_ordered_incompressible")
+{
+  // Every chunk expands by 5 bytes
+  const size_t num_chunks = 20;
+  const size_t decomp_data_size = num_chunks * chunk_size;
+  const size_t margin = num_chunks * 5 + chunk_size + 5;
+  vector<size_t> offsets;
+  vector<size_t> sizes;
+  for (size_t ix = 0; ix < num_chunks; ++ix) {
+    offsets.push_back(ix * (chunk_size + 5));
+    sizes.push_back(chunk_size + 5);
+  }
+  const uintptr_t comp_data_buffer = decomp_data_size + margin - num_chunks * (chunk_size + 5);
+  const auto launches = schedule_in_place_decompression(
+      0, decomp_data_size, chunk_size, comp_data_buffer, offsets, sizes);
+
+  check_schedule(launches, decomp_data_size, comp_data_buffer, offsets, sizes);
+}
+
+TEST_CASE("in_place_unordered_cycle")
+{
+  // Chunk 0's data sits in chunk 1's output and chunk 1's data sits in chunk 0's output
+  const vector<size_t> offsets{100, 0};
+  const vector<size_t> sizes{50, 50};
+  REQUIRE_THROWS_AS(
+      schedule_in_place_decompression(0, 200, chunk_size, 0, offsets, sizes),
+      HipCompException);
+}
+
+TEST_CASE("in_place_self_overlap")
+{
+  const vector<size_t> offsets{0};
+  const vector<size_t> sizes{50};
+  REQUIRE_THROWS_AS(
+      schedule_in_place_decompression(0, 100, chunk_size, 20, offsets, sizes),
+      HipCompException);
+}
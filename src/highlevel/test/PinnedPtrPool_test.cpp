@@ -78,6 +78,21 @@ struct PoolTestWrapper {
   }   
 };
 
+struct BufferPoolTestWrapper {
+  PinnedBufferPool& pool;
+  BufferPoolTestWrapper(PinnedBufferPool& pool) 
+    : pool(pool)
+  {}
+
+  size_t get_current_available_buffer_count() {
+    return pool.get_current_available_buffer_count();
+  }
+
+  size_t capacity() {
+    return pool.capacity();
+  }   
+};
+
 }
 
 template<typename T>
@@ -116,6 +131,9 @@ void test_pinned_ptr_pool() {
 
   REQUIRE(test_wrapper.get_current_available_pointer_count() == num_pinned_realloc - 1);
   REQUIRE(test_wrapper.capacity() == num_pinned_realloc + num_pinned_prealloc);
+  REQUIRE(test_wrapper.capacity() == PinnedPool::capacity_for(pinned_ptrs.size()));
+  REQUIRE(PinnedPool::capacity_for(0) == num_pinned_prealloc);
+  REQUIRE(PinnedPool::capacity_for(num_pinned_prealloc) == num_pinned_prealloc);
 
   pinned_ptrs.clear();
   REQUIRE(test_wrapper.capacity() == num_pinned_realloc + num_pinned_prealloc);
@@ -132,3 +150,45 @@ TEST_CASE("test_pinned_ptr_pool_short")
 {
   test_pinned_ptr_pool<short>();
 }
+
+TEST_CASE("test_pinned_buffer_pool")
+{
+  PinnedBufferPool pool{};
+  BufferPoolTestWrapper test_wrapper{pool};
+
+  REQUIRE(test_wrapper.capacity() == 0);
+
+  auto large = pool.allocate(1 << 20);
+  auto small = pool.allocate(1 << 10);
+  REQUIRE(large->size() == (1 << 20));
+  REQUIRE(small->size() == (1 << 10));
+  REQUIRE(test_wrapper.capacity() == (1 << 20) + (1 << 10));
+  REQUIRE(test_wrapper.get_current_available_buffer_count() == 0);
+
+  // the whole buffer must be writable
+  large->get_ptr()[(1 << 20) - 1] = 1;
+  uint8_t* large_ptr = large->get_ptr();
+  uint8_t* small_ptr = small->get_ptr();
+
+  large.reset();
+  small.reset();
+  REQUIRE(test_wrapper.get_current_available_buffer_count() == 2);
+
+  // requests are served by the smallest buffer that fits without allocating
+  auto reused_small = pool.allocate(100);
+  REQUIRE(reused_small->get_ptr() == small_ptr);
+  auto reused_large = pool.allocate(1 << 11);
+  REQUIRE(reused_large->get_ptr() == large_ptr);
+  REQUIRE(reused_large->size() == (1 << 20));
+  REQUIRE(test_wrapper.capacity() == (1 << 20) + (1 << 10));
+  REQUIRE(test_wrapper.get_current_available_buffer_count() == 0);
+
+  // nothing fits, so the pool grows
+  auto grown = pool.allocate(1 << 21);
+  REQUIRE(test_wrapper.capacity() == (1 << 21) + (1 << 20) + (1 << 10));
+
+  reused_small.reset();
+  reused_large.reset();
+  grown.reset();
+  REQUIRE(test_wrapper.get_current_available_buffer_count() == 3);
+}
@@ -0,0 +1,386 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tests/catch.hpp"
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompPriorityScheduler.hpp"
+
+using namespace hipcomp;
+using namespace std;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * A launch as seen by the simulated device
+ */
+struct SimulatedLaunch {
+  SchedulePriority priority;
+  size_t batch_size;
+  Clock::time_point start;
+  Clock::time_point end;
+};
+
+/**
+ * The timeline shared by the backends of both queues
+ */
+struct SimulatedDevice {
+  std::mutex mutex;
+  std::vector<SimulatedLaunch> launches;
+
+  void record(const SimulatedLaunch& launch)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    launches.push_back(launch);
+  }
+
+  std::vector<SimulatedLaunch> get_launches(SchedulePriority priority)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<SimulatedLaunch> res;
+    for (const auto& launch : launches) {
+      if (launch.priority == priority) {
+        res.push_back(launch);
+      }
+    }
+    return res;
+  }
+};
+
+/**
+ * Simulated device backend. "Compression" copies each chunk with a one byte header 
+ * and takes chunk_time per chunk, like a kernel whose duration grows with the batch.
+ */
+struct SimulatedBackend : BatchedCompressBackend {
+  SimulatedDevice& device;
+  SchedulePriority priority;
+  size_t max_batch_size;
+  std::chrono::microseconds chunk_time;
+  bool fail;
+
+  SimulatedBackend(
+      SimulatedDevice& device, 
+      SchedulePriority priority, 
+      size_t max_batch_size, 
+      std::chrono::microseconds chunk_time)
+    : device(device),
+      priority(priority),
+      max_batch_size(max_batch_size),
+      chunk_time(chunk_time),
+      fail(false)
+  {}
+
+  size_t get_max_chunk_size() const override
+  {
+    return 1 << 16;
+  }
+
+  size_t get_max_batch_size() const override
+  {
+    return max_batch_size;
+  }
+
+  size_t get_max_compressed_chunk_size(size_t uncompressed_bytes) const override
+  {
+    return uncompressed_bytes + 1;
+  }
+
+  void compress_batch(
+      const void* const* uncompressed_ptrs,
+      const size_t* uncompressed_bytes,
+      size_t /*max_uncompressed_chunk_bytes*/,
+      size_t batch_size,
+      void* const* compressed_ptrs,
+      size_t* compressed_bytes) override
+  {
+    run(batch_size);
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      uint8_t* out = static_cast<uint8_t*>(compressed_ptrs[ix]);
+      out[0] = 0xc0;
+      std::memcpy(out + 1, uncompressed_ptrs[ix], uncompressed_bytes[ix]);
+      compressed_bytes[ix] = uncompressed_bytes[ix] + 1;
+    }
+  }
+
+  void decompress_batch(
+      const void* const* compressed_ptrs,
+      const size_t* compressed_bytes,
+      const size_t* uncompressed_buffer_bytes,
+      size_t batch_size,
+      void* const* uncompressed_ptrs,
+      size_t* uncompressed_bytes) override
+  {
+    run(batch_size);
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      const uint8_t* in = static_cast<const uint8_t*>(compressed_ptrs[ix]);
+      if (in[0] != 0xc0 || compressed_bytes[ix] - 1 > uncompressed_buffer_bytes[ix]) {
+        throw HipCompException(hipcompErrorCannotDecompress, "corrupt chunk");
+      }
+      std::memcpy(uncompressed_ptrs[ix], in + 1, compressed_bytes[ix] - 1);
+      uncompressed_bytes[ix] = compressed_bytes[ix] - 1;
+    }
+  }
+
+private:
+  void run(size_t batch_size)
+  {
+    const Clock::time_point start = Clock::now();
+    if (fail) {
+      throw HipCompException(hipcompErrorInternal, "simulated launch failure");
+    }
+    std::this_thread::sleep_for(chunk_time * batch_size);
+    device.record(SimulatedLaunch{priority, batch_size, start, Clock::now()});
+  }
+};
+
+/**
+ * The buffers and arrays of one batch
+ */
+struct HostBatch {
+  std::vector<std::vector<uint8_t>> inputs;
+  std::vector<std::vector<uint8_t>> outputs;
+  std::vector<const void*> input_ptrs;
+  std::vector<size_t> input_bytes;
+  std::vector<void*> output_ptrs;
+  std::vector<size_t> output_bytes;
+
+  HostBatch(size_t batch_size, size_t seed)
+  {
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      inputs.emplace_back(10 + (seed + ix) % 50, static_cast<uint8_t>(seed + ix));
+      outputs.emplace_back(inputs.back().size() + 1);
+    }
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      input_ptrs.push_back(inputs[ix].data());
+      input_bytes.push_back(inputs[ix].size());
+      output_ptrs.push_back(outputs[ix].data());
+    }
+    output_bytes.resize(batch_size);
+  }
+
+  std::future<void> submit_compress(PriorityBatchScheduler& scheduler, SchedulePriority priority)
+  {
+    return scheduler.submit_compress(
+        priority, input_ptrs.data(), input_bytes.data(), inputs.size(), output_ptrs.data(), output_bytes.data());
+  }
+
+  bool is_compressed() const
+  {
+    for (size_t ix = 0; ix < inputs.size(); ++ix) {
+      if (output_bytes[ix] != inputs[ix].size() + 1 
+          || !std::equal(inputs[ix].begin(), inputs[ix].end(), outputs[ix].begin() + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+} // namespace
+
+TEST_CASE("PrioritySchedulerRoundTripTest", "[small]")
+{
+  SimulatedDevice device;
+  PrioritySchedulerOptions options;
+  options.throughput_slice_chunks = 64;
+  PriorityBatchScheduler scheduler{
+      std::make_unique<SimulatedBackend>(device, SchedulePriority::Latency, 16, std::chrono::microseconds(0)),
+      std::make_unique<SimulatedBackend>(device, SchedulePriority::Throughput, 1024, std::chrono::microseconds(0)),
+      options};
+
+  HostBatch bulk(1000, 1);
+  bulk.submit_compress(scheduler, SchedulePriority::Throughput).get();
+  REQUIRE(bulk.is_compressed());
+
+  // throughput batches launch in slices
+  REQUIRE(scheduler.get_num_launches(SchedulePriority::Throughput) == 16);
+  for (const auto& launch : device.get_launches(SchedulePriority::Throughput)) {
+    REQUIRE(launch.batch_size <= 64);
+  }
+
+  // latency batches launch whole, up to the backend's batch size
+  HostBatch interactive(40, 2);
+  interactive.submit_compress(scheduler, SchedulePriority::Latency).get();
+  REQUIRE(interactive.is_compressed());
+  REQUIRE(scheduler.get_num_launches(SchedulePriority::Latency) == 3);
+
+  std::vector<std::vector<uint8_t>> decompressed(bulk.inputs.size());
+  std::vector<void*> decompressed_ptrs;
+  std::vector<size_t> buffer_bytes;
+  std::vector<size_t> decompressed_bytes(bulk.inputs.size());
+  for (size_t ix = 0; ix < bulk.inputs.size(); ++ix) {
+    decompressed[ix].resize(bulk.inputs[ix].size());
+    decompressed_ptrs.push_back(decompressed[ix].data());
+    buffer_bytes.push_back(decompressed[ix].size());
+  }
+  std::vector<const void*> compressed_ptrs(bulk.output_ptrs.begin(), bulk.output_ptrs.end());
+  scheduler.submit_decompress(
+      SchedulePriority::Latency, 
+      compressed_ptrs.data(), 
+      bulk.output_bytes.data(), 
+      buffer_bytes.data(), 
+      bulk.inputs.size(), 
+      decompressed_ptrs.data(), 
+      decompressed_bytes.data()).get();
+  REQUIRE(decompressed == bulk.inputs);
+  for (size_t ix = 0; ix < bulk.inputs.size(); ++ix) {
+    REQUIRE(decompressed_bytes[ix] == bulk.inputs[ix].size());
+  }
+}
+
+TEST_CASE("PrioritySchedulerPreemptionTest", "[small]")
+{
+  SimulatedDevice device;
+  PrioritySchedulerOptions options;
+  options.throughput_slice_chunks = 10;
+  options.max_throughput_delay = std::chrono::microseconds(10000000);
+  PriorityBatchScheduler scheduler{
+      std::make_unique<SimulatedBackend>(device, SchedulePriority::Latency, 64, std::chrono::microseconds(100)),
+      std::make_unique<SimulatedBackend>(device, SchedulePriority::Throughput, 1024, std::chrono::microseconds(100)),
+      options};
+
+  // 50 slices of 1ms each
+  HostBatch bulk(500, 3);
+  auto bulk_done = bulk.submit_compress(scheduler, SchedulePriority::Throughput);
+
+  while (device.get_launches(SchedulePriority::Throughput).size() < 2) {
+    std::this_thread::yield();
+  }
+
+  std::vector<HostBatch> interactive;
+  for (size_t ix = 0; ix < 5; ++ix) {
+    interactive.emplace_back(8, 10 + ix);
+  }
+  const Clock::time_point submit_time = Clock::now();
+  std::vector<std::future<void>> interactive_done;
+  for (auto& batch : interactive) {
+    interactive_done.push_back(batch.submit_compress(scheduler, SchedulePriority::Latency));
+  }
+  for (auto& done : interactive_done) {
+    done.get();
+  }
+  const Clock::time_point latency_end = Clock::now();
+
+  // the interactive batches finished while the bulk batch was still running
+  REQUIRE(bulk_done.wait_for(std::chrono::seconds(0)) != std::future_status::ready);
+  bulk_done.get();
+  REQUIRE(bulk.is_compressed());
+  for (const auto& batch : interactive) {
+    REQUIRE(batch.is_compressed());
+  }
+
+  // no bulk slice started while interactive work was pending, so at most the slice 
+  // that was already running overlapped it
+  size_t overlapping = 0;
+  for (const auto& launch : device.get_launches(SchedulePriority::Throughput)) {
+    if (launch.start > submit_time && launch.start < latency_end) {
+      ++overlapping;
+    }
+  }
+  REQUIRE(overlapping == 0);
+  REQUIRE(scheduler.get_num_launches(SchedulePriority::Throughput) == 50);
+}
+
+TEST_CASE("PrioritySchedulerStarvationTest", "[small]")
+{
+  SimulatedDevice device;
+  PrioritySchedulerOptions options;
+  options.throughput_slice_chunks = 4;
+  options.max_throughput_delay = std::chrono::microseconds(1000);
+  PriorityBatchScheduler scheduler{
+      std::make_unique<SimulatedBackend>(device, SchedulePriority::Latency, 64, std::chrono::microseconds(200)),
+      std::make_unique<SimulatedBackend>(device, SchedulePriority::Throughput, 1024, std::chrono::microseconds(10)),
+      options};
+
+  // keep the latency queue busy for well over the time the bulk batch needs
+  std::vector<HostBatch> interactive;
+  for (size_t ix = 0; ix < 100; ++ix) {
+    interactive.emplace_back(10, ix);
+  }
+  std::vector<std::future<void>> interactive_done;
+  for (auto& batch : interactive) {
+    interactive_done.push_back(batch.submit_compress(scheduler, SchedulePriority::Latency));
+  }
+
+  HostBatch bulk(40, 7);
+  auto bulk_done = bulk.submit_compress(scheduler, SchedulePriority::Throughput);
+
+  // 10 slices with at most 1ms of deferral each
+  REQUIRE(bulk_done.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+  REQUIRE(interactive_done.back().wait_for(std::chrono::seconds(0)) != std::future_status::ready);
+  bulk_done.get();
+  REQUIRE(bulk.is_compressed());
+
+  for (auto& done : interactive_done) {
+    done.get();
+  }
+}
+
+TEST_CASE("PrioritySchedulerErrorTest", "[small]")
+{
+  SimulatedDevice device;
+  auto latency_backend = std::make_unique<SimulatedBackend>(
+      device, SchedulePriority::Latency, 64, std::chrono::microseconds(0));
+  auto throughput_backend = std::make_unique<SimulatedBackend>(
+      device, SchedulePriority::Throughput, 64, std::chrono::microseconds(0));
+  SimulatedBackend& throughput_ref = *throughput_backend;
+  PriorityBatchScheduler scheduler{std::move(latency_backend), std::move(throughput_backend)};
+
+  throughput_ref.fail = true;
+  HostBatch bulk(10, 0);
+  auto failed = bulk.submit_compress(scheduler, SchedulePriority::Throughput);
+  try {
+    failed.get();
+    FAIL("expected the backend error");
+  } catch (const HipCompException& e) {
+    REQUIRE(e.get_error() == hipcompErrorInternal);
+  }
+
+  // the other queue and later batches are unaffected
+  HostBatch interactive(10, 1);
+  interactive.submit_compress(scheduler, SchedulePriority::Latency).get();
+  REQUIRE(interactive.is_compressed());
+
+  throughput_ref.fail = false;
+  bulk.submit_compress(scheduler, SchedulePriority::Throughput).get();
+  REQUIRE(bulk.is_compressed());
+
+  // empty batches are ready right away
+  REQUIRE(scheduler.submit_compress(SchedulePriority::Latency, nullptr, nullptr, 0, nullptr, nullptr)
+      .wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+
+  REQUIRE_THROWS_AS(
+      PriorityBatchScheduler(nullptr, std::make_unique<SimulatedBackend>(
+          device, SchedulePriority::Throughput, 64, std::chrono::microseconds(0))),
+      HipCompException);
+}
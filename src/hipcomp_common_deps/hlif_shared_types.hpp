@@ -62,7 +62,8 @@ enum FormatType : uint8_t {
   GDeflate = 3,
   Cascaded = 4,
   Bitcomp = 5,
-  NotSupportedError = 6  
+  NotSupportedError = 6,
+  Segmented = 7
 };
 
 struct CommonHeader {
@@ -96,5 +97,8 @@ struct CompressArgs {
   size_t* comp_chunk_offsets;
   size_t* comp_chunk_sizes;
   hipcompStatus_t* output_status;
+  // If not null, chunks are written to comp_buffer in chunk order. Counts the chunks
+  // whose offsets have been published.
+  uint32_t* ix_ordered_chunk;
 };
 
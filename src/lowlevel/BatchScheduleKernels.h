@@ -0,0 +1,79 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hip/hip_runtime.h"
+
+namespace hipcomp {
+namespace lowlevel {
+
+/**
+ * @brief Smallest batch that is reordered by size.
+ *
+ * Smaller batches fit on the device at once, so the order in which their chunks 
+ * start does not change when the batch finishes.
+ */
+constexpr size_t BATCH_SCHEDULE_MIN_CHUNKS = 256;
+
+/**
+ * @brief Temp space needed to reorder a batch by size, 0 if it is not reordered.
+ */
+size_t batchScheduleTempSize(size_t batch_size);
+
+/**
+ * @brief Orders the chunks of a batch from the largest to the smallest, ordered on stream.
+ *
+ * The batched kernels launch one group per chunk, and groups start roughly in 
+ * launch order. Starting the longest chunks first keeps a few late, large chunks 
+ * from running alone at the end of a batch with skewed sizes. Chunks are bucketed 
+ * by the power of two of their size; the order within a bucket is unspecified.
+ *
+ * @param device_sizes The size of each chunk (GPU accessible).
+ * @param batch_size The number of chunks.
+ * @param temp_ptr The temp space to write the order to (GPU accessible).
+ * @param temp_bytes The size of the temp space.
+ * @param stream The stream to order on.
+ *
+ * @return The index of the chunk that each group handles (GPU accessible), or null 
+ * if the batch is kept in order because it is small or the temp space is too small.
+ */
+const uint32_t* batchScheduleBySize(
+    const size_t* device_sizes,
+    size_t batch_size,
+    void* temp_ptr,
+    size_t temp_bytes,
+    hipStream_t stream);
+
+/**
+ * @brief The chunk that a group handles given the order from batchScheduleBySize
+ */
+__device__ inline size_t scheduledChunk(const uint32_t* chunk_order, size_t ix_group)
+{
+  return chunk_order == nullptr ? ix_group : chunk_order[ix_group];
+}
+
+} // namespace lowlevel
+} // namespace hipcomp
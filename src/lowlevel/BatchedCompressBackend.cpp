@@ -0,0 +1,337 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompCoalescingService.hpp"
+
+#include "Check.h"
+#include "HipUtils.h"
+
+namespace hipcomp {
+
+namespace {
+
+/**
+ * @brief The batched C API entry points of a format, looked up by its options type
+ */
+template<typename FormatOpts>
+struct BatchedCodecFunctions;
+
+#define BATCHED_CODEC_FUNCTIONS(Format, OptsType)                              \
+  template<>                                                                   \
+  struct BatchedCodecFunctions<OptsType> {                                     \
+    static hipcompStatus_t get_temp_size(                                      \
+        size_t batch_size, size_t max_chunk_bytes, OptsType opts, size_t* temp_bytes) \
+    {                                                                          \
+      return hipcompBatched##Format##CompressGetTempSize(                      \
+          batch_size, max_chunk_bytes, opts, temp_bytes);                      \
+    }                                                                          \
+    static hipcompStatus_t get_decompress_temp_size(                           \
+        size_t batch_size, size_t max_chunk_bytes, size_t* temp_bytes)        \
+    {                                                                          \
+      return hipcompBatched##Format##DecompressGetTempSize(                    \
+          batch_size, max_chunk_bytes, temp_bytes);                            \
+    }                                                                          \
+    static hipcompStatus_t get_max_output_chunk_size(                          \
+        size_t max_chunk_bytes, OptsType opts, size_t* max_compressed_bytes)   \
+    {                                                                          \
+      return hipcompBatched##Format##CompressGetMaxOutputChunkSize(            \
+          max_chunk_bytes, opts, max_compressed_bytes);                        \
+    }                                                                          \
+    static hipcompStatus_t compress_async(                                     \
+        const void* const* device_uncompressed_ptrs,                           \
+        const size_t* device_uncompressed_bytes,                               \
+        size_t max_uncompressed_chunk_bytes,                                   \
+        size_t batch_size,                                                     \
+        void* device_temp_ptr,                                                 \
+        size_t temp_bytes,                                                     \
+        void* const* device_compressed_ptrs,                                   \
+        size_t* device_compressed_bytes,                                       \
+        OptsType opts,                                                         \
+        hipStream_t stream)                                                    \
+    {                                                                          \
+      return hipcompBatched##Format##CompressAsync(                            \
+          device_uncompressed_ptrs, device_uncompressed_bytes,                 \
+          max_uncompressed_chunk_bytes, batch_size, device_temp_ptr,           \
+          temp_bytes, device_compressed_ptrs, device_compressed_bytes,         \
+          opts, stream);                                                       \
+    }                                                                          \
+    static hipcompStatus_t decompress_async(                                   \
+        const void* const* device_compressed_ptrs,                             \
+        const size_t* device_compressed_bytes,                                 \
+        const size_t* device_uncompressed_bytes,                               \
+        size_t* device_actual_uncompressed_bytes,                              \
+        size_t batch_size,                                                     \
+        void* device_temp_ptr,                                                 \
+        size_t temp_bytes,                                                     \
+        void* const* device_uncompressed_ptrs,                                 \
+        hipcompStatus_t* device_statuses,                                      \
+        hipStream_t stream)                                                    \
+    {                                                                          \
+      return hipcompBatched##Format##DecompressAsync(                          \
+          device_compressed_ptrs, device_compressed_bytes,                     \
+          device_uncompressed_bytes, device_actual_uncompressed_bytes,         \
+          batch_size, device_temp_ptr, temp_bytes, device_uncompressed_ptrs,   \
+          device_statuses, stream);                                            \
+    }                                                                          \
+  };
+
+BATCHED_CODEC_FUNCTIONS(LZ4, hipcompBatchedLZ4Opts_t)
+BATCHED_CODEC_FUNCTIONS(Snappy, hipcompBatchedSnappyOpts_t)
+BATCHED_CODEC_FUNCTIONS(Cascaded, hipcompBatchedCascadedOpts_t)
+BATCHED_CODEC_FUNCTIONS(Gdeflate, hipcompBatchedGdeflateOpts_t)
+BATCHED_CODEC_FUNCTIONS(ANS, hipcompBatchedANSOpts_t)
+BATCHED_CODEC_FUNCTIONS(Bitcomp, hipcompBatchedBitcompFormatOpts)
+
+#undef BATCHED_CODEC_FUNCTIONS
+
+/**
+ * @brief Backend that launches hipcompBatched*CompressAsync and hipcompBatched*DecompressAsync 
+ * on a stream
+ *
+ * The per-chunk pointer and size arrays of a batch are packed back to back so that
+ * each launch needs one H2D copy for the inputs and one D2H copy for the results.
+ */
+template<typename FormatOpts>
+struct DeviceBatchedCompressBackend : BatchedCompressBackend {
+private:
+  typedef BatchedCodecFunctions<FormatOpts> Functions;
+
+  FormatOpts format_opts;
+  hipStream_t stream;
+  size_t max_batch_size;
+  size_t max_chunk_bytes;
+  size_t temp_bytes;
+  void* device_temp;
+  // Compression:   [uncompressed ptrs | uncompressed bytes | compressed ptrs | compressed bytes]
+  // Decompression: [compressed ptrs | compressed bytes | buffer bytes | uncompressed ptrs |
+  //                 uncompressed bytes | statuses]
+  uint64_t* device_arrays;
+  uint64_t* host_arrays;
+
+public:
+  DeviceBatchedCompressBackend(
+      const FormatOpts& format_opts,
+      hipStream_t stream,
+      const size_t max_batch_size,
+      const size_t max_chunk_bytes)
+    : format_opts(format_opts),
+      stream(stream),
+      max_batch_size(max_batch_size),
+      max_chunk_bytes(max_chunk_bytes),
+      temp_bytes(0),
+      device_temp(nullptr),
+      device_arrays(nullptr),
+      host_arrays(nullptr)
+  {
+    static_assert(sizeof(void*) == sizeof(uint64_t) && sizeof(size_t) == sizeof(uint64_t), 
+        "Pointer and size arrays are packed as 64-bit words.");
+    static_assert(sizeof(hipcompStatus_t) <= sizeof(uint64_t), 
+        "Statuses are stored in 64-bit words.");
+
+    size_t decompress_temp_bytes = 0;
+    CHECK_API_CALL(Functions::get_temp_size(max_batch_size, max_chunk_bytes, format_opts, &temp_bytes));
+    CHECK_API_CALL(Functions::get_decompress_temp_size(max_batch_size, max_chunk_bytes, &decompress_temp_bytes));
+    temp_bytes = std::max(temp_bytes, decompress_temp_bytes);
+    if (temp_bytes > 0) {
+      HipUtils::check(hipMalloc(&device_temp, temp_bytes));
+    }
+    HipUtils::check(hipMalloc(&device_arrays, 6 * max_batch_size * sizeof(uint64_t)));
+    HipUtils::check(hipHostMalloc(&host_arrays, 6 * max_batch_size * sizeof(uint64_t), hipHostMallocDefault));
+  }
+
+  ~DeviceBatchedCompressBackend()
+  {
+    HipUtils::check(hipFree(device_temp));
+    HipUtils::check(hipFree(device_arrays));
+    HipUtils::check(hipHostFree(host_arrays));
+  }
+
+  size_t get_max_chunk_size() const final override
+  {
+    return max_chunk_bytes;
+  }
+
+  size_t get_max_batch_size() const final override
+  {
+    return max_batch_size;
+  }
+
+  size_t get_max_compressed_chunk_size(const size_t uncompressed_bytes) const final override
+  {
+    size_t res;
+    CHECK_API_CALL(Functions::get_max_output_chunk_size(uncompressed_bytes, format_opts, &res));
+    return res;
+  }
+
+  void compress_batch(
+      const void* const* uncompressed_ptrs,
+      const size_t* uncompressed_bytes,
+      const size_t max_uncompressed_chunk_bytes,
+      const size_t batch_size,
+      void* const* compressed_ptrs,
+      size_t* compressed_bytes) final override
+  {
+    if (batch_size > max_batch_size || max_uncompressed_chunk_bytes > max_chunk_bytes) {
+      throw HipCompException(hipcompErrorInvalidValue, "Batch exceeds the limits the backend was created with.");
+    }
+
+    std::memcpy(host_arrays, uncompressed_ptrs, batch_size * sizeof(uint64_t));
+    std::memcpy(host_arrays + batch_size, uncompressed_bytes, batch_size * sizeof(uint64_t));
+    std::memcpy(host_arrays + 2 * batch_size, compressed_ptrs, batch_size * sizeof(uint64_t));
+    HipUtils::check(hipMemcpyAsync(
+        device_arrays, host_arrays, 3 * batch_size * sizeof(uint64_t), hipMemcpyHostToDevice, stream));
+
+    CHECK_API_CALL(Functions::compress_async(
+        reinterpret_cast<const void* const*>(device_arrays),
+        reinterpret_cast<const size_t*>(device_arrays + batch_size),
+        max_uncompressed_chunk_bytes,
+        batch_size,
+        device_temp,
+        temp_bytes,
+        reinterpret_cast<void* const*>(device_arrays + 2 * batch_size),
+        reinterpret_cast<size_t*>(device_arrays + 3 * batch_size),
+        format_opts,
+        stream));
+
+    HipUtils::check(hipMemcpyAsync(
+        host_arrays + 3 * batch_size, device_arrays + 3 * batch_size, batch_size * sizeof(uint64_t), 
+        hipMemcpyDeviceToHost, stream));
+    HipUtils::check(hipStreamSynchronize(stream));
+
+    std::memcpy(compressed_bytes, host_arrays + 3 * batch_size, batch_size * sizeof(uint64_t));
+  }
+
+  void decompress_batch(
+      const void* const* compressed_ptrs,
+      const size_t* compressed_bytes,
+      const size_t* uncompressed_buffer_bytes,
+      const size_t batch_size,
+      void* const* uncompressed_ptrs,
+      size_t* uncompressed_bytes) final override
+  {
+    if (batch_size == 0) {
+      return;
+    }
+    if (batch_size > max_batch_size 
+        || *std::max_element(uncompressed_buffer_bytes, uncompressed_buffer_bytes + batch_size) > max_chunk_bytes) {
+      throw HipCompException(hipcompErrorInvalidValue, "Batch exceeds the limits the backend was created with.");
+    }
+
+    std::memcpy(host_arrays, compressed_ptrs, batch_size * sizeof(uint64_t));
+    std::memcpy(host_arrays + batch_size, compressed_bytes, batch_size * sizeof(uint64_t));
+    std::memcpy(host_arrays + 2 * batch_size, uncompressed_buffer_bytes, batch_size * sizeof(uint64_t));
+    std::memcpy(host_arrays + 3 * batch_size, uncompressed_ptrs, batch_size * sizeof(uint64_t));
+    HipUtils::check(hipMemcpyAsync(
+        device_arrays, host_arrays, 4 * batch_size * sizeof(uint64_t), hipMemcpyHostToDevice, stream));
+
+    hipcompStatus_t* device_statuses = reinterpret_cast<hipcompStatus_t*>(device_arrays + 5 * batch_size);
+    CHECK_API_CALL(Functions::decompress_async(
+        reinterpret_cast<const void* const*>(device_arrays),
+        reinterpret_cast<const size_t*>(device_arrays + batch_size),
+        reinterpret_cast<const size_t*>(device_arrays + 2 * batch_size),
+        reinterpret_cast<size_t*>(device_arrays + 4 * batch_size),
+        batch_size,
+        device_temp,
+        temp_bytes,
+        reinterpret_cast<void* const*>(device_arrays + 3 * batch_size),
+        device_statuses,
+        stream));
+
+    // The actual sizes and the statuses are adjacent
+    HipUtils::check(hipMemcpyAsync(
+        host_arrays + 4 * batch_size, device_arrays + 4 * batch_size, 2 * batch_size * sizeof(uint64_t), 
+        hipMemcpyDeviceToHost, stream));
+    HipUtils::check(hipStreamSynchronize(stream));
+
+    const hipcompStatus_t* statuses = reinterpret_cast<const hipcompStatus_t*>(host_arrays + 5 * batch_size);
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      if (statuses[ix] != hipcompSuccess) {
+        throw HipCompException(statuses[ix], "Chunk " + std::to_string(ix) + " of the batch failed to decompress.");
+      }
+    }
+    std::memcpy(uncompressed_bytes, host_arrays + 4 * batch_size, batch_size * sizeof(uint64_t));
+  }
+};
+
+template<typename FormatOpts>
+std::unique_ptr<BatchedCompressBackend> create_device_backend(
+    const FormatOpts& format_opts, hipStream_t stream, const size_t max_batch_size, const size_t max_chunk_bytes)
+{
+  return std::make_unique<DeviceBatchedCompressBackend<FormatOpts>>(
+      format_opts, stream, max_batch_size, max_chunk_bytes);
+}
+
+} // namespace
+
+void BatchedCompressBackend::decompress_batch(
+    const void* const* /*compressed_ptrs*/,
+    const size_t* /*compressed_bytes*/,
+    const size_t* /*uncompressed_buffer_bytes*/,
+    size_t /*batch_size*/,
+    void* const* /*uncompressed_ptrs*/,
+    size_t* /*uncompressed_bytes*/)
+{
+  throw HipCompException(hipcompErrorNotSupported, "This backend does not decompress.");
+}
+
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedLZ4Opts_t& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes)
+{
+  return create_device_backend(format_opts, stream, max_batch_size, max_chunk_bytes);
+}
+
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedSnappyOpts_t& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes)
+{
+  return create_device_backend(format_opts, stream, max_batch_size, max_chunk_bytes);
+}
+
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedCascadedOpts_t& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes)
+{
+  return create_device_backend(format_opts, stream, max_batch_size, max_chunk_bytes);
+}
+
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedGdeflateOpts_t& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes)
+{
+  return create_device_backend(format_opts, stream, max_batch_size, max_chunk_bytes);
+}
+
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedANSOpts_t& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes)
+{
+  return create_device_backend(format_opts, stream, max_batch_size, max_chunk_bytes);
+}
+
+std::unique_ptr<BatchedCompressBackend> create_batched_compress_backend(
+    const hipcompBatchedBitcompFormatOpts& format_opts, hipStream_t stream, size_t max_batch_size, size_t max_chunk_bytes)
+{
+  return create_device_backend(format_opts, stream, max_batch_size, max_chunk_bytes);
+}
+
+} // namespace hipcomp
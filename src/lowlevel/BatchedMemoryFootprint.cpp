@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "hipcomp/hipcompMemoryFootprint.hpp"
+
+#include "Check.h"
+
+namespace hipcomp {
+
+namespace {
+
+MemoryFootprint make_footprint(const size_t temp_bytes, const size_t max_output_bytes)
+{
+  MemoryFootprint footprint{};
+  footprint.temp = temp_bytes;
+  footprint.max_output = max_output_bytes;
+  return footprint;
+}
+
+} // namespace
+
+/******************************************************************************
+ * COMPRESSION ****************************************************************
+ *****************************************************************************/
+
+#define BATCHED_COMPRESS_FOOTPRINT(Format, OptsType)                           \
+  MemoryFootprint get_batched_compress_memory_footprint(                       \
+      size_t batch_size,                                                       \
+      size_t max_uncompressed_chunk_bytes,                                     \
+      const OptsType& format_opts)                                             \
+  {                                                                            \
+    size_t temp_bytes;                                                         \
+    CHECK_API_CALL(hipcompBatched##Format##CompressGetTempSize(                \
+        batch_size, max_uncompressed_chunk_bytes, format_opts, &temp_bytes));  \
+    size_t max_comp_chunk_bytes;                                               \
+    CHECK_API_CALL(hipcompBatched##Format##CompressGetMaxOutputChunkSize(      \
+        max_uncompressed_chunk_bytes, format_opts, &max_comp_chunk_bytes));    \
+    return make_footprint(temp_bytes, batch_size * max_comp_chunk_bytes);      \
+  }
+
+BATCHED_COMPRESS_FOOTPRINT(LZ4, hipcompBatchedLZ4Opts_t)
+BATCHED_COMPRESS_FOOTPRINT(Snappy, hipcompBatchedSnappyOpts_t)
+BATCHED_COMPRESS_FOOTPRINT(Cascaded, hipcompBatchedCascadedOpts_t)
+BATCHED_COMPRESS_FOOTPRINT(Gdeflate, hipcompBatchedGdeflateOpts_t)
+BATCHED_COMPRESS_FOOTPRINT(ANS, hipcompBatchedANSOpts_t)
+BATCHED_COMPRESS_FOOTPRINT(Bitcomp, hipcompBatchedBitcompFormatOpts)
+
+#undef BATCHED_COMPRESS_FOOTPRINT
+
+/******************************************************************************
+ * DECOMPRESSION **************************************************************
+ *****************************************************************************/
+
+#define BATCHED_DECOMPRESS_FOOTPRINT(Format, OptsType)                         \
+  MemoryFootprint get_batched_decompress_memory_footprint(                     \
+      size_t batch_size,                                                       \
+      size_t max_uncompressed_chunk_bytes,                                     \
+      const OptsType& /* format_opts */)                                       \
+  {                                                                            \
+    size_t temp_bytes;                                                         \
+    CHECK_API_CALL(hipcompBatched##Format##DecompressGetTempSize(              \
+        batch_size, max_uncompressed_chunk_bytes, &temp_bytes));               \
+    return make_footprint(temp_bytes, batch_size * max_uncompressed_chunk_bytes); \
+  }
+
+BATCHED_DECOMPRESS_FOOTPRINT(LZ4, hipcompBatchedLZ4Opts_t)
+BATCHED_DECOMPRESS_FOOTPRINT(Snappy, hipcompBatchedSnappyOpts_t)
+BATCHED_DECOMPRESS_FOOTPRINT(Cascaded, hipcompBatchedCascadedOpts_t)
+BATCHED_DECOMPRESS_FOOTPRINT(Gdeflate, hipcompBatchedGdeflateOpts_t)
+BATCHED_DECOMPRESS_FOOTPRINT(ANS, hipcompBatchedANSOpts_t)
+BATCHED_DECOMPRESS_FOOTPRINT(Bitcomp, hipcompBatchedBitcompFormatOpts)
+
+#undef BATCHED_DECOMPRESS_FOOTPRINT
+
+} // namespace hipcomp
@@ -0,0 +1,138 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <string>
+#include <vector>
+
+#include "hipcomp/hipcompHostThreadPool.hpp"
+#include "hipcomp/hipcompHybridBackend.hpp"
+
+#include "Check.h"
+#include "LZ4HostCodec.h"
+
+namespace hipcomp {
+
+namespace {
+
+// The largest chunk the device kernels accept, so that every host chunk can also
+// be decompressed on the device
+constexpr size_t LZ4_MAX_CHUNK_SIZE = 1 << 24;
+
+/**
+ * @brief Backend that runs the LZ4 host codec on the shared host thread pool
+ *
+ * The threads take chunks one at a time, so a few large chunks do not leave the 
+ * other threads idle behind one of them.
+ */
+struct HostLZ4Backend : BatchedCompressBackend {
+private:
+  size_t max_batch_size;
+  size_t max_chunk_bytes;
+  // The most pool threads working on one batch, 0 for all
+  size_t num_threads;
+
+public:
+  HostLZ4Backend(const size_t max_batch_size, const size_t max_chunk_bytes, const size_t num_threads)
+    : max_batch_size(max_batch_size),
+      max_chunk_bytes(max_chunk_bytes),
+      num_threads(num_threads)
+  {
+    if (max_chunk_bytes > LZ4_MAX_CHUNK_SIZE) {
+      throw HipCompException(hipcompErrorInvalidValue, 
+          "Maximum chunk size for LZ4 is " + std::to_string(LZ4_MAX_CHUNK_SIZE));
+    }
+  }
+
+  size_t get_max_chunk_size() const final override
+  {
+    return max_chunk_bytes;
+  }
+
+  size_t get_max_batch_size() const final override
+  {
+    return max_batch_size;
+  }
+
+  size_t get_max_compressed_chunk_size(const size_t uncompressed_bytes) const final override
+  {
+    return lowlevel::lz4HostMaxCompressedSize(uncompressed_bytes);
+  }
+
+  void compress_batch(
+      const void* const* uncompressed_ptrs,
+      const size_t* uncompressed_bytes,
+      const size_t max_uncompressed_chunk_bytes,
+      const size_t batch_size,
+      void* const* compressed_ptrs,
+      size_t* compressed_bytes) final override
+  {
+    if (batch_size > max_batch_size || max_uncompressed_chunk_bytes > max_chunk_bytes) {
+      throw HipCompException(hipcompErrorInvalidValue, "Batch exceeds the limits the backend was created with.");
+    }
+
+    get_host_thread_pool().parallel_for(batch_size, [&](const size_t ix) {
+      compressed_bytes[ix] = lowlevel::lz4HostCompressChunk(
+          static_cast<const uint8_t*>(uncompressed_ptrs[ix]), 
+          uncompressed_bytes[ix], 
+          static_cast<uint8_t*>(compressed_ptrs[ix]));
+    }, num_threads);
+  }
+
+  void decompress_batch(
+      const void* const* compressed_ptrs,
+      const size_t* compressed_bytes,
+      const size_t* uncompressed_buffer_bytes,
+      const size_t batch_size,
+      void* const* uncompressed_ptrs,
+      size_t* uncompressed_bytes) final override
+  {
+    if (batch_size > max_batch_size) {
+      throw HipCompException(hipcompErrorInvalidValue, "Batch exceeds the limits the backend was created with.");
+    }
+
+    std::vector<hipcompStatus_t> statuses(batch_size);
+    get_host_thread_pool().parallel_for(batch_size, [&](const size_t ix) {
+      statuses[ix] = lowlevel::lz4HostDecompressChunk(
+          static_cast<const uint8_t*>(compressed_ptrs[ix]), 
+          compressed_bytes[ix], 
+          static_cast<uint8_t*>(uncompressed_ptrs[ix]), 
+          uncompressed_buffer_bytes[ix], 
+          &uncompressed_bytes[ix]);
+    }, num_threads);
+
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      if (statuses[ix] != hipcompSuccess) {
+        throw HipCompException(statuses[ix], "Chunk " + std::to_string(ix) + " of the batch failed to decompress.");
+      }
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<BatchedCompressBackend> create_host_lz4_backend(
+    const size_t max_batch_size, const size_t max_chunk_bytes, const size_t num_threads)
+{
+  return std::make_unique<HostLZ4Backend>(max_batch_size, max_chunk_bytes, num_threads);
+}
+
+} // namespace hipcomp
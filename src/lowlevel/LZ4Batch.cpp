@@ -52,6 +52,7 @@
 #include "Check.h"
 #include "HipUtils.h"
 #include "LZ4CompressionKernels.h"
+#include "Tracing.h"
 #include "common.h"
 #include "hipcomp.h"
 #include "hipcomp.hpp"
@@ -98,6 +99,7 @@ hipcompStatus_t hipcompBatchedLZ4DecompressAsync(
     hipcompStatus_t* device_statuses,
     hipStream_t stream)
 {
+  TraceScope trace("batched_decompress", "lz4", 0, batch_size, stream);
   // NOTE: if we start using `max_uncompressed_chunk_bytes`, we need to check
   // to make sure it is not zero, as we have notified users to supply zero if
   // they are not finding the maximum size.
@@ -118,7 +120,7 @@ hipcompStatus_t hipcompBatchedLZ4DecompressAsync(
         stream);
 
   } catch (const std::exception& e) {
-    return Check::exception_to_error(e, "hipcompBatchedLZ4DecompressAsync()");
+    return trace.set_status(Check::exception_to_error(e, "hipcompBatchedLZ4DecompressAsync()"));
   }
 
   return hipcompSuccess;
@@ -131,6 +133,7 @@ hipcompStatus_t hipcompBatchedLZ4GetDecompressSizeAsync(
     size_t batch_size,
     hipStream_t stream)
 {
+  TraceScope trace("batched_get_decompress_size", "lz4", 0, batch_size, stream);
   CHECK_NOT_NULL(device_compressed_ptrs);
   CHECK_NOT_NULL(device_compressed_bytes);
   CHECK_NOT_NULL(device_uncompressed_bytes);
@@ -144,8 +147,8 @@ hipcompStatus_t hipcompBatchedLZ4GetDecompressSizeAsync(
         batch_size,
         stream);
   } catch (const std::exception& e) {
-    return Check::exception_to_error(
-        e, "hipcompBatchedLZ4GetDecompressSizeAsync()");
+    return trace.set_status(Check::exception_to_error(
+        e, "hipcompBatchedLZ4GetDecompressSizeAsync()"));
   }
 
   return hipcompSuccess;
@@ -198,6 +201,36 @@ hipcompStatus_t hipcompBatchedLZ4CompressAsync(
     const hipcompBatchedLZ4Opts_t format_opts,
     hipStream_t stream)
 {
+  return hipcompBatchedLZ4CompressWithStatsAsync(
+      device_uncompressed_ptrs,
+      device_uncompressed_bytes,
+      max_uncompressed_chunk_size,
+      batch_size,
+      device_temp_ptr,
+      temp_bytes,
+      device_compressed_ptrs,
+      device_compressed_bytes,
+      format_opts,
+      nullptr,
+      stream);
+}
+
+hipcompStatus_t hipcompBatchedLZ4CompressWithStatsAsync(
+    const void* const* const device_uncompressed_ptrs,
+    const size_t* const device_uncompressed_bytes,
+    const size_t max_uncompressed_chunk_size,
+    const size_t batch_size,
+    void* const device_temp_ptr,
+    const size_t temp_bytes,
+    void* const* const device_compressed_ptrs,
+    size_t* const device_compressed_bytes,
+    const hipcompBatchedLZ4Opts_t format_opts,
+    hipcompChunkStats_t* const device_stats,
+    hipStream_t stream)
+{
+  TraceScope trace(
+      "batched_compress", "lz4", max_uncompressed_chunk_size * batch_size, batch_size, stream,
+      max_uncompressed_chunk_size, format_opts.data_type);
   // NOTE: if we start using `max_uncompressed_chunk_bytes`, we need to check
   // to make sure it is not zero, as we have notified users to supply zero if
   // they are not finding the maximum size.
@@ -215,9 +248,10 @@ hipcompStatus_t hipcompBatchedLZ4CompressAsync(
             reinterpret_cast<uint8_t* const*>(device_compressed_ptrs)),
         HipUtils::device_pointer(device_compressed_bytes),
         format_opts.data_type,
-        stream);
+        stream,
+        device_stats ? HipUtils::device_pointer(device_stats) : nullptr);
   } catch (const std::exception& e) {
-    return Check::exception_to_error(e, "hipcompBatchedLZ4CompressAsync()");
+    return trace.set_status(Check::exception_to_error(e, "hipcompBatchedLZ4CompressWithStatsAsync()"));
   }
 
   return hipcompSuccess;
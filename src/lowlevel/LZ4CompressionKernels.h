@@ -73,6 +73,8 @@ extern const int DECOMP_CHUNKS_PER_BLOCK;
  * @param comp_sizes
  * @param data_type The type of the input data to compress.
  * @param stream The stream to operate on.
+ * @param comp_stats_device The statistics of each batch item (output). Can be
+ * nullptr.
  */
 void lz4BatchCompress(
     const uint8_t* const* decomp_data_device,
@@ -84,7 +86,8 @@ void lz4BatchCompress(
     uint8_t* const* comp_data_device,
     size_t* const comp_sizes_device,
     hipcompType_t data_type,
-    hipStream_t stream);
+    hipStream_t stream,
+    hipcompChunkStats_t* comp_stats_device = nullptr);
 
 void lz4BatchDecompress(
     const uint8_t* const* device_in_ptrs,
@@ -0,0 +1,228 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "LZ4HostCodec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "common.h"
+
+namespace hipcomp {
+namespace lowlevel {
+
+namespace {
+
+// The limits of the LZ4 block format, which the device kernels follow as well
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t MAX_OFFSET = (1U << 16) - 1;
+constexpr size_t MIN_ENDING_LITERALS = 5;
+constexpr size_t LAST_VALID_MATCH = 12;
+
+constexpr int HASH_LOG = 12;
+
+uint32_t read32(const uint8_t* ptr)
+{
+  uint32_t res;
+  std::memcpy(&res, ptr, sizeof(res));
+  return res;
+}
+
+uint32_t hashOf(const uint32_t word)
+{
+  return (word * 2654435761U) >> (32 - HASH_LOG);
+}
+
+/**
+ * @brief Writes a length that did not fit in its nibble as a run of bytes
+ */
+uint8_t* writeLength(uint8_t* out, size_t length)
+{
+  while (length >= 255) {
+    *out++ = 255;
+    length -= 255;
+  }
+  *out++ = static_cast<uint8_t>(length);
+  return out;
+}
+
+/**
+ * @brief Writes a sequence of literals followed by a match of match_length bytes at 
+ * offset, or only the literals if match_length is 0.
+ */
+uint8_t* writeSequence(
+    uint8_t* out, 
+    const uint8_t* literals, 
+    const size_t num_literals, 
+    const size_t offset, 
+    const size_t match_length)
+{
+  uint8_t* token = out++;
+  const size_t match_code = match_length == 0 ? 0 : match_length - MIN_MATCH;
+  *token = static_cast<uint8_t>((std::min<size_t>(num_literals, 15) << 4) | std::min<size_t>(match_code, 15));
+  if (num_literals >= 15) {
+    out = writeLength(out, num_literals - 15);
+  }
+  if (num_literals > 0) {
+    std::memcpy(out, literals, num_literals);
+    out += num_literals;
+  }
+
+  if (match_length > 0) {
+    *out++ = static_cast<uint8_t>(offset & 0xff);
+    *out++ = static_cast<uint8_t>(offset >> 8);
+    if (match_code >= 15) {
+      out = writeLength(out, match_code - 15);
+    }
+  }
+  return out;
+}
+
+/**
+ * @brief Reads a length continued in bytes after its nibble. Returns false if the 
+ * input ends first.
+ */
+bool readLength(const uint8_t*& in, const uint8_t* in_end, size_t& length)
+{
+  uint8_t byte;
+  do {
+    if (in == in_end) {
+      return false;
+    }
+    byte = *in++;
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+} // namespace
+
+size_t lz4HostMaxCompressedSize(const size_t size)
+{
+  return roundUpTo(size + 1 + roundUpDiv(size, 255), sizeof(size_t));
+}
+
+size_t lz4HostCompressChunk(const uint8_t* const input, const size_t input_size, uint8_t* const output)
+{
+  uint8_t* out = output;
+  size_t anchor = 0;
+
+  if (input_size > LAST_VALID_MATCH) {
+    std::vector<uint32_t> hash_table(size_t(1) << HASH_LOG, 0);
+    // A match must start before this so that its input ends before the final literals
+    const size_t match_limit = input_size - LAST_VALID_MATCH;
+    const size_t match_end_limit = input_size - MIN_ENDING_LITERALS;
+
+    size_t pos = 0;
+    while (pos < match_limit) {
+      const uint32_t word = read32(input + pos);
+      uint32_t& entry = hash_table[hashOf(word)];
+      // Entries store the position plus one, so that 0 marks an empty slot
+      const size_t candidate = entry;
+      entry = static_cast<uint32_t>(pos + 1);
+
+      if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET || read32(input + candidate - 1) != word) {
+        ++pos;
+        continue;
+      }
+      const size_t match_pos = candidate - 1;
+
+      size_t match_length = MIN_MATCH;
+      while (pos + match_length < match_end_limit && input[match_pos + match_length] == input[pos + match_length]) {
+        ++match_length;
+      }
+
+      out = writeSequence(out, input + anchor, pos - anchor, pos - match_pos, match_length);
+      pos += match_length;
+      anchor = pos;
+    }
+  }
+
+  // The remaining input, at least the ending literals, closes the block
+  out = writeSequence(out, input + anchor, input_size - anchor, 0, 0);
+
+  // A sequence never costs more than its literals, so the block stays within the 
+  // bound of a block that only holds literals
+  return static_cast<size_t>(out - output);
+}
+
+hipcompStatus_t lz4HostDecompressChunk(
+    const uint8_t* const input, 
+    const size_t input_size, 
+    uint8_t* const output, 
+    const size_t output_capacity,
+    size_t* const output_size)
+{
+  const uint8_t* in = input;
+  const uint8_t* const in_end = input + input_size;
+  size_t out_pos = 0;
+
+  while (in < in_end) {
+    const uint8_t token = *in++;
+
+    size_t num_literals = token >> 4;
+    if (num_literals == 15 && !readLength(in, in_end, num_literals)) {
+      return hipcompErrorCannotDecompress;
+    }
+    if (num_literals > static_cast<size_t>(in_end - in) || num_literals > output_capacity - out_pos) {
+      return hipcompErrorCannotDecompress;
+    }
+    if (num_literals > 0) {
+      std::memcpy(output + out_pos, in, num_literals);
+      in += num_literals;
+      out_pos += num_literals;
+    }
+
+    if (in == in_end) {
+      // The last sequence has no match
+      break;
+    }
+
+    if (in_end - in < 2) {
+      return hipcompErrorCannotDecompress;
+    }
+    const size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+    in += 2;
+    size_t match_length = token & 0xf;
+    if (match_length == 15 && !readLength(in, in_end, match_length)) {
+      return hipcompErrorCannotDecompress;
+    }
+    match_length += MIN_MATCH;
+
+    if (offset == 0 || offset > out_pos || match_length > output_capacity - out_pos) {
+      return hipcompErrorCannotDecompress;
+    }
+    // Byte by byte, as the match may overlap its own output
+    const uint8_t* match = output + out_pos - offset;
+    for (size_t i = 0; i < match_length; ++i) {
+      output[out_pos + i] = match[i];
+    }
+    out_pos += match_length;
+  }
+
+  *output_size = out_pos;
+  return hipcompSuccess;
+}
+
+} // namespace lowlevel
+} // namespace hipcomp
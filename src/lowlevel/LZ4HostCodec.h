@@ -0,0 +1,76 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hipcomp.h"
+
+namespace hipcomp {
+namespace lowlevel {
+
+/**
+ * @brief The largest output of lz4HostCompressChunk for a chunk of size bytes.
+ *
+ * The same bound as the device compressor, so that either side can fill the output
+ * buffers of a batch.
+ */
+size_t lz4HostMaxCompressedSize(size_t size);
+
+/**
+ * @brief Compresses a chunk into an LZ4 block on the host.
+ *
+ * The block can be decompressed by the device kernels, and blocks from the device 
+ * compressor by lz4HostDecompressChunk(). Matches are found with a greedy hash 
+ * search, which is faster but compresses less than the device compressor.
+ *
+ * @param input The uncompressed chunk.
+ * @param input_size The size of the chunk.
+ * @param output The output location, at least lz4HostMaxCompressedSize(input_size) bytes.
+ *
+ * @return The size of the block.
+ */
+size_t lz4HostCompressChunk(const uint8_t* input, size_t input_size, uint8_t* output);
+
+/**
+ * @brief Decompresses an LZ4 block on the host.
+ *
+ * @param input The block.
+ * @param input_size The size of the block.
+ * @param output The output location.
+ * @param output_capacity The size of the output location.
+ * @param output_size Set to the decompressed size.
+ *
+ * @return hipcompSuccess, or hipcompErrorCannotDecompress if the block is malformed 
+ * or does not fit in the output.
+ */
+hipcompStatus_t lz4HostDecompressChunk(
+    const uint8_t* input, 
+    size_t input_size, 
+    uint8_t* output, 
+    size_t output_capacity,
+    size_t* output_size);
+
+} // namespace lowlevel
+} // namespace hipcomp
@@ -49,9 +49,11 @@
 
 #include "hipcomp/snappy.h"
 
+#include "BatchScheduleKernels.h"
 #include "Check.h"
 #include "HipUtils.h"
 #include "SnappyBatchKernels.h"
+#include "Tracing.h"
 #include "common.h"
 #include "hipcomp.h"
 #include "hipcomp.hpp"
@@ -82,7 +84,7 @@ size_t snappy_get_max_compressed_length(size_t source_bytes)
  *****************************************************************************/
 
 hipcompStatus_t hipcompBatchedSnappyDecompressGetTempSize(
-    size_t /* num_chunks */,
+    size_t num_chunks,
     size_t /* max_uncompressed_chunk_size */,
     size_t* temp_bytes)
 {
@@ -90,8 +92,8 @@ hipcompStatus_t hipcompBatchedSnappyDecompressGetTempSize(
     // error check inputs
     CHECK_NOT_NULL(temp_bytes);
 
-    // Snappy doesn't need any workspace in GPU memory
-    *temp_bytes = 0;
+    // Snappy only uses workspace to order large batches by size
+    *temp_bytes = lowlevel::batchScheduleTempSize(num_chunks);
 
   } catch (const std::exception& e) {
     return Check::exception_to_error(
@@ -108,6 +110,7 @@ hipcompStatus_t hipcompBatchedSnappyGetDecompressSizeAsync(
     size_t batch_size,
     hipStream_t stream)
 {
+  TraceScope trace("batched_get_decompress_size", "snappy", 0, batch_size, stream);
   try {
     // error check inputs
     CHECK_NOT_NULL(device_compressed_ptrs);
@@ -122,8 +125,8 @@ hipcompStatus_t hipcompBatchedSnappyGetDecompressSizeAsync(
         stream);
 
   } catch (const std::exception& e) {
-    return Check::exception_to_error(
-        e, "hipcompBatchedSnappyGetDecompressSizeAsync()");
+    return trace.set_status(Check::exception_to_error(
+        e, "hipcompBatchedSnappyGetDecompressSizeAsync()"));
   }
 
   return hipcompSuccess;
@@ -135,12 +138,40 @@ hipcompStatus_t hipcompBatchedSnappyDecompressAsync(
     const size_t* device_uncompressed_bytes,
     size_t* device_actual_uncompressed_bytes,
     size_t batch_size,
-    void* const /* temp_ptr */,
-    const size_t /* temp_bytes */,
+    void* const temp_ptr,
+    const size_t temp_bytes,
+    void* const* device_uncompressed_ptr,
+    hipcompStatus_t* device_statuses,
+    hipStream_t stream)
+{
+  return hipcompBatchedSnappyDecompressWithProfileAsync(
+      device_compressed_ptrs,
+      device_compressed_bytes,
+      device_uncompressed_bytes,
+      device_actual_uncompressed_bytes,
+      batch_size,
+      temp_ptr,
+      temp_bytes,
+      device_uncompressed_ptr,
+      device_statuses,
+      nullptr,
+      stream);
+}
+
+hipcompStatus_t hipcompBatchedSnappyDecompressWithProfileAsync(
+    const void* const* device_compressed_ptrs,
+    const size_t* device_compressed_bytes,
+    const size_t* device_uncompressed_bytes,
+    size_t* device_actual_uncompressed_bytes,
+    size_t batch_size,
+    void* const temp_ptr,
+    const size_t temp_bytes,
     void* const* device_uncompressed_ptr,
     hipcompStatus_t* device_statuses,
+    hipcompSnappyDecompressProfile_t* device_profiles,
     hipStream_t stream)
 {
+  TraceScope trace("batched_decompress", "snappy", 0, batch_size, stream);
   try {
     // error check inputs
     CHECK_NOT_NULL(device_compressed_ptrs);
@@ -148,6 +179,9 @@ hipcompStatus_t hipcompBatchedSnappyDecompressAsync(
     CHECK_NOT_NULL(device_uncompressed_bytes);
     CHECK_NOT_NULL(device_uncompressed_ptr);
 
+    const uint32_t* chunk_order = lowlevel::batchScheduleBySize(
+        device_uncompressed_bytes, batch_size, temp_ptr, temp_bytes, stream);
+
     gpu_unsnap(
         device_compressed_ptrs,
         device_compressed_bytes,
@@ -156,17 +190,19 @@ hipcompStatus_t hipcompBatchedSnappyDecompressAsync(
         device_statuses,
         device_actual_uncompressed_bytes,
         batch_size,
-        stream);
+        stream,
+        chunk_order,
+        device_profiles);
 
   } catch (const std::exception& e) {
-    return Check::exception_to_error(e, "hipcompBatchedSnappyDecompressAsync()");
+    return trace.set_status(Check::exception_to_error(e, "hipcompBatchedSnappyDecompressWithProfileAsync()"));
   }
 
   return hipcompSuccess;
 }
 
 hipcompStatus_t hipcompBatchedSnappyCompressGetTempSize(
-    const size_t /* batch_size */,
+    const size_t batch_size,
     const size_t /* max_chunk_size */,
     const hipcompBatchedSnappyOpts_t /* format_opts */,
     size_t* const temp_bytes)
@@ -175,8 +211,8 @@ hipcompStatus_t hipcompBatchedSnappyCompressGetTempSize(
     // error check inputs
     CHECK_NOT_NULL(temp_bytes);
 
-    // Snappy doesn't need any workspace in GPU memory
-    *temp_bytes = 0;
+    // Snappy only uses workspace to order large batches by size
+    *temp_bytes = lowlevel::batchScheduleTempSize(batch_size);
 
   } catch (const std::exception& e) {
     return Check::exception_to_error(
@@ -208,15 +244,44 @@ hipcompStatus_t hipcompBatchedSnappyCompressGetMaxOutputChunkSize(
 hipcompStatus_t hipcompBatchedSnappyCompressAsync(
     const void* const* device_uncompressed_ptr,
     const size_t* device_uncompressed_bytes,
-    size_t /*max_uncompressed_chunk_bytes*/,
+    size_t max_uncompressed_chunk_bytes,
+    size_t batch_size,
+    void* device_temp_ptr,
+    size_t temp_bytes,
+    void* const* device_compressed_ptr,
+    size_t* device_compressed_bytes,
+    const hipcompBatchedSnappyOpts_t format_ops,
+    hipStream_t stream)
+{
+  return hipcompBatchedSnappyCompressWithStatsAsync(
+      device_uncompressed_ptr,
+      device_uncompressed_bytes,
+      max_uncompressed_chunk_bytes,
+      batch_size,
+      device_temp_ptr,
+      temp_bytes,
+      device_compressed_ptr,
+      device_compressed_bytes,
+      format_ops,
+      nullptr,
+      stream);
+}
+
+hipcompStatus_t hipcompBatchedSnappyCompressWithStatsAsync(
+    const void* const* device_uncompressed_ptr,
+    const size_t* device_uncompressed_bytes,
+    size_t max_uncompressed_chunk_bytes, // only traced
     size_t batch_size,
-    void* /* device_temp_ptr */,
-    size_t /* temp_bytes */,
+    void* device_temp_ptr,
+    size_t temp_bytes,
     void* const* device_compressed_ptr,
     size_t* device_compressed_bytes,
     const hipcompBatchedSnappyOpts_t /* format_ops */,
+    hipcompChunkStats_t* device_stats,
     hipStream_t stream)
 {
+  TraceScope trace(
+      "batched_compress", "snappy", max_uncompressed_chunk_bytes * batch_size, batch_size, stream, max_uncompressed_chunk_bytes);
   try {
     // error check inputs
     CHECK_NOT_NULL(device_uncompressed_ptr);
@@ -226,6 +291,8 @@ hipcompStatus_t hipcompBatchedSnappyCompressAsync(
 
     size_t* device_out_available_bytes = nullptr;
     gpu_snappy_status_s* statuses = nullptr;
+    const uint32_t* chunk_order = lowlevel::batchScheduleBySize(
+        device_uncompressed_bytes, batch_size, device_temp_ptr, temp_bytes, stream);
 
     gpu_snap(
         device_uncompressed_ptr,
@@ -235,10 +302,12 @@ hipcompStatus_t hipcompBatchedSnappyCompressAsync(
         statuses,
         device_compressed_bytes,
         batch_size,
-        stream);
+        stream,
+        chunk_order,
+        device_stats);
 
   } catch (const std::exception& e) {
-    return Check::exception_to_error(e, "hipcompBatchedSnappyCompressAsync()");
+    return trace.set_status(Check::exception_to_error(e, "hipcompBatchedSnappyCompressWithStatsAsync()"));
   }
 
   return hipcompSuccess;
@@ -50,6 +50,7 @@
 #pragma once
 
 #include "hipcomp.h"
+#include "hipcomp/snappy.h"
 #include "snappy/types.h"
 
 namespace hipcomp {
@@ -76,6 +77,10 @@ namespace hipcomp {
  * @param[in] count The number of chunks to compress.
  * @param[in] stream All the compression will be enqueued into this HIP
  * stream and run asynchronously.
+ * @param[in] chunk_order The order to start the chunks in, from
+ * lowlevel::batchScheduleBySize. Could be null-ptr to keep the batch order.
+ * @param[out] device_stats Pointer to the statistics of each chunk.
+ * Could be null-ptr.
  **/
 void gpu_snap(
   const void* const* device_in_ptr,
@@ -85,7 +90,9 @@ void gpu_snap(
 	gpu_snappy_status_s *outputs,
 	size_t* device_out_bytes,
   int count,
-  hipStream_t stream);
+  hipStream_t stream,
+  const uint32_t* chunk_order = nullptr,
+  hipcompChunkStats_t* device_stats = nullptr);
 
 /**
  * @brief Interface for decompressing data with Snappy
@@ -109,6 +116,11 @@ void gpu_snap(
  * @param[in] count The number of chunks to decompress.
  * @param[in] stream All the decompression will be enqueued into this HIP
  * stream and run asynchronously.
+ * @param[in] chunk_order The order to start the chunks in, from
+ * lowlevel::batchScheduleBySize. Could be null-ptr to keep the batch order.
+ * @param[out] device_profiles Pointer to the cycle counts of the decompression
+ * stages for each chunk. Could be null-ptr, which runs the kernel without
+ * cycle counters.
  **/
 void gpu_unsnap(
     const void* const* device_in_ptr,
@@ -118,7 +130,9 @@ void gpu_unsnap(
     hipcompStatus_t* outputs,
     size_t* device_out_bytes,
     int count,
-    hipStream_t stream);
+    hipStream_t stream,
+    const uint32_t* chunk_order = nullptr,
+    hipcompSnappyDecompressProfile_t* device_profiles = nullptr);
 
 /**
  * @brief Compute the sizes of the uncompressed data chunks
@@ -51,6 +51,7 @@
 
 #include "Check.h"
 #include "HipUtils.h"
+#include "Tracing.h"
 #include "common.h"
 #include "hipcomp.h"
 #include "hipcomp.hpp"
@@ -104,6 +105,7 @@ hipcompStatus_t hipcompBatchedANSDecompressAsync(
     hipStream_t stream)
 {
 #ifdef ENABLE_ANS
+  TraceScope trace("batched_decompress", "ans", 0, batch_size, stream);
   try {
     ans::decompressAsync(
       HipUtils::device_pointer(device_compressed_ptrs),
@@ -115,7 +117,7 @@ hipcompStatus_t hipcompBatchedANSDecompressAsync(
       device_statuses ? HipUtils::device_pointer(device_statuses) : nullptr,
       stream);
   } catch (const std::exception& e) {
-     return Check::exception_to_error(e, "hipcompBatchedANSDecompressAsync()");
+     return trace.set_status(Check::exception_to_error(e, "hipcompBatchedANSDecompressAsync()"));
   }
   return hipcompSuccess;
 #else
@@ -186,6 +188,8 @@ hipcompStatus_t hipcompBatchedANSCompressAsync(
     hipStream_t stream)
 {
 #ifdef ENABLE_ANS
+  TraceScope trace(
+      "batched_compress", "ans", max_uncompressed_chunk_bytes * batch_size, batch_size, stream, max_uncompressed_chunk_bytes);
   assert(format_opts.type == hipcompANSType_t::hipcomp_rANS);
   MAYBE_UNUSED(format_opts);
   ans::ansType_t ans_type = ans::ansType_t::rANS;
@@ -203,7 +207,7 @@ hipcompStatus_t hipcompBatchedANSCompressAsync(
         HipUtils::device_pointer(device_compressed_bytes),
         stream);
   } catch (const std::exception& e) {
-    return Check::exception_to_error(e, "hipcompBatchedANSCompressAsync()");
+    return trace.set_status(Check::exception_to_error(e, "hipcompBatchedANSCompressAsync()"));
   }
   return hipcompSuccess;
 #else
@@ -230,6 +234,7 @@ hipcompStatus_t hipcompBatchedANSGetDecompressSizeAsync(
     size_t batch_size,
     hipStream_t stream) {
 #ifdef ENABLE_ANS
+  TraceScope trace("batched_get_decompress_size", "ans", 0, batch_size, stream);
   ans::getDecompressSizeAsync(
       device_compressed_ptrs,
       device_uncompressed_bytes,
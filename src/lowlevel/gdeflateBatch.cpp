@@ -51,6 +51,7 @@
 
 #include "Check.h"
 #include "HipUtils.h"
+#include "Tracing.h"
 #include "common.h"
 #include "hipcomp.h"
 #include "hipcomp.hpp"
@@ -130,6 +131,7 @@ hipcompStatus_t hipcompBatchedGdeflateDecompressAsync(
     hipStream_t stream)
 {
 #ifdef ENABLE_GDEFLATE
+  TraceScope trace("batched_decompress", "gdeflate", 0, batch_size, stream);
   // NOTE: if we start using `max_uncompressed_chunk_bytes`, we need to check
   // to make sure it is not zero, as we have notified users to supply zero if
   // they are not finding the maximum size.
@@ -150,7 +152,7 @@ hipcompStatus_t hipcompBatchedGdeflateDecompressAsync(
     if(device_status_ptrs) convertGdeflateOutputStatuses(device_status_ptrs, batch_size, stream);
 
   } catch (const std::exception& e) {
-    return Check::exception_to_error(e, "hipcompBatchedGdeflateDecompressAsync()");
+    return trace.set_status(Check::exception_to_error(e, "hipcompBatchedGdeflateDecompressAsync()"));
   }
 
   return hipcompSuccess;
@@ -178,11 +180,12 @@ hipcompStatus_t hipcompBatchedGdeflateGetDecompressSizeAsync(
     size_t batch_size,
     hipStream_t stream) {
 #ifdef ENABLE_GDEFLATE
+  TraceScope trace("batched_get_decompress_size", "gdeflate", 0, batch_size, stream);
   try {
     gdeflate::getDecompressSizeAsync(device_compressed_ptrs, device_compressed_bytes,
         device_uncompressed_bytes, batch_size, stream);
   } catch (const std::exception& e) {
-    return Check::exception_to_error(e, "hipcompBatchedGdeflateDecompressAsync()");
+    return trace.set_status(Check::exception_to_error(e, "hipcompBatchedGdeflateDecompressAsync()"));
   }
 
   return hipcompSuccess;
@@ -266,12 +269,14 @@ hipcompStatus_t hipcompBatchedGdeflateCompressAsync(
     hipStream_t stream)
 {
 #ifdef ENABLE_GDEFLATE
+  TraceScope trace(
+      "batched_compress", "gdeflate", max_uncompressed_chunk_size * batch_size, batch_size, stream, max_uncompressed_chunk_size);
   try {
     gdeflate::gdeflate_compression_algo algo = getGdeflateEnumFromFormatOpts(format_opts);
     gdeflate::compressAsync(device_in_ptrs, device_in_bytes, max_uncompressed_chunk_size,
         batch_size, temp_ptr, temp_bytes, device_out_ptrs, device_out_bytes, algo, stream);
   } catch (const std::exception& e) {
-    return Check::exception_to_error(e, "hipcompBatchedGdeflateCompressAsync()");
+    return trace.set_status(Check::exception_to_error(e, "hipcompBatchedGdeflateCompressAsync()"));
   }
 
   return hipcompSuccess;
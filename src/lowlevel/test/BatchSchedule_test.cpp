@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <vector>
+
+#include "hip/hip_runtime.h"
+
+#include "tests/catch.hpp"
+
+#include "BatchScheduleKernels.h"
+
+#define HIP_CHECK(cond)                                                       \
+  do {                                                                         \
+    hipError_t err = cond;                                                    \
+    REQUIRE(err == hipSuccess);                                               \
+  } while (false)
+
+using namespace hipcomp::lowlevel;
+
+namespace
+{
+
+int log2Size(const size_t size)
+{
+  int log2_size = 0;
+  while (log2_size < 63 && (size_t(1) << (log2_size + 1)) <= size) {
+    ++log2_size;
+  }
+  return log2_size;
+}
+
+std::vector<uint32_t> schedule(const std::vector<size_t>& sizes)
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  size_t* d_sizes;
+  void* d_temp;
+  const size_t temp_bytes = batchScheduleTempSize(sizes.size());
+  HIP_CHECK(hipMalloc(&d_sizes, sizes.size() * sizeof(size_t)));
+  HIP_CHECK(hipMalloc(&d_temp, temp_bytes));
+  HIP_CHECK(hipMemcpy(d_sizes, sizes.data(), sizes.size() * sizeof(size_t), hipMemcpyHostToDevice));
+
+  const uint32_t* d_order = batchScheduleBySize(d_sizes, sizes.size(), d_temp, temp_bytes, stream);
+  REQUIRE(d_order != nullptr);
+
+  std::vector<uint32_t> order(sizes.size());
+  HIP_CHECK(hipMemcpyAsync(order.data(), d_order, order.size() * sizeof(uint32_t), hipMemcpyDeviceToHost, stream));
+  HIP_CHECK(hipStreamSynchronize(stream));
+
+  HIP_CHECK(hipFree(d_temp));
+  HIP_CHECK(hipFree(d_sizes));
+  HIP_CHECK(hipStreamDestroy(stream));
+  return order;
+}
+
+} // namespace
+
+TEST_CASE("BatchScheduleLargestFirstTest", "[small]")
+{
+  std::vector<size_t> sizes(5000);
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    // mostly small chunks, with a few large and empty ones at the end
+    sizes[i] = i % 997 == 996 ? (size_t(16) << 20) - i : (i % 13 == 0 ? 0 : 1024 + i % 100);
+  }
+
+  const std::vector<uint32_t> order = schedule(sizes);
+
+  std::vector<uint32_t> sorted = order;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    REQUIRE(sorted[i] == i);
+  }
+
+  for (size_t i = 1; i < order.size(); ++i) {
+    REQUIRE(log2Size(sizes[order[i - 1]]) >= log2Size(sizes[order[i]]));
+  }
+  REQUIRE(sizes[order.front()] >= (size_t(8) << 20));
+  REQUIRE(sizes[order.back()] == 0);
+}
+
+TEST_CASE("BatchScheduleSmallBatchTest", "[small]")
+{
+  REQUIRE(batchScheduleTempSize(BATCH_SCHEDULE_MIN_CHUNKS - 1) == 0);
+  REQUIRE(batchScheduleTempSize(BATCH_SCHEDULE_MIN_CHUNKS) >= BATCH_SCHEDULE_MIN_CHUNKS * sizeof(uint32_t));
+
+  // Small batches, and batches without enough temp space, keep their order
+  REQUIRE(batchScheduleBySize(nullptr, BATCH_SCHEDULE_MIN_CHUNKS - 1, nullptr, 0, 0) == nullptr);
+  uint32_t temp;
+  REQUIRE(batchScheduleBySize(nullptr, BATCH_SCHEDULE_MIN_CHUNKS, &temp, sizeof(temp), 0) == nullptr);
+}
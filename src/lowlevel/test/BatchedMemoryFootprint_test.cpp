@@ -0,0 +1,70 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "tests/catch.hpp"
+
+#include "hipcomp/hipcompMemoryFootprint.hpp"
+
+using namespace hipcomp;
+
+TEST_CASE("BatchedLZ4FootprintTest", "[small]")
+{
+  const size_t batch_size = 1000;
+  const size_t chunk_bytes = 1 << 16;
+
+  size_t temp_bytes;
+  REQUIRE(hipcompBatchedLZ4CompressGetTempSize(batch_size, chunk_bytes, hipcompBatchedLZ4DefaultOpts, &temp_bytes) == hipcompSuccess);
+  size_t max_comp_chunk_bytes;
+  REQUIRE(hipcompBatchedLZ4CompressGetMaxOutputChunkSize(chunk_bytes, hipcompBatchedLZ4DefaultOpts, &max_comp_chunk_bytes) == hipcompSuccess);
+
+  const MemoryFootprint comp = get_batched_compress_memory_footprint(batch_size, chunk_bytes, hipcompBatchedLZ4DefaultOpts);
+  REQUIRE(comp.temp == temp_bytes);
+  REQUIRE(comp.max_output == batch_size * max_comp_chunk_bytes);
+  REQUIRE(comp.scratch == 0);
+  REQUIRE(comp.device_bytes() == temp_bytes + batch_size * max_comp_chunk_bytes);
+  REQUIRE(comp.pinned_bytes() == 0);
+  REQUIRE(comp.pageable_bytes() == 0);
+
+  const MemoryFootprint decomp = get_batched_decompress_memory_footprint(batch_size, chunk_bytes, hipcompBatchedLZ4DefaultOpts);
+  REQUIRE(hipcompBatchedLZ4DecompressGetTempSize(batch_size, chunk_bytes, &temp_bytes) == hipcompSuccess);
+  REQUIRE(decomp.temp == temp_bytes);
+  REQUIRE(decomp.max_output == batch_size * chunk_bytes);
+}
+
+TEST_CASE("BatchedSnappyCascadedFootprintTest", "[small]")
+{
+  const MemoryFootprint snappy = get_batched_compress_memory_footprint(10, 4096, hipcompBatchedSnappyDefaultOpts);
+  REQUIRE(snappy.temp == 0);
+  REQUIRE(snappy.max_output >= 10 * 4096);
+
+  const MemoryFootprint cascaded = get_batched_compress_memory_footprint(10, 4096, hipcompBatchedCascadedDefaultOpts);
+  REQUIRE(cascaded.temp == 0);
+  REQUIRE(cascaded.max_output == 10 * (4096 + 8));
+}
+
+TEST_CASE("BatchedFootprintInvalidChunkSizeTest", "[small]")
+{
+  // larger than the maximum LZ4 chunk size
+  REQUIRE_THROWS(get_batched_compress_memory_footprint(1, size_t(1) << 32, hipcompBatchedLZ4DefaultOpts));
+}
@@ -0,0 +1,158 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "tests/catch.hpp"
+
+#include "LZ4HostCodec.h"
+
+using namespace hipcomp;
+using namespace hipcomp::lowlevel;
+
+namespace
+{
+
+std::vector<uint8_t> compress(const std::vector<uint8_t>& input)
+{
+  std::vector<uint8_t> output(lz4HostMaxCompressedSize(input.size()));
+  output.resize(lz4HostCompressChunk(input.data(), input.size(), output.data()));
+  REQUIRE(output.size() <= lz4HostMaxCompressedSize(input.size()));
+  return output;
+}
+
+void check_round_trip(const std::vector<uint8_t>& input)
+{
+  const std::vector<uint8_t> compressed = compress(input);
+
+  std::vector<uint8_t> output(input.size());
+  size_t output_size = 0;
+  REQUIRE(lz4HostDecompressChunk(compressed.data(), compressed.size(), output.data(), output.size(), &output_size) 
+      == hipcompSuccess);
+  REQUIRE(output_size == input.size());
+  REQUIRE(output == input);
+}
+
+std::vector<uint8_t> random_runs(const size_t size, const int max_run, const int num_symbols)
+{
+  std::mt19937 gen(size);
+  std::uniform_int_distribution<int> run_dist(1, max_run);
+  std::uniform_int_distribution<int> symbol_dist(0, num_symbols - 1);
+
+  std::vector<uint8_t> data;
+  data.reserve(size);
+  while (data.size() < size) {
+    data.insert(data.end(), std::min<size_t>(run_dist(gen), size - data.size()), 
+        static_cast<uint8_t>(symbol_dist(gen)));
+  }
+  return data;
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("LZ4HostRoundTripTest", "[small]")
+{
+  for (const size_t size : {0, 1, 12, 13, 100, 4096, 100000}) {
+    check_round_trip(random_runs(size, 16, 4));
+    check_round_trip(random_runs(size, 1, 256));
+  }
+}
+
+TEST_CASE("LZ4HostLongMatchTest", "[small]")
+{
+  // Lengths beyond the nibble need continuation bytes, and the offset of a run 
+  // overlaps its own output
+  const std::vector<uint8_t> input(70000, 'a');
+  const std::vector<uint8_t> compressed = compress(input);
+  REQUIRE(compressed.size() < 1000);
+  check_round_trip(input);
+}
+
+TEST_CASE("LZ4HostBlockEndTest", "[small]")
+{
+  // The block must end in at least 5 literals, and the last match must start at 
+  // least 12 bytes before the end
+  const std::vector<uint8_t> input(64, 'x');
+  const std::vector<uint8_t> compressed = compress(input);
+
+  size_t literals_at_end = 0;
+  size_t pos = 0;
+  while (pos < compressed.size()) {
+    const uint8_t token = compressed[pos++];
+    size_t num_literals = token >> 4;
+    if (num_literals == 15) {
+      while (compressed[pos] == 255) {
+        num_literals += compressed[pos++];
+      }
+      num_literals += compressed[pos++];
+    }
+    pos += num_literals;
+    if (pos == compressed.size()) {
+      literals_at_end = num_literals;
+      break;
+    }
+    pos += 2;
+    if ((token & 0xf) == 15) {
+      while (compressed[pos++] == 255) {}
+    }
+  }
+  REQUIRE(literals_at_end >= 5);
+}
+
+TEST_CASE("LZ4HostCorruptTest", "[small]")
+{
+  const std::vector<uint8_t> input = random_runs(10000, 16, 4);
+  const std::vector<uint8_t> compressed = compress(input);
+  std::vector<uint8_t> output(input.size());
+  size_t output_size = 0;
+
+  SECTION("output too small")
+  {
+    REQUIRE(lz4HostDecompressChunk(compressed.data(), compressed.size(), output.data(), output.size() - 1, &output_size) 
+        == hipcompErrorCannotDecompress);
+  }
+
+  SECTION("truncated")
+  {
+    // A block cut at the end of a sequence's literals is still well formed, but 
+    // then holds less data
+    const hipcompStatus_t status = lz4HostDecompressChunk(
+        compressed.data(), compressed.size() / 2, output.data(), output.size(), &output_size);
+    REQUIRE((status == hipcompErrorCannotDecompress || output_size < input.size()));
+  }
+
+  SECTION("offset before the start")
+  {
+    // A token with no literals and a match at offset 1 on empty output
+    const std::vector<uint8_t> bad = {0x00, 0x01, 0x00};
+    REQUIRE(lz4HostDecompressChunk(bad.data(), bad.size(), output.data(), output.size(), &output_size) 
+        == hipcompErrorCannotDecompress);
+  }
+}
@@ -71,6 +71,12 @@
 #  define LITERAL_SECTORS 4
 #endif
 
+#ifndef LOG_CYCLECOUNT
+   // Build the decompression kernel with cycle counters that backs
+   // hipcompBatchedSnappyDecompressWithProfileAsync; 0 leaves it out
+#  define LOG_CYCLECOUNT 1
+#endif
+
 namespace hipcomp
 {
   namespace snappy
@@ -115,8 +121,6 @@ namespace hipcomp
     constexpr unsigned BATCH_COUNT = (1 << LOG2_BATCH_COUNT);
     constexpr unsigned PREFETCH_SIZE = (1 << LOG2_PREFETCH_SIZE); // 4KB, in 32B chunks
                                                                   //: TODO: amd: does it make sense to tune this for AMD to have the same amount of chunks?
-
-    constexpr unsigned LOG_CYCLECOUNT = 0;
   } // namespace snappy
 } // namespace hipcomp
 
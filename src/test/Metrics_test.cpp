@@ -0,0 +1,282 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "tests/catch.hpp"
+#include "Metrics.h"
+#include "Tracing.h"
+#include "hipcomp.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hipcomp;
+
+namespace {
+
+/**
+ * Enables metrics from a clean registry for the lifetime of the guard
+ */
+struct MetricsGuard {
+  MetricsGuard()
+  {
+    reset_metrics();
+    set_metrics_enabled(true);
+  }
+
+  ~MetricsGuard()
+  {
+    set_metrics_enabled(false);
+    reset_metrics();
+  }
+};
+
+const OperationMetrics* find_operation(
+    const MetricsSnapshot& snapshot, const std::string& codec, const std::string& operation)
+{
+  for (const OperationMetrics& metrics : snapshot.operations) {
+    if (metrics.codec == codec && metrics.operation == operation) {
+      return &metrics;
+    }
+  }
+  return nullptr;
+}
+
+const EventMetrics* find_event(const MetricsSnapshot& snapshot, const std::string& name)
+{
+  for (const EventMetrics& event : snapshot.events) {
+    if (event.name == name) {
+      return &event;
+    }
+  }
+  return nullptr;
+}
+
+LatencyHistogram histogram_of(const std::vector<uint64_t>& latencies_ns)
+{
+  MetricsGuard guard;
+  for (const uint64_t latency_ns : latencies_ns) {
+    metrics::record_operation(
+        TraceEvent{"compress", "histogram", 0, 0, nullptr, 0, HIPCOMP_TYPE_CHAR}, latency_ns, hipcompSuccess);
+  }
+  return find_operation(get_metrics_snapshot(), "histogram", "compress")->latency;
+}
+
+} // namespace
+
+TEST_CASE("MetricsDisabledByDefaultTest", "[small]")
+{
+  REQUIRE_FALSE(get_metrics_enabled());
+  {
+    TraceScope scope("compress", "lz4", 1024, 1, nullptr);
+  }
+  REQUIRE(find_operation(get_metrics_snapshot(), "lz4", "compress") == nullptr);
+}
+
+TEST_CASE("HistogramBucketsTest", "[small]")
+{
+  // every latency is at most its bucket's upper bound, and within 1/64 of it
+  size_t ix_bucket = 0;
+  for (uint64_t value = 1; value < (uint64_t(1) << 40); value = value * 3 / 2 + 1) {
+    const LatencyHistogram histogram = histogram_of({value});
+    ix_bucket = 0;
+    while (histogram.counts[ix_bucket] == 0) {
+      ++ix_bucket;
+    }
+    const uint64_t upper = LatencyHistogram::get_bucket_upper_bound_ns(ix_bucket);
+    REQUIRE(value <= upper);
+    REQUIRE(upper - value <= value / 64);
+    if (ix_bucket > 0) {
+      REQUIRE(LatencyHistogram::get_bucket_upper_bound_ns(ix_bucket - 1) < value);
+    }
+  }
+
+  // the largest latencies share the last bucket
+  const LatencyHistogram histogram = histogram_of({uint64_t(1) << 50});
+  REQUIRE(histogram.counts.back() == 1);
+  REQUIRE(histogram.max_ns == uint64_t(1) << 50);
+}
+
+TEST_CASE("HistogramQuantilesTest", "[small]")
+{
+  std::vector<uint64_t> latencies;
+  for (uint64_t ix = 1; ix <= 1000; ++ix) {
+    latencies.push_back(ix * 1000);
+  }
+  const LatencyHistogram histogram = histogram_of(latencies);
+
+  REQUIRE(histogram.count == 1000);
+  REQUIRE(histogram.min_ns == 1000);
+  REQUIRE(histogram.max_ns == 1000000);
+  REQUIRE(histogram.get_mean_ns() == Approx(500500.0));
+
+  const double quantiles[] = {0.5, 0.9, 0.99};
+  for (const double quantile : quantiles) {
+    const double expected = quantile * 1000000;
+    REQUIRE(histogram.get_quantile_ns(quantile) >= expected);
+    REQUIRE(histogram.get_quantile_ns(quantile) <= expected * 1.02);
+  }
+  REQUIRE(histogram.get_quantile_ns(0.0) == 1000);
+  REQUIRE(histogram.get_quantile_ns(1.0) == 1000000);
+  REQUIRE(LatencyHistogram().get_quantile_ns(0.5) == 0);
+}
+
+TEST_CASE("MetricsOperationsTest", "[small]")
+{
+  MetricsGuard guard;
+  {
+    TraceScope outer("compress", "lz4", 4096, 4, nullptr);
+    TraceScope inner("batch_compress", "lz4", 4096, 4, nullptr);
+  }
+  {
+    TraceScope scope("decompress", "lz4", 4096, 4, nullptr);
+  }
+  {
+    TraceScope scope("decompress", "lz4", 1024, 1, nullptr);
+  }
+
+  const MetricsSnapshot snapshot = get_metrics_snapshot();
+  REQUIRE(snapshot.operations.size() == 3);
+
+  const OperationMetrics* compress = find_operation(snapshot, "lz4", "compress");
+  REQUIRE(compress != nullptr);
+  REQUIRE(compress->calls == 1);
+  REQUIRE(compress->bytes_in == 4096);
+  REQUIRE(compress->bytes_out == 0);
+  REQUIRE(compress->errors.empty());
+  REQUIRE(compress->latency.count == 1);
+
+  const OperationMetrics* decompress = find_operation(snapshot, "lz4", "decompress");
+  REQUIRE(decompress != nullptr);
+  REQUIRE(decompress->calls == 2);
+  REQUIRE(decompress->bytes_in == 0);
+  REQUIRE(decompress->bytes_out == 5120);
+
+  reset_metrics();
+  const MetricsSnapshot empty = get_metrics_snapshot();
+  REQUIRE(empty.operations.empty());
+}
+
+TEST_CASE("MetricsErrorsTest", "[small]")
+{
+  MetricsGuard guard;
+  {
+    TraceScope scope("batched_compress", "snappy", 0, 8, nullptr);
+    scope.set_status(hipcompErrorInvalidValue);
+  }
+  try {
+    TraceScope scope("decompress", "snappy", 0, 0, nullptr);
+    scope.run([]() { throw HipCompException(hipcompErrorCannotDecompress, "corrupt"); });
+  } catch (const HipCompException&) {
+  }
+  try {
+    TraceScope scope("decompress", "snappy", 0, 0, nullptr);
+    throw std::runtime_error("unexpected");
+  } catch (const std::runtime_error&) {
+  }
+
+  const MetricsSnapshot snapshot = get_metrics_snapshot();
+  const OperationMetrics* compress = find_operation(snapshot, "snappy", "batched_compress");
+  REQUIRE(compress->errors.size() == 1);
+  REQUIRE(compress->errors.at(hipcompErrorInvalidValue) == 1);
+
+  const OperationMetrics* decompress = find_operation(snapshot, "snappy", "decompress");
+  REQUIRE(decompress->calls == 2);
+  REQUIRE(decompress->errors.at(hipcompErrorCannotDecompress) == 1);
+  REQUIRE(decompress->errors.at(hipcompErrorInternal) == 1);
+}
+
+TEST_CASE("MetricsEventsTest", "[small]")
+{
+  MetricsGuard guard;
+  metrics::count_event("scratch_allocation", 100);
+  metrics::count_event("scratch_allocation", 50);
+  metrics::count_event("scratch_reallocation", 150);
+
+  const MetricsSnapshot snapshot = get_metrics_snapshot();
+  REQUIRE(find_event(snapshot, "scratch_allocation")->count == 2);
+  REQUIRE(find_event(snapshot, "scratch_allocation")->bytes == 150);
+  REQUIRE(find_event(snapshot, "scratch_reallocation")->count == 1);
+
+  set_metrics_enabled(false);
+  metrics::count_event("scratch_allocation", 100);
+  const MetricsSnapshot unchanged = get_metrics_snapshot();
+  REQUIRE(find_event(unchanged, "scratch_allocation")->count == 2);
+}
+
+TEST_CASE("MetricsConcurrentTest", "[small]")
+{
+  MetricsGuard guard;
+  const size_t num_threads = 8;
+  const size_t num_calls = 1000;
+  std::vector<std::thread> threads;
+  for (size_t ix = 0; ix < num_threads; ++ix) {
+    threads.emplace_back([num_calls]() {
+      for (size_t call = 0; call < num_calls; ++call) {
+        TraceScope scope("compress", "cascaded", 10, 1, nullptr);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  const MetricsSnapshot snapshot = get_metrics_snapshot();
+  const OperationMetrics* compress = find_operation(snapshot, "cascaded", "compress");
+  REQUIRE(compress->calls == num_threads * num_calls);
+  REQUIRE(compress->bytes_in == num_threads * num_calls * 10);
+  REQUIRE(compress->latency.count == num_threads * num_calls);
+}
+
+TEST_CASE("MetricsPrometheusTest", "[small]")
+{
+  MetricsGuard guard;
+  metrics::record_operation(
+      TraceEvent{"compress", "lz4", 2048, 2, nullptr, 0, HIPCOMP_TYPE_CHAR}, 1500, hipcompSuccess);
+  metrics::record_operation(
+      TraceEvent{"compress", "lz4", 0, 2, nullptr, 0, HIPCOMP_TYPE_CHAR}, 2500, hipcompErrorNotSupported);
+  metrics::count_event("scratch_allocation", 64);
+
+  const std::string text = get_metrics_snapshot().to_prometheus();
+  const char* const expected[] = {
+      "# TYPE hipcomp_operation_calls_total counter\n",
+      "hipcomp_operation_calls_total{codec=\"lz4\",operation=\"compress\"} 2\n",
+      "hipcomp_operation_bytes_in_total{codec=\"lz4\",operation=\"compress\"} 2048\n",
+      "hipcomp_operation_errors_total{codec=\"lz4\",operation=\"compress\","
+      "status=\"hipcompErrorNotSupported\"} 1\n",
+      "# TYPE hipcomp_operation_latency_seconds summary\n",
+      "hipcomp_operation_latency_seconds{codec=\"lz4\",operation=\"compress\",quantile=\"0.5\"} "
+      "1.503e-06\n",
+      "hipcomp_operation_latency_seconds{codec=\"lz4\",operation=\"compress\",quantile=\"0.999\"} "
+      "2.5e-06\n",
+      "hipcomp_operation_latency_seconds_sum{codec=\"lz4\",operation=\"compress\"} 4e-06\n",
+      "hipcomp_operation_latency_seconds_count{codec=\"lz4\",operation=\"compress\"} 2\n",
+      "hipcomp_events_total{event=\"scratch_allocation\"} 1\n",
+      "hipcomp_event_bytes_total{event=\"scratch_allocation\"} 64\n"};
+  for (const char* line : expected) {
+    INFO(line);
+    REQUIRE(text.find(line) != std::string::npos);
+  }
+}
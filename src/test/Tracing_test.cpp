@@ -0,0 +1,203 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "tests/catch.hpp"
+#include "Tracing.h"
+#include "hipcomp.hpp"
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace hipcomp;
+
+namespace {
+
+/**
+ * Records "begin:<operation>" and "end:<operation>" for each call.
+ */
+struct RecordingListener : TraceListener {
+  std::vector<std::string> calls;
+
+  void begin(const TraceEvent& event) override
+  {
+    calls.push_back(std::string("begin:") + event.operation);
+  }
+
+  void end(const TraceEvent& event) override
+  {
+    calls.push_back(std::string("end:") + event.operation);
+  }
+};
+
+struct ThrowingListener : TraceListener {
+  void begin(const TraceEvent&) override
+  {
+  }
+
+  void end(const TraceEvent&) override
+  {
+    throw std::runtime_error("listener failure");
+  }
+};
+
+/**
+ * Sets a listener for the lifetime of the guard and disables tracing afterwards.
+ */
+struct ListenerGuard {
+  explicit ListenerGuard(std::shared_ptr<TraceListener> listener)
+  {
+    set_trace_listener(std::move(listener));
+  }
+
+  ~ListenerGuard()
+  {
+    set_trace_listener(nullptr);
+  }
+};
+
+size_t count(const std::string& text, const std::string& pattern)
+{
+  size_t num = 0;
+  for (size_t pos = text.find(pattern); pos != std::string::npos;
+       pos = text.find(pattern, pos + 1)) {
+    ++num;
+  }
+  return num;
+}
+
+} // namespace
+
+TEST_CASE("TraceDisabledByDefaultTest", "[small]")
+{
+  REQUIRE(get_trace_listener() == nullptr);
+  REQUIRE_FALSE(tracing::enabled.load());
+
+  TraceScope scope("compress", "lz4", 1024, 1, nullptr);
+}
+
+TEST_CASE("TraceNestedScopesTest", "[small]")
+{
+  auto listener = std::make_shared<RecordingListener>();
+  {
+    ListenerGuard guard(listener);
+    REQUIRE(get_trace_listener() == listener);
+
+    TraceScope outer("compress", "lz4", 1 << 20, 16, nullptr);
+    {
+      TraceScope inner("batch_compress", "lz4", 1 << 20, 16, nullptr);
+    }
+  }
+
+  const std::vector<std::string> expected{
+      "begin:compress", "begin:batch_compress", "end:batch_compress", "end:compress"};
+  REQUIRE(listener->calls == expected);
+
+  // after disabling, scopes reach no listener
+  TraceScope scope("compress", "lz4", 0, 0, nullptr);
+  REQUIRE(listener->calls.size() == expected.size());
+}
+
+TEST_CASE("TraceEndOnExceptionTest", "[small]")
+{
+  auto listener = std::make_shared<RecordingListener>();
+  ListenerGuard guard(listener);
+
+  try {
+    TraceScope scope("decompress", "snappy", 0, 0, nullptr);
+    throw HipCompException(hipcompErrorCannotDecompress, "corrupt");
+  } catch (const HipCompException&) {
+  }
+
+  const std::vector<std::string> expected{"begin:decompress", "end:decompress"};
+  REQUIRE(listener->calls == expected);
+}
+
+TEST_CASE("TraceScopeOutlivesListenerTest", "[small]")
+{
+  auto listener = std::make_shared<RecordingListener>();
+  set_trace_listener(listener);
+  {
+    TraceScope scope("compress", "cascaded", 0, 0, nullptr);
+    set_trace_listener(std::make_shared<ThrowingListener>());
+  }
+  set_trace_listener(nullptr);
+
+  // the scope ends on the listener it began on
+  const std::vector<std::string> expected{"begin:compress", "end:compress"};
+  REQUIRE(listener->calls == expected);
+
+  // exceptions from a listener do not escape the destructor
+  set_trace_listener(std::make_shared<ThrowingListener>());
+  {
+    TraceScope scope("compress", "cascaded", 0, 0, nullptr);
+  }
+  set_trace_listener(nullptr);
+}
+
+TEST_CASE("ChromeTraceWriterTest", "[small]")
+{
+  auto writer = std::make_shared<ChromeTraceWriter>();
+  {
+    ListenerGuard guard(writer);
+    TraceScope outer("compress", "lz4", 4096, 2, nullptr);
+    TraceScope inner("batch_\"compress\"", "lz4", 4096, 2, nullptr);
+  }
+  REQUIRE(writer->get_num_events() == 4);
+
+  std::ostringstream out;
+  writer->write(out);
+  const std::string json = out.str();
+
+  REQUIRE(json.find("{\"traceEvents\":[") == 0);
+  REQUIRE(count(json, "\"ph\":\"B\"") == 2);
+  REQUIRE(count(json, "\"ph\":\"E\"") == 2);
+  REQUIRE(count(json, "\"cat\":\"lz4\"") == 4);
+  REQUIRE(count(json, "\"bytes\":4096") == 2);
+  REQUIRE(count(json, "\"batch_size\":2") == 2);
+  REQUIRE(json.find("batch_\\\"compress\\\"") != std::string::npos);
+  REQUIRE(json.find("]}") != std::string::npos);
+
+  writer->clear();
+  REQUIRE(writer->get_num_events() == 0);
+  std::ostringstream empty;
+  writer->write(empty);
+  REQUIRE(count(empty.str(), "\"ph\"") == 0);
+}
+
+TEST_CASE("RoctxListenerTest", "[small]")
+{
+#ifdef HIPCOMP_USE_ROCTX
+  REQUIRE(create_roctx_trace_listener() != nullptr);
+#else
+  try {
+    create_roctx_trace_listener();
+    FAIL("Expected an exception without roctx");
+  } catch (const HipCompException& e) {
+    REQUIRE(e.get_error() == hipcompErrorNotSupported);
+  }
+#endif
+}
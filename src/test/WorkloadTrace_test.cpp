@@ -0,0 +1,222 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#define CATCH_CONFIG_MAIN
+
+#include "tests/catch.hpp"
+#include "Tracing.h"
+#include "hipcomp.hpp"
+#include "hipcomp/hipcompWorkloadTrace.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hipcomp;
+
+namespace {
+
+/**
+ * Sets a listener for the lifetime of the guard and disables tracing afterwards.
+ */
+struct ListenerGuard {
+  explicit ListenerGuard(std::shared_ptr<TraceListener> listener)
+  {
+    set_trace_listener(std::move(listener));
+  }
+
+  ~ListenerGuard()
+  {
+    set_trace_listener(nullptr);
+  }
+};
+
+WorkloadCall make_call(
+    const std::string& operation, const std::string& codec, const uint64_t bytes, const uint64_t start_ns)
+{
+  return WorkloadCall{operation, codec, bytes, 16, 65536, HIPCOMP_TYPE_INT, start_ns, 2500, 0, 0};
+}
+
+void require_equal(const WorkloadCall& a, const WorkloadCall& b)
+{
+  REQUIRE(a.operation == b.operation);
+  REQUIRE(a.codec == b.codec);
+  REQUIRE(a.bytes == b.bytes);
+  REQUIRE(a.batch_size == b.batch_size);
+  REQUIRE(a.chunk_size == b.chunk_size);
+  REQUIRE(a.data_type == b.data_type);
+  REQUIRE(a.start_ns == b.start_ns);
+  REQUIRE(a.duration_ns == b.duration_ns);
+  REQUIRE(a.thread == b.thread);
+  REQUIRE(a.stream == b.stream);
+}
+
+void require_invalid(const std::string& bytes)
+{
+  std::istringstream in(bytes);
+  try {
+    read_workload(in);
+    FAIL("Expected an exception");
+  } catch (const HipCompException& e) {
+    REQUIRE(e.get_error() == hipcompErrorInvalidValue);
+  }
+}
+
+} // namespace
+
+TEST_CASE("WorkloadRecorderOutermostCallsTest", "[small]")
+{
+  auto recorder = std::make_shared<WorkloadRecorder>();
+  hipStream_t other_stream = reinterpret_cast<hipStream_t>(0x10);
+  {
+    ListenerGuard guard(recorder);
+    {
+      TraceScope outer("compress", "lz4", 1 << 20, 16, nullptr, 65536, HIPCOMP_TYPE_INT);
+      TraceScope inner("batch_compress", "lz4", 1 << 20, 16, nullptr, 65536, HIPCOMP_TYPE_INT);
+    }
+    {
+      TraceScope scope("batched_decompress", "snappy", 0, 8, other_stream);
+    }
+    std::thread([]() { TraceScope scope("decompress", "lz4", 1 << 20, 16, nullptr, 65536, HIPCOMP_TYPE_INT); })
+        .join();
+  }
+  {
+    // not recorded once the listener is unset
+    TraceScope scope("compress", "lz4", 1024, 1, nullptr);
+  }
+
+  const std::vector<WorkloadCall> calls = recorder->get_calls();
+  REQUIRE(calls.size() == 3);
+
+  REQUIRE(calls[0].operation == "compress");
+  REQUIRE(calls[0].codec == "lz4");
+  REQUIRE(calls[0].bytes == 1 << 20);
+  REQUIRE(calls[0].batch_size == 16);
+  REQUIRE(calls[0].chunk_size == 65536);
+  REQUIRE(calls[0].data_type == HIPCOMP_TYPE_INT);
+  REQUIRE(calls[0].thread == 0);
+  REQUIRE(calls[0].stream == 0);
+
+  REQUIRE(calls[1].operation == "batched_decompress");
+  REQUIRE(calls[1].chunk_size == 0);
+  REQUIRE(calls[1].data_type == HIPCOMP_TYPE_CHAR);
+  REQUIRE(calls[1].thread == 0);
+  REQUIRE(calls[1].stream == 1);
+  REQUIRE(calls[1].start_ns >= calls[0].start_ns + calls[0].duration_ns);
+
+  REQUIRE(calls[2].operation == "decompress");
+  REQUIRE(calls[2].thread == 1);
+  REQUIRE(calls[2].stream == 0);
+
+  recorder->clear();
+  REQUIRE(recorder->get_calls().empty());
+}
+
+TEST_CASE("WorkloadRecorderEndOnExceptionTest", "[small]")
+{
+  auto recorder = std::make_shared<WorkloadRecorder>();
+  ListenerGuard guard(recorder);
+
+  try {
+    TraceScope scope("decompress", "cascaded", 4096, 1, nullptr, 4096, HIPCOMP_TYPE_UINT);
+    throw HipCompException(hipcompErrorCannotDecompress, "corrupt");
+  } catch (const HipCompException&) {
+  }
+
+  const std::vector<WorkloadCall> calls = recorder->get_calls();
+  REQUIRE(calls.size() == 1);
+  REQUIRE(calls[0].operation == "decompress");
+  REQUIRE(calls[0].data_type == HIPCOMP_TYPE_UINT);
+}
+
+TEST_CASE("WorkloadRoundTripTest", "[small]")
+{
+  std::vector<WorkloadCall> calls{
+      make_call("compress", "lz4", 1 << 20, 1000),
+      make_call("decompress", "lz4", 1 << 20, 5000),
+      make_call("batched_compress", "cascaded", 0, 5000),
+      make_call("compress", "lz4", 12345, 1ull << 40)};
+  calls[2].data_type = HIPCOMP_TYPE_BITS;
+  calls[2].thread = 3;
+  calls[3].stream = 70000;
+  calls[3].duration_ns = 0;
+
+  std::stringstream buffer;
+  write_workload(buffer, calls);
+  const std::vector<WorkloadCall> read = read_workload(buffer);
+
+  REQUIRE(read.size() == calls.size());
+  for (size_t ix = 0; ix < calls.size(); ++ix) {
+    require_equal(read[ix], calls[ix]);
+  }
+
+  std::stringstream empty;
+  write_workload(empty, std::vector<WorkloadCall>());
+  REQUIRE(read_workload(empty).empty());
+}
+
+TEST_CASE("WorkloadCompactTest", "[small]")
+{
+  std::vector<WorkloadCall> calls;
+  for (uint64_t ix = 0; ix < 1000; ++ix) {
+    calls.push_back(make_call(ix % 2 ? "decompress" : "compress", "lz4", 1 << 20, 1000000 + ix * 40000));
+  }
+
+  std::stringstream buffer;
+  write_workload(buffer, calls);
+  REQUIRE(buffer.str().size() < 20 * calls.size());
+  REQUIRE(read_workload(buffer).size() == calls.size());
+}
+
+TEST_CASE("WorkloadMalformedTest", "[small]")
+{
+  std::stringstream buffer;
+  write_workload(buffer, std::vector<WorkloadCall>{make_call("compress", "lz4", 4096, 0)});
+  const std::string valid = buffer.str();
+
+  require_invalid("");
+  require_invalid("{\"traceEvents\":[]}");
+  for (size_t size = 0; size < valid.size(); ++size) {
+    require_invalid(valid.substr(0, size));
+  }
+
+  // an unknown version
+  std::string version = valid;
+  version[4] = 2;
+  require_invalid(version);
+
+  // an integer longer than 64 bits
+  require_invalid(std::string("HCWT\x01") + std::string(10, '\xff'));
+
+  // a name index past the names
+  std::stringstream bad_name;
+  write_workload(bad_name, std::vector<WorkloadCall>());
+  std::string bad_name_bytes = bad_name.str();
+  bad_name_bytes.back() = 1;
+  bad_name_bytes += std::string("\x05\x00", 2);
+  require_invalid(bad_name_bytes);
+
+  REQUIRE_THROWS_AS(read_workload(std::string("/nonexistent/workload.hcwt")), HipCompException);
+}
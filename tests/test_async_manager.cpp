@@ -0,0 +1,244 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.hpp"
+#include "hipcomp/lz4.hpp"
+#include "hipcomp/hipcompAsync.hpp"
+
+#include "catch.hpp"
+#include "test_common.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Test notifying the completion of manager calls through callbacks and futures //
+
+using namespace std;
+using namespace hipcomp;
+
+namespace
+{
+
+const size_t chunk_size = 1 << 16;
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("async futures round trip", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, stream};
+  AsyncManager async_manager{manager};
+
+  const std::vector<uint8_t> input = buildData(1000000, 1);
+  uint8_t* d_input;
+  uint8_t* d_decomp;
+  HIP_CHECK(hipMalloc(&d_input, input.size()));
+  HIP_CHECK(hipMalloc(&d_decomp, input.size()));
+  HIP_CHECK(hipMemcpy(d_input, input.data(), input.size(), hipMemcpyHostToDevice));
+
+  CompressionConfig comp_config = manager.configure_compression(input.size());
+  uint8_t* d_comp;
+  HIP_CHECK(hipMalloc(&d_comp, comp_config.max_compressed_buffer_size));
+
+  std::future<CompressionResult> comp_future = async_manager.compress(d_input, d_comp, comp_config, stream);
+  const CompressionResult comp_result = comp_future.get();
+  REQUIRE(comp_result.status == hipcompSuccess);
+  REQUIRE(comp_result.comp_size == manager.get_compressed_output_size(d_comp));
+  REQUIRE(comp_result.comp_size <= comp_config.max_compressed_buffer_size);
+
+  DecompressionConfig decomp_config = manager.configure_decompression(comp_config);
+  std::future<DecompressionResult> decomp_future = async_manager.decompress(d_decomp, d_comp, decomp_config, stream);
+  const DecompressionResult decomp_result = decomp_future.get();
+  REQUIRE(decomp_result.status == hipcompSuccess);
+  REQUIRE(decomp_result.decomp_size == input.size());
+
+  // The callback runs after the decompression has finished
+  std::vector<uint8_t> output(input.size());
+  HIP_CHECK(hipMemcpy(output.data(), d_decomp, input.size(), hipMemcpyDeviceToHost));
+  REQUIRE(output == input);
+  REQUIRE(async_manager.get_num_in_flight() == 0);
+
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_decomp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST_CASE("async callbacks with many calls in flight", "[small]")
+{
+  hipStream_t user_stream;
+  HIP_CHECK(hipStreamCreate(&user_stream));
+  std::vector<hipStream_t> streams(3);
+  for (auto& stream : streams) {
+    HIP_CHECK(hipStreamCreate(&stream));
+  }
+
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, user_stream};
+
+  const size_t num_calls = 64;
+  const size_t input_size = 100000;
+  std::vector<std::vector<uint8_t>> inputs(num_calls);
+  std::vector<uint8_t*> d_inputs(num_calls);
+  std::vector<uint8_t*> d_comps(num_calls);
+  std::vector<CompressionConfig> comp_configs;
+  for (size_t ix = 0; ix < num_calls; ++ix) {
+    inputs[ix] = buildData(input_size, static_cast<int>(ix));
+    comp_configs.push_back(manager.configure_compression(input_size));
+    HIP_CHECK(hipMalloc(&d_inputs[ix], input_size));
+    HIP_CHECK(hipMalloc(&d_comps[ix], comp_configs.back().max_compressed_buffer_size));
+    HIP_CHECK(hipMemcpy(d_inputs[ix], inputs[ix].data(), input_size, hipMemcpyHostToDevice));
+  }
+
+  std::vector<size_t> comp_sizes(num_calls, 0);
+  std::vector<hipcompStatus_t> statuses(num_calls, hipcompErrorInternal);
+  std::atomic<size_t> num_done(0);
+  {
+    AsyncManager async_manager{manager};
+    for (size_t ix = 0; ix < num_calls; ++ix) {
+      async_manager.compress(
+          d_inputs[ix], 
+          d_comps[ix], 
+          comp_configs[ix], 
+          streams[ix % streams.size()],
+          [&, ix](const CompressionResult& result) {
+            statuses[ix] = result.status;
+            comp_sizes[ix] = result.comp_size;
+            ++num_done;
+          });
+    }
+    // The configs can be dropped while their calls are in flight
+    comp_configs.clear();
+    // Destroying the async manager waits for the callbacks
+  }
+  REQUIRE(num_done == num_calls);
+
+  for (size_t ix = 0; ix < num_calls; ++ix) {
+    REQUIRE(statuses[ix] == hipcompSuccess);
+    REQUIRE(comp_sizes[ix] == manager.get_compressed_output_size(d_comps[ix]));
+
+    DecompressionConfig decomp_config = manager.configure_decompression(d_comps[ix]);
+    uint8_t* d_decomp;
+    HIP_CHECK(hipMalloc(&d_decomp, input_size));
+    manager.decompress(d_decomp, d_comps[ix], decomp_config);
+    std::vector<uint8_t> output(input_size);
+    HIP_CHECK(hipMemcpyAsync(output.data(), d_decomp, input_size, hipMemcpyDeviceToHost, user_stream));
+    HIP_CHECK(hipStreamSynchronize(user_stream));
+    REQUIRE(output == inputs[ix]);
+    HIP_CHECK(hipFree(d_decomp));
+  }
+
+  for (size_t ix = 0; ix < num_calls; ++ix) {
+    HIP_CHECK(hipFree(d_comps[ix]));
+    HIP_CHECK(hipFree(d_inputs[ix]));
+  }
+  for (auto& stream : streams) {
+    HIP_CHECK(hipStreamDestroy(stream));
+  }
+  HIP_CHECK(hipStreamDestroy(user_stream));
+}
+
+TEST_CASE("async callback waits on earlier stream work", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, stream};
+  AsyncManager async_manager{manager};
+
+  const std::vector<uint8_t> input = buildData(500000, 3);
+  uint8_t* d_input;
+  HIP_CHECK(hipMalloc(&d_input, input.size()));
+  CompressionConfig comp_config = manager.configure_compression(input.size());
+  uint8_t* d_comp;
+  HIP_CHECK(hipMalloc(&d_comp, comp_config.max_compressed_buffer_size));
+
+  // The copy is still in flight when the call is issued. The compression, and 
+  // with it the callback, is ordered after it.
+  HIP_CHECK(hipMemcpyAsync(d_input, input.data(), input.size(), hipMemcpyHostToDevice, stream));
+
+  std::mutex mutex;
+  std::condition_variable done;
+  bool finished = false;
+  CompressionResult result{hipcompErrorInternal, 0};
+  async_manager.compress(d_input, d_comp, comp_config, stream, 
+      [&](const CompressionResult& res) {
+        std::lock_guard<std::mutex> lock(mutex);
+        result = res;
+        finished = true;
+        done.notify_all();
+      });
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    REQUIRE(done.wait_for(lock, std::chrono::seconds(10), [&]() { return finished; }));
+  }
+  REQUIRE(result.status == hipcompSuccess);
+  REQUIRE(result.comp_size == manager.get_compressed_output_size(d_comp));
+
+  REQUIRE_THROWS_AS(
+      async_manager.compress(d_input, d_comp, comp_config, stream, CompressionCallback()), 
+      HipCompException);
+
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST_CASE("async call finishes when its callback throws", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, stream};
+
+  const std::vector<uint8_t> input = buildData(100000, 4);
+  uint8_t* d_input;
+  HIP_CHECK(hipMalloc(&d_input, input.size()));
+  HIP_CHECK(hipMemcpy(d_input, input.data(), input.size(), hipMemcpyHostToDevice));
+  CompressionConfig comp_config = manager.configure_compression(input.size());
+  uint8_t* d_comp;
+  HIP_CHECK(hipMalloc(&d_comp, comp_config.max_compressed_buffer_size));
+
+  {
+    AsyncManager async_manager{manager};
+    async_manager.compress(d_input, d_comp, comp_config, stream, 
+        [](const CompressionResult&) { throw std::runtime_error("callback failed"); });
+    HIP_CHECK(hipStreamSynchronize(stream));
+    // The destructor waits for the call, which must not stay in flight
+  }
+
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
@@ -0,0 +1,284 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp/lz4.h"
+#include "hipcomp/snappy.h"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <vector>
+
+// Test batches that mix small and large chunks, which are started largest first //
+
+#define HIP_CHECK(cond)                                                       \
+  do {                                                                         \
+    hipError_t err = cond;                                                    \
+    REQUIRE(err == hipSuccess);                                               \
+  } while (false)
+
+namespace
+{
+
+struct LZ4Codec
+{
+  static size_t compress_temp(size_t batch_size, size_t max_chunk_bytes)
+  {
+    size_t temp_bytes;
+    REQUIRE(hipcompBatchedLZ4CompressGetTempSize(
+        batch_size, max_chunk_bytes, hipcompBatchedLZ4DefaultOpts, &temp_bytes) == hipcompSuccess);
+    return temp_bytes;
+  }
+
+  static size_t decompress_temp(size_t batch_size, size_t max_chunk_bytes)
+  {
+    size_t temp_bytes;
+    REQUIRE(hipcompBatchedLZ4DecompressGetTempSize(
+        batch_size, max_chunk_bytes, &temp_bytes) == hipcompSuccess);
+    return temp_bytes;
+  }
+
+  static size_t max_output(size_t max_chunk_bytes)
+  {
+    size_t max_comp_bytes;
+    REQUIRE(hipcompBatchedLZ4CompressGetMaxOutputChunkSize(
+        max_chunk_bytes, hipcompBatchedLZ4DefaultOpts, &max_comp_bytes) == hipcompSuccess);
+    return max_comp_bytes;
+  }
+
+  static hipcompStatus_t compress(
+      void** d_uncomp_ptrs, size_t* d_uncomp_bytes, size_t max_chunk_bytes, size_t batch_size,
+      void* d_temp, size_t temp_bytes, void** d_comp_ptrs, size_t* d_comp_bytes, hipStream_t stream)
+  {
+    return hipcompBatchedLZ4CompressAsync(
+        d_uncomp_ptrs, d_uncomp_bytes, max_chunk_bytes, batch_size, d_temp, temp_bytes,
+        d_comp_ptrs, d_comp_bytes, hipcompBatchedLZ4DefaultOpts, stream);
+  }
+
+  static hipcompStatus_t decompress(
+      void** d_comp_ptrs, size_t* d_comp_bytes, size_t* d_uncomp_bytes, size_t* d_actual_bytes,
+      size_t batch_size, void* d_temp, size_t temp_bytes, void** d_uncomp_ptrs,
+      hipcompStatus_t* d_statuses, hipStream_t stream)
+  {
+    return hipcompBatchedLZ4DecompressAsync(
+        d_comp_ptrs, d_comp_bytes, d_uncomp_bytes, d_actual_bytes, batch_size, d_temp,
+        temp_bytes, d_uncomp_ptrs, d_statuses, stream);
+  }
+};
+
+struct SnappyCodec
+{
+  static size_t compress_temp(size_t batch_size, size_t max_chunk_bytes)
+  {
+    size_t temp_bytes;
+    REQUIRE(hipcompBatchedSnappyCompressGetTempSize(
+        batch_size, max_chunk_bytes, hipcompBatchedSnappyDefaultOpts, &temp_bytes) == hipcompSuccess);
+    return temp_bytes;
+  }
+
+  static size_t decompress_temp(size_t batch_size, size_t max_chunk_bytes)
+  {
+    size_t temp_bytes;
+    REQUIRE(hipcompBatchedSnappyDecompressGetTempSize(
+        batch_size, max_chunk_bytes, &temp_bytes) == hipcompSuccess);
+    return temp_bytes;
+  }
+
+  static size_t max_output(size_t max_chunk_bytes)
+  {
+    size_t max_comp_bytes;
+    REQUIRE(hipcompBatchedSnappyCompressGetMaxOutputChunkSize(
+        max_chunk_bytes, hipcompBatchedSnappyDefaultOpts, &max_comp_bytes) == hipcompSuccess);
+    return max_comp_bytes;
+  }
+
+  static hipcompStatus_t compress(
+      void** d_uncomp_ptrs, size_t* d_uncomp_bytes, size_t max_chunk_bytes, size_t batch_size,
+      void* d_temp, size_t temp_bytes, void** d_comp_ptrs, size_t* d_comp_bytes, hipStream_t stream)
+  {
+    return hipcompBatchedSnappyCompressAsync(
+        d_uncomp_ptrs, d_uncomp_bytes, max_chunk_bytes, batch_size, d_temp, temp_bytes,
+        d_comp_ptrs, d_comp_bytes, hipcompBatchedSnappyDefaultOpts, stream);
+  }
+
+  static hipcompStatus_t decompress(
+      void** d_comp_ptrs, size_t* d_comp_bytes, size_t* d_uncomp_bytes, size_t* d_actual_bytes,
+      size_t batch_size, void* d_temp, size_t temp_bytes, void** d_uncomp_ptrs,
+      hipcompStatus_t* d_statuses, hipStream_t stream)
+  {
+    return hipcompBatchedSnappyDecompressAsync(
+        d_comp_ptrs, d_comp_bytes, d_uncomp_bytes, d_actual_bytes, batch_size, d_temp,
+        temp_bytes, d_uncomp_ptrs, d_statuses, stream);
+  }
+};
+
+std::vector<size_t> skewedSizes(const size_t batch_size, const size_t large_chunk_bytes)
+{
+  std::vector<size_t> sizes(batch_size);
+  for (size_t i = 0; i < batch_size; ++i) {
+    // mostly 1 KB chunks, with the large ones towards the end of the batch
+    sizes[i] = (i % 97 == 96) ? large_chunk_bytes - i : 1024 + i % 7;
+  }
+  sizes[batch_size - 1] = large_chunk_bytes;
+  return sizes;
+}
+
+template <typename Codec>
+void test_skewed_batch(const std::vector<size_t>& sizes, const bool full_temp)
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  const size_t batch_size = sizes.size();
+  size_t max_chunk_bytes = 0;
+  size_t total_bytes = 0;
+  for (const size_t size : sizes) {
+    max_chunk_bytes = std::max(max_chunk_bytes, size);
+    total_bytes += size;
+  }
+  const size_t max_comp_bytes = Codec::max_output(max_chunk_bytes);
+
+  // Without the full temp space, the batch is processed in its own order
+  size_t comp_temp_bytes = Codec::compress_temp(batch_size, max_chunk_bytes);
+  size_t decomp_temp_bytes = Codec::decompress_temp(batch_size, max_chunk_bytes);
+  if (!full_temp) {
+    comp_temp_bytes = Codec::compress_temp(1, max_chunk_bytes) * batch_size;
+    decomp_temp_bytes = 0;
+  }
+
+  std::vector<uint8_t> input(total_bytes);
+  srand(7);
+  for (size_t i = 0; i < total_bytes; ++i) {
+    input[i] = (i / 61) % 5 == 0 ? static_cast<uint8_t>(rand()) : static_cast<uint8_t>(i / 300);
+  }
+
+  uint8_t* d_input;
+  uint8_t* d_comp;
+  uint8_t* d_output;
+  void* d_comp_temp;
+  void* d_decomp_temp;
+  HIP_CHECK(hipMalloc(&d_input, total_bytes));
+  HIP_CHECK(hipMalloc(&d_comp, batch_size * max_comp_bytes));
+  HIP_CHECK(hipMalloc(&d_output, total_bytes));
+  HIP_CHECK(hipMalloc(&d_comp_temp, std::max(comp_temp_bytes, size_t{1})));
+  HIP_CHECK(hipMalloc(&d_decomp_temp, std::max(decomp_temp_bytes, size_t{1})));
+  HIP_CHECK(hipMemcpy(d_input, input.data(), total_bytes, hipMemcpyHostToDevice));
+
+  std::vector<void*> input_ptrs(batch_size);
+  std::vector<void*> comp_ptrs(batch_size);
+  std::vector<void*> output_ptrs(batch_size);
+  size_t offset = 0;
+  for (size_t i = 0; i < batch_size; ++i) {
+    input_ptrs[i] = d_input + offset;
+    output_ptrs[i] = d_output + offset;
+    comp_ptrs[i] = d_comp + i * max_comp_bytes;
+    offset += sizes[i];
+  }
+
+  void** d_input_ptrs;
+  void** d_comp_ptrs;
+  void** d_output_ptrs;
+  size_t* d_sizes;
+  size_t* d_comp_bytes;
+  size_t* d_actual_bytes;
+  hipcompStatus_t* d_statuses;
+  HIP_CHECK(hipMalloc(&d_input_ptrs, batch_size * sizeof(void*)));
+  HIP_CHECK(hipMalloc(&d_comp_ptrs, batch_size * sizeof(void*)));
+  HIP_CHECK(hipMalloc(&d_output_ptrs, batch_size * sizeof(void*)));
+  HIP_CHECK(hipMalloc(&d_sizes, batch_size * sizeof(size_t)));
+  HIP_CHECK(hipMalloc(&d_comp_bytes, batch_size * sizeof(size_t)));
+  HIP_CHECK(hipMalloc(&d_actual_bytes, batch_size * sizeof(size_t)));
+  HIP_CHECK(hipMalloc(&d_statuses, batch_size * sizeof(hipcompStatus_t)));
+  HIP_CHECK(hipMemcpy(d_input_ptrs, input_ptrs.data(), batch_size * sizeof(void*), hipMemcpyHostToDevice));
+  HIP_CHECK(hipMemcpy(d_comp_ptrs, comp_ptrs.data(), batch_size * sizeof(void*), hipMemcpyHostToDevice));
+  HIP_CHECK(hipMemcpy(d_output_ptrs, output_ptrs.data(), batch_size * sizeof(void*), hipMemcpyHostToDevice));
+  HIP_CHECK(hipMemcpy(d_sizes, sizes.data(), batch_size * sizeof(size_t), hipMemcpyHostToDevice));
+
+  REQUIRE(Codec::compress(
+      d_input_ptrs, d_sizes, max_chunk_bytes, batch_size, d_comp_temp, comp_temp_bytes,
+      d_comp_ptrs, d_comp_bytes, stream) == hipcompSuccess);
+  REQUIRE(Codec::decompress(
+      d_comp_ptrs, d_comp_bytes, d_sizes, d_actual_bytes, batch_size, d_decomp_temp,
+      decomp_temp_bytes, d_output_ptrs, d_statuses, stream) == hipcompSuccess);
+
+  std::vector<uint8_t> output(total_bytes);
+  std::vector<size_t> actual_bytes(batch_size);
+  std::vector<hipcompStatus_t> statuses(batch_size);
+  HIP_CHECK(hipMemcpyAsync(output.data(), d_output, total_bytes, hipMemcpyDeviceToHost, stream));
+  HIP_CHECK(hipMemcpyAsync(actual_bytes.data(), d_actual_bytes, batch_size * sizeof(size_t), hipMemcpyDeviceToHost, stream));
+  HIP_CHECK(hipMemcpyAsync(statuses.data(), d_statuses, batch_size * sizeof(hipcompStatus_t), hipMemcpyDeviceToHost, stream));
+  HIP_CHECK(hipStreamSynchronize(stream));
+
+  for (size_t i = 0; i < batch_size; ++i) {
+    REQUIRE(statuses[i] == hipcompSuccess);
+    REQUIRE(actual_bytes[i] == sizes[i]);
+  }
+  REQUIRE(output == input);
+
+  HIP_CHECK(hipFree(d_statuses));
+  HIP_CHECK(hipFree(d_actual_bytes));
+  HIP_CHECK(hipFree(d_comp_bytes));
+  HIP_CHECK(hipFree(d_sizes));
+  HIP_CHECK(hipFree(d_output_ptrs));
+  HIP_CHECK(hipFree(d_comp_ptrs));
+  HIP_CHECK(hipFree(d_input_ptrs));
+  HIP_CHECK(hipFree(d_decomp_temp));
+  HIP_CHECK(hipFree(d_comp_temp));
+  HIP_CHECK(hipFree(d_output));
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("skewed lz4 batch", "[small]")
+{
+  test_skewed_batch<LZ4Codec>(skewedSizes(1000, 4 << 20), true);
+}
+
+TEST_CASE("skewed lz4 batch without schedule space", "[small]")
+{
+  test_skewed_batch<LZ4Codec>(skewedSizes(1000, 4 << 20), false);
+}
+
+TEST_CASE("skewed lz4 small batch", "[small]")
+{
+  test_skewed_batch<LZ4Codec>(skewedSizes(100, 1 << 20), true);
+}
+
+TEST_CASE("skewed snappy batch", "[small]")
+{
+  test_skewed_batch<SnappyCodec>(skewedSizes(1000, 1 << 20), true);
+}
+
+TEST_CASE("skewed snappy batch without schedule space", "[small]")
+{
+  test_skewed_batch<SnappyCodec>(skewedSizes(1000, 1 << 20), false);
+}
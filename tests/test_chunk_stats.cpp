@@ -0,0 +1,233 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.h"
+#include "hipcomp/cascaded.h"
+#include "hipcomp/lz4.h"
+#include "hipcomp/snappy.h"
+
+#include "DatasetGenerator.hpp"
+#include "catch.hpp"
+
+#include <algorithm>
+#include <vector>
+
+// Test the per-chunk statistics of the batched compression interfaces //
+
+using namespace hipcomp;
+
+#define HIP_CHECK(cond)                                                       \
+  do {                                                                         \
+    hipError_t err = (cond);                                                  \
+    REQUIRE(err == hipSuccess);                                               \
+  } while (false)
+
+/******************************************************************************
+ * HELPER FUNCTIONS ***********************************************************
+ *****************************************************************************/
+
+namespace
+{
+
+const size_t chunk_bytes = 1 << 16;
+
+enum ChunkKind
+{
+  RUNS = 0,
+  RANDOM = 1,
+  TEXT = 2,
+  NUM_CHUNKS = 3
+};
+
+/**
+ * A batch of a compressible, an incompressible and a text chunk in managed
+ * memory, with room for the statistics
+ */
+struct StatsBatch {
+  std::vector<void*> input_ptrs;
+  std::vector<size_t> input_bytes;
+  void** d_input_ptrs;
+  size_t* d_input_bytes;
+  void** d_comp_ptrs;
+  size_t* d_comp_bytes;
+  hipcompChunkStats_t* d_stats;
+  void* d_temp;
+  size_t temp_bytes;
+
+  StatsBatch(size_t max_comp_chunk_bytes, size_t temp_bytes)
+    : temp_bytes(temp_bytes)
+  {
+    const std::vector<std::vector<uint8_t>> inputs
+        = {datasets::generate("runs:64", chunk_bytes, HIPCOMP_TYPE_CHAR, 1),
+           datasets::generate("random", chunk_bytes, HIPCOMP_TYPE_CHAR, 2),
+           datasets::generate("text", chunk_bytes, HIPCOMP_TYPE_CHAR, 3)};
+
+    HIP_CHECK(hipMallocManaged(&d_input_ptrs, sizeof(void*) * NUM_CHUNKS));
+    HIP_CHECK(hipMallocManaged(&d_input_bytes, sizeof(size_t) * NUM_CHUNKS));
+    HIP_CHECK(hipMallocManaged(&d_comp_ptrs, sizeof(void*) * NUM_CHUNKS));
+    HIP_CHECK(hipMallocManaged(&d_comp_bytes, sizeof(size_t) * NUM_CHUNKS));
+    HIP_CHECK(hipMallocManaged(&d_stats, sizeof(hipcompChunkStats_t) * NUM_CHUNKS));
+    HIP_CHECK(hipMalloc(&d_temp, std::max<size_t>(temp_bytes, 1)));
+
+    for (size_t ix = 0; ix < NUM_CHUNKS; ++ix) {
+      HIP_CHECK(hipMallocManaged(&d_input_ptrs[ix], inputs[ix].size()));
+      std::copy(inputs[ix].begin(), inputs[ix].end(), static_cast<uint8_t*>(d_input_ptrs[ix]));
+      d_input_bytes[ix] = inputs[ix].size();
+      HIP_CHECK(hipMallocManaged(&d_comp_ptrs[ix], max_comp_chunk_bytes));
+    }
+    std::fill(d_stats, d_stats + NUM_CHUNKS, hipcompChunkStats_t{});
+  }
+
+  ~StatsBatch()
+  {
+    for (size_t ix = 0; ix < NUM_CHUNKS; ++ix) {
+      hipFree(d_input_ptrs[ix]);
+      hipFree(d_comp_ptrs[ix]);
+    }
+    hipFree(d_input_ptrs);
+    hipFree(d_input_bytes);
+    hipFree(d_comp_ptrs);
+    hipFree(d_comp_bytes);
+    hipFree(d_stats);
+    hipFree(d_temp);
+  }
+
+  void check_sizes() const
+  {
+    for (size_t ix = 0; ix < NUM_CHUNKS; ++ix) {
+      REQUIRE(d_stats[ix].uncompressed_bytes == d_input_bytes[ix]);
+      REQUIRE(d_stats[ix].compressed_bytes == d_comp_bytes[ix]);
+    }
+  }
+
+  void check_matches() const
+  {
+    for (size_t ix = 0; ix < NUM_CHUNKS; ++ix) {
+      const hipcompChunkStats_t& stats = d_stats[ix];
+      REQUIRE(stats.match_bytes + stats.literal_bytes == stats.uncompressed_bytes);
+      REQUIRE(stats.num_RLEs == 0);
+    }
+    REQUIRE(d_stats[RUNS].match_bytes > d_stats[RUNS].uncompressed_bytes * 9 / 10);
+    REQUIRE(d_stats[RUNS].num_matches > 0);
+    REQUIRE(d_stats[RANDOM].literal_bytes > d_stats[RANDOM].uncompressed_bytes * 99 / 100);
+    REQUIRE(d_stats[TEXT].num_matches > 0);
+    REQUIRE(d_stats[TEXT].literal_bytes > 0);
+  }
+};
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("chunk stats lz4", "[small]")
+{
+  size_t max_comp_chunk_bytes;
+  size_t temp_bytes;
+  REQUIRE(hipcompBatchedLZ4CompressGetMaxOutputChunkSize(
+      chunk_bytes, hipcompBatchedLZ4DefaultOpts, &max_comp_chunk_bytes) == hipcompSuccess);
+  REQUIRE(hipcompBatchedLZ4CompressGetTempSize(
+      NUM_CHUNKS, chunk_bytes, hipcompBatchedLZ4DefaultOpts, &temp_bytes) == hipcompSuccess);
+
+  StatsBatch batch(max_comp_chunk_bytes, temp_bytes);
+  REQUIRE(hipcompBatchedLZ4CompressWithStatsAsync(
+      batch.d_input_ptrs, batch.d_input_bytes, chunk_bytes, NUM_CHUNKS, batch.d_temp, temp_bytes,
+      batch.d_comp_ptrs, batch.d_comp_bytes, hipcompBatchedLZ4DefaultOpts, batch.d_stats, 0)
+      == hipcompSuccess);
+  HIP_CHECK(hipDeviceSynchronize());
+
+  batch.check_sizes();
+  batch.check_matches();
+}
+
+TEST_CASE("chunk stats snappy", "[small]")
+{
+  size_t max_comp_chunk_bytes;
+  size_t temp_bytes;
+  REQUIRE(hipcompBatchedSnappyCompressGetMaxOutputChunkSize(
+      chunk_bytes, hipcompBatchedSnappyDefaultOpts, &max_comp_chunk_bytes) == hipcompSuccess);
+  REQUIRE(hipcompBatchedSnappyCompressGetTempSize(
+      NUM_CHUNKS, chunk_bytes, hipcompBatchedSnappyDefaultOpts, &temp_bytes) == hipcompSuccess);
+
+  StatsBatch batch(max_comp_chunk_bytes, temp_bytes);
+  REQUIRE(hipcompBatchedSnappyCompressWithStatsAsync(
+      batch.d_input_ptrs, batch.d_input_bytes, chunk_bytes, NUM_CHUNKS, batch.d_temp, temp_bytes,
+      batch.d_comp_ptrs, batch.d_comp_bytes, hipcompBatchedSnappyDefaultOpts, batch.d_stats, 0)
+      == hipcompSuccess);
+  HIP_CHECK(hipDeviceSynchronize());
+
+  batch.check_sizes();
+  batch.check_matches();
+}
+
+TEST_CASE("chunk stats cascaded", "[small]")
+{
+  hipcompBatchedCascadedOpts_t options = hipcompBatchedCascadedDefaultOpts;
+  options.type = HIPCOMP_TYPE_CHAR;
+  size_t max_comp_chunk_bytes;
+  size_t temp_bytes;
+  REQUIRE(hipcompBatchedCascadedCompressGetMaxOutputChunkSize(
+      chunk_bytes, options, &max_comp_chunk_bytes) == hipcompSuccess);
+  REQUIRE(hipcompBatchedCascadedCompressGetTempSize(
+      NUM_CHUNKS, chunk_bytes, options, &temp_bytes) == hipcompSuccess);
+
+  StatsBatch batch(max_comp_chunk_bytes, temp_bytes);
+  REQUIRE(hipcompBatchedCascadedCompressWithStatsAsync(
+      batch.d_input_ptrs, batch.d_input_bytes, chunk_bytes, NUM_CHUNKS, batch.d_temp, temp_bytes,
+      batch.d_comp_ptrs, batch.d_comp_bytes, options, batch.d_stats, 0)
+      == hipcompSuccess);
+  HIP_CHECK(hipDeviceSynchronize());
+
+  batch.check_sizes();
+  REQUIRE(batch.d_stats[RUNS].num_RLEs == options.num_RLEs);
+  REQUIRE(batch.d_stats[RUNS].num_deltas == options.num_deltas);
+  REQUIRE(batch.d_stats[RUNS].use_bp == options.use_bp);
+  // Random bytes do not compress, so they are stored without any layers
+  REQUIRE(batch.d_stats[RANDOM].num_RLEs == 0);
+  REQUIRE(batch.d_stats[RANDOM].num_deltas == 0);
+  REQUIRE(batch.d_stats[RANDOM].use_bp == 0);
+  REQUIRE(batch.d_stats[RANDOM].num_matches == 0);
+}
+
+TEST_CASE("chunk stats are optional", "[small]")
+{
+  size_t max_comp_chunk_bytes;
+  size_t temp_bytes;
+  REQUIRE(hipcompBatchedLZ4CompressGetMaxOutputChunkSize(
+      chunk_bytes, hipcompBatchedLZ4DefaultOpts, &max_comp_chunk_bytes) == hipcompSuccess);
+  REQUIRE(hipcompBatchedLZ4CompressGetTempSize(
+      NUM_CHUNKS, chunk_bytes, hipcompBatchedLZ4DefaultOpts, &temp_bytes) == hipcompSuccess);
+
+  StatsBatch batch(max_comp_chunk_bytes, temp_bytes);
+  REQUIRE(hipcompBatchedLZ4CompressWithStatsAsync(
+      batch.d_input_ptrs, batch.d_input_bytes, chunk_bytes, NUM_CHUNKS, batch.d_temp, temp_bytes,
+      batch.d_comp_ptrs, batch.d_comp_bytes, hipcompBatchedLZ4DefaultOpts, nullptr, 0)
+      == hipcompSuccess);
+  HIP_CHECK(hipDeviceSynchronize());
+  for (size_t ix = 0; ix < NUM_CHUNKS; ++ix) {
+    REQUIRE(batch.d_comp_bytes[ix] > 0);
+    REQUIRE(batch.d_stats[ix].uncompressed_bytes == 0);
+  }
+}
@@ -0,0 +1,149 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.hpp"
+#include "hipcomp/lz4.h"
+#include "hipcomp/hipcompCoalescingService.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Test the coalescing service with the LZ4 batched backend //
+
+using namespace std;
+using namespace hipcomp;
+
+#define HIP_CHECK(cond)                                                       \
+  do {                                                                         \
+    hipError_t err = cond;                                                    \
+    REQUIRE(err == hipSuccess);                                               \
+  } while (false)
+
+namespace
+{
+
+std::vector<uint8_t> decompress_lz4_chunk(const void* d_comp, size_t comp_bytes, size_t decomp_bytes, hipStream_t stream)
+{
+  // the arrays are small, so they share one device allocation
+  void** d_ptrs;
+  HIP_CHECK(hipMalloc(&d_ptrs, 2 * sizeof(void*) + 3 * sizeof(size_t)));
+  size_t* d_sizes = reinterpret_cast<size_t*>(d_ptrs + 2);
+
+  uint8_t* d_decomp;
+  HIP_CHECK(hipMalloc(&d_decomp, decomp_bytes));
+  size_t temp_bytes;
+  REQUIRE(hipcompBatchedLZ4DecompressGetTempSize(1, decomp_bytes, &temp_bytes) == hipcompSuccess);
+  void* d_temp;
+  HIP_CHECK(hipMalloc(&d_temp, std::max<size_t>(temp_bytes, 1)));
+  hipcompStatus_t* d_status;
+  HIP_CHECK(hipMalloc(&d_status, sizeof(hipcompStatus_t)));
+
+  const void* h_ptrs[2] = {d_comp, d_decomp};
+  const size_t h_sizes[2] = {comp_bytes, decomp_bytes};
+  HIP_CHECK(hipMemcpy(d_ptrs, h_ptrs, sizeof(h_ptrs), hipMemcpyHostToDevice));
+  HIP_CHECK(hipMemcpy(d_sizes, h_sizes, sizeof(h_sizes), hipMemcpyHostToDevice));
+
+  REQUIRE(hipcompBatchedLZ4DecompressAsync(
+      d_ptrs, d_sizes, d_sizes + 1, d_sizes + 2, 1, d_temp, temp_bytes, d_ptrs + 1, d_status, stream) == hipcompSuccess);
+  HIP_CHECK(hipStreamSynchronize(stream));
+
+  hipcompStatus_t status;
+  HIP_CHECK(hipMemcpy(&status, d_status, sizeof(status), hipMemcpyDeviceToHost));
+  REQUIRE(status == hipcompSuccess);
+
+  std::vector<uint8_t> res(decomp_bytes);
+  HIP_CHECK(hipMemcpy(res.data(), d_decomp, decomp_bytes, hipMemcpyDeviceToHost));
+
+  HIP_CHECK(hipFree(d_ptrs));
+  HIP_CHECK(hipFree(d_decomp));
+  HIP_CHECK(hipFree(d_temp));
+  HIP_CHECK(hipFree(d_status));
+  return res;
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("coalescing service LZ4", "[small]")
+{
+  constexpr size_t num_threads = 4;
+  constexpr size_t requests_per_thread = 50;
+  constexpr size_t num_requests = num_threads * requests_per_thread;
+  constexpr size_t max_chunk_bytes = 1 << 16;
+
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  CoalescingOptions options;
+  options.max_batch_size = 64;
+  CoalescingCompressionService service{
+      create_batched_compress_backend(hipcompBatchedLZ4DefaultOpts, stream, options.max_batch_size, max_chunk_bytes),
+      options};
+
+  std::vector<std::vector<uint8_t>> inputs(num_requests);
+  std::vector<uint8_t*> d_inputs(num_requests);
+  std::vector<uint8_t*> d_outputs(num_requests);
+  for (size_t r = 0; r < num_requests; ++r) {
+    inputs[r].resize(500 + (r * 911) % 8000);
+    for (size_t i = 0; i < inputs[r].size(); ++i) {
+      inputs[r][i] = static_cast<uint8_t>((r + i / 10) % 13);
+    }
+    HIP_CHECK(hipMalloc(&d_inputs[r], inputs[r].size()));
+    HIP_CHECK(hipMemcpy(d_inputs[r], inputs[r].data(), inputs[r].size(), hipMemcpyHostToDevice));
+    HIP_CHECK(hipMalloc(&d_outputs[r], service.get_max_compressed_size(inputs[r].size())));
+  }
+
+  std::vector<size_t> comp_sizes(num_requests);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<std::future<size_t>> futures;
+      for (size_t r = t * requests_per_thread; r < (t + 1) * requests_per_thread; ++r) {
+        futures.push_back(service.submit(d_inputs[r], inputs[r].size(), d_outputs[r]));
+      }
+      for (size_t ix = 0; ix < futures.size(); ++ix) {
+        comp_sizes[t * requests_per_thread + ix] = futures[ix].get();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(service.get_num_launches() < num_requests);
+  for (size_t r = 0; r < num_requests; ++r) {
+    REQUIRE(comp_sizes[r] > 0);
+    REQUIRE(decompress_lz4_chunk(d_outputs[r], comp_sizes[r], inputs[r].size(), stream) == inputs[r]);
+    HIP_CHECK(hipFree(d_inputs[r]));
+    HIP_CHECK(hipFree(d_outputs[r]));
+  }
+
+  HIP_CHECK(hipStreamDestroy(stream));
+}
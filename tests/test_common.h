@@ -52,6 +52,7 @@
 #include "hipcomp.h"
 #include "hipcomp.hpp"
 #include "hipcomp/cascaded.h"
+#include "hipcomp/hipcompManager.hpp"
 
 #include "../src/common.h"
 #include "catch.hpp"
@@ -59,6 +60,7 @@
 #include <vector>
 #include <hip/hip_runtime.h>
 #include <iomanip>
+#include <iostream>
 #include <random>
 
 using namespace hipcomp;
@@ -87,6 +89,137 @@ void random_runs(
   }
 }
 
+/**
+ * @brief Runs of bytes broken up by random bytes, so the data compresses. The data
+ * only depends on the seed, so threads may build it concurrently.
+ */
+inline std::vector<uint8_t> buildData(const size_t size, const int seed = 0)
+{
+  std::vector<uint8_t> input(size);
+  uint32_t state = 2463534242u + seed;
+  for (size_t i = 0; i < size; ++i) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    input[i] = (i / 97) % 7 == 0 ? static_cast<uint8_t>(state) : static_cast<uint8_t>(i / 1000 + seed);
+  }
+  return input;
+}
+
+/**
+ * @brief Decompresses `d_comp` with `manager` and checks the result matches `input`
+ */
+inline void decompressAndCheck(
+    hipcompManagerBase& manager,
+    const uint8_t* d_comp,
+    const std::vector<uint8_t>& input,
+    hipStream_t stream)
+{
+  DecompressionConfig decomp_config = manager.configure_decompression(d_comp);
+  REQUIRE(decomp_config.decomp_data_size == input.size());
+
+  uint8_t* d_decomp;
+  HIP_CHECK(hipMalloc(&d_decomp, input.size() + 1));
+  manager.decompress(d_decomp, d_comp, decomp_config);
+
+  std::vector<uint8_t> output(input.size(), 0xff);
+  HIP_CHECK(hipMemcpyAsync(output.data(), d_decomp, input.size(), hipMemcpyDeviceToHost, stream));
+  HIP_CHECK(hipStreamSynchronize(stream));
+  REQUIRE(*decomp_config.get_status() == hipcompSuccess);
+  REQUIRE(output == input);
+
+  HIP_CHECK(hipFree(d_decomp));
+}
+
+/**
+ * @brief Where the chunks of a ChunkBatch live
+ */
+enum class ChunkMemory
+{
+  Device, ///< hipMalloc, only the device side can access the chunks
+  Managed ///< hipMallocManaged, both the host and the device side can access them
+};
+
+/**
+ * @brief Chunks, their compressed form and the host arrays that describe them for
+ * the batched interfaces. The chunks only depend on the seed.
+ */
+struct ChunkBatch {
+  std::vector<std::vector<uint8_t>> inputs;
+  std::vector<const void*> input_ptrs;
+  std::vector<size_t> input_bytes;
+  std::vector<void*> comp_ptrs;
+  std::vector<size_t> comp_bytes;
+  std::vector<void*> decomp_ptrs;
+  std::vector<size_t> decomp_bytes;
+
+  ChunkBatch(
+      ChunkMemory memory,
+      size_t batch_size,
+      size_t seed,
+      size_t max_chunk_bytes,
+      size_t max_comp_chunk_bytes)
+    : inputs(batch_size),
+      comp_bytes(batch_size),
+      decomp_bytes(batch_size)
+  {
+    for (size_t ix = 0; ix < batch_size; ++ix) {
+      inputs[ix].resize(1000 + ((seed + ix) * 911) % (max_chunk_bytes - 1000));
+      for (size_t i = 0; i < inputs[ix].size(); ++i) {
+        inputs[ix][i] = static_cast<uint8_t>((seed + ix + i / 10) % 13);
+      }
+      void* input = allocate(memory, inputs[ix].size());
+      HIP_CHECK(hipMemcpy(input, inputs[ix].data(), inputs[ix].size(), hipMemcpyDefault));
+      input_ptrs.push_back(input);
+      input_bytes.push_back(inputs[ix].size());
+      comp_ptrs.push_back(allocate(memory, max_comp_chunk_bytes));
+      decomp_ptrs.push_back(allocate(memory, inputs[ix].size()));
+    }
+  }
+
+  ChunkBatch(const ChunkBatch&) = delete;
+  ChunkBatch& operator=(const ChunkBatch&) = delete;
+
+  ~ChunkBatch()
+  {
+    for (size_t ix = 0; ix < input_ptrs.size(); ++ix) {
+      hipFree(const_cast<void*>(input_ptrs[ix]));
+      hipFree(comp_ptrs[ix]);
+      hipFree(decomp_ptrs[ix]);
+    }
+  }
+
+  std::vector<const void*> get_comp_inputs() const
+  {
+    return std::vector<const void*>(comp_ptrs.begin(), comp_ptrs.end());
+  }
+
+  /**
+   * @brief Checks the decompressed chunks match the inputs
+   */
+  void check_decompressed() const
+  {
+    for (size_t ix = 0; ix < inputs.size(); ++ix) {
+      REQUIRE(decomp_bytes[ix] == inputs[ix].size());
+      std::vector<uint8_t> output(inputs[ix].size());
+      HIP_CHECK(hipMemcpy(output.data(), decomp_ptrs[ix], output.size(), hipMemcpyDefault));
+      REQUIRE(output == inputs[ix]);
+    }
+  }
+
+private:
+  static void* allocate(ChunkMemory memory, size_t bytes)
+  {
+    void* ptr;
+    if (memory == ChunkMemory::Managed) {
+      HIP_CHECK(hipMallocManaged(&ptr, bytes));
+    } else {
+      HIP_CHECK(hipMalloc(&ptr, bytes));
+    }
+    return ptr;
+  }
+};
+
 template <typename T>
 void dump(const std::string desc, std::vector<T>& data, size_t size)
 {
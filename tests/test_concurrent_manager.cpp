@@ -0,0 +1,199 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.hpp"
+#include "hipcomp/lz4.hpp"
+#include "hipcomp/hipcompSegmentedManager.hpp"
+
+#include "catch.hpp"
+#include "test_common.h"
+
+#include <thread>
+#include <vector>
+
+// Test using a single manager from several host threads //
+
+using namespace std;
+using namespace hipcomp;
+
+namespace
+{
+
+const size_t chunk_size = 1 << 16;
+const size_t num_threads = 4;
+const int rounds_per_thread = 3;
+
+/**
+ * Compresses and decompresses input with the given manager. Catch assertions are not
+ * thread-safe, so this reports failure through its return value instead.
+ *
+ * If use_stream is false, the calls without a stream argument are used, which run on 
+ * the user stream of the manager.
+ */
+bool roundTrip(
+    hipcompManagerBase& manager, 
+    const std::vector<uint8_t>& input, 
+    hipStream_t stream,
+    const bool use_stream)
+{
+  CompressionConfig comp_config = manager.configure_compression(input.size());
+
+  uint8_t* d_input = nullptr;
+  uint8_t* d_comp = nullptr;
+  uint8_t* d_decomp = nullptr;
+  bool ok = hipMalloc(&d_input, input.size()) == hipSuccess
+      && hipMalloc(&d_comp, comp_config.max_compressed_buffer_size) == hipSuccess
+      && hipMalloc(&d_decomp, input.size()) == hipSuccess
+      && hipMemcpyAsync(d_input, input.data(), input.size(), hipMemcpyHostToDevice, stream) == hipSuccess
+      && hipStreamSynchronize(stream) == hipSuccess;
+
+  std::vector<uint8_t> output(input.size(), 0xff);
+  if (ok) {
+    DecompressionConfig decomp_config = manager.configure_decompression(comp_config);
+    if (use_stream) {
+      manager.compress(d_input, d_comp, comp_config, stream);
+      manager.decompress(d_decomp, d_comp, decomp_config, stream);
+    } else {
+      manager.compress(d_input, d_comp, comp_config);
+      manager.decompress(d_decomp, d_comp, decomp_config);
+    }
+    ok = hipMemcpyAsync(output.data(), d_decomp, input.size(), hipMemcpyDeviceToHost, stream) == hipSuccess
+        && hipStreamSynchronize(stream) == hipSuccess
+        && *comp_config.get_status() == hipcompSuccess
+        && *decomp_config.get_status() == hipcompSuccess
+        && output == input;
+  }
+
+  hipFree(d_decomp);
+  hipFree(d_comp);
+  hipFree(d_input);
+  return ok;
+}
+
+void runThreads(hipcompManagerBase& manager, const std::vector<hipStream_t>& streams, const bool use_stream)
+{
+  std::vector<int> results(num_threads, 0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      bool ok = true;
+      for (int round = 0; round < rounds_per_thread; ++round) {
+        const int seed = static_cast<int>(t) * rounds_per_thread + round;
+        ok = roundTrip(manager, buildData(300000 + seed * 1001, seed), streams[t], use_stream) && ok;
+      }
+      results[t] = ok;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 0; t < num_threads; ++t) {
+    REQUIRE(results[t]);
+  }
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("concurrent calls on separate streams", "[small]")
+{
+  hipStream_t user_stream;
+  HIP_CHECK(hipStreamCreate(&user_stream));
+  std::vector<hipStream_t> streams(num_threads);
+  for (auto& stream : streams) {
+    HIP_CHECK(hipStreamCreate(&stream));
+  }
+
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, user_stream};
+  runThreads(manager, streams, true);
+
+  // Each stream leased a context, which the footprint reports
+  const MemoryFootprint footprint = manager.get_memory_footprint(1 << 20);
+  REQUIRE(footprint.contexts > 0);
+  REQUIRE(footprint.device_bytes() 
+      == footprint.scratch + footprint.ix_chunk + footprint.max_output + footprint.contexts);
+
+  // The contexts are reused by later calls on the same streams
+  runThreads(manager, streams, true);
+  REQUIRE(manager.get_memory_footprint(1 << 20).contexts == footprint.contexts);
+
+  for (auto& stream : streams) {
+    HIP_CHECK(hipStreamDestroy(stream));
+  }
+  HIP_CHECK(hipStreamDestroy(user_stream));
+}
+
+TEST_CASE("concurrent calls on the user stream", "[small]")
+{
+  hipStream_t user_stream;
+  HIP_CHECK(hipStreamCreate(&user_stream));
+  const std::vector<hipStream_t> streams(num_threads, user_stream);
+
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, user_stream};
+  runThreads(manager, streams, false);
+
+  // Calls on the user stream only use the manager's scratch buffer
+  REQUIRE(manager.get_memory_footprint(1 << 20).contexts == 0);
+
+  HIP_CHECK(hipStreamDestroy(user_stream));
+}
+
+TEST_CASE("stream argument matching the user stream", "[small]")
+{
+  hipStream_t user_stream;
+  HIP_CHECK(hipStreamCreate(&user_stream));
+
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, user_stream};
+  REQUIRE(roundTrip(manager, buildData(200000, 1), user_stream, true));
+  REQUIRE(manager.get_memory_footprint(1 << 20).contexts == 0);
+
+  HIP_CHECK(hipStreamDestroy(user_stream));
+}
+
+TEST_CASE("segmented manager rejects other streams", "[small]")
+{
+  hipStream_t user_stream;
+  hipStream_t other_stream;
+  HIP_CHECK(hipStreamCreate(&user_stream));
+  HIP_CHECK(hipStreamCreate(&other_stream));
+
+  SegmentedManager manager{
+      [](hipStream_t stream) {
+        return std::make_shared<LZ4Manager>(chunk_size, HIPCOMP_TYPE_CHAR, stream);
+      },
+      1 << 20, 
+      2, 
+      user_stream};
+
+  const std::vector<uint8_t> input = buildData(3 << 20, 2);
+  REQUIRE_THROWS_AS(roundTrip(manager, input, other_stream, true), HipCompException);
+  REQUIRE(roundTrip(manager, input, user_stream, false));
+
+  HIP_CHECK(hipStreamDestroy(other_stream));
+  HIP_CHECK(hipStreamDestroy(user_stream));
+}
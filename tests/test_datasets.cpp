@@ -0,0 +1,149 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.hpp"
+#include "hipcomp/cascaded.hpp"
+#include "hipcomp/lz4.hpp"
+#include "hipcomp/snappy.hpp"
+
+#include "DatasetGenerator.hpp"
+#include "catch.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Round trips every codec over the synthetic datasets of the benchmarks //
+
+using namespace hipcomp;
+
+#define HIP_CHECK(cond)                                                       \
+  do {                                                                         \
+    hipError_t err = (cond);                                                  \
+    REQUIRE(err == hipSuccess);                                               \
+  } while (false)
+
+/******************************************************************************
+ * HELPER FUNCTIONS ***********************************************************
+ *****************************************************************************/
+
+namespace
+{
+
+const size_t DATASET_BYTES = 1 << 20;
+
+std::vector<std::string> dataset_specs()
+{
+  return {"runs",
+          "runs:2",
+          "sorted",
+          "nearsorted:0.1",
+          "entropy:0",
+          "entropy:3.5",
+          "random",
+          "text",
+          "floats",
+          "noise"};
+}
+
+void test_round_trip(hipcompManagerBase& manager, const std::vector<uint8_t>& input, hipStream_t stream)
+{
+  uint8_t* d_in_data;
+  HIP_CHECK(hipMalloc(&d_in_data, input.size()));
+  HIP_CHECK(hipMemcpy(d_in_data, input.data(), input.size(), hipMemcpyHostToDevice));
+
+  auto comp_config = manager.configure_compression(input.size());
+  uint8_t* d_comp_out;
+  HIP_CHECK(hipMalloc(&d_comp_out, comp_config.max_compressed_buffer_size));
+  manager.compress(d_in_data, d_comp_out, comp_config);
+  HIP_CHECK(hipStreamSynchronize(stream));
+
+  auto decomp_config = manager.configure_decompression(d_comp_out);
+  REQUIRE(decomp_config.decomp_data_size == input.size());
+
+  uint8_t* d_out;
+  HIP_CHECK(hipMalloc(&d_out, input.size()));
+  HIP_CHECK(hipMemset(d_out, 0, input.size()));
+  manager.decompress(d_out, d_comp_out, decomp_config);
+  HIP_CHECK(hipStreamSynchronize(stream));
+
+  std::vector<uint8_t> res(input.size());
+  HIP_CHECK(hipMemcpy(res.data(), d_out, input.size(), hipMemcpyDeviceToHost));
+  REQUIRE(res == input);
+
+  HIP_CHECK(hipFree(d_in_data));
+  HIP_CHECK(hipFree(d_comp_out));
+  HIP_CHECK(hipFree(d_out));
+}
+
+template <typename CreateManager>
+void test_datasets(const hipcompType_t data_type, CreateManager create_manager)
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  for (const std::string& spec : dataset_specs()) {
+    for (const uint64_t seed : {1, 2}) {
+      INFO("dataset " << spec << ", seed " << seed);
+      const std::vector<uint8_t> input = datasets::generate(spec, DATASET_BYTES, data_type, seed);
+      std::unique_ptr<hipcompManagerBase> manager = create_manager(stream);
+      test_round_trip(*manager, input, stream);
+    }
+  }
+
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("datasets lz4", "[small]")
+{
+  for (const hipcompType_t data_type : {HIPCOMP_TYPE_CHAR, HIPCOMP_TYPE_INT}) {
+    test_datasets(data_type, [data_type](hipStream_t stream) {
+      return std::unique_ptr<hipcompManagerBase>(new LZ4Manager(1 << 16, data_type, stream));
+    });
+  }
+}
+
+TEST_CASE("datasets snappy", "[small]")
+{
+  test_datasets(HIPCOMP_TYPE_CHAR, [](hipStream_t stream) {
+    return std::unique_ptr<hipcompManagerBase>(new SnappyManager(1 << 16, stream));
+  });
+}
+
+TEST_CASE("datasets cascaded", "[small]")
+{
+  for (const hipcompType_t data_type : {HIPCOMP_TYPE_CHAR, HIPCOMP_TYPE_INT, HIPCOMP_TYPE_LONGLONG}) {
+    test_datasets(data_type, [data_type](hipStream_t stream) {
+      hipcompBatchedCascadedOpts_t options = hipcompBatchedCascadedDefaultOpts;
+      options.type = data_type;
+      return std::unique_ptr<hipcompManagerBase>(new CascadedManager(options, stream));
+    });
+  }
+}
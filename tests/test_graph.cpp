@@ -0,0 +1,295 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.hpp"
+#include "hipcomp/lz4.h"
+#include "hipcomp/lz4.hpp"
+#include "hipcomp/hipcompGraph.hpp"
+
+#include "catch.hpp"
+#include "test_common.h"
+
+#include <vector>
+
+// Test capturing manager and batched work into graphs //
+
+using namespace std;
+using namespace hipcomp;
+
+namespace
+{
+
+const size_t chunk_size = 1 << 16;
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("graph compress replays on new data", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  const size_t input_size = (1 << 20) + 123;
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, stream};
+  CompressionConfig comp_config = manager.configure_compression(input_size);
+
+  uint8_t* d_input;
+  uint8_t* d_comp;
+  size_t* comp_size;
+  HIP_CHECK(hipMalloc(&d_input, input_size));
+  HIP_CHECK(hipMalloc(&d_comp, comp_config.max_compressed_buffer_size));
+  HIP_CHECK(hipHostMalloc(&comp_size, sizeof(size_t), hipHostMallocDefault));
+
+  CompressGraph graph{manager, stream, comp_config, d_input, d_comp, comp_size};
+
+  for (int round = 0; round < 3; ++round) {
+    const std::vector<uint8_t> input = buildData(input_size, round);
+    HIP_CHECK(hipMemcpyAsync(d_input, input.data(), input_size, hipMemcpyHostToDevice, stream));
+    *comp_size = 0;
+    graph.launch();
+    HIP_CHECK(hipStreamSynchronize(stream));
+
+    REQUIRE(*graph.get_config().get_status() == hipcompSuccess);
+    REQUIRE(*comp_size == manager.get_compressed_output_size(d_comp));
+    REQUIRE(*comp_size <= comp_config.max_compressed_buffer_size);
+    decompressAndCheck(manager, d_comp, input, stream);
+  }
+
+  HIP_CHECK(hipHostFree(comp_size));
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST_CASE("graph compress with new buffers", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  const size_t input_size = 500000;
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, stream};
+  CompressionConfig comp_config = manager.configure_compression(input_size);
+
+  uint8_t* d_input[2];
+  uint8_t* d_comp[2];
+  std::vector<uint8_t> input[2];
+  for (int i = 0; i < 2; ++i) {
+    input[i] = buildData(input_size, 10 + i);
+    HIP_CHECK(hipMalloc(&d_input[i], input_size));
+    HIP_CHECK(hipMalloc(&d_comp[i], comp_config.max_compressed_buffer_size));
+    HIP_CHECK(hipMemcpy(d_input[i], input[i].data(), input_size, hipMemcpyHostToDevice));
+  }
+
+  CompressGraph graph{manager, stream, comp_config, d_input[0], d_comp[0]};
+  graph.launch(d_input[1], d_comp[1]);
+  graph.launch(d_input[0], d_comp[0]);
+  HIP_CHECK(hipStreamSynchronize(stream));
+  REQUIRE(*graph.get_config().get_status() == hipcompSuccess);
+
+  for (int i = 0; i < 2; ++i) {
+    decompressAndCheck(manager, d_comp[i], input[i], stream);
+    HIP_CHECK(hipFree(d_comp[i]));
+    HIP_CHECK(hipFree(d_input[i]));
+  }
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST_CASE("graph decompress", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  const size_t input_size = (2 << 20) + 7;
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, stream};
+  CompressionConfig comp_config = manager.configure_compression(input_size);
+  DecompressionConfig decomp_config = manager.configure_decompression(comp_config);
+
+  uint8_t* d_input;
+  uint8_t* d_comp;
+  uint8_t* d_decomp;
+  HIP_CHECK(hipMalloc(&d_input, input_size));
+  HIP_CHECK(hipMalloc(&d_comp, comp_config.max_compressed_buffer_size));
+  HIP_CHECK(hipMalloc(&d_decomp, input_size));
+
+  CompressGraph comp_graph{manager, stream, comp_config, d_input, d_comp};
+  DecompressGraph decomp_graph{manager, stream, decomp_config, d_decomp, d_comp};
+
+  for (int round = 0; round < 2; ++round) {
+    const std::vector<uint8_t> input = buildData(input_size, 20 + round);
+    HIP_CHECK(hipMemcpyAsync(d_input, input.data(), input_size, hipMemcpyHostToDevice, stream));
+    comp_graph.launch();
+    decomp_graph.launch();
+
+    std::vector<uint8_t> output(input_size, 0xff);
+    HIP_CHECK(hipMemcpyAsync(output.data(), d_decomp, input_size, hipMemcpyDeviceToHost, stream));
+    HIP_CHECK(hipStreamSynchronize(stream));
+    REQUIRE(*comp_graph.get_config().get_status() == hipcompSuccess);
+    REQUIRE(*decomp_graph.get_config().get_status() == hipcompSuccess);
+    REQUIRE(output == input);
+  }
+
+  HIP_CHECK(hipFree(d_decomp));
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST_CASE("graph rejects host reads while capturing", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  const std::vector<uint8_t> input = buildData(100000, 30);
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, stream};
+  CompressionConfig comp_config = manager.configure_compression(input.size());
+
+  uint8_t* d_input;
+  uint8_t* d_comp;
+  HIP_CHECK(hipMalloc(&d_input, input.size()));
+  HIP_CHECK(hipMalloc(&d_comp, comp_config.max_compressed_buffer_size));
+  HIP_CHECK(hipMemcpy(d_input, input.data(), input.size(), hipMemcpyHostToDevice));
+  manager.compress(d_input, d_comp, comp_config);
+  HIP_CHECK(hipStreamSynchronize(stream));
+
+  HIP_CHECK(hipStreamBeginCapture(stream, hipStreamCaptureModeThreadLocal));
+  REQUIRE_THROWS(manager.configure_decompression(d_comp));
+  REQUIRE_THROWS(manager.get_compressed_output_size(d_comp));
+  hipGraph_t graph;
+  HIP_CHECK(hipStreamEndCapture(stream, &graph));
+  HIP_CHECK(hipGraphDestroy(graph));
+
+  // The manager is still usable afterwards
+  decompressAndCheck(manager, d_comp, input, stream);
+
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST_CASE("graph batched lz4", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  const size_t batch_size = 8;
+  const size_t input_size = batch_size * chunk_size;
+
+  size_t comp_temp_bytes;
+  size_t decomp_temp_bytes;
+  size_t max_comp_chunk_bytes;
+  REQUIRE(hipcompBatchedLZ4CompressGetTempSize(
+      batch_size, chunk_size, hipcompBatchedLZ4DefaultOpts, &comp_temp_bytes) == hipcompSuccess);
+  REQUIRE(hipcompBatchedLZ4DecompressGetTempSize(
+      batch_size, chunk_size, &decomp_temp_bytes) == hipcompSuccess);
+  REQUIRE(hipcompBatchedLZ4CompressGetMaxOutputChunkSize(
+      chunk_size, hipcompBatchedLZ4DefaultOpts, &max_comp_chunk_bytes) == hipcompSuccess);
+
+  uint8_t* d_input;
+  uint8_t* d_comp;
+  uint8_t* d_decomp;
+  void* d_comp_temp;
+  void* d_decomp_temp;
+  HIP_CHECK(hipMalloc(&d_input, input_size));
+  HIP_CHECK(hipMalloc(&d_comp, batch_size * max_comp_chunk_bytes));
+  HIP_CHECK(hipMalloc(&d_decomp, input_size));
+  HIP_CHECK(hipMalloc(&d_comp_temp, comp_temp_bytes));
+  HIP_CHECK(hipMalloc(&d_decomp_temp, decomp_temp_bytes));
+
+  std::vector<void*> input_ptrs(batch_size);
+  std::vector<void*> comp_ptrs(batch_size);
+  std::vector<void*> decomp_ptrs(batch_size);
+  std::vector<size_t> chunk_bytes(batch_size, chunk_size);
+  for (size_t i = 0; i < batch_size; ++i) {
+    input_ptrs[i] = d_input + i * chunk_size;
+    comp_ptrs[i] = d_comp + i * max_comp_chunk_bytes;
+    decomp_ptrs[i] = d_decomp + i * chunk_size;
+  }
+
+  void** d_input_ptrs;
+  void** d_comp_ptrs;
+  void** d_decomp_ptrs;
+  size_t* d_chunk_bytes;
+  size_t* d_comp_bytes;
+  size_t* d_decomp_bytes;
+  hipcompStatus_t* d_statuses;
+  HIP_CHECK(hipMalloc(&d_input_ptrs, batch_size * sizeof(void*)));
+  HIP_CHECK(hipMalloc(&d_comp_ptrs, batch_size * sizeof(void*)));
+  HIP_CHECK(hipMalloc(&d_decomp_ptrs, batch_size * sizeof(void*)));
+  HIP_CHECK(hipMalloc(&d_chunk_bytes, batch_size * sizeof(size_t)));
+  HIP_CHECK(hipMalloc(&d_comp_bytes, batch_size * sizeof(size_t)));
+  HIP_CHECK(hipMalloc(&d_decomp_bytes, batch_size * sizeof(size_t)));
+  HIP_CHECK(hipMalloc(&d_statuses, batch_size * sizeof(hipcompStatus_t)));
+  HIP_CHECK(hipMemcpy(d_input_ptrs, input_ptrs.data(), batch_size * sizeof(void*), hipMemcpyHostToDevice));
+  HIP_CHECK(hipMemcpy(d_comp_ptrs, comp_ptrs.data(), batch_size * sizeof(void*), hipMemcpyHostToDevice));
+  HIP_CHECK(hipMemcpy(d_decomp_ptrs, decomp_ptrs.data(), batch_size * sizeof(void*), hipMemcpyHostToDevice));
+  HIP_CHECK(hipMemcpy(d_chunk_bytes, chunk_bytes.data(), batch_size * sizeof(size_t), hipMemcpyHostToDevice));
+
+  // The batched APIs issue no synchronization or allocation, so they can be captured directly
+  hipGraph_t graph;
+  hipGraphExec_t exec;
+  HIP_CHECK(hipStreamBeginCapture(stream, hipStreamCaptureModeThreadLocal));
+  REQUIRE(hipcompBatchedLZ4CompressAsync(
+      d_input_ptrs, d_chunk_bytes, chunk_size, batch_size, d_comp_temp, comp_temp_bytes,
+      d_comp_ptrs, d_comp_bytes, hipcompBatchedLZ4DefaultOpts, stream) == hipcompSuccess);
+  REQUIRE(hipcompBatchedLZ4DecompressAsync(
+      d_comp_ptrs, d_comp_bytes, d_chunk_bytes, d_decomp_bytes, batch_size, d_decomp_temp,
+      decomp_temp_bytes, d_decomp_ptrs, d_statuses, stream) == hipcompSuccess);
+  HIP_CHECK(hipStreamEndCapture(stream, &graph));
+  HIP_CHECK(hipGraphInstantiate(&exec, graph, nullptr, nullptr, 0));
+
+  for (int round = 0; round < 2; ++round) {
+    const std::vector<uint8_t> input = buildData(input_size, 40 + round);
+    HIP_CHECK(hipMemcpyAsync(d_input, input.data(), input_size, hipMemcpyHostToDevice, stream));
+    HIP_CHECK(hipGraphLaunch(exec, stream));
+
+    std::vector<uint8_t> output(input_size, 0xff);
+    std::vector<hipcompStatus_t> statuses(batch_size, hipcompErrorInternal);
+    HIP_CHECK(hipMemcpyAsync(output.data(), d_decomp, input_size, hipMemcpyDeviceToHost, stream));
+    HIP_CHECK(hipMemcpyAsync(statuses.data(), d_statuses, batch_size * sizeof(hipcompStatus_t), hipMemcpyDeviceToHost, stream));
+    HIP_CHECK(hipStreamSynchronize(stream));
+    for (size_t i = 0; i < batch_size; ++i) {
+      REQUIRE(statuses[i] == hipcompSuccess);
+    }
+    REQUIRE(output == input);
+  }
+
+  HIP_CHECK(hipGraphExecDestroy(exec));
+  HIP_CHECK(hipGraphDestroy(graph));
+  HIP_CHECK(hipFree(d_statuses));
+  HIP_CHECK(hipFree(d_decomp_bytes));
+  HIP_CHECK(hipFree(d_comp_bytes));
+  HIP_CHECK(hipFree(d_chunk_bytes));
+  HIP_CHECK(hipFree(d_decomp_ptrs));
+  HIP_CHECK(hipFree(d_comp_ptrs));
+  HIP_CHECK(hipFree(d_input_ptrs));
+  HIP_CHECK(hipFree(d_decomp_temp));
+  HIP_CHECK(hipFree(d_comp_temp));
+  HIP_CHECK(hipFree(d_decomp));
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
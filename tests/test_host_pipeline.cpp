@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.hpp"
+#include "hipcomp/lz4.hpp"
+#include "hipcomp/hipcompHostPipeline.hpp"
+
+#include "catch.hpp"
+#include "test_common.h"
+
+#include <vector>
+
+// Test host buffer compression through the staging pipeline //
+
+using namespace std;
+using namespace hipcomp;
+
+namespace
+{
+
+void test_host_pipeline(
+    const size_t input_size,
+    const size_t slice_size,
+    const size_t num_slots)
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  const size_t chunk_size = 1 << 16;
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, stream};
+  HostPipeline pipeline{manager, stream, slice_size, num_slots};
+
+  const std::vector<uint8_t> input = buildData(input_size);
+
+  std::vector<uint8_t> comp(pipeline.get_max_compressed_size(input_size));
+  const size_t comp_size = pipeline.compress(input.data(), input.size(), comp.data());
+  REQUIRE(comp_size <= comp.size());
+
+  REQUIRE(pipeline.get_decompressed_size(comp.data(), comp_size) == input_size);
+
+  std::vector<uint8_t> output(input_size, 0xff);
+  pipeline.decompress(output.data(), comp.data(), comp_size);
+  REQUIRE(output == input);
+
+  // The second round reuses the staging buffers
+  std::vector<uint8_t> comp2(comp.size());
+  REQUIRE(pipeline.compress(input.data(), input.size(), comp2.data()) == comp_size);
+  std::vector<uint8_t> output2(input_size, 0xff);
+  pipeline.decompress(output2.data(), comp2.data(), comp_size);
+  REQUIRE(output2 == input);
+
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("host pipeline single slice", "[small]")
+{
+  test_host_pipeline(100000, 1 << 20, 3);
+}
+
+TEST_CASE("host pipeline many slices", "[small]")
+{
+  test_host_pipeline((10 << 20) + 12345, 1 << 20, 3);
+}
+
+TEST_CASE("host pipeline double buffered", "[small]")
+{
+  test_host_pipeline((5 << 20) + 1, 1 << 19, 2);
+}
+
+TEST_CASE("host pipeline single slot", "[small]")
+{
+  test_host_pipeline(3 << 20, 1 << 20, 1);
+}
+
+TEST_CASE("host pipeline empty input", "[small]")
+{
+  test_host_pipeline(0, 1 << 20, 3);
+}
+
+TEST_CASE("host pipeline rejects truncated input", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+  LZ4Manager manager{1 << 16, HIPCOMP_TYPE_CHAR, stream};
+  HostPipeline pipeline{manager, stream, 1 << 20, 3};
+
+  const std::vector<uint8_t> input = buildData(1 << 21);
+  std::vector<uint8_t> comp(pipeline.get_max_compressed_size(input.size()));
+  const size_t comp_size = pipeline.compress(input.data(), input.size(), comp.data());
+
+  REQUIRE_THROWS(pipeline.get_decompressed_size(comp.data(), comp_size - 1));
+
+  HIP_CHECK(hipStreamDestroy(stream));
+}
@@ -0,0 +1,106 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.hpp"
+#include "hipcomp/lz4.h"
+#include "hipcomp/hipcompHybridBackend.hpp"
+
+#include "catch.hpp"
+#include "test_common.h"
+
+#include <algorithm>
+#include <vector>
+
+// Test the hybrid backend and LZ4 interchange between the host and the device //
+
+using namespace std;
+using namespace hipcomp;
+
+namespace
+{
+
+constexpr size_t max_chunk_bytes = 1 << 16;
+
+void compress(ChunkBatch& batch, BatchedCompressBackend& backend)
+{
+  backend.compress_batch(batch.input_ptrs.data(), batch.input_bytes.data(),
+      *std::max_element(batch.input_bytes.begin(), batch.input_bytes.end()), batch.inputs.size(),
+      batch.comp_ptrs.data(), batch.comp_bytes.data());
+}
+
+void decompress_and_check(ChunkBatch& batch, BatchedCompressBackend& backend)
+{
+  const std::vector<const void*> comp_inputs = batch.get_comp_inputs();
+  backend.decompress_batch(comp_inputs.data(), batch.comp_bytes.data(), batch.input_bytes.data(), batch.inputs.size(),
+      batch.decomp_ptrs.data(), batch.decomp_bytes.data());
+  batch.check_decompressed();
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("LZ4 host and device interchange", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  {
+    auto host = create_host_lz4_backend(64, max_chunk_bytes);
+    auto device = create_batched_compress_backend(hipcompBatchedLZ4DefaultOpts, stream, 64, max_chunk_bytes);
+    REQUIRE(host->get_max_compressed_chunk_size(max_chunk_bytes) 
+        == device->get_max_compressed_chunk_size(max_chunk_bytes));
+
+    ChunkBatch batch(ChunkMemory::Managed, 64, 0, max_chunk_bytes, host->get_max_compressed_chunk_size(max_chunk_bytes));
+    compress(batch, *host);
+    decompress_and_check(batch, *device);
+
+    compress(batch, *device);
+    decompress_and_check(batch, *host);
+  }
+
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST_CASE("hybrid LZ4 backend", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  {
+    auto backend = create_hybrid_lz4_backend(hipcompBatchedLZ4DefaultOpts, stream, 128, max_chunk_bytes);
+    ChunkBatch batch(
+        ChunkMemory::Managed, 128, 0, max_chunk_bytes, backend->get_max_compressed_chunk_size(max_chunk_bytes));
+    for (int i = 0; i < 4; ++i) {
+      compress(batch, *backend);
+      decompress_and_check(batch, *backend);
+    }
+    REQUIRE(backend->get_compress_device_share() > 0.0);
+    REQUIRE(backend->get_compress_device_share() < 1.0);
+  }
+
+  HIP_CHECK(hipStreamDestroy(stream));
+}
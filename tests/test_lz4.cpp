@@ -155,6 +155,60 @@ void test_lz4(const std::vector<T>& input, hipcompType_t data_type, const size_t
   hipFree(out_ptr);
 }
 
+template <typename T>
+void test_lz4_in_place(const std::vector<T>& input, hipcompType_t data_type, const size_t chunk_size = 1 << 16)
+{
+  T* d_in_data;
+  const size_t in_bytes = sizeof(T) * input.size();
+  HIP_CHECK(hipMalloc((void**)&d_in_data, in_bytes));
+  HIP_CHECK(
+      hipMemcpy(d_in_data, input.data(), in_bytes, hipMemcpyHostToDevice));
+
+  hipStream_t stream;
+  hipStreamCreate(&stream);
+
+  LZ4Manager manager{chunk_size, data_type, stream};
+  auto comp_config = manager.configure_compression(in_bytes);
+  comp_config.in_place_decompressible = true;
+
+  uint8_t* d_comp_out;
+  HIP_CHECK(hipMalloc(&d_comp_out, comp_config.max_compressed_buffer_size));
+
+  manager.compress(
+      reinterpret_cast<const uint8_t*>(d_in_data),
+      d_comp_out,
+      comp_config);
+  HIP_CHECK(hipStreamSynchronize(stream));
+
+  size_t comp_out_bytes = manager.get_compressed_output_size(d_comp_out);
+  hipFree(d_in_data);
+
+  // Move the compressed data to the end of a buffer that fits the output plus the margin
+  const size_t buffer_size = in_bytes + manager.get_in_place_decompression_margin(in_bytes);
+  REQUIRE(comp_out_bytes <= buffer_size);
+
+  uint8_t* d_buffer;
+  HIP_CHECK(hipMalloc(&d_buffer, buffer_size));
+  HIP_CHECK(hipMemset(d_buffer, 0, buffer_size));
+  uint8_t* d_comp_in_place = d_buffer + buffer_size - comp_out_bytes;
+  HIP_CHECK(
+      hipMemcpy(d_comp_in_place, d_comp_out, comp_out_bytes, hipMemcpyDeviceToDevice));
+  hipFree(d_comp_out);
+
+  auto decomp_config = manager.configure_decompression(d_comp_in_place);
+  manager.decompress_in_place(d_buffer, d_comp_in_place, decomp_config);
+  HIP_CHECK(hipStreamSynchronize(stream));
+  REQUIRE(*decomp_config.get_status() == hipcompSuccess);
+
+  std::vector<T> res(input.size());
+  hipMemcpy(
+      &res[0], d_buffer, input.size() * sizeof(T), hipMemcpyDeviceToHost);
+
+  REQUIRE(res == input);
+
+  hipFree(d_buffer);
+}
+
 } // namespace
 
 /******************************************************************************
@@ -277,4 +331,139 @@ TEST_CASE("comp/decomp LZ4-none-aligned-sizes", "[hipcomp][small]")
       test_lz4(input, type);
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("comp/decomp LZ4-in-place", "[hipcomp][small]")
+{
+  using T = uint8_t;
+
+  for (size_t num = 1; num < 1 << 18; num = num * 2 + 1) {
+    std::vector<T> input = buildRuns<T>(num, 3);
+    test_lz4_in_place(input, HIPCOMP_TYPE_UCHAR);
+  }
+}
+
+TEST_CASE("comp/decomp LZ4-in-place-incompressible", "[hipcomp][small]")
+{
+  using T = uint8_t;
+
+  std::vector<T> input(1 << 20);
+  uint32_t state = 12345;
+  for (T& val : input) {
+    state = state * 1103515245 + 12345;
+    val = static_cast<T>(state >> 16);
+  }
+
+  test_lz4_in_place(input, HIPCOMP_TYPE_UCHAR, 32768);
+}
+
+TEST_CASE("comp/decomp LZ4-async-output-size", "[hipcomp][small]")
+{
+  const std::vector<uint8_t> input = buildRuns<uint8_t>(1000, 300);
+  const size_t in_bytes = input.size();
+
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+  hipEvent_t event;
+  HIP_CHECK(hipEventCreate(&event));
+
+  uint8_t* d_in_data;
+  HIP_CHECK(hipMalloc(&d_in_data, in_bytes));
+  HIP_CHECK(hipMemcpy(d_in_data, input.data(), in_bytes, hipMemcpyHostToDevice));
+
+  LZ4Manager manager{1 << 16, HIPCOMP_TYPE_CHAR, stream};
+  auto comp_config = manager.configure_compression(in_bytes);
+
+  uint8_t* d_comp_out;
+  HIP_CHECK(hipMalloc(&d_comp_out, comp_config.max_compressed_buffer_size));
+
+  size_t* d_comp_size;
+  HIP_CHECK(hipMalloc(&d_comp_size, sizeof(size_t)));
+  size_t* h_comp_size;
+  HIP_CHECK(hipHostMalloc(&h_comp_size, sizeof(size_t), hipHostMallocDefault));
+  *h_comp_size = 0;
+
+  manager.compress(d_in_data, d_comp_out, comp_config);
+  manager.get_compressed_output_size_async(d_comp_out, d_comp_size);
+  manager.get_compressed_output_size_async(d_comp_out, h_comp_size, event);
+
+  // Only the event is waited on, the stream itself is never synchronized
+  HIP_CHECK(hipEventSynchronize(event));
+  REQUIRE(*comp_config.get_status() == hipcompSuccess);
+
+  size_t comp_size_from_device = 0;
+  HIP_CHECK(hipMemcpy(&comp_size_from_device, d_comp_size, sizeof(size_t), hipMemcpyDeviceToHost));
+
+  const size_t comp_size = manager.get_compressed_output_size(d_comp_out);
+  REQUIRE(*h_comp_size == comp_size);
+  REQUIRE(comp_size_from_device == comp_size);
+  REQUIRE(comp_size <= comp_config.max_compressed_buffer_size);
+
+  HIP_CHECK(hipFree(d_in_data));
+  HIP_CHECK(hipFree(d_comp_out));
+  HIP_CHECK(hipFree(d_comp_size));
+  HIP_CHECK(hipHostFree(h_comp_size));
+  HIP_CHECK(hipEventDestroy(event));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST_CASE("LZ4-memory-footprint", "[hipcomp][small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  const size_t chunk_size = 1 << 16;
+  const size_t in_bytes = 10 * chunk_size + 123;
+  LZ4Manager manager{chunk_size, HIPCOMP_TYPE_CHAR, stream};
+  const size_t max_comp_size = manager.configure_compression(in_bytes).max_compressed_buffer_size;
+
+  const MemoryFootprint single = manager.get_memory_footprint(in_bytes);
+  REQUIRE(single.scratch == manager.get_required_scratch_buffer_size());
+  REQUIRE(single.ix_chunk > 0);
+  REQUIRE(single.temp == 0);
+  REQUIRE(single.max_output == max_comp_size);
+  REQUIRE(single.status_pool > 0);
+  REQUIRE(single.headers > 0);
+  REQUIRE(single.device_bytes() == single.scratch + single.ix_chunk + max_comp_size);
+
+  // scratch and headers are shared by the whole batch
+  const MemoryFootprint batch = manager.get_memory_footprint(in_bytes, 64);
+  REQUIRE(batch.scratch == single.scratch);
+  REQUIRE(batch.headers == single.headers);
+  REQUIRE(batch.max_output == 64 * max_comp_size);
+  REQUIRE(batch.status_pool >= 64 * sizeof(hipcompStatus_t));
+  REQUIRE(batch.pageable_bytes() == 64 * single.pageable_bytes());
+
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST_CASE("LZ4-kernel-resource-usage", "[hipcomp][small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  int num_cus = 0;
+  HIP_CHECK(hipDeviceGetAttribute(&num_cus, hipDeviceAttributeMultiprocessorCount, 0));
+
+  LZ4Manager manager{1 << 16, HIPCOMP_TYPE_CHAR, stream};
+  const std::vector<KernelResourceUsage> usage = manager.get_kernel_resource_usage();
+  REQUIRE(usage.size() == 2);
+  REQUIRE(usage[0].kernel == "lz4_compress");
+  REQUIRE(usage[1].kernel == "lz4_decompress");
+  for (const KernelResourceUsage& kernel : usage) {
+    REQUIRE(kernel.device_id == 0);
+    REQUIRE(kernel.block_size > 0);
+    REQUIRE(kernel.registers_per_thread > 0);
+    REQUIRE(kernel.num_cus == static_cast<uint32_t>(num_cus));
+    REQUIRE(kernel.ctas_per_cu > 0);
+    // The HLIF kernels launch as many CTAs as fit on the device
+    REQUIRE(kernel.grid_size == kernel.num_cus * kernel.ctas_per_cu);
+    REQUIRE(kernel.device_fraction() == 1.0);
+    REQUIRE(kernel.occupancy > 0.0);
+    REQUIRE(kernel.occupancy <= 1.0);
+  }
+  // The decompression kernel stages its input in LDS
+  REQUIRE(usage[1].dynamic_lds_bytes > 0);
+
+  HIP_CHECK(hipStreamDestroy(stream));
+}
@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.hpp"
+#include "hipcomp/lz4.h"
+#include "hipcomp/snappy.h"
+#include "hipcomp/hipcompPriorityScheduler.hpp"
+
+#include "catch.hpp"
+#include "test_common.h"
+
+#include <vector>
+
+// Test the priority scheduler with the batched device backends //
+
+using namespace std;
+using namespace hipcomp;
+
+namespace
+{
+
+constexpr size_t max_chunk_bytes = 1 << 16;
+
+void round_trip(ChunkBatch& batch, PriorityBatchScheduler& scheduler, SchedulePriority priority)
+{
+  scheduler.submit_compress(
+      priority, batch.input_ptrs.data(), batch.input_bytes.data(), batch.inputs.size(),
+      batch.comp_ptrs.data(), batch.comp_bytes.data()).get();
+  const std::vector<const void*> comp_inputs = batch.get_comp_inputs();
+  scheduler.submit_decompress(
+      priority, comp_inputs.data(), batch.comp_bytes.data(), batch.input_bytes.data(), batch.inputs.size(),
+      batch.decomp_ptrs.data(), batch.decomp_bytes.data()).get();
+  batch.check_decompressed();
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("priority scheduler LZ4", "[small]")
+{
+  PrioritySchedulerOptions options;
+  options.throughput_slice_chunks = 32;
+  auto scheduler = create_priority_batch_scheduler(hipcompBatchedLZ4DefaultOpts, 256, max_chunk_bytes, options);
+
+  size_t max_comp_chunk_bytes;
+  REQUIRE(hipcompBatchedLZ4CompressGetMaxOutputChunkSize(
+      max_chunk_bytes, hipcompBatchedLZ4DefaultOpts, &max_comp_chunk_bytes) == hipcompSuccess);
+
+  ChunkBatch bulk(ChunkMemory::Device, 200, 0, max_chunk_bytes, max_comp_chunk_bytes);
+  ChunkBatch interactive(ChunkMemory::Device, 8, 1, max_chunk_bytes, max_comp_chunk_bytes);
+  round_trip(bulk, *scheduler, SchedulePriority::Throughput);
+  round_trip(interactive, *scheduler, SchedulePriority::Latency);
+
+  // 7 slices for each direction of the bulk batch, one launch each for the interactive one
+  REQUIRE(scheduler->get_num_launches(SchedulePriority::Throughput) == 14);
+  REQUIRE(scheduler->get_num_launches(SchedulePriority::Latency) == 2);
+}
+
+TEST_CASE("priority scheduler Snappy", "[small]")
+{
+  auto scheduler = create_priority_batch_scheduler(hipcompBatchedSnappyDefaultOpts, 64, max_chunk_bytes);
+
+  size_t max_comp_chunk_bytes;
+  REQUIRE(hipcompBatchedSnappyCompressGetMaxOutputChunkSize(
+      max_chunk_bytes, hipcompBatchedSnappyDefaultOpts, &max_comp_chunk_bytes) == hipcompSuccess);
+
+  ChunkBatch interactive(ChunkMemory::Device, 20, 2, max_chunk_bytes, max_comp_chunk_bytes);
+  round_trip(interactive, *scheduler, SchedulePriority::Latency);
+}
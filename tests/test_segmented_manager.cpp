@@ -0,0 +1,168 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.hpp"
+#include "hipcomp/lz4.hpp"
+#include "hipcomp/hipcompManagerFactory.hpp"
+#include "hipcomp/hipcompSegmentedManager.hpp"
+
+#include "catch.hpp"
+#include "test_common.h"
+
+#include <vector>
+
+// Test compression of large buffers split into segments across streams //
+
+using namespace std;
+using namespace hipcomp;
+
+namespace
+{
+
+const size_t chunk_size = 1 << 16;
+
+SegmentManagerFactory lz4Factory()
+{
+  return [](hipStream_t stream) {
+    return std::make_shared<LZ4Manager>(chunk_size, HIPCOMP_TYPE_CHAR, stream);
+  };
+}
+
+void test_segmented(
+    const size_t input_size,
+    const size_t segment_size,
+    const size_t num_streams,
+    const bool pinned_output)
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  SegmentedManager manager{lz4Factory(), segment_size, num_streams, stream};
+
+  const std::vector<uint8_t> input = buildData(input_size);
+  uint8_t* d_input;
+  HIP_CHECK(hipMalloc(&d_input, input_size + 1));
+  HIP_CHECK(hipMemcpy(d_input, input.data(), input_size, hipMemcpyHostToDevice));
+
+  CompressionConfig comp_config = manager.configure_compression(input_size);
+  REQUIRE(comp_config.num_chunks == (input_size + segment_size - 1) / segment_size);
+
+  uint8_t* comp;
+  if (pinned_output) {
+    HIP_CHECK(hipHostMalloc(&comp, comp_config.max_compressed_buffer_size, hipHostMallocDefault));
+  } else {
+    HIP_CHECK(hipMalloc(&comp, comp_config.max_compressed_buffer_size));
+  }
+
+  // Compress twice to reuse the staging slots
+  for (int round = 0; round < 2; ++round) {
+    manager.compress(d_input, comp, comp_config);
+    HIP_CHECK(hipStreamSynchronize(stream));
+    REQUIRE(*comp_config.get_status() == hipcompSuccess);
+  }
+
+  const size_t comp_size = manager.get_compressed_output_size(comp);
+  REQUIRE(comp_size <= comp_config.max_compressed_buffer_size);
+
+  decompressAndCheck(manager, comp, input, stream);
+
+  // The container names its format, so the factory can rebuild a manager for it
+  if (input_size > 0) {
+    auto factory_manager = create_manager(comp, stream);
+    decompressAndCheck(*factory_manager, comp, input, stream);
+  }
+
+  if (pinned_output) {
+    HIP_CHECK(hipHostFree(comp));
+  } else {
+    HIP_CHECK(hipFree(comp));
+  }
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("segmented single segment", "[small]")
+{
+  test_segmented(100000, 1 << 20, 4, false);
+}
+
+TEST_CASE("segmented many segments", "[small]")
+{
+  test_segmented((10 << 20) + 12345, 1 << 20, 4, false);
+}
+
+TEST_CASE("segmented more segments than streams", "[small]")
+{
+  test_segmented((6 << 20) + 1, 1 << 19, 2, false);
+}
+
+TEST_CASE("segmented single stream", "[small]")
+{
+  test_segmented(3 << 20, 1 << 20, 1, false);
+}
+
+TEST_CASE("segmented pinned host output", "[small]")
+{
+  test_segmented((4 << 20) + 777, 1 << 20, 3, true);
+}
+
+TEST_CASE("segmented empty input", "[small]")
+{
+  test_segmented(0, 1 << 20, 4, false);
+}
+
+TEST_CASE("segmented rejects a different segment size", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  SegmentedManager manager{lz4Factory(), 1 << 20, 2, stream};
+  SegmentedManager other{lz4Factory(), 1 << 19, 2, stream};
+
+  const std::vector<uint8_t> input = buildData(3 << 20);
+  uint8_t* d_input;
+  HIP_CHECK(hipMalloc(&d_input, input.size()));
+  HIP_CHECK(hipMemcpy(d_input, input.data(), input.size(), hipMemcpyHostToDevice));
+
+  CompressionConfig comp_config = manager.configure_compression(input.size());
+  uint8_t* d_comp;
+  HIP_CHECK(hipMalloc(&d_comp, comp_config.max_compressed_buffer_size));
+  manager.compress(d_input, d_comp, comp_config);
+
+  uint8_t* d_decomp;
+  HIP_CHECK(hipMalloc(&d_decomp, input.size()));
+  DecompressionConfig decomp_config = other.configure_decompression(d_comp);
+  REQUIRE_THROWS(other.decompress(d_decomp, d_comp, decomp_config));
+
+  HIP_CHECK(hipFree(d_decomp));
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
@@ -0,0 +1,180 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.hpp"
+#include "hipcomp/lz4.hpp"
+#include "hipcomp/snappy.hpp"
+#include "hipcomp/hipcompManagerFactory.hpp"
+#include "hipcomp/hipcompShardedManager.hpp"
+
+#include "catch.hpp"
+#include "test_common.h"
+
+#include <vector>
+
+// Test compression of a buffer sharded across devices //
+
+using namespace std;
+using namespace hipcomp;
+
+namespace
+{
+
+const size_t chunk_size = 1 << 16;
+
+ShardManagerFactory lz4Factory()
+{
+  return [](hipStream_t stream, int device_id) {
+    return std::make_shared<LZ4Manager>(chunk_size, HIPCOMP_TYPE_CHAR, stream, device_id);
+  };
+}
+
+void test_sharded(
+    const ShardManagerFactory& factory,
+    const size_t input_size,
+    const std::vector<int>& shard_device_ids)
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  ShardedManager manager{factory, chunk_size, shard_device_ids, stream};
+
+  const std::vector<uint8_t> input = buildData(input_size);
+  uint8_t* d_input;
+  HIP_CHECK(hipMalloc(&d_input, input_size + 1));
+  HIP_CHECK(hipMemcpy(d_input, input.data(), input_size, hipMemcpyHostToDevice));
+
+  CompressionConfig comp_config = manager.configure_compression(input_size);
+  uint8_t* d_comp;
+  HIP_CHECK(hipMalloc(&d_comp, comp_config.max_compressed_buffer_size));
+
+  // Compress twice to reuse the shard containers
+  for (int round = 0; round < 2; ++round) {
+    manager.compress(d_input, d_comp, comp_config);
+    HIP_CHECK(hipStreamSynchronize(stream));
+    REQUIRE(*comp_config.get_status() == hipcompSuccess);
+  }
+  REQUIRE(manager.get_compressed_output_size(d_comp) <= comp_config.max_compressed_buffer_size);
+
+  decompressAndCheck(manager, d_comp, input, stream);
+
+  // The unified container is a regular container of the shard format
+  if (input_size > 0) {
+    auto single_manager = create_manager(d_comp, stream);
+    decompressAndCheck(*single_manager, d_comp, input, stream);
+  }
+
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+std::vector<int> allDevices()
+{
+  int num_devices = 0;
+  HIP_CHECK(hipGetDeviceCount(&num_devices));
+  std::vector<int> device_ids;
+  for (int device_id = 0; device_id < num_devices; ++device_id) {
+    int can_access = 1;
+    if (device_id != 0) {
+      HIP_CHECK(hipDeviceCanAccessPeer(&can_access, 0, device_id));
+    }
+    if (can_access) {
+      device_ids.push_back(device_id);
+    }
+  }
+  return device_ids;
+}
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("sharded single shard", "[small]")
+{
+  test_sharded(lz4Factory(), (3 << 20) + 17, {0});
+}
+
+TEST_CASE("sharded shards on one device", "[small]")
+{
+  test_sharded(lz4Factory(), (10 << 20) + 12345, {0, 0, 0});
+}
+
+TEST_CASE("sharded more shards than chunks", "[small]")
+{
+  test_sharded(lz4Factory(), 2 * chunk_size + 5, {0, 0, 0, 0});
+}
+
+TEST_CASE("sharded empty input", "[small]")
+{
+  test_sharded(lz4Factory(), 0, {0, 0});
+}
+
+TEST_CASE("sharded snappy", "[small]")
+{
+  test_sharded(
+      [](hipStream_t stream, int device_id) {
+        return std::make_shared<SnappyManager>(chunk_size, stream, device_id);
+      },
+      (5 << 20) + 3, 
+      {0, 0});
+}
+
+TEST_CASE("sharded all devices", "[small]")
+{
+  test_sharded(lz4Factory(), (16 << 20) + 999, allDevices());
+}
+
+TEST_CASE("sharded decompresses a single manager container", "[small]")
+{
+  hipStream_t stream;
+  HIP_CHECK(hipStreamCreate(&stream));
+
+  LZ4Manager single_manager{chunk_size, HIPCOMP_TYPE_CHAR, stream};
+  ShardedManager manager{lz4Factory(), chunk_size, {0, 0}, stream};
+
+  const std::vector<uint8_t> input = buildData((4 << 20) + 100);
+  uint8_t* d_input;
+  HIP_CHECK(hipMalloc(&d_input, input.size()));
+  HIP_CHECK(hipMemcpy(d_input, input.data(), input.size(), hipMemcpyHostToDevice));
+
+  CompressionConfig comp_config = single_manager.configure_compression(input.size());
+  uint8_t* d_comp;
+  HIP_CHECK(hipMalloc(&d_comp, comp_config.max_compressed_buffer_size));
+  single_manager.compress(d_input, d_comp, comp_config);
+  HIP_CHECK(hipStreamSynchronize(stream));
+
+  decompressAndCheck(manager, d_comp, input, stream);
+
+  HIP_CHECK(hipFree(d_comp));
+  HIP_CHECK(hipFree(d_input));
+  HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST_CASE("sharded rejects a mismatched chunk size", "[small]")
+{
+  REQUIRE_THROWS(ShardedManager(lz4Factory(), chunk_size / 2, {0}));
+}
@@ -0,0 +1,210 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#define CATCH_CONFIG_MAIN
+
+#include "hipcomp.h"
+#include "hipcomp/snappy.h"
+
+#include "DatasetGenerator.hpp"
+#include "catch.hpp"
+
+#include <algorithm>
+#include <vector>
+
+// Test the profile of the stages of the batched Snappy decompression //
+
+#define HIP_CHECK(cond)                                                       \
+  do {                                                                         \
+    hipError_t err = (cond);                                                  \
+    REQUIRE(err == hipSuccess);                                               \
+  } while (false)
+
+/******************************************************************************
+ * HELPER FUNCTIONS ***********************************************************
+ *****************************************************************************/
+
+namespace
+{
+
+const size_t chunk_bytes = 1 << 16;
+
+const char* const chunk_datasets[] = {"runs:64", "random", "text", "entropy:4"};
+const size_t num_chunks = sizeof(chunk_datasets) / sizeof(chunk_datasets[0]);
+
+/**
+ * A batch of chunks from the dataset generators, compressed with Snappy, in
+ * managed memory, with room for the decompressed chunks and their profiles
+ */
+struct ProfileBatch {
+  std::vector<std::vector<uint8_t>> inputs;
+  void** d_comp_ptrs;
+  size_t* d_comp_bytes;
+  void** d_decomp_ptrs;
+  size_t* d_decomp_bytes;
+  size_t* d_actual_bytes;
+  hipcompStatus_t* d_statuses;
+  hipcompSnappyDecompressProfile_t* d_profiles;
+  void* d_temp;
+  size_t temp_bytes;
+
+  ProfileBatch()
+  {
+    for (size_t ix = 0; ix < num_chunks; ++ix) {
+      inputs.push_back(hipcomp::datasets::generate(
+          chunk_datasets[ix], chunk_bytes, HIPCOMP_TYPE_CHAR, ix + 1));
+    }
+
+    size_t max_comp_chunk_bytes;
+    REQUIRE(hipcompBatchedSnappyCompressGetMaxOutputChunkSize(
+        chunk_bytes, hipcompBatchedSnappyDefaultOpts, &max_comp_chunk_bytes) == hipcompSuccess);
+    size_t comp_temp_bytes;
+    REQUIRE(hipcompBatchedSnappyCompressGetTempSize(
+        num_chunks, chunk_bytes, hipcompBatchedSnappyDefaultOpts, &comp_temp_bytes)
+        == hipcompSuccess);
+    REQUIRE(hipcompBatchedSnappyDecompressGetTempSize(num_chunks, chunk_bytes, &temp_bytes)
+        == hipcompSuccess);
+
+    void** d_input_ptrs;
+    size_t* d_input_bytes;
+    HIP_CHECK(hipMallocManaged(&d_input_ptrs, sizeof(void*) * num_chunks));
+    HIP_CHECK(hipMallocManaged(&d_input_bytes, sizeof(size_t) * num_chunks));
+    HIP_CHECK(hipMallocManaged(&d_comp_ptrs, sizeof(void*) * num_chunks));
+    HIP_CHECK(hipMallocManaged(&d_comp_bytes, sizeof(size_t) * num_chunks));
+    HIP_CHECK(hipMallocManaged(&d_decomp_ptrs, sizeof(void*) * num_chunks));
+    HIP_CHECK(hipMallocManaged(&d_decomp_bytes, sizeof(size_t) * num_chunks));
+    HIP_CHECK(hipMallocManaged(&d_actual_bytes, sizeof(size_t) * num_chunks));
+    HIP_CHECK(hipMallocManaged(&d_statuses, sizeof(hipcompStatus_t) * num_chunks));
+    HIP_CHECK(hipMallocManaged(
+        &d_profiles, sizeof(hipcompSnappyDecompressProfile_t) * num_chunks));
+    HIP_CHECK(hipMalloc(&d_temp, std::max<size_t>(std::max(temp_bytes, comp_temp_bytes), 1)));
+
+    for (size_t ix = 0; ix < num_chunks; ++ix) {
+      HIP_CHECK(hipMallocManaged(&d_input_ptrs[ix], inputs[ix].size()));
+      std::copy(inputs[ix].begin(), inputs[ix].end(), static_cast<uint8_t*>(d_input_ptrs[ix]));
+      d_input_bytes[ix] = inputs[ix].size();
+      HIP_CHECK(hipMallocManaged(&d_comp_ptrs[ix], max_comp_chunk_bytes));
+      HIP_CHECK(hipMallocManaged(&d_decomp_ptrs[ix], inputs[ix].size()));
+      d_decomp_bytes[ix] = inputs[ix].size();
+    }
+
+    REQUIRE(hipcompBatchedSnappyCompressAsync(
+        d_input_ptrs, d_input_bytes, chunk_bytes, num_chunks, d_temp, comp_temp_bytes,
+        d_comp_ptrs, d_comp_bytes, hipcompBatchedSnappyDefaultOpts, 0) == hipcompSuccess);
+    HIP_CHECK(hipDeviceSynchronize());
+
+    for (size_t ix = 0; ix < num_chunks; ++ix) {
+      hipFree(d_input_ptrs[ix]);
+    }
+    hipFree(d_input_ptrs);
+    hipFree(d_input_bytes);
+
+    clear();
+  }
+
+  ~ProfileBatch()
+  {
+    for (size_t ix = 0; ix < num_chunks; ++ix) {
+      hipFree(d_comp_ptrs[ix]);
+      hipFree(d_decomp_ptrs[ix]);
+    }
+    hipFree(d_comp_ptrs);
+    hipFree(d_comp_bytes);
+    hipFree(d_decomp_ptrs);
+    hipFree(d_decomp_bytes);
+    hipFree(d_actual_bytes);
+    hipFree(d_statuses);
+    hipFree(d_profiles);
+    hipFree(d_temp);
+  }
+
+  void clear()
+  {
+    std::fill(d_profiles, d_profiles + num_chunks, hipcompSnappyDecompressProfile_t{});
+    std::fill(d_actual_bytes, d_actual_bytes + num_chunks, 0);
+    for (size_t ix = 0; ix < num_chunks; ++ix) {
+      std::fill_n(static_cast<uint8_t*>(d_decomp_ptrs[ix]), d_decomp_bytes[ix], 0);
+    }
+  }
+
+  hipcompStatus_t decompress(hipcompSnappyDecompressProfile_t* profiles)
+  {
+    return hipcompBatchedSnappyDecompressWithProfileAsync(
+        d_comp_ptrs, d_comp_bytes, d_decomp_bytes, d_actual_bytes, num_chunks, d_temp,
+        temp_bytes, d_decomp_ptrs, d_statuses, profiles, 0);
+  }
+
+  void check_output() const
+  {
+    for (size_t ix = 0; ix < num_chunks; ++ix) {
+      REQUIRE(d_statuses[ix] == hipcompSuccess);
+      REQUIRE(d_actual_bytes[ix] == inputs[ix].size());
+      const uint8_t* output = static_cast<const uint8_t*>(d_decomp_ptrs[ix]);
+      REQUIRE(std::equal(inputs[ix].begin(), inputs[ix].end(), output));
+    }
+  }
+};
+
+} // namespace
+
+/******************************************************************************
+ * UNIT TESTS *****************************************************************
+ *****************************************************************************/
+
+TEST_CASE("snappy decompress profile", "[small]")
+{
+  ProfileBatch batch;
+  REQUIRE(batch.decompress(batch.d_profiles) == hipcompSuccess);
+  HIP_CHECK(hipDeviceSynchronize());
+
+  batch.check_output();
+  for (size_t ix = 0; ix < num_chunks; ++ix) {
+    const hipcompSnappyDecompressProfile_t& profile = batch.d_profiles[ix];
+    REQUIRE(profile.total_cycles > 0);
+    REQUIRE(profile.prefetch_cycles > 0);
+    REQUIRE(profile.decode_cycles > 0);
+    REQUIRE(profile.process_cycles > 0);
+    REQUIRE(profile.prefetch_cycles <= profile.total_cycles);
+    REQUIRE(profile.decode_cycles <= profile.total_cycles);
+    REQUIRE(profile.process_cycles <= profile.total_cycles);
+    REQUIRE(
+        profile.decode_2_to_3_byte_cycles + profile.decode_2_to_5_byte_cycles
+            + profile.decode_single_thread_cycles
+        <= profile.decode_cycles);
+    REQUIRE(profile.num_batches > 0);
+  }
+  // Random bytes are a few long literals, which take few batches
+  REQUIRE(batch.d_profiles[2].num_batches > batch.d_profiles[1].num_batches);
+}
+
+TEST_CASE("snappy decompress profile is optional", "[small]")
+{
+  ProfileBatch batch;
+  REQUIRE(batch.decompress(nullptr) == hipcompSuccess);
+  HIP_CHECK(hipDeviceSynchronize());
+
+  batch.check_output();
+  for (size_t ix = 0; ix < num_chunks; ++ix) {
+    REQUIRE(batch.d_profiles[ix].total_cycles == 0);
+    REQUIRE(batch.d_profiles[ix].num_batches == 0);
+  }
+}